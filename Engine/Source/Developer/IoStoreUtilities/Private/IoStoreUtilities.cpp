@@ -60,6 +60,7 @@
 #include "IO/IoContainerHeader.h"
 #include "ProfilingDebugging/CountersTrace.h"
 #include "IO/IoStore.h"
+#include "IO/IoReadOrderRecording.h"
 
 //PRAGMA_DISABLE_OPTIMIZATION
 
@@ -612,6 +613,7 @@ struct FIoStoreArguments
 	TArray<FContainerSourceSpec> Containers;
 	FCookedFileStatMap CookedFileStatMap;
 	TArray<FFileOrderMap> OrderMaps;
+	TArray<TArray<FIoReadOrderRecordEntry>> ReadOrderRecordings;
 	FKeyChain KeyChain;
 	FKeyChain PatchKeyChain;
 	FString DLCPluginPath;
@@ -1148,6 +1150,173 @@ static void CreateDiskLayout(
 	}
 }
 
+struct FReadCostEstimate
+{
+	uint64 ReadCount = 0;
+	uint64 BytesRead = 0;
+	uint64 SeekCount = 0;
+	uint64 SeekDistance = 0;
+};
+
+// Replays the recorded reads against a layout of the chunks, in uncompressed offsets as the compressed sizes aren't known yet.
+// Reads cover whole compression blocks, blocks also needed by the previous read are only read once and any read not continuing
+// from where the previous read ended is a seek.
+static FReadCostEstimate EstimateReadCost(
+	const TArray<FContainerTargetFile*>& LayoutOrder,
+	const TArray<TArray<FIoReadOrderRecordEntry>>& Recordings,
+	uint64 CompressionBlockSize)
+{
+	TMap<FIoChunkId, TPair<uint64, uint64>> ChunkRanges;
+	ChunkRanges.Reserve(LayoutOrder.Num());
+	uint64 LayoutOffset = 0;
+	for (const FContainerTargetFile* TargetFile : LayoutOrder)
+	{
+		ChunkRanges.Add(TargetFile->ChunkId, MakeTuple(LayoutOffset, TargetFile->SourceSize));
+		LayoutOffset += Align(TargetFile->SourceSize, CompressionBlockSize);
+	}
+
+	FReadCostEstimate Estimate;
+	for (const TArray<FIoReadOrderRecordEntry>& Recording : Recordings)
+	{
+		uint64 PrevBegin = 0;
+		uint64 PrevEnd = 0;
+		bool bIsFirstRead = true;
+		for (const FIoReadOrderRecordEntry& Entry : Recording)
+		{
+			const TPair<uint64, uint64>* ChunkRange = ChunkRanges.Find(Entry.ChunkId);
+			if (!ChunkRange || Entry.Offset >= ChunkRange->Value)
+			{
+				continue;
+			}
+			const uint64 ReadSize = FMath::Min(Entry.Size, ChunkRange->Value - Entry.Offset);
+			const uint64 Begin = AlignDown(ChunkRange->Key + Entry.Offset, CompressionBlockSize);
+			const uint64 End = Align(ChunkRange->Key + Entry.Offset + ReadSize, CompressionBlockSize);
+			const uint64 OverlapBegin = FMath::Max(Begin, PrevBegin);
+			const uint64 OverlapEnd = FMath::Min(End, PrevEnd);
+
+			++Estimate.ReadCount;
+			Estimate.BytesRead += (End - Begin) - (OverlapEnd > OverlapBegin ? OverlapEnd - OverlapBegin : 0);
+			if (!bIsFirstRead && (Begin < PrevBegin || Begin > PrevEnd))
+			{
+				++Estimate.SeekCount;
+				Estimate.SeekDistance += Begin > PrevEnd ? Begin - PrevEnd : PrevEnd - Begin;
+			}
+			PrevBegin = Begin;
+			PrevEnd = End;
+			bIsFirstRead = false;
+		}
+	}
+	return Estimate;
+}
+
+// Moves the chunks read in the recordings to the front of each container, in the order they were first read, so that the reads of a run
+// are mostly sequential and chunks read at different times don't share compression blocks or read buffers. Chunks that were never read
+// keep the order from CreateDiskLayout behind them.
+static void ApplyReadOrderRecordings(
+	const TArray<FContainerTargetSpec*>& ContainerTargets,
+	const TArray<TArray<FIoReadOrderRecordEntry>>& Recordings,
+	uint64 CompressionBlockSize)
+{
+	IOSTORE_CPU_SCOPE(ApplyReadOrderRecordings);
+
+	// Rank chunks by when they were first read relative to the length of each recording, averaged over the recordings reading them
+	TMap<FIoChunkId, TPair<double, int32>> ChunkRankSums;
+	for (const TArray<FIoReadOrderRecordEntry>& Recording : Recordings)
+	{
+		TArray<FIoChunkId> FirstReads;
+		TSet<FIoChunkId> SeenChunks;
+		for (const FIoReadOrderRecordEntry& Entry : Recording)
+		{
+			bool bIsAlreadyInSet;
+			SeenChunks.Add(Entry.ChunkId, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet)
+			{
+				FirstReads.Add(Entry.ChunkId);
+			}
+		}
+		for (int32 ReadIndex = 0; ReadIndex < FirstReads.Num(); ++ReadIndex)
+		{
+			TPair<double, int32>& RankSum = ChunkRankSums.FindOrAdd(FirstReads[ReadIndex], MakeTuple(0.0, 0));
+			RankSum.Key += double(ReadIndex) / double(FirstReads.Num());
+			++RankSum.Value;
+		}
+	}
+	TMap<FIoChunkId, double> ChunkRanks;
+	ChunkRanks.Reserve(ChunkRankSums.Num());
+	for (const TPair<FIoChunkId, TPair<double, int32>>& RankSum : ChunkRankSums)
+	{
+		ChunkRanks.Add(RankSum.Key, RankSum.Value.Key / RankSum.Value.Value);
+	}
+
+	FReadCostEstimate TotalBefore;
+	FReadCostEstimate TotalAfter;
+	UE_LOG(LogIoStore, Display, TEXT("Applying %d read order recordings, estimated cost in uncompressed bytes:"), Recordings.Num());
+	UE_LOG(LogIoStore, Display, TEXT("%-40s %10s %14s %14s %10s %10s %16s %16s"), TEXT("Container"), TEXT("Reads"), TEXT("MB Before"), TEXT("MB After"), TEXT("Seeks Bef."), TEXT("Seeks Aft."), TEXT("Seek MB Before"), TEXT("Seek MB After"));
+	for (FContainerTargetSpec* ContainerTarget : ContainerTargets)
+	{
+		TArray<FContainerTargetFile*> LayoutOrder;
+		LayoutOrder.Reserve(ContainerTarget->TargetFiles.Num());
+		for (FContainerTargetFile& TargetFile : ContainerTarget->TargetFiles)
+		{
+			LayoutOrder.Add(&TargetFile);
+		}
+		Algo::SortBy(LayoutOrder, [](const FContainerTargetFile* TargetFile) { return TargetFile->IdealOrder; });
+
+		const FReadCostEstimate Before = EstimateReadCost(LayoutOrder, Recordings, CompressionBlockSize);
+
+		// The shader library stays first and memory mapped bulk data is never read through the dispatcher
+		auto GetLayoutGroup = [&ChunkRanks](const FContainerTargetFile* TargetFile)
+		{
+			if (TargetFile->ChunkType == EContainerChunkType::ShaderCodeLibrary)
+			{
+				return 0;
+			}
+			if (TargetFile->ChunkType != EContainerChunkType::MemoryMappedBulkData && ChunkRanks.Contains(TargetFile->ChunkId))
+			{
+				return 1;
+			}
+			return 2;
+		};
+		Algo::StableSort(LayoutOrder, [&ChunkRanks, &GetLayoutGroup](const FContainerTargetFile* A, const FContainerTargetFile* B)
+		{
+			const int32 GroupA = GetLayoutGroup(A);
+			const int32 GroupB = GetLayoutGroup(B);
+			if (GroupA != GroupB)
+			{
+				return GroupA < GroupB;
+			}
+			return GroupA == 1 && ChunkRanks.FindChecked(A->ChunkId) < ChunkRanks.FindChecked(B->ChunkId);
+		});
+		uint64 IdealOrder = 0;
+		for (FContainerTargetFile* TargetFile : LayoutOrder)
+		{
+			TargetFile->IdealOrder = IdealOrder++;
+		}
+
+		const FReadCostEstimate After = EstimateReadCost(LayoutOrder, Recordings, CompressionBlockSize);
+		if (Before.ReadCount)
+		{
+			UE_LOG(LogIoStore, Display, TEXT("%-40s %10llu %14.2f %14.2f %10llu %10llu %16.2f %16.2f"),
+				*ContainerTarget->Name.ToString(), Before.ReadCount,
+				double(Before.BytesRead) / 1024.0 / 1024.0, double(After.BytesRead) / 1024.0 / 1024.0,
+				Before.SeekCount, After.SeekCount,
+				double(Before.SeekDistance) / 1024.0 / 1024.0, double(After.SeekDistance) / 1024.0 / 1024.0);
+		}
+		TotalBefore.ReadCount += Before.ReadCount;
+		TotalBefore.BytesRead += Before.BytesRead;
+		TotalBefore.SeekCount += Before.SeekCount;
+		TotalBefore.SeekDistance += Before.SeekDistance;
+		TotalAfter.BytesRead += After.BytesRead;
+		TotalAfter.SeekCount += After.SeekCount;
+		TotalAfter.SeekDistance += After.SeekDistance;
+	}
+	UE_LOG(LogIoStore, Display, TEXT("%-40s %10llu %14.2f %14.2f %10llu %10llu %16.2f %16.2f"),
+		TEXT("Total"), TotalBefore.ReadCount,
+		double(TotalBefore.BytesRead) / 1024.0 / 1024.0, double(TotalAfter.BytesRead) / 1024.0 / 1024.0,
+		TotalBefore.SeekCount, TotalAfter.SeekCount,
+		double(TotalBefore.SeekDistance) / 1024.0 / 1024.0, double(TotalAfter.SeekDistance) / 1024.0 / 1024.0);
+}
+
 FContainerTargetSpec* AddContainer(
 	FName Name,
 	TArray<FContainerTargetSpec*>& Containers)
@@ -2722,6 +2891,10 @@ int32 CreateTarget(const FIoStoreArguments& Arguments, const FIoStoreWriterSetti
 		ClusterStatsCsv.CreateOutputFile(ClusterCSVPath);
 	}
 	CreateDiskLayout(ContainerTargets, Packages, Arguments.OrderMaps, PackageIdMap, Arguments.bClusterByOrderFilePriority);
+	if (!Arguments.ReadOrderRecordings.IsEmpty())
+	{
+		ApplyReadOrderRecordings(ContainerTargets, Arguments.ReadOrderRecordings, GeneralIoWriterSettings.CompressionBlockSize);
+	}
 
 	for (FContainerTargetSpec* ContainerTarget : ContainerTargets)
 	{
@@ -5194,6 +5367,23 @@ static bool ParseOrderFileArguments(FIoStoreArguments& Arguments)
 	}
 
 	Arguments.bClusterByOrderFilePriority = !FParse::Param(FCommandLine::Get(), TEXT("DoNotClusterByOrderPriority"));
+
+	FString ReadOrderRecordingsStr;
+	if (FParse::Value(FCommandLine::Get(), TEXT("ReadOrderRecordings="), ReadOrderRecordingsStr, false))
+	{
+		TArray<FString> ReadOrderRecordingPaths;
+		ReadOrderRecordingsStr.ParseIntoArray(ReadOrderRecordingPaths, TEXT(","), true);
+		for (const FString& ReadOrderRecordingPath : ReadOrderRecordingPaths)
+		{
+			TArray<FIoReadOrderRecordEntry>& Recording = Arguments.ReadOrderRecordings.AddDefaulted_GetRef();
+			if (!LoadIoReadOrderRecording(*ReadOrderRecordingPath, Recording))
+			{
+				UE_LOG(LogIoStore, Error, TEXT("Failed to load read order recording '%s'"), *ReadOrderRecordingPath);
+				return false;
+			}
+			UE_LOG(LogIoStore, Display, TEXT("Read order recording %s (%d reads)"), *ReadOrderRecordingPath, Recording.Num());
+		}
+	}
 	
 	return true;
 }
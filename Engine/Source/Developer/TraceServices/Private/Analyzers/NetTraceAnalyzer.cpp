@@ -15,6 +15,7 @@ enum ENetTraceAnalyzerVersion
 	ENetTraceAnalyzerVersion_Initial = 1,
 	ENetTraceAnalyzerVersion_BunchChannelIndex = 2,
 	ENetTraceAnalyzerVersion_BunchChannelInfo = 3,
+	ENetTraceAnalyzerVersion_ConnectionStatsCounter = 4,
 };
 
 
@@ -45,6 +46,7 @@ void FNetTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context)
 	Builder.RouteEvent(RouteId_ObjectDestroyedEvent, "NetTrace", "ObjectDestroyedEvent");
 	Builder.RouteEvent(RouteId_ConnectionStateUpdatedEvent, "NetTrace", "ConnectionStateUpdatedEvent");
 	Builder.RouteEvent(RouteId_InstanceUpdatedEvent, "NetTrace", "InstanceUpdatedEvent");
+	Builder.RouteEvent(RouteId_ConnectionStatsCounterEvent, "NetTrace", "ConnectionStatsCounterEvent");
 
 	// Default names
 	{
@@ -166,6 +168,12 @@ bool FNetTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventCont
 		}
 		break;
 
+		case RouteId_ConnectionStatsCounterEvent:
+		{
+			HandleConnectionStatsCounterEvent(Context, EventData);
+		}
+		break;
+
 		case RouteId_ObjectCreatedEvent:
 		{
 			HandleObjectCreatedEvent(Context, EventData);
@@ -601,6 +609,33 @@ void FNetTraceAnalyzer::HandleConnectionClosedEvent(const FOnEventContext& Conte
 	}
 }
 
+void FNetTraceAnalyzer::HandleConnectionStatsCounterEvent(const FOnEventContext& Context, const FEventData& EventData)
+{
+	const uint64 TimestampCycles = EventData.GetValue<uint64>("Timestamp");
+	const uint32 Value = EventData.GetValue<uint32>("Value");
+	const uint16 NameId = EventData.GetValue<uint16>("NameId");
+	const uint16 ConnectionId = EventData.GetValue<uint16>("ConnectionId");
+	const uint8 GameInstanceId = EventData.GetValue<uint8>("GameInstanceId");
+
+	LastTimeStamp = Context.EventTime.AsSeconds(TimestampCycles);
+
+	FNetTraceConnectionState* ConnectionState = GetActiveConnectionState(GameInstanceId, ConnectionId);
+	if (!ConnectionState)
+	{
+		return;
+	}
+
+	const uint32* NetProfilerNameIndex = TracedNameIdToNetProfilerNameIdMap.Find(NameId);
+
+	// Counters are reported from the sending side
+	FNetProfilerConnectionData& ConnectionData = NetProfilerProvider.EditConnectionData(ConnectionState->ConnectionIndex, ENetProfilerConnectionMode::Outgoing);
+
+	FNetProfilerStatsCounter& StatsCounter = ConnectionData.StatsCounters.PushBack();
+	StatsCounter.TimeStamp = GetLastTimestamp();
+	StatsCounter.NameIndex = NetProfilerNameIndex ? *NetProfilerNameIndex : 0u;
+	StatsCounter.Value = Value;
+}
+
 void FNetTraceAnalyzer::HandleObjectCreatedEvent(const FOnEventContext& Context, const FEventData& EventData)
 {
 	const uint64 TypeId = EventData.GetValue<uint64>("TypeId");
@@ -37,6 +37,7 @@ private:
 		RouteId_ObjectDestroyedEvent,
 		RouteId_ConnectionStateUpdatedEvent,
 		RouteId_InstanceUpdatedEvent,
+		RouteId_ConnectionStatsCounterEvent,
 	};
 
 	// This must be kept in sync with Event types in NetTrace.h
@@ -121,6 +122,7 @@ private:
 	void HandleConnectionCreatedEvent(const FOnEventContext& Context, const FEventData& EventData);
 	void HandleConnectionUpdatedEvent(const FOnEventContext& Context, const FEventData& EventData);
 	void HandleConnectionClosedEvent(const FOnEventContext& Context, const FEventData& EventData);
+	void HandleConnectionStatsCounterEvent(const FOnEventContext& Context, const FEventData& EventData);
 	void HandleObjectCreatedEvent(const FOnEventContext& Context, const FEventData& EventData);
 	void HandleObjectDestroyedEvent(const FOnEventContext& Context, const FEventData& EventData);
 
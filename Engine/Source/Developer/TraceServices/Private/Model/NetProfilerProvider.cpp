@@ -537,6 +537,25 @@ uint32 FNetProfilerProvider::GetPacketContentEventChangeCount(uint32 ConnectionI
 	return Connections[ConnectionIndex].Data[Mode]->ContentEventChangeCount;
 }
 
+uint32 FNetProfilerProvider::GetStatsCounterCount(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode) const
+{
+	Session.ReadAccessCheck();
+	check(ConnectionIndex < Connections.Num());
+
+	return Connections[ConnectionIndex].Data[Mode]->StatsCounters.Num();
+}
+
+void FNetProfilerProvider::EnumerateStatsCounters(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode, TFunctionRef<void(const FNetProfilerStatsCounter&)> Callback) const
+{
+	Session.ReadAccessCheck();
+	check(ConnectionIndex < Connections.Num());
+
+	for (const FNetProfilerStatsCounter& StatsCounter : Connections[ConnectionIndex].Data[Mode]->StatsCounters)
+	{
+		Callback(StatsCounter);
+	}
+}
+
 ITable<FNetProfilerAggregatedStats>* FNetProfilerProvider::CreateAggregation(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode, uint32 PacketIndexIntervalStart, uint32 PacketIndexIntervalEnd, uint32 StartPosition, uint32 EndPosition) const
 {
 	Session.ReadAccessCheck();
@@ -26,12 +26,14 @@ struct FNetProfilerConnectionData
 	FNetProfilerConnectionData(ILinearAllocator& Allocator)
 		: Packets(Allocator, 1024)
 		, ContentEvents(Allocator, 8192)
+		, StatsCounters(Allocator, 1024)
 		, PacketChangeCount(0u)
 		, ContentEventChangeCount(0u)
 	{}
 
 	TPagedArray<FNetProfilerPacket> Packets;
 	TPagedArray<FNetProfilerContentEvent> ContentEvents;
+	TPagedArray<FNetProfilerStatsCounter> StatsCounters;
 
 	uint32 PacketChangeCount;
 	uint32 ContentEventChangeCount;
@@ -112,6 +114,10 @@ public:
 	virtual void EnumeratePacketContentEventsByPosition(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode, uint32 PacketIndex, uint32 StartPos, uint32 EndPos, TFunctionRef<void(const FNetProfilerContentEvent&)> Callback) const override;
 	virtual uint32 GetPacketContentEventChangeCount(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode) const override;
 
+	// Enumerate stats counters
+	virtual uint32 GetStatsCounterCount(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode) const override;
+	virtual void EnumerateStatsCounters(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode, TFunctionRef<void(const FNetProfilerStatsCounter&)> Callback) const override;
+
 	// Stats queries
 	virtual ITable<FNetProfilerAggregatedStats>* CreateAggregation(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode, uint32 PacketIndexIntervalStart, uint32 PacketIndexIntervalEnd, uint32 StartPosition, uint32 EndPosition) const override;
 
@@ -142,6 +142,13 @@ struct FNetProfilerPacket
 	ENetProfilerConnectionState ConnectionState;
 };
 
+struct FNetProfilerStatsCounter
+{
+	FNetProfilerTimeStamp TimeStamp;
+	uint32 NameIndex;				// Index in the Name array
+	uint32 Value;
+};
+
 struct FNetProfilerConnection
 {
 	const TCHAR* Name = nullptr;
@@ -229,6 +236,11 @@ public:
 	// Returns a change number incremented each time a change occurs in the packet content events for the specified connection and connection mode. */
 	virtual uint32 GetPacketContentEventChangeCount(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode) const = 0;
 
+	// Gets the number of stats counter values reported for the specified connection and connection mode.
+	virtual uint32 GetStatsCounterCount(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode) const = 0;
+	// Enumerates all stats counter values reported for the specified connection and connection mode, in the order they were traced.
+	virtual void EnumerateStatsCounters(uint32 ConnectionIndex, ENetProfilerConnectionMode Mode, TFunctionRef<void(const FNetProfilerStatsCounter&)> Callback) const = 0;
+
 	// Computes aggregated stats for a packet interval or for a range of content events in a single packet.
 	// [PacketIndexIntervalStart, PacketIndexIntervalEnd] is the inclusive packet interval.
 	// [StartPosition, EndPosition) is the exclusive bit range interval; only used when PacketIndexIntervalStart == PacketIndexIntervalEnd.
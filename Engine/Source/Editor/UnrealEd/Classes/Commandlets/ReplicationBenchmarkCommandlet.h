@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Commandlets/Commandlet.h"
+#include "ReplicationBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless server replication benchmark, using simulated client connections which absorb all traffic (see USimulatedClientNetConnection).
+ * Spawns replicated actors with configurable property churn in an empty world, replicates them to every client for a number of frames,
+ * and reports the time spent in each replication phase and the bytes sent per frame.
+ *
+ * Usage:
+ *	UnrealEditor-Cmd <Project> -run=ReplicationBenchmark [-Clients=16] [-Actors=1000] [-Frames=300] [-Churn=0.25] [-ValidateParallel] [-Output=Results.csv]
+ *
+ * See the commandlet implementation for the full list of parameters.
+ */
+UCLASS()
+class UReplicationBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -18,6 +18,7 @@
 #include "ICollectionManager.h"
 #include "CollectionManagerModule.h"
 #include "Interfaces/ITargetPlatform.h"
+#include "AssetRegistry/AssetRegistryFlatState.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "GameDelegates.h"
 #include "Commandlets/IChunkDataGenerator.h"
@@ -1372,6 +1373,17 @@ void FAssetRegistryGenerator::AddAssetToFileOrderRecursive(const FName& InPackag
 	}
 }
 
+/** Writes a runtime registry in the format of FAssetRegistryFlatState next to it, see [AssetRegistry] bSerializeFlatAssetRegistry */
+static void SaveFlatAssetRegistry(const FAssetRegistryState& RuntimeState, const FString& AssetRegistryFilename)
+{
+	FArrayWriter SerializedFlatAssetRegistry;
+	FAssetRegistryFlatState::Save(RuntimeState, SerializedFlatAssetRegistry);
+
+	const FString FlatAssetRegistryFilename = FPaths::ChangeExtension(AssetRegistryFilename, TEXT("flat"));
+	FFileHelper::SaveArrayToFile(SerializedFlatAssetRegistry, *FlatAssetRegistryFilename);
+	UE_LOG(LogAssetRegistryGenerator, Display, TEXT("Generated flat asset registry %s, size is %5.2fkb"), *FlatAssetRegistryFilename, (float)SerializedFlatAssetRegistry.Num() / 1024.f);
+}
+
 bool FAssetRegistryGenerator::SaveAssetRegistry(const FString& SandboxPath, bool bSerializeDevelopmentAssetRegistry, bool bForceNoFilter)
 {
 	UE_LOG(LogAssetRegistryGenerator, Display, TEXT("Saving asset registry v%d."), FAssetRegistryVersion::Type::LatestVersion);
@@ -1490,6 +1502,10 @@ bool FAssetRegistryGenerator::SaveAssetRegistry(const FString& SandboxPath, bool
 				PlatformSandboxPath += ChunkBucketNames[ChunkBucketElement.Key] + TEXT(".") + SandboxPathExtension;
 
 				FFileHelper::SaveArrayToFile(SerializedAssetRegistry, *PlatformSandboxPath);
+				if (SaveOptions.bSerializeFlatAssetRegistry)
+				{
+					SaveFlatAssetRegistry(NewState, PlatformSandboxPath);
+				}
 
 				FString FilenameForLog;
 				if (ChunkBucketElement.Key != GenericChunkBucket)
@@ -1516,6 +1532,10 @@ bool FAssetRegistryGenerator::SaveAssetRegistry(const FString& SandboxPath, bool
 			// Save the generated registry
 			FString PlatformSandboxPath = SandboxPath.Replace(TEXT("[Platform]"), *TargetPlatform->PlatformName());
 			FFileHelper::SaveArrayToFile(SerializedAssetRegistry, *PlatformSandboxPath);
+			if (SaveOptions.bSerializeFlatAssetRegistry)
+			{
+				SaveFlatAssetRegistry(State, PlatformSandboxPath);
+			}
 			UE_LOG(LogAssetRegistryGenerator, Display, TEXT("Generated asset registry num assets %d, size is %5.2fkb"), ObjectToDataMap.Num(), (float)SerializedAssetRegistry.Num() / 1024.f);
 		}
 	}
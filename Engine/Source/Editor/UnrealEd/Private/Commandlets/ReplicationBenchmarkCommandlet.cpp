@@ -0,0 +1,394 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/ReplicationBenchmarkCommandlet.h"
+#include "ReplicationBenchmarkTypes.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "EngineGlobals.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Net/UnrealNetwork.h"
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogReplicationBenchmark, Log, All);
+
+
+/*-----------------------------------------------------------------------------
+	UReplicationBenchmarkNetDriver.
+-----------------------------------------------------------------------------*/
+
+UReplicationBenchmarkNetDriver::UReplicationBenchmarkNetDriver(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NetConnectionClass = USimulatedClientNetConnection::StaticClass();
+}
+
+bool UReplicationBenchmarkNetDriver::InitConnect(FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error)
+{
+	Error = TEXT("The replication benchmark net driver only supports simulated client connections");
+
+	return false;
+}
+
+bool UReplicationBenchmarkNetDriver::InitListen(FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error)
+{
+	return InitBase(false, InNotify, ListenURL, bReuseAddressAndPort, Error);
+}
+
+
+/*-----------------------------------------------------------------------------
+	AReplicationBenchmarkActor.
+-----------------------------------------------------------------------------*/
+
+AReplicationBenchmarkActor::AReplicationBenchmarkActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Vector(FVector::ZeroVector)
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneComponent"));
+
+	bReplicates = true;
+	SetReplicatingMovement(true);
+
+	FMemory::Memzero(Values);
+}
+
+void AReplicationBenchmarkActor::Churn(FRandomStream& RandomStream, int32 NumChangedProperties)
+{
+	for (int32 ChangeIdx = 0; ChangeIdx < NumChangedProperties; ChangeIdx++)
+	{
+		// One past the last value selects Vector
+		const int32 PropertyIdx = RandomStream.RandHelper(NumValues + 1);
+
+		if (PropertyIdx < NumValues)
+		{
+			Values[PropertyIdx] = (int32)RandomStream.GetUnsignedInt();
+		}
+		else
+		{
+			Vector = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.f, 1000.f);
+		}
+	}
+}
+
+void AReplicationBenchmarkActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AReplicationBenchmarkActor, Values);
+	DOREPLIFETIME(AReplicationBenchmarkActor, Vector);
+}
+
+
+/*-----------------------------------------------------------------------------
+	UReplicationBenchmarkCommandlet.
+-----------------------------------------------------------------------------*/
+
+/**
+ * UReplicationBenchmarkCommandlet
+ *
+ * Optional parameters:
+ *	-Clients=N:				The number of simulated client connections (default 16)
+ *	-Actors=N:				The number of replicated actors (default 1000)
+ *	-Frames=N:				The number of measured frames (default 300)
+ *	-WarmupFrames=N:		The number of frames run before measuring, while actor channels are opened (default 30)
+ *	-TickRate=N:			The simulated server tick rate, in frames per second (default 30)
+ *	-Churn=F:				The fraction of actors which change replicated properties each frame (default 0.25)
+ *	-ChurnProperties=N:		The number of properties changed on each churned actor (default 4)
+ *	-Movement:				Churned actors also move, which exercises movement replication and relevancy changes
+ *	-WorldExtent=F:			Actors and clients are placed randomly within this distance of the origin, along X/Y (default 20000)
+ *	-NetSpeed=N:			The net speed of each client, in bytes per second (default 1000000)
+ *	-Seed=N:				The random seed (default 0)
+ *	-ValidateParallel:		Enables net.ParallelPrioritizeActors with net.ParallelPrioritizeActors.Validate, so every frame compares the
+ *							parallel actor gather against the serial one, and fails if any connection differs
+ *	-Output=Path:			Appends the results to a CSV file, for tracking over time (e.g. on CI)
+ *
+ * Example:
+ *	UnrealEditor-Cmd MyProject -run=ReplicationBenchmark -Clients=64 -Actors=5000 -Churn=0.1 -Output=ReplicationBenchmark.csv
+ */
+
+UReplicationBenchmarkCommandlet::UReplicationBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UReplicationBenchmarkCommandlet::Main(const FString& Params)
+{
+	const TCHAR* Parms = *Params;
+
+	int32 NumClients = 16;
+	int32 NumActors = 1000;
+	int32 NumFrames = 300;
+	int32 NumWarmupFrames = 30;
+	float TickRate = 30.f;
+	float ChurnFraction = 0.25f;
+	int32 NumChurnProperties = 4;
+	float WorldExtent = 20000.f;
+	int32 NetSpeed = 1000000;
+	int32 Seed = 0;
+	FString OutputPath;
+
+	FParse::Value(Parms, TEXT("Clients="), NumClients);
+	FParse::Value(Parms, TEXT("Actors="), NumActors);
+	FParse::Value(Parms, TEXT("Frames="), NumFrames);
+	FParse::Value(Parms, TEXT("WarmupFrames="), NumWarmupFrames);
+	FParse::Value(Parms, TEXT("TickRate="), TickRate);
+	FParse::Value(Parms, TEXT("Churn="), ChurnFraction);
+	FParse::Value(Parms, TEXT("ChurnProperties="), NumChurnProperties);
+	FParse::Value(Parms, TEXT("WorldExtent="), WorldExtent);
+	FParse::Value(Parms, TEXT("NetSpeed="), NetSpeed);
+	FParse::Value(Parms, TEXT("Seed="), Seed);
+	FParse::Value(Parms, TEXT("Output="), OutputPath);
+
+	const bool bMovement = FParse::Param(Parms, TEXT("Movement"));
+	const bool bValidateParallel = FParse::Param(Parms, TEXT("ValidateParallel"));
+
+	NumClients = FMath::Max(NumClients, 1);
+	NumActors = FMath::Max(NumActors, 0);
+	NumFrames = FMath::Max(NumFrames, 1);
+	NumWarmupFrames = FMath::Max(NumWarmupFrames, 0);
+	ChurnFraction = FMath::Clamp(ChurnFraction, 0.f, 1.f);
+
+	// ServerReplicateActors skips connections which haven't received for 1.5 seconds, so the tick rate must stay above that
+	const float DeltaSeconds = 1.f / FMath::Clamp(TickRate, 1.f, 1000.f);
+
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("Replication benchmark: %i clients, %i actors, %i frames at %.1f Hz, churn %.2f (%i properties%s)"),
+		NumClients, NumActors, NumFrames, 1.f / DeltaSeconds, ChurnFraction, NumChurnProperties, bMovement ? TEXT(", movement") : TEXT(""));
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ReplicationBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	FString Error;
+	UReplicationBenchmarkNetDriver* NetDriver = NewObject<UReplicationBenchmarkNetDriver>(GetTransientPackage());
+
+	NetDriver->SetNetDriverName(TEXT("ReplicationBenchmarkNetDriver"));
+
+	if (!NetDriver->InitListen(World, URL, false, Error))
+	{
+		UE_LOG(LogReplicationBenchmark, Error, TEXT("Failed to initialize net driver: %s"), *Error);
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+
+		return 1;
+	}
+
+	NetDriver->SetWorld(World);
+	World->SetNetDriver(NetDriver);
+
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	IConsoleVariable* ParallelPrioritizeCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.ParallelPrioritizeActors"));
+	IConsoleVariable* ParallelPrioritizeValidateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.ParallelPrioritizeActors.Validate"));
+	const int32 PrevParallelPrioritize = ParallelPrioritizeCVar != nullptr ? ParallelPrioritizeCVar->GetInt() : 0;
+	const int32 PrevParallelPrioritizeValidate = ParallelPrioritizeValidateCVar != nullptr ? ParallelPrioritizeValidateCVar->GetInt() : 0;
+
+	if (bValidateParallel && ParallelPrioritizeCVar != nullptr && ParallelPrioritizeValidateCVar != nullptr)
+	{
+		ParallelPrioritizeCVar->Set(1, ECVF_SetByCode);
+		ParallelPrioritizeValidateCVar->Set(1, ECVF_SetByCode);
+	}
+
+	FRandomStream RandomStream(Seed);
+
+	auto GetRandomLocation = [&RandomStream, WorldExtent]() -> FVector
+		{
+			return FVector(RandomStream.FRandRange(-WorldExtent, WorldExtent), RandomStream.FRandRange(-WorldExtent, WorldExtent), 0.f);
+		};
+
+	TArray<AReplicationBenchmarkActor*> Actors;
+
+	Actors.Reserve(NumActors);
+
+	for (int32 ActorIdx = 0; ActorIdx < NumActors; ActorIdx++)
+	{
+		AReplicationBenchmarkActor* Actor = World->SpawnActor<AReplicationBenchmarkActor>(GetRandomLocation(), FRotator::ZeroRotator);
+
+		if (Actor != nullptr)
+		{
+			Actor->Churn(RandomStream, AReplicationBenchmarkActor::NumValues);
+
+			// The world context doesn't track the net driver, so actors must be registered with it directly
+			NetDriver->AddNetworkActor(Actor);
+			Actors.Add(Actor);
+		}
+	}
+
+	TArray<USimulatedClientNetConnection*> Connections;
+
+	for (int32 ClientIdx = 0; ClientIdx < NumClients; ClientIdx++)
+	{
+		// Each client views the world from a non-replicated actor, in place of a player controller
+		AReplicationBenchmarkActor* Viewer = World->SpawnActor<AReplicationBenchmarkActor>(GetRandomLocation(), FRotator::ZeroRotator);
+
+		Viewer->SetReplicates(false);
+
+		USimulatedClientNetConnection* Connection = NewObject<USimulatedClientNetConnection>();
+
+		Connection->InitConnection(NetDriver, USOCK_Open, URL, NetSpeed);
+		Connection->InitSendBuffer();
+
+		NetDriver->AddClientConnection(Connection);
+
+		Connection->OwningActor = Viewer;
+		Connection->SetClientWorldPackageName(NetDriver->GetWorldPackage()->GetFName());
+
+		Connections.Add(Connection);
+	}
+
+	FNetReplicationPhaseTimings FrameTimings;
+	FNetReplicationPhaseTimings TotalTimings;
+	uint64 TotalFrameCycles = 0;
+	uint64 MaxFrameCycles = 0;
+	uint64 TotalBytes = 0;
+	uint64 TotalPackets = 0;
+
+	NetDriver->SetReplicationPhaseTimings(&FrameTimings);
+
+	const int32 NumChurnedActors = FMath::RoundToInt(ChurnFraction * Actors.Num());
+
+	for (int32 FrameIdx = 0; FrameIdx < NumWarmupFrames + NumFrames; FrameIdx++)
+	{
+		for (int32 ChurnIdx = 0; ChurnIdx < NumChurnedActors; ChurnIdx++)
+		{
+			AReplicationBenchmarkActor* Actor = Actors[RandomStream.RandHelper(Actors.Num())];
+
+			Actor->Churn(RandomStream, NumChurnProperties);
+
+			if (bMovement)
+			{
+				const FVector Offset(RandomStream.FRandRange(-500.f, 500.f), RandomStream.FRandRange(-500.f, 500.f), 0.f);
+				const FVector NewLocation = (Actor->GetActorLocation() + Offset).BoundToCube(WorldExtent);
+
+				Actor->SetActorLocation(NewLocation);
+			}
+		}
+
+		// Simulated clients never send packets, so keep them from being treated as timed out by ServerReplicateActors
+		for (USimulatedClientNetConnection* Connection : Connections)
+		{
+			Connection->LastReceiveTime = NetDriver->GetElapsedTime();
+		}
+
+		const uint32 StartOutBytes = NetDriver->OutTotalBytes;
+		const uint32 StartOutPackets = NetDriver->OutTotalPackets;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		FrameTimings.Reset();
+
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+
+		const uint64 FrameCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		if (FrameIdx >= NumWarmupFrames)
+		{
+			TotalTimings.BuildConsiderListCycles += FrameTimings.BuildConsiderListCycles;
+			TotalTimings.PrioritizeActorsCycles += FrameTimings.PrioritizeActorsCycles;
+			TotalTimings.ReplicatePropertiesCycles += FrameTimings.ReplicatePropertiesCycles;
+			TotalTimings.FlushNetCycles += FrameTimings.FlushNetCycles;
+
+			TotalFrameCycles += FrameCycles;
+			MaxFrameCycles = FMath::Max(MaxFrameCycles, FrameCycles);
+
+			TotalBytes += NetDriver->OutTotalBytes - StartOutBytes;
+			TotalPackets += NetDriver->OutTotalPackets - StartOutPackets;
+		}
+	}
+
+	NetDriver->SetReplicationPhaseTimings(nullptr);
+
+	auto AverageMs = [NumFrames](uint64 Cycles) -> double
+		{
+			return FPlatformTime::ToMilliseconds64(Cycles) / NumFrames;
+		};
+
+	const double BuildConsiderListMs = AverageMs(TotalTimings.BuildConsiderListCycles);
+	const double PrioritizeActorsMs = AverageMs(TotalTimings.PrioritizeActorsCycles);
+	const double ReplicatePropertiesMs = AverageMs(TotalTimings.ReplicatePropertiesCycles);
+	const double FlushNetMs = AverageMs(TotalTimings.FlushNetCycles);
+	const double FrameMs = AverageMs(TotalFrameCycles);
+	const double MaxFrameMs = FPlatformTime::ToMilliseconds64(MaxFrameCycles);
+	const double BytesPerFrame = (double)TotalBytes / NumFrames;
+	const double PacketsPerFrame = (double)TotalPackets / NumFrames;
+
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("Average per frame (%i frames):"), NumFrames);
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("  BuildConsiderList:    %8.3f ms"), BuildConsiderListMs);
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("  PrioritizeActors:     %8.3f ms"), PrioritizeActorsMs);
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("  ReplicateProperties:  %8.3f ms"), ReplicatePropertiesMs);
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("  FlushNet:             %8.3f ms"), FlushNetMs);
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("  Frame:                %8.3f ms (max %.3f ms)"), FrameMs, MaxFrameMs);
+	UE_LOG(LogReplicationBenchmark, Display, TEXT("  Bytes sent:           %10.1f (%.1f packets)"), BytesPerFrame, PacketsPerFrame);
+
+	int32 Result = 0;
+
+	if (bValidateParallel)
+	{
+		if (ParallelPrioritizeCVar == nullptr || ParallelPrioritizeValidateCVar == nullptr)
+		{
+			UE_LOG(LogReplicationBenchmark, Error, TEXT("-ValidateParallel requires net.ParallelPrioritizeActors and net.ParallelPrioritizeActors.Validate"));
+
+			Result = 1;
+		}
+		else
+		{
+			ParallelPrioritizeCVar->Set(PrevParallelPrioritize, ECVF_SetByCode);
+			ParallelPrioritizeValidateCVar->Set(PrevParallelPrioritizeValidate, ECVF_SetByCode);
+
+			const uint32 NumMismatches = NetDriver->GetParallelGatherMismatches();
+
+			if (NumMismatches > 0)
+			{
+				UE_LOG(LogReplicationBenchmark, Error, TEXT("Parallel and serial actor gathers differed for %u connection updates"), NumMismatches);
+
+				Result = 1;
+			}
+			else
+			{
+				UE_LOG(LogReplicationBenchmark, Display, TEXT("Parallel and serial actor gathers matched for every connection update"));
+			}
+		}
+	}
+
+	if (!OutputPath.IsEmpty())
+	{
+		FString Output;
+
+		if (!FPaths::FileExists(OutputPath))
+		{
+			Output += TEXT("Clients,Actors,Frames,TickRate,Churn,ChurnProperties,Movement,")
+				TEXT("BuildConsiderListMs,PrioritizeActorsMs,ReplicatePropertiesMs,FlushNetMs,FrameMs,MaxFrameMs,BytesPerFrame,PacketsPerFrame")
+				LINE_TERMINATOR;
+		}
+
+		Output += FString::Printf(TEXT("%i,%i,%i,%.1f,%.3f,%i,%i,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f,%.2f") LINE_TERMINATOR,
+			NumClients, NumActors, NumFrames, 1.f / DeltaSeconds, ChurnFraction, NumChurnProperties, bMovement ? 1 : 0,
+			BuildConsiderListMs, PrioritizeActorsMs, ReplicatePropertiesMs, FlushNetMs, FrameMs, MaxFrameMs, BytesPerFrame, PacketsPerFrame);
+
+		if (!FFileHelper::SaveStringToFile(Output, *OutputPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogReplicationBenchmark, Error, TEXT("Failed to write results to '%s'"), *OutputPath);
+
+			Result = 1;
+		}
+	}
+
+	World->SetNetDriver(nullptr);
+	NetDriver->SetWorld(nullptr);
+	NetDriver->Shutdown();
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return Result;
+}
@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "GameFramework/Actor.h"
+#include "Engine/NetDriver.h"
+
+#include "ReplicationBenchmarkTypes.generated.h"
+
+
+/**
+ * Net driver used by UReplicationBenchmarkCommandlet, which has no socket - all of its client connections are simulated
+ */
+UCLASS(transient, config=Engine)
+class UReplicationBenchmarkNetDriver : public UNetDriver
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	//~ Begin UNetDriver Interface
+	virtual bool IsAvailable() const override { return true; }
+	virtual bool InitConnect(FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error) override;
+	virtual bool InitListen(FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error) override;
+	virtual ISocketSubsystem* GetSocketSubsystem() override { return nullptr; }
+	virtual bool IsNetResourceValid() override { return true; }
+	//~ End UNetDriver Interface
+};
+
+
+/**
+ * Replicated actor used by UReplicationBenchmarkCommandlet, with a configurable amount of property churn
+ */
+UCLASS(transient, notplaceable)
+class AReplicationBenchmarkActor : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** The number of replicated values, which may be changed by Churn */
+	static constexpr int32 NumValues = 16;
+
+	/**
+	 * Changes a number of randomly selected replicated properties
+	 *
+	 * @param RandomStream			The random stream used to select and change properties
+	 * @param NumChangedProperties	The number of properties to change
+	 */
+	void Churn(FRandomStream& RandomStream, int32 NumChangedProperties);
+
+	//~ Begin AActor Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	//~ End AActor Interface
+
+private:
+	UPROPERTY(Replicated)
+	int32 Values[NumValues];
+
+	UPROPERTY(Replicated)
+	FVector Vector;
+};
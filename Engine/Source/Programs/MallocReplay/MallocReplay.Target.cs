@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class MallocReplayTarget : TargetRules
+{
+	public MallocReplayTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "MallocReplay";
+
+		// Lean and mean
+		bBuildDeveloperTools = false;
+
+		// Compile out references from Core to the rest of the engine
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+
+		// The allocators are what is measured, don't put profiling proxies in front of them
+		bUseMallocProfiler = false;
+
+		// Logs are still useful to print the results
+		bUseLoggingInShipping = true;
+
+		// Make a console application under Windows, so entry point is main() everywhere
+		bIsBuildingConsoleApplication = true;
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MallocReplay.h"
+#include "MallocReplayLog.h"
+#include "MallocReplayer.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#include "RequiredProgramMainCPPInclude.h"
+
+DEFINE_LOG_CATEGORY(LogMallocReplay);
+
+IMPLEMENT_APPLICATION(MallocReplay, "MallocReplay");
+
+namespace MallocReplay
+{
+	/** Switches selecting the allocator of the process, see FPlatformMemory::BaseAllocator(). Unsupported ones fall back to the default allocator. */
+	static const TCHAR* const AllocatorSwitches[] =
+	{
+		TEXT("binnedmalloc2"),
+		TEXT("binnedmalloc3"),
+		TEXT("mimalloc"),
+		TEXT("jemalloc"),
+		TEXT("ansimalloc"),
+	};
+
+	static void PrintUsage()
+	{
+		UE_LOG(LogMallocReplay, Display, TEXT("Replays an allocation history saved with -mallocsavereplay and measures the allocator."));
+		UE_LOG(LogMallocReplay, Display, TEXT("  MallocReplay -replayfile=File [-threads=N] [-maxops=N] [-nolatency] [-notouch] [-csv=File] [-binnedmalloc3|-mimalloc|...]"));
+		UE_LOG(LogMallocReplay, Display, TEXT("    Replays with the allocator of the process on N threads, 0 for one per recorded thread (default 1)."));
+		UE_LOG(LogMallocReplay, Display, TEXT("  MallocReplay -replayfile=File -allallocators [-threadcounts=1,0] [-csv=File] ..."));
+		UE_LOG(LogMallocReplay, Display, TEXT("    Runs a replay process for each allocator and thread count, appending the results to the csv file (default MallocReplay.csv)."));
+	}
+
+	static void PrintResults(const FMallocReplayLog& Log, const FMallocReplayResults& Results)
+	{
+		const double MB = 1024.0 * 1024.0;
+		const double NanosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1e9;
+		const uint64 PeakUsed = Results.PeakUsedPhysical - Results.BaselineUsedPhysical;
+
+		UE_LOG(LogMallocReplay, Display, TEXT("%s, %d threads: %llu operations in %.3f s, %.2f M ops/s"),
+			GMalloc->GetDescriptiveName(), Results.NumThreads, Results.NumOps, Results.Seconds, Results.NumOps / Results.Seconds / 1e6);
+		UE_LOG(LogMallocReplay, Display, TEXT("%s, %d threads: peak resident %.2f MB over a baseline of %.2f MB for a peak of %.2f MB live, fragmentation overhead %.1f%%"),
+			GMalloc->GetDescriptiveName(), Results.NumThreads, PeakUsed / MB, Results.BaselineUsedPhysical / MB, Log.PeakLiveBytes / MB,
+			Log.PeakLiveBytes ? (double(PeakUsed) / Log.PeakLiveBytes - 1.0) * 100.0 : 0.0);
+
+		// Nothing is timed with -nolatency
+		uint64 NumSamples = 0;
+		for (int32 OpType = 0; OpType < FMallocReplayResults::NumOpTypes; ++OpType)
+		{
+			for (int32 SizeClass = 0; SizeClass < FMallocReplayResults::NumSizeClasses; ++SizeClass)
+			{
+				NumSamples += Results.Latencies[OpType][SizeClass].NumSamples;
+			}
+		}
+		if (NumSamples == 0)
+		{
+			return;
+		}
+
+		UE_LOG(LogMallocReplay, Display, TEXT("%-8s %-12s %12s %10s %10s %10s %10s"), TEXT("Op"), TEXT("Size"), TEXT("Count"), TEXT("p50 ns"), TEXT("p99 ns"), TEXT("p99.9 ns"), TEXT("max ns"));
+		for (int32 OpType = 0; OpType < FMallocReplayResults::NumOpTypes; ++OpType)
+		{
+			for (int32 SizeClass = 0; SizeClass < FMallocReplayResults::NumSizeClasses; ++SizeClass)
+			{
+				const FMallocReplayLatencyHistogram& Histogram = Results.Latencies[OpType][SizeClass];
+				if (Histogram.NumSamples)
+				{
+					UE_LOG(LogMallocReplay, Display, TEXT("%-8s %-12s %12llu %10.0f %10.0f %10.0f %10.0f"),
+						FMallocReplayResults::GetOpTypeName(OpType), *FMallocReplayResults::GetSizeClassName(SizeClass), Histogram.NumSamples,
+						Histogram.GetPercentile(0.5) * NanosecondsPerCycle, Histogram.GetPercentile(0.99) * NanosecondsPerCycle,
+						Histogram.GetPercentile(0.999) * NanosecondsPerCycle, Histogram.MaxCycles * NanosecondsPerCycle);
+				}
+			}
+		}
+	}
+
+	/** Appends a summary row and a row per operation and size class, so runs of several allocators can be compared in one sheet */
+	static void AppendResultsToCsv(const FString& CsvFilename, const FString& AllocatorSwitch, const FMallocReplayLog& Log, const FMallocReplayResults& Results)
+	{
+		const double MB = 1024.0 * 1024.0;
+		const double NanosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1e9;
+		const uint64 PeakUsed = Results.PeakUsedPhysical - Results.BaselineUsedPhysical;
+		const FString RowPrefix = FString::Printf(TEXT("%s,%s,%d"), *AllocatorSwitch, GMalloc->GetDescriptiveName(), Results.NumThreads);
+
+		FString Csv;
+		if (!IFileManager::Get().FileExists(*CsvFilename))
+		{
+			Csv += TEXT("Switch,Allocator,Threads,Op,Size,Count,OpsPerSec,PeakResidentMB,PeakLiveMB,FragmentationOverhead,P50ns,P99ns,P999ns,MaxNs\n");
+		}
+		Csv += FString::Printf(TEXT("%s,All,All,%llu,%.0f,%.2f,%.2f,%.4f,,,,\n"), *RowPrefix, Results.NumOps, Results.NumOps / Results.Seconds,
+			PeakUsed / MB, Log.PeakLiveBytes / MB, Log.PeakLiveBytes ? double(PeakUsed) / Log.PeakLiveBytes - 1.0 : 0.0);
+		for (int32 OpType = 0; OpType < FMallocReplayResults::NumOpTypes; ++OpType)
+		{
+			for (int32 SizeClass = 0; SizeClass < FMallocReplayResults::NumSizeClasses; ++SizeClass)
+			{
+				const FMallocReplayLatencyHistogram& Histogram = Results.Latencies[OpType][SizeClass];
+				if (Histogram.NumSamples)
+				{
+					Csv += FString::Printf(TEXT("%s,%s,%s,%llu,,,,,%.0f,%.0f,%.0f,%.0f\n"), *RowPrefix, FMallocReplayResults::GetOpTypeName(OpType),
+						*FMallocReplayResults::GetSizeClassName(SizeClass), Histogram.NumSamples,
+						Histogram.GetPercentile(0.5) * NanosecondsPerCycle, Histogram.GetPercentile(0.99) * NanosecondsPerCycle,
+						Histogram.GetPercentile(0.999) * NanosecondsPerCycle, Histogram.MaxCycles * NanosecondsPerCycle);
+				}
+			}
+		}
+
+		if (!FFileHelper::SaveStringToFile(Csv, *CsvFilename, FFileHelper::EEncodingOptions::ForceAnsi, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogMallocReplay, Error, TEXT("Could not write the results to '%s'."), *CsvFilename);
+		}
+	}
+
+	static int32 RunReplay(const TCHAR* CommandLine, const FString& ReplayFilename)
+	{
+		uint64 MaxOps = MAX_uint64;
+		FParse::Value(CommandLine, TEXT("maxops="), MaxOps);
+
+		FMallocReplayOptions Options;
+		FParse::Value(CommandLine, TEXT("threads="), Options.NumThreads);
+		Options.bMeasureLatency = !FParse::Param(CommandLine, TEXT("nolatency"));
+		Options.bTouchMemory = !FParse::Param(CommandLine, TEXT("notouch"));
+
+		FMallocReplayLog Log;
+		if (!Log.Load(*ReplayFilename, MaxOps))
+		{
+			return 1;
+		}
+
+		FMallocReplayResults Results;
+		if (!ReplayMallocLog(Log, Options, Results))
+		{
+			return 1;
+		}
+		PrintResults(Log, Results);
+
+		FString CsvFilename;
+		if (FParse::Value(CommandLine, TEXT("csv="), CsvFilename))
+		{
+			FString AllocatorSwitch = TEXT("default");
+			for (const TCHAR* Switch : AllocatorSwitches)
+			{
+				if (FParse::Param(CommandLine, Switch))
+				{
+					AllocatorSwitch = Switch;
+					break;
+				}
+			}
+			AppendResultsToCsv(CsvFilename, AllocatorSwitch, Log, Results);
+		}
+		return 0;
+	}
+
+	/**
+	 * Allocators can't be swapped once the process started, so each allocator is measured in its own process, which also keeps the
+	 * resident memory of a run from weighing on the next ones.
+	 */
+	static int32 RunAllAllocators(const TCHAR* CommandLine, const FString& ReplayFilename)
+	{
+		FString ThreadCountsString = TEXT("1,0");
+		FParse::Value(CommandLine, TEXT("threadcounts="), ThreadCountsString, false);
+		TArray<FString> ThreadCounts;
+		ThreadCountsString.ParseIntoArray(ThreadCounts, TEXT(","));
+
+		FString CsvFilename = TEXT("MallocReplay.csv");
+		FParse::Value(CommandLine, TEXT("csv="), CsvFilename);
+		CsvFilename = FPaths::ConvertRelativePathToFull(CsvFilename);
+
+		FString ForwardedParams;
+		uint64 MaxOps = 0;
+		if (FParse::Value(CommandLine, TEXT("maxops="), MaxOps))
+		{
+			ForwardedParams += FString::Printf(TEXT(" -maxops=%llu"), MaxOps);
+		}
+		if (FParse::Param(CommandLine, TEXT("nolatency")))
+		{
+			ForwardedParams += TEXT(" -nolatency");
+		}
+		if (FParse::Param(CommandLine, TEXT("notouch")))
+		{
+			ForwardedParams += TEXT(" -notouch");
+		}
+
+		int32 NumFailedRuns = 0;
+		for (const TCHAR* Switch : AllocatorSwitches)
+		{
+			for (const FString& ThreadCount : ThreadCounts)
+			{
+				const FString Params = FString::Printf(TEXT("-replayfile=\"%s\" -threads=%s -csv=\"%s\" -%s%s"),
+					*FPaths::ConvertRelativePathToFull(ReplayFilename), *ThreadCount, *CsvFilename, Switch, *ForwardedParams);
+				UE_LOG(LogMallocReplay, Display, TEXT("Running %s %s"), FPlatformProcess::ExecutablePath(), *Params);
+
+				FProcHandle ProcHandle = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, false, false, false, nullptr, 0, nullptr, nullptr);
+				int32 ReturnCode = -1;
+				if (ProcHandle.IsValid())
+				{
+					FPlatformProcess::WaitForProc(ProcHandle);
+					FPlatformProcess::GetProcReturnCode(ProcHandle, &ReturnCode);
+					FPlatformProcess::CloseProc(ProcHandle);
+				}
+				if (ReturnCode != 0)
+				{
+					UE_LOG(LogMallocReplay, Error, TEXT("Replay with -%s on %s threads failed (%d)."), Switch, *ThreadCount, ReturnCode);
+					++NumFailedRuns;
+				}
+			}
+		}
+
+		UE_LOG(LogMallocReplay, Display, TEXT("Results were appended to %s"), *CsvFilename);
+		return NumFailedRuns ? 1 : 0;
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	GEngineLoop.PreInit(ArgC, ArgV);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	int32 ReturnCode = 0;
+	FString ReplayFilename;
+	if (!FParse::Value(CommandLine, TEXT("replayfile="), ReplayFilename))
+	{
+		MallocReplay::PrintUsage();
+		ReturnCode = 1;
+	}
+	else if (FParse::Param(CommandLine, TEXT("allallocators")))
+	{
+		ReturnCode = MallocReplay::RunAllAllocators(CommandLine, ReplayFilename);
+	}
+	else
+	{
+		ReturnCode = MallocReplay::RunReplay(CommandLine, ReplayFilename);
+	}
+
+	FEngineLoop::AppPreExit();
+	FEngineLoop::AppExit();
+	return ReturnCode;
+}
@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MallocReplayLog.h"
+#include "MallocReplay.h"
+#include "HAL/PlatformTime.h"
+
+#include <stdio.h>
+
+namespace MallocReplayLog
+{
+	/** Operations per pseudo thread for files without thread ids */
+	static constexpr uint32 OpsPerThreadBlock = 1024;
+
+	struct FLiveAllocation
+	{
+		uint32 Slot;
+		uint64 Size;
+	};
+}
+
+bool FMallocReplayLog::Load(const TCHAR* Filename, uint64 MaxOps)
+{
+	using namespace MallocReplayLog;
+
+#if PLATFORM_WINDOWS
+	FILE* ReplayFile = nullptr;
+	if (fopen_s(&ReplayFile, TCHAR_TO_UTF8(Filename), "rb") != 0 || ReplayFile == nullptr)
+#else
+	FILE* ReplayFile = fopen(TCHAR_TO_UTF8(Filename), "rb");
+	if (ReplayFile == nullptr)
+#endif // PLATFORM_WINDOWS
+	{
+		UE_LOG(LogMallocReplay, Error, TEXT("Could not open replay file '%s'."), Filename);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TMap<uint64, FLiveAllocation> LiveAllocations;
+	TMap<uint32, uint32> ThreadIdToIndex;
+	// Number of lifetimes each slot went through, a slot is free when its lifetime ended
+	TArray<uint32> SlotLifetimes;
+	TArray<uint32> FreeSlots;
+	uint64 LiveBytes = 0;
+
+	auto ConsumePointer = [&](uint64 Ptr, FMallocReplayOp& Op) -> uint64
+	{
+		FLiveAllocation Allocation;
+		if (Ptr == 0)
+		{
+			return 0;
+		}
+		if (!LiveAllocations.RemoveAndCopyValue(Ptr, Allocation))
+		{
+			++NumInvalidOps;
+			return 0;
+		}
+		Op.InSlot = Allocation.Slot;
+		Op.InLifetime = SlotLifetimes[Allocation.Slot]++;
+		LiveBytes -= Allocation.Size;
+		return Allocation.Size;
+	};
+
+	auto ProducePointer = [&](uint64 Ptr, uint64 Size, FMallocReplayOp& Op)
+	{
+		if (Ptr == 0)
+		{
+			return;
+		}
+		if (LiveAllocations.Contains(Ptr))
+		{
+			// Returned twice without being freed, the previous allocation is leaked like it was in the recording
+			++NumInvalidOps;
+			LiveAllocations.Remove(Ptr);
+		}
+		const uint32 Slot = FreeSlots.Num() ? FreeSlots.Pop(false) : SlotLifetimes.Add(0);
+		Op.OutSlot = Slot;
+		Op.OutLifetime = SlotLifetimes[Slot];
+		LiveAllocations.Add(Ptr, FLiveAllocation{ Slot, Size });
+		LiveBytes += Size;
+		PeakLiveBytes = FMath::Max(PeakLiveBytes, LiveBytes);
+	};
+
+	// For file format, see FMallocReplayProxy. The first line contains column headers and the last one the closing note.
+	char LineBuffer[512];
+	fgets(LineBuffer, sizeof(LineBuffer), ReplayFile);
+
+	while (uint64(Ops.Num()) < MaxOps && fgets(LineBuffer, sizeof(LineBuffer), ReplayFile) != nullptr)
+	{
+		char OpBuffer[128] = { 0 };
+		uint64 PtrOut = 0, PtrIn = 0, Size = 0, Ordinal = 0;
+		uint32 Alignment = 0, ThreadId = 0;
+#if PLATFORM_WINDOWS
+		const int32 NumFields = sscanf_s(LineBuffer, "%s %llu %llu %llu %u\t# %llu %u", OpBuffer, static_cast<unsigned int>(sizeof(OpBuffer)), &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal, &ThreadId);
+#else
+		const int32 NumFields = sscanf(LineBuffer, "%127s %llu %llu %llu %u\t# %llu %u", OpBuffer, &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal, &ThreadId);
+#endif // PLATFORM_WINDOWS
+		if (NumFields < 6)
+		{
+			continue;
+		}
+		if (Ops.Num() == MAX_int32)
+		{
+			UE_LOG(LogMallocReplay, Warning, TEXT("Replay file '%s' has more than %d operations, the rest is ignored."), Filename, MAX_int32);
+			break;
+		}
+
+		FMallocReplayOp Op;
+		Op.Alignment = Alignment;
+		if (NumFields == 7)
+		{
+			bHasThreadIds = true;
+			Op.Thread = ThreadIdToIndex.FindOrAdd(ThreadId, ThreadIdToIndex.Num());
+		}
+		else
+		{
+			Op.Thread = uint32(Ops.Num()) / OpsPerThreadBlock;
+		}
+		NumThreads = FMath::Max(NumThreads, Op.Thread + 1);
+
+		if (!FCStringAnsi::Strcmp(OpBuffer, "Malloc"))
+		{
+			Op.Type = FMallocReplayOp::EType::Malloc;
+			Op.Size = Size;
+			ProducePointer(PtrOut, Size, Op);
+		}
+		else if (!FCStringAnsi::Strcmp(OpBuffer, "Realloc"))
+		{
+			// The slot passed in is only released below, so the returned pointer gets another one even when reallocating in place
+			Op.Type = FMallocReplayOp::EType::Realloc;
+			Op.Size = Size;
+			ConsumePointer(PtrIn, Op);
+			ProducePointer(PtrOut, Size, Op);
+		}
+		else if (!FCStringAnsi::Strcmp(OpBuffer, "Free"))
+		{
+			Op.Type = FMallocReplayOp::EType::Free;
+			Op.Size = ConsumePointer(PtrIn, Op);
+		}
+		else
+		{
+			++NumInvalidOps;
+			continue;
+		}
+		if (Op.InSlot != FMallocReplayOp::NoSlot)
+		{
+			FreeSlots.Add(Op.InSlot);
+		}
+		Ops.Add(Op);
+	}
+	fclose(ReplayFile);
+
+	NumSlots = SlotLifetimes.Num();
+	UE_LOG(LogMallocReplay, Display, TEXT("Loaded %d operations from %u %s in %.2f seconds, peak of %.2f MB in %u live allocations, %llu invalid operations."),
+		Ops.Num(), NumThreads, bHasThreadIds ? TEXT("threads") : TEXT("blocks (no thread ids)"), FPlatformTime::Seconds() - StartTime,
+		PeakLiveBytes / (1024.0 * 1024.0), NumSlots, NumInvalidOps);
+	return Ops.Num() > 0;
+}
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A single allocator operation of a replay log, with its pointers resolved to slots */
+struct FMallocReplayOp
+{
+	enum class EType : uint8
+	{
+		Malloc,
+		Realloc,
+		Free,
+	};
+
+	static constexpr uint32 NoSlot = MAX_uint32;
+
+	/** Requested size for Malloc and Realloc, size of the freed allocation for Free */
+	uint64 Size = 0;
+	/** Slot holding the pointer passed in, and the lifetime of the slot it belongs to */
+	uint32 InSlot = NoSlot;
+	uint32 InLifetime = 0;
+	/** Slot receiving the pointer returned, and the lifetime of the slot it starts */
+	uint32 OutSlot = NoSlot;
+	uint32 OutLifetime = 0;
+	uint32 Alignment = 0;
+	/** Dense index of the thread that recorded the operation */
+	uint32 Thread = 0;
+	EType Type = EType::Malloc;
+};
+
+/**
+ * Allocation history written by FMallocReplayProxy (-mallocsavereplay), loaded in memory so reading it doesn't weigh on the replay.
+ *
+ * Recorded pointers are replaced by slots, reused once the allocation they held is freed, so the replay only needs an array as large as
+ * the peak number of live allocations. Each use of a slot is a lifetime: an operation producing a pointer starts a lifetime and the one
+ * consuming it ends it, which is what replay threads synchronize on when an allocation made on one thread is freed on another.
+ */
+struct FMallocReplayLog
+{
+	TArray<FMallocReplayOp> Ops;
+	uint32 NumSlots = 0;
+	/** Number of recording threads, files written before thread ids were recorded are split in blocks of operations instead */
+	uint32 NumThreads = 0;
+	bool bHasThreadIds = false;
+	/** Peak of the sum of the sizes of the live allocations */
+	uint64 PeakLiveBytes = 0;
+	/** Operations referencing pointers that were not allocated at that moment */
+	uint64 NumInvalidOps = 0;
+
+	bool Load(const TCHAR* Filename, uint64 MaxOps);
+};
@@ -0,0 +1,263 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MallocReplayer.h"
+#include "MallocReplay.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include "HAL/UnrealMemory.h"
+
+#include <atomic>
+
+void FMallocReplayLatencyHistogram::Merge(const FMallocReplayLatencyHistogram& Other)
+{
+	for (uint32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Counts[Bucket] += Other.Counts[Bucket];
+	}
+	NumSamples += Other.NumSamples;
+	MaxCycles = FMath::Max(MaxCycles, Other.MaxCycles);
+}
+
+uint64 FMallocReplayLatencyHistogram::GetPercentile(double Percentile) const
+{
+	const uint64 Rank = FMath::Max<uint64>(uint64(FMath::CeilToDouble(Percentile * NumSamples)), 1);
+	uint64 Count = 0;
+	for (uint32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Count += Counts[Bucket];
+		if (Count >= Rank)
+		{
+			return GetBucketLowerBound(Bucket);
+		}
+	}
+	return MaxCycles;
+}
+
+FString FMallocReplayResults::GetSizeClassName(int32 SizeClass)
+{
+	return SizeClass < NumSizeClasses - 1 ? FString::Printf(TEXT("<= %llu"), 16ull << SizeClass) : FString::Printf(TEXT("> %llu"), 16ull << (NumSizeClasses - 2));
+}
+
+const TCHAR* FMallocReplayResults::GetOpTypeName(int32 OpType)
+{
+	switch (FMallocReplayOp::EType(OpType))
+	{
+	case FMallocReplayOp::EType::Malloc:
+		return TEXT("Malloc");
+	case FMallocReplayOp::EType::Realloc:
+		return TEXT("Realloc");
+	case FMallocReplayOp::EType::Free:
+		return TEXT("Free");
+	}
+	return TEXT("Unknown");
+}
+
+namespace MallocReplayer
+{
+	/**
+	 * A slot goes through lifetimes, each of which is free (2 * Lifetime), then holds a pointer (2 * Lifetime + 1), and ends when
+	 * the pointer is consumed, which is the free state of the next lifetime.
+	 */
+	struct FSlot
+	{
+		void* Ptr = nullptr;
+		std::atomic<uint32> State{ 0 };
+	};
+
+	struct FThreadStats
+	{
+		FMallocReplayLatencyHistogram Latencies[FMallocReplayResults::NumOpTypes][FMallocReplayResults::NumSizeClasses];
+		double FinishTime = 0.0;
+	};
+
+	static void WaitForState(const FSlot& Slot, uint32 State)
+	{
+		for (uint32 SpinCount = 0; Slot.State.load(std::memory_order_acquire) != State; ++SpinCount)
+		{
+			if (SpinCount < 64)
+			{
+				FPlatformProcess::YieldCycles(100);
+			}
+			else
+			{
+				FPlatformProcess::YieldThread();
+			}
+		}
+	}
+
+	static void TouchPages(void* Ptr, uint64 Size)
+	{
+		static const SIZE_T PageSize = FPlatformMemory::GetConstants().PageSize;
+		for (uint64 Offset = 0; Offset < Size; Offset += PageSize)
+		{
+			((volatile uint8*)Ptr)[Offset] = 0;
+		}
+	}
+
+	static void ExecuteOp(const FMallocReplayOp& Op, FSlot* Slots, const FMallocReplayOptions& Options, FThreadStats& Stats)
+	{
+		void* InPtr = nullptr;
+		if (Op.InSlot != FMallocReplayOp::NoSlot)
+		{
+			WaitForState(Slots[Op.InSlot], 2 * Op.InLifetime + 1);
+			InPtr = Slots[Op.InSlot].Ptr;
+		}
+
+		void* Result = nullptr;
+		const uint64 StartCycles = Options.bMeasureLatency ? FPlatformTime::Cycles64() : 0;
+		switch (Op.Type)
+		{
+		case FMallocReplayOp::EType::Malloc:
+			Result = FMemory::Malloc(Op.Size, Op.Alignment);
+			break;
+		case FMallocReplayOp::EType::Realloc:
+			Result = FMemory::Realloc(InPtr, Op.Size, Op.Alignment);
+			break;
+		case FMallocReplayOp::EType::Free:
+			FMemory::Free(InPtr);
+			break;
+		}
+		if (Options.bMeasureLatency)
+		{
+			Stats.Latencies[int32(Op.Type)][FMallocReplayResults::GetSizeClass(Op.Size)].Add(FPlatformTime::Cycles64() - StartCycles);
+		}
+
+		if (Op.InSlot != FMallocReplayOp::NoSlot)
+		{
+			Slots[Op.InSlot].State.store(2 * Op.InLifetime + 2, std::memory_order_release);
+		}
+
+		if (Result && Options.bTouchMemory)
+		{
+			TouchPages(Result, Op.Size);
+		}
+		if (Op.OutSlot != FMallocReplayOp::NoSlot)
+		{
+			FSlot& OutSlot = Slots[Op.OutSlot];
+			WaitForState(OutSlot, 2 * Op.OutLifetime);
+			OutSlot.Ptr = Result;
+			OutSlot.State.store(2 * Op.OutLifetime + 1, std::memory_order_release);
+		}
+		else if (Result)
+		{
+			// The recorded operation returned null (e.g. a realloc to 0 bytes), so nothing will free what this allocator returned
+			FMemory::Free(Result);
+		}
+	}
+}
+
+bool ReplayMallocLog(const FMallocReplayLog& Log, const FMallocReplayOptions& Options, FMallocReplayResults& OutResults)
+{
+	using namespace MallocReplayer;
+
+	int32 NumThreads = Options.NumThreads;
+	if (NumThreads <= 0)
+	{
+		NumThreads = Log.bHasThreadIds ? int32(Log.NumThreads) : FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	}
+	NumThreads = FMath::Clamp(NumThreads, 1, int32(FMath::Max(Log.NumThreads, 1u)));
+
+	// Split the operations between the replay threads, keeping the order of the log
+	TArray<TArray<int32>> ThreadOps;
+	ThreadOps.SetNum(NumThreads);
+	if (NumThreads > 1)
+	{
+		for (int32 OpIndex = 0; OpIndex < Log.Ops.Num(); ++OpIndex)
+		{
+			ThreadOps[Log.Ops[OpIndex].Thread % NumThreads].Add(OpIndex);
+		}
+	}
+
+	TUniquePtr<FSlot[]> Slots = MakeUnique<FSlot[]>(Log.NumSlots);
+	TArray<TUniquePtr<FThreadStats>> ThreadStats;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		ThreadStats.Add(MakeUnique<FThreadStats>());
+	}
+
+	GMalloc->Trim(true);
+	OutResults.BaselineUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	OutResults.PeakUsedPhysical = OutResults.BaselineUsedPhysical;
+
+	std::atomic<bool> bStart{ false };
+	std::atomic<int32> NumRunningThreads{ NumThreads };
+	TArray<FThread> Threads;
+	Threads.Reserve(NumThreads);
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Threads.Emplace(*FString::Printf(TEXT("MallocReplay %d"), ThreadIndex),
+			[&Log, &Options, &ThreadOps, &ThreadStats, &bStart, &NumRunningThreads, &Slots, NumThreads, ThreadIndex]()
+			{
+				FMemory::SetupTLSCachesOnCurrentThread();
+				FThreadStats& Stats = *ThreadStats[ThreadIndex];
+				while (!bStart.load(std::memory_order_acquire))
+				{
+					FPlatformProcess::YieldThread();
+				}
+
+				if (NumThreads == 1)
+				{
+					for (const FMallocReplayOp& Op : Log.Ops)
+					{
+						ExecuteOp(Op, Slots.Get(), Options, Stats);
+					}
+				}
+				else
+				{
+					for (int32 OpIndex : ThreadOps[ThreadIndex])
+					{
+						ExecuteOp(Log.Ops[OpIndex], Slots.Get(), Options, Stats);
+					}
+				}
+
+				Stats.FinishTime = FPlatformTime::Seconds();
+				NumRunningThreads.fetch_sub(1, std::memory_order_release);
+				FMemory::ClearAndDisableTLSCachesOnCurrentThread();
+			});
+	}
+
+	// Sample the resident memory while the replay threads run, the process peak would include loading the log
+	const double StartTime = FPlatformTime::Seconds();
+	bStart.store(true, std::memory_order_release);
+	while (NumRunningThreads.load(std::memory_order_acquire) > 0)
+	{
+		OutResults.PeakUsedPhysical = FMath::Max<uint64>(OutResults.PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+		FPlatformProcess::Sleep(0.005f);
+	}
+	OutResults.PeakUsedPhysical = FMath::Max<uint64>(OutResults.PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	for (FThread& Thread : Threads)
+	{
+		Thread.Join();
+	}
+
+	OutResults.NumThreads = NumThreads;
+	OutResults.NumOps = Log.Ops.Num();
+	OutResults.Seconds = 0.0;
+	for (const TUniquePtr<FThreadStats>& Stats : ThreadStats)
+	{
+		OutResults.Seconds = FMath::Max(OutResults.Seconds, Stats->FinishTime - StartTime);
+		for (int32 OpType = 0; OpType < FMallocReplayResults::NumOpTypes; ++OpType)
+		{
+			for (int32 SizeClass = 0; SizeClass < FMallocReplayResults::NumSizeClasses; ++SizeClass)
+			{
+				OutResults.Latencies[OpType][SizeClass].Merge(Stats->Latencies[OpType][SizeClass]);
+			}
+		}
+	}
+
+	// Free what the recording left allocated
+	for (uint32 SlotIndex = 0; SlotIndex < Log.NumSlots; ++SlotIndex)
+	{
+		if (Slots[SlotIndex].State.load(std::memory_order_relaxed) & 1)
+		{
+			FMemory::Free(Slots[SlotIndex].Ptr);
+		}
+	}
+	GMalloc->Trim(true);
+
+	return true;
+}
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MallocReplayLog.h"
+
+/** Histogram of operation latencies, with 8 buckets per power of two of cycles */
+struct FMallocReplayLatencyHistogram
+{
+	static constexpr uint32 NumExactBuckets = 16;
+	static constexpr uint32 NumSubBuckets = 8;
+	static constexpr uint32 NumBuckets = NumExactBuckets + (64 - 4) * NumSubBuckets;
+
+	uint64 Counts[NumBuckets] = {};
+	uint64 NumSamples = 0;
+	uint64 MaxCycles = 0;
+
+	void Add(uint64 Cycles)
+	{
+		++Counts[GetBucket(Cycles)];
+		++NumSamples;
+		MaxCycles = FMath::Max(MaxCycles, Cycles);
+	}
+
+	void Merge(const FMallocReplayLatencyHistogram& Other);
+
+	/** Lower bound of the bucket holding the given percentile, in cycles */
+	uint64 GetPercentile(double Percentile) const;
+
+	static uint32 GetBucket(uint64 Cycles)
+	{
+		if (Cycles < NumExactBuckets)
+		{
+			return uint32(Cycles);
+		}
+		const uint32 Log2 = uint32(FMath::FloorLog2_64(Cycles));
+		return NumExactBuckets + (Log2 - 4) * NumSubBuckets + uint32((Cycles >> (Log2 - 3)) & (NumSubBuckets - 1));
+	}
+
+	static uint64 GetBucketLowerBound(uint32 Bucket)
+	{
+		if (Bucket < NumExactBuckets)
+		{
+			return Bucket;
+		}
+		const uint32 Log2 = (Bucket - NumExactBuckets) / NumSubBuckets + 4;
+		const uint64 SubBucket = (Bucket - NumExactBuckets) % NumSubBuckets;
+		return (NumSubBuckets + SubBucket) << (Log2 - 3);
+	}
+};
+
+struct FMallocReplayOptions
+{
+	/** Number of replay threads, 0 for one per recording thread */
+	int32 NumThreads = 1;
+	/** Whether to time each operation for the latency histograms, which adds the cost of reading the clock to the throughput */
+	bool bMeasureLatency = true;
+	/** Whether to write to every page of the allocations, so the resident memory is the one the recorded program would have used */
+	bool bTouchMemory = true;
+};
+
+struct FMallocReplayResults
+{
+	/** Size classes are powers of two from 16 bytes to 1 MB, the last one holds larger sizes */
+	static constexpr int32 NumSizeClasses = 18;
+	static constexpr int32 NumOpTypes = 3;
+
+	int32 NumThreads = 0;
+	uint64 NumOps = 0;
+	double Seconds = 0.0;
+	uint64 BaselineUsedPhysical = 0;
+	uint64 PeakUsedPhysical = 0;
+	FMallocReplayLatencyHistogram Latencies[NumOpTypes][NumSizeClasses];
+
+	static int32 GetSizeClass(uint64 Size)
+	{
+		return FMath::Min<int32>(Size <= 16 ? 0 : int32(FMath::CeilLogTwo64(Size)) - 4, NumSizeClasses - 1);
+	}
+
+	/** Name of the size class, "<= 16", ..., "<= 1048576" or "> 1048576" */
+	static FString GetSizeClassName(int32 SizeClass);
+	static const TCHAR* GetOpTypeName(int32 OpType);
+};
+
+/**
+ * Replays the operations of a log with the allocator of the process.
+ *
+ * Each recording thread is replayed on one replay thread (or some share one, when there are less replay threads), in the order of the log.
+ * An operation using a pointer produced on another thread waits for it, so the allocator sees the same cross thread frees as in the
+ * recording. Waiting only ever happens on an earlier operation of the log, so the replay can't deadlock.
+ */
+bool ReplayMallocLog(const FMallocReplayLog& Log, const FMallocReplayOptions& Options, FMallocReplayResults& OutResults);
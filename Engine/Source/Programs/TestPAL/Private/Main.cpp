@@ -1071,13 +1071,17 @@ void ReplayMallocFile(const FString& ReplayFileName, uint64 OperationToStopAfter
 	{
 		FSimpleScopeSecondsCounter Duration(WallTimeDuration);
 
+		// Lines are read whole since newer files have the thread id after the operation number, which is ignored here
+		char LineBuffer[512] = {0};
 		char OpBuffer[128] = {0};
 		uint64 PtrOut, PtrIn, Size, Ordinal;
 		uint32 Alignment;
 #if PLATFORM_WINDOWS
-		if (fscanf_s(ReplayFile, "%s %llu %llu %llu %u\t# %llu\n", OpBuffer, static_cast<unsigned int>(sizeof(OpBuffer)), &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal) != 6)
+		if (fgets(LineBuffer, sizeof(LineBuffer), ReplayFile) == nullptr ||
+			sscanf_s(LineBuffer, "%s %llu %llu %llu %u\t# %llu", OpBuffer, static_cast<unsigned int>(sizeof(OpBuffer)), &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal) != 6)
 #else
-		if (fscanf(ReplayFile, "%s %llu %llu %llu %u\t# %llu\n", OpBuffer, &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal) != 6)
+		if (fgets(LineBuffer, sizeof(LineBuffer), ReplayFile) == nullptr ||
+			sscanf(LineBuffer, "%127s %llu %llu %llu %u\t# %llu", OpBuffer, &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal) != 6)
 #endif // PLATFORM_WINDOWS
 		{
 			UE_LOG(LogTestPAL, Display, TEXT("Hit end of the replay file on %llu-th operation."), OperationNumber);
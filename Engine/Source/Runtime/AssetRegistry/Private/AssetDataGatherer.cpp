@@ -8,8 +8,10 @@
 #include "AssetRegistry/AssetData.h"
 #include "AssetRegistryArchive.h"
 #include "AssetRegistryPrivate.h"
+#include "Async/MappedFileHandle.h"
 #include "Async/ParallelFor.h"
 #include "Containers/BinaryHeap.h"
+#include "HAL/PlatformFileManager.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/RunnableThread.h"
 #include "Hash/Blake3.h"
@@ -18,12 +20,15 @@
 #include "Misc/AsciiSet.h"
 #include "Misc/Char.h"
 #include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/PathViews.h"
 #include "Misc/ScopeLock.h"
 #include "Misc/ScopeExit.h"
 #include "PackageReader.h"
 #include "Serialization/Archive.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Templates/UniquePtr.h"
 #include "Templates/UnrealTemplate.h"
 
@@ -32,7 +37,9 @@ namespace AssetDataGathererConstants
 	constexpr int32 SingleThreadFilesPerBatch = 3;
 	constexpr int32 ExpectedMaxBatchSize = 100;
 	constexpr int32 MinSecondsToElapseBeforeCacheWrite = 60;
-	static constexpr uint32 CacheSerializationMagic = 0xCBA78340; // Added integrity checking
+	static constexpr uint32 CacheSerializationMagic = 0xCBA78341; // Split into independently checked segments
+	/** Number of packages in each segment of the cache file */
+	constexpr int32 CacheAssetsPerSegment = 4096;
 }
 
 namespace UE
@@ -58,11 +65,12 @@ void AssignStringWithoutShrinking(FString& InOutResult, FStringView Value)
 	}
 }
 
-FDiscoveredPathData::FDiscoveredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath, const FDateTime& InPackageTimestamp)
+FDiscoveredPathData::FDiscoveredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath, const FDateTime& InPackageTimestamp, int64 InPackageFileSize)
 	: LocalAbsPath(InLocalAbsPath)
 	, LongPackageName(InLongPackageName)
 	, RelPath(InRelPath)
 	, PackageTimestamp(InPackageTimestamp)
+	, PackageFileSize(InPackageFileSize)
 {
 }
 
@@ -80,10 +88,11 @@ void FDiscoveredPathData::Assign(FStringView InLocalAbsPath, FStringView InLongP
 	AssignStringWithoutShrinking(RelPath, InRelPath);
 }
 
-void FDiscoveredPathData::Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath, const FDateTime& InPackageTimestamp)
+void FDiscoveredPathData::Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath, const FDateTime& InPackageTimestamp, int64 InPackageFileSize)
 {
 	Assign(InLocalAbsPath, InLongPackageName, InRelPath);
 	PackageTimestamp = InPackageTimestamp;
+	PackageFileSize = InPackageFileSize;
 }
 
 SIZE_T FDiscoveredPathData::GetAllocatedSize() const
@@ -91,15 +100,16 @@ SIZE_T FDiscoveredPathData::GetAllocatedSize() const
 	return LocalAbsPath.GetAllocatedSize() + LongPackageName.GetAllocatedSize() + RelPath.GetAllocatedSize();
 }
 
-FGatheredPathData::FGatheredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp)
+FGatheredPathData::FGatheredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp, int64 InPackageFileSize)
 	: LocalAbsPath(InLocalAbsPath)
 	, LongPackageName(InLongPackageName)
 	, PackageTimestamp(InPackageTimestamp)
+	, PackageFileSize(InPackageFileSize)
 {
 }
 
 FGatheredPathData::FGatheredPathData(const FDiscoveredPathData& DiscoveredData)
-	:FGatheredPathData(DiscoveredData.LocalAbsPath, DiscoveredData.LongPackageName, DiscoveredData.PackageTimestamp)
+	:FGatheredPathData(DiscoveredData.LocalAbsPath, DiscoveredData.LongPackageName, DiscoveredData.PackageTimestamp, DiscoveredData.PackageFileSize)
 {
 }
 
@@ -107,19 +117,21 @@ FGatheredPathData::FGatheredPathData(FDiscoveredPathData&& DiscoveredData)
 	: LocalAbsPath(MoveTemp(DiscoveredData.LocalAbsPath))
 	, LongPackageName(MoveTemp(DiscoveredData.LongPackageName))
 	, PackageTimestamp(MoveTemp(DiscoveredData.PackageTimestamp))
+	, PackageFileSize(DiscoveredData.PackageFileSize)
 {
 }
 
-void FGatheredPathData::Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp)
+void FGatheredPathData::Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp, int64 InPackageFileSize)
 {
 	AssignStringWithoutShrinking(LocalAbsPath, InLocalAbsPath);
 	AssignStringWithoutShrinking(LongPackageName, InLongPackageName);
 	PackageTimestamp = InPackageTimestamp;
+	PackageFileSize = InPackageFileSize;
 }
 
 void FGatheredPathData::Assign(const FDiscoveredPathData& DiscoveredData)
 {
-	Assign(DiscoveredData.LocalAbsPath, DiscoveredData.LongPackageName, DiscoveredData.PackageTimestamp);
+	Assign(DiscoveredData.LocalAbsPath, DiscoveredData.LongPackageName, DiscoveredData.PackageTimestamp, DiscoveredData.PackageFileSize);
 }
 
 SIZE_T FGatheredPathData::GetAllocatedSize() const
@@ -1537,7 +1549,7 @@ void FAssetDataDiscovery::TickInternal()
 						check(IteratedFiles.Num() == NumIteratedFiles);
 						IteratedFiles.Emplace();
 					}
-					IteratedFiles[NumIteratedFiles++].Assign(LocalAbsPath, DirLongPackageName, RelPath, InPackageStatData.ModificationTime);
+					IteratedFiles[NumIteratedFiles++].Assign(LocalAbsPath, DirLongPackageName, RelPath, InPackageStatData.ModificationTime, InPackageStatData.FileSize);
 				}
 			}
 			return true;
@@ -1739,6 +1751,12 @@ FDateTime FPathExistence::GetModificationTime()
 	return ModificationTime;
 }
 
+int64 FPathExistence::GetFileSize()
+{
+	LoadExistenceData();
+	return FileSize;
+}
+
 void FPathExistence::LoadExistenceData()
 {
 	if (bHasExistenceData)
@@ -1749,6 +1767,7 @@ void FPathExistence::LoadExistenceData()
 	if (StatData.bIsValid)
 	{
 		ModificationTime = StatData.ModificationTime;
+		FileSize = StatData.FileSize;
 		PathType = StatData.bIsDirectory ? EType::Directory : EType::File;
 	}
 	else
@@ -1876,7 +1895,7 @@ void FAssetDataDiscovery::SetPropertiesAndWait(FPathExistence& QueryPath, bool b
 					LongPackageName << MountDir->GetLongPackageName();
 					FPathViews::AppendPath(LongPackageName, ScanDir->GetMountRelPath());
 					FPathViews::AppendPath(LongPackageName, FileRelPathNoExt);
-					AddDiscoveredFile(FDiscoveredPathData(SearchPath, LongPackageName, RelPathFromParentDir, QueryPath.GetModificationTime()));
+					AddDiscoveredFile(FDiscoveredPathData(SearchPath, LongPackageName, RelPathFromParentDir, QueryPath.GetModificationTime(), QueryPath.GetFileSize()));
 					if (FPathViews::IsPathLeaf(RelPath) && !ScanDir->HasScanned())
 					{
 						SetIsIdle(false);
@@ -2207,7 +2226,7 @@ void FAssetDataDiscovery::OnFileCreated(const FString& LocalAbsPath)
 		LongPackageName << MountDir->GetLongPackageName();
 		FPathViews::AppendPath(LongPackageName, ScanDir->GetMountRelPath());
 		FPathViews::AppendPath(LongPackageName, FileRelPathNoExt);
-		AddDiscoveredFile(FDiscoveredPathData(LocalAbsPath, LongPackageName, RelPathFromParentDir, StatData.ModificationTime));
+		AddDiscoveredFile(FDiscoveredPathData(LocalAbsPath, LongPackageName, RelPathFromParentDir, StatData.ModificationTime, StatData.FileSize));
 		if (FPathViews::IsPathLeaf(FileRelPath))
 		{
 			ScanDir->MarkFileAlreadyScanned(FileRelPath);
@@ -2827,7 +2846,7 @@ void FAssetDataGatherer::TickInternal(bool& bOutIsTickInterrupt)
 		{
 			// Check whether we need to invalidate the cached data
 			const FDateTime& CachedTimestamp = DiskCachedAssetData->Timestamp;
-			if (AssetFileData.PackageTimestamp != CachedTimestamp)
+			if (AssetFileData.PackageTimestamp != CachedTimestamp || AssetFileData.PackageFileSize != DiskCachedAssetData->FileSize)
 			{
 				DiskCachedAssetData = nullptr;
 			}
@@ -2910,7 +2929,7 @@ void FAssetDataGatherer::TickInternal(bool& bOutIsTickInterrupt)
 			if (bCachePackage)
 			{
 				// Update the cache
-				FDiskCachedAssetData* NewData = new FDiskCachedAssetData(ReadContext.AssetFileData.PackageTimestamp, ReadContext.Extension);
+				FDiskCachedAssetData* NewData = new FDiskCachedAssetData(ReadContext.AssetFileData.PackageTimestamp, ReadContext.AssetFileData.PackageFileSize, ReadContext.Extension);
 				NewData->AssetDataList.Reserve(ReadContext.AssetDataFromFile.Num());
 				for (const FAssetData* BackgroundAssetData : ReadContext.AssetDataFromFile)
 				{
@@ -3326,27 +3345,40 @@ void FAssetDataGatherer::LoadCacheFileInternal(FStringView CacheFilename)
 	}
 
 	TRACE_CPUPROFILER_EVENT_SCOPE(LoadCacheFile);
-	// load the cached data
-	TUniquePtr<FArchive> FileAr(IFileManager::Get().CreateFileReader(*FString(CacheFilename), FILEREAD_Silent));
-	if (FileAr && !FileAr->IsError() && FileAr->TotalSize() > 2 * sizeof(uint32))
+	// Map the cached data where the platform supports it, the segments are then deserialized in place; else read the whole file
+	FString CacheFilenameStr(CacheFilename);
+	TUniquePtr<IMappedFileHandle> MappedFileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*CacheFilenameStr));
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	if (MappedFileHandle && MappedFileHandle->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize(), true /* bPreloadHint */));
+	}
+	TArray64<uint8> FileData;
+	FMemoryView CacheData;
+	if (MappedRegion)
 	{
+		CacheData = FMemoryView(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	}
+	else if (FFileHelper::LoadFileToArray(FileData, *CacheFilenameStr, FILEREAD_Silent))
+	{
+		CacheData = MakeMemoryView(FileData);
+	}
+
+	if (CacheData.GetSize() > 2 * sizeof(uint32))
+	{
+		FMemoryReaderView FileAr(CacheData);
 		uint32 MagicNumber = 0;
-		*FileAr << MagicNumber;
-		if (!FileAr->IsError() && MagicNumber == AssetDataGathererConstants::CacheSerializationMagic)
+		FileAr << MagicNumber;
+		if (!FileAr.IsError() && MagicNumber == AssetDataGathererConstants::CacheSerializationMagic)
 		{
 			FAssetRegistryVersion::Type RegistryVersion;
-			if (FAssetRegistryVersion::SerializeVersion(*FileAr, RegistryVersion) && RegistryVersion == FAssetRegistryVersion::LatestVersion)
+			if (FAssetRegistryVersion::SerializeVersion(FileAr, RegistryVersion) && RegistryVersion == FAssetRegistryVersion::LatestVersion)
 			{
-				UE::AssetDataGather::Private::FChecksumArchiveReader ChecksummingReader(*FileAr);
-				FAssetRegistryReader RegistryReader(ChecksummingReader);
-				if (!RegistryReader.IsError())
-				{
-					SerializeCacheLoad(RegistryReader);
+				SerializeCacheLoad(CacheData.RightChop(FileAr.Tell()), CacheFilename);
 
-					FGathererScopeLock ResultsScopeLock(&ResultsLock);
-					DependencyResults.Reserve(DiskCachedAssetDataMap.Num());
-					AssetResults.Reserve(DiskCachedAssetDataMap.Num());
-				}
+				FGathererScopeLock ResultsScopeLock(&ResultsLock);
+				DependencyResults.Reserve(DiskCachedAssetDataMap.Num());
+				AssetResults.Reserve(DiskCachedAssetDataMap.Num());
 			}
 		}
 	}
@@ -3430,13 +3462,7 @@ void FAssetDataGatherer::SaveCacheFileInternal(const FString& CacheFilename, con
 		FAssetRegistryVersion::Type RegistryVersion = FAssetRegistryVersion::LatestVersion;
 		FAssetRegistryVersion::SerializeVersion(*FileAr, RegistryVersion);
 #if ALLOW_NAME_BATCH_SAVING
-		{
-			// We might be able to reduce load time by using AssetRegistry::SerializationOptions
-			// to save certain common tags as FName.
-			UE::AssetDataGather::Private::FChecksumArchiveWriter ChecksummingWriter(*FileAr);
-			FAssetRegistryWriter Ar(FAssetRegistryWriterOptions(), ChecksummingWriter);
-			SerializeCacheSave(Ar, AssetsToSave);
-		}
+		SerializeCacheSave(*FileAr, AssetsToSave);
 #else		
 		checkf(false, TEXT("Cannot save asset registry cache in this configuration"));
 #endif
@@ -3458,79 +3484,166 @@ void FAssetDataGatherer::SaveCacheFileInternal(const FString& CacheFilename, con
 	}
 }
 
-void FAssetDataGatherer::SerializeCacheSave(FAssetRegistryWriter& Ar, const TArray<TPair<FName,FDiskCachedAssetData*>>& AssetsToSave)
+void FAssetDataGatherer::SerializeCacheSave(FArchive& Ar, const TArray<TPair<FName,FDiskCachedAssetData*>>& AssetsToSave)
 {
 #if ALLOW_NAME_BATCH_SAVING
 	using namespace UE::AssetDataGather::Private;
 
 	double SerializeStartTime = FPlatformTime::Seconds();
 
-	// serialize number of objects
-	int32 LocalNumAssets = AssetsToSave.Num();
-	Ar << LocalNumAssets;
+	// Each segment has its own name batch, tag store and checksums so it can be loaded on its own, on any thread.
+	// We might be able to reduce load time by using AssetRegistry::SerializationOptions
+	// to save certain common tags as FName.
+	const int32 NumSegments = FMath::DivideAndRoundUp(AssetsToSave.Num(), AssetDataGathererConstants::CacheAssetsPerSegment);
+	TArray<TArray64<uint8>> SegmentData;
+	SegmentData.SetNum(NumSegments);
+	ParallelFor(NumSegments,
+		[&AssetsToSave, &SegmentData](int32 SegmentIndex)
+		{
+			const int32 FirstAssetIndex = SegmentIndex * AssetDataGathererConstants::CacheAssetsPerSegment;
+			int32 LocalNumAssets = FMath::Min(AssetsToSave.Num() - FirstAssetIndex, AssetDataGathererConstants::CacheAssetsPerSegment);
+
+			FMemoryWriter64 SegmentAr(SegmentData[SegmentIndex]);
+			FChecksumArchiveWriter ChecksummingWriter(SegmentAr);
+			FAssetRegistryWriter RegistryWriter(FAssetRegistryWriterOptions(), ChecksummingWriter);
+			RegistryWriter << LocalNumAssets;
+			for (int32 AssetIndex = FirstAssetIndex; AssetIndex < FirstAssetIndex + LocalNumAssets; ++AssetIndex)
+			{
+				FName AssetName = AssetsToSave[AssetIndex].Key;
+				RegistryWriter << AssetName;
+				AssetsToSave[AssetIndex].Value->SerializeForCache(RegistryWriter);
+			}
+		},
+		EParallelForFlags::Unbalanced
+	);
 
-	for (const TPair<FName, FDiskCachedAssetData*>& Pair : AssetsToSave)
+	// The segment table, followed by the segments in order
+	int32 LocalNumSegments = NumSegments;
+	Ar << LocalNumSegments;
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
 	{
-		FName AssetName = Pair.Key;
-		Ar << AssetName;
-		Pair.Value->SerializeForCache(Ar);
+		int32 SegmentNumAssets = FMath::Min(AssetsToSave.Num() - SegmentIndex * AssetDataGathererConstants::CacheAssetsPerSegment, AssetDataGathererConstants::CacheAssetsPerSegment);
+		int64 SegmentSize = SegmentData[SegmentIndex].Num();
+		Ar << SegmentNumAssets;
+		Ar << SegmentSize;
+	}
+	for (TArray64<uint8>& Data : SegmentData)
+	{
+		Ar.Serialize(Data.GetData(), Data.Num());
 	}
 
 	UE_LOG(LogAssetRegistry, Verbose, TEXT("Asset data gatherer serialized in %0.6f seconds"), FPlatformTime::Seconds() - SerializeStartTime);
 #endif
 }
 
-void FAssetDataGatherer::SerializeCacheLoad(FAssetRegistryReader& Ar)
+void FAssetDataGatherer::SerializeCacheLoad(FMemoryView CacheData, FStringView CacheFilename)
 {
 	CHECK_IS_LOCKED_CURRENT_THREAD(TickLock);
 	using namespace UE::AssetDataGather::Private;
 
 	double SerializeStartTime = FPlatformTime::Seconds();
-	// serialize number of objects
-	int32 LocalNumAssets = 0;
-	Ar << LocalNumAssets;
 
-	const int32 MinAssetEntrySize = sizeof(int32);
-	const int64 MaxPossibleNumAssets = (Ar.TotalSize() - Ar.Tell()) / MinAssetEntrySize;
-	if (Ar.IsError() || LocalNumAssets < 0 || MaxPossibleNumAssets < LocalNumAssets)
+	struct FSegment
 	{
-		Ar.SetError();
+		FMemoryView Data;
+		int32 NumAssets = 0;
+		FName* PackageNameBlock = nullptr;
+		FDiskCachedAssetData* AssetDataBlock = nullptr;
+	};
+
+	// Read the segment table, the segments follow it in order
+	FMemoryReaderView TableAr(CacheData);
+	int32 NumSegments = 0;
+	TableAr << NumSegments;
+
+	const int64 SegmentTableEntrySize = sizeof(int32) + sizeof(int64);
+	if (TableAr.IsError() || NumSegments < 0 || (TableAr.TotalSize() - TableAr.Tell()) / SegmentTableEntrySize < NumSegments)
+	{
+		UE_LOG(LogAssetRegistry, Error, TEXT("There was an error loading the asset registry cache."));
+		return;
 	}
-	else
+
+	TArray<FSegment> Segments;
+	Segments.SetNum(NumSegments);
+	uint64 SegmentOffset = TableAr.Tell() + NumSegments * SegmentTableEntrySize;
+	int32 TotalNumAssets = 0;
+	for (FSegment& Segment : Segments)
 	{
-		FSoftObjectPathSerializationScope SerializationScope(NAME_None, NAME_None, ESoftObjectPathCollectType::NonPackage, ESoftObjectPathSerializeType::AlwaysSerialize);
+		int64 SegmentSize = 0;
+		TableAr << Segment.NumAssets;
+		TableAr << SegmentSize;
+
+		const int32 MinAssetEntrySize = sizeof(int32);
+		if (TableAr.IsError() || Segment.NumAssets < 0 || SegmentSize < 0 || SegmentOffset + SegmentSize > CacheData.GetSize() ||
+			SegmentSize / MinAssetEntrySize < Segment.NumAssets)
+		{
+			UE_LOG(LogAssetRegistry, Error, TEXT("There was an error loading the asset registry cache."));
+			return;
+		}
+		Segment.Data = CacheData.Mid(SegmentOffset, SegmentSize);
+		SegmentOffset += SegmentSize;
+		TotalNumAssets += Segment.NumAssets;
+	}
 
-		// allocate one single block for all asset data structs (to reduce tens of thousands of heap allocations)
-		FName* PackageNameBlock = new FName[LocalNumAssets];
-		FDiskCachedAssetData* AssetDataBlock = new FDiskCachedAssetData[LocalNumAssets];
-		for (int32 AssetIndex = 0; AssetIndex < LocalNumAssets; ++AssetIndex)
+	ParallelFor(Segments.Num(),
+		[&Segments](int32 SegmentIndex)
 		{
-			// Load the name first to add the entry to the tmap below
-			// Visual Studio Static Analyzer issues C6385 if we call Ar << PackageNameBlock[AssetIndex] or AssetDataBlock[AssetIndex].SerializeForCache
-			Ar << *(PackageNameBlock + AssetIndex); // -C6385
-			(AssetDataBlock + AssetIndex)->SerializeForCache(Ar); // -C6385
-			if (Ar.IsError())
+			FSegment& Segment = Segments[SegmentIndex];
+			FSoftObjectPathSerializationScope SerializationScope(NAME_None, NAME_None, ESoftObjectPathCollectType::NonPackage, ESoftObjectPathSerializeType::AlwaysSerialize);
+
+			FMemoryReaderView SegmentAr(Segment.Data);
+			FChecksumArchiveReader ChecksummingReader(SegmentAr);
+			FAssetRegistryReader Ar(ChecksummingReader);
+			int32 LocalNumAssets = 0;
+			Ar << LocalNumAssets;
+			if (Ar.IsError() || LocalNumAssets != Segment.NumAssets)
 			{
-				// There was an error reading the cache. Bail out.
-				break;
+				return;
 			}
-		}
 
-		if (Ar.IsError())
+			// allocate one single block per segment for all asset data structs (to reduce tens of thousands of heap allocations)
+			Segment.PackageNameBlock = new FName[LocalNumAssets];
+			Segment.AssetDataBlock = new FDiskCachedAssetData[LocalNumAssets];
+			for (int32 AssetIndex = 0; AssetIndex < LocalNumAssets; ++AssetIndex)
+			{
+				// Visual Studio Static Analyzer issues C6385 if we call Ar << PackageNameBlock[AssetIndex] or AssetDataBlock[AssetIndex].SerializeForCache
+				Ar << *(Segment.PackageNameBlock + AssetIndex); // -C6385
+				(Segment.AssetDataBlock + AssetIndex)->SerializeForCache(Ar); // -C6385
+				if (Ar.IsError())
+				{
+					// There was an error reading the segment, only the assets of this segment are discarded
+					delete[] Segment.AssetDataBlock;
+					Segment.AssetDataBlock = nullptr;
+					break;
+				}
+			}
+		},
+		EParallelForFlags::Unbalanced
+	);
+
+	int32 NumDiscardedAssets = 0;
+	DiskCachedAssetDataMap.Reserve(DiskCachedAssetDataMap.Num() + TotalNumAssets);
+	for (FSegment& Segment : Segments)
+	{
+		if (Segment.AssetDataBlock)
 		{
-			delete[] AssetDataBlock;
-			UE_LOG(LogAssetRegistry, Error, TEXT("There was an error loading the asset registry cache."));
+			for (int32 AssetIndex = 0; AssetIndex < Segment.NumAssets; ++AssetIndex)
+			{
+				DiskCachedAssetDataMap.Add(*(Segment.PackageNameBlock + AssetIndex), (Segment.AssetDataBlock + AssetIndex)); // -C6385
+			}
+			DiskCachedAssetBlocks.Emplace(Segment.NumAssets, Segment.AssetDataBlock);
 		}
 		else
 		{
-			DiskCachedAssetDataMap.Reserve(DiskCachedAssetDataMap.Num() + LocalNumAssets);
-			for (int32 AssetIndex = 0; AssetIndex < LocalNumAssets; ++AssetIndex)
-			{
-				DiskCachedAssetDataMap.Add(*(PackageNameBlock + AssetIndex), (AssetDataBlock + AssetIndex)); // -C6385
-			}
-			DiskCachedAssetBlocks.Emplace(LocalNumAssets, AssetDataBlock);
+			NumDiscardedAssets += Segment.NumAssets;
 		}
-		delete[] PackageNameBlock;
+		delete[] Segment.PackageNameBlock;
+	}
+
+	if (NumDiscardedAssets > 0)
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("There was an error loading parts of the asset registry cache '%.*s', %d of its %d packages will be rescanned."),
+			CacheFilename.Len(), CacheFilename.GetData(), NumDiscardedAssets, TotalNumAssets);
 	}
 
 	UE_LOG(LogAssetRegistry, Verbose, TEXT("Asset data gatherer serialized in %0.6f seconds"), FPlatformTime::Seconds() - SerializeStartTime);
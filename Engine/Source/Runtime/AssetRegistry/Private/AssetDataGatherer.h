@@ -16,6 +16,7 @@
 #include "HAL/FileManager.h"
 #include "HAL/Platform.h"
 #include "HAL/Runnable.h"
+#include "Memory/MemoryView.h"
 #include "Misc/DateTime.h"
 #include "Misc/Optional.h"
 #include "PackageDependencyData.h"
@@ -25,8 +26,6 @@
 class FArchive;
 struct FAssetData;
 class FDiskCachedAssetData;
-class FAssetRegistryReader;
-class FAssetRegistryWriter; // Not defined if !ALLOW_NAME_BATCH_SAVING
 class FPackageReader;
 namespace UE::AssetDataGather::Private
 {
@@ -241,10 +240,16 @@ private:
 	 * Filters the list of assets by child paths of the elements in SaveCacheLongPackageNameDirs, if it is non-empty.
 	 */
 	void GetAssetsToSave(TArrayView<const FString> SaveCacheLongPackageNameDirs, TArray<TPair<FName,FDiskCachedAssetData*>>& OutAssetsToSave);
-	/** Writes to file the timestamped cache of discovered assets. */
-	void SerializeCacheSave(FAssetRegistryWriter& Ar, const TArray<TPair<FName,FDiskCachedAssetData*>>& AssetsToSave);
-	/** Reads from file the timestamped cache of discovered assets, for quick loading of data for assets that have not changed on disk. */
-	void SerializeCacheLoad(FAssetRegistryReader& Ar);
+	/**
+	 * Writes to file the timestamped cache of discovered assets.
+	 * The assets are split into segments that are serialized in parallel, each with its own names, tags and checksums.
+	 */
+	void SerializeCacheSave(FArchive& Ar, const TArray<TPair<FName,FDiskCachedAssetData*>>& AssetsToSave);
+	/**
+	 * Reads from file the timestamped cache of discovered assets, for quick loading of data for assets that have not changed on disk.
+	 * The segments are deserialized in parallel from CacheData, a corrupt segment only discards the assets it holds.
+	 */
+	void SerializeCacheLoad(FMemoryView CacheData, FStringView CacheFilename);
 
 	/* Adds the given PackageName,DiskCachedAssetData pair into NewCachedAssetDataMap, and detects collisions for multiple files with the same PackageName */
 	void AddToCache(FName PackageName, FDiskCachedAssetData* DiskCachedAssetData);
@@ -75,13 +75,15 @@ struct FDiscoveredPathData
 	FString RelPath;
 	/** If the path is a file, the modification timestamp of the package file (that it had when it was discovered). */
 	FDateTime PackageTimestamp;
+	/** If the path is a file, the size of the package file (that it had when it was discovered), -1 if unknown. */
+	int64 PackageFileSize = -1;
 
 	FDiscoveredPathData() = default;
 	FDiscoveredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath,
-		const FDateTime& InPackageTimestamp);
+		const FDateTime& InPackageTimestamp, int64 InPackageFileSize);
 	FDiscoveredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath);
 	void Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath,
-		const FDateTime& InPackageTimestamp);
+		const FDateTime& InPackageTimestamp, int64 InPackageFileSize);
 	void Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, FStringView InRelPath);
 
 	/** Return the total amount of heap memory used by the gatherer (including not-yet-claimed search results). */
@@ -97,12 +99,14 @@ struct FGatheredPathData
 	FString LongPackageName;
 	/** The modification timestamp of the package file (that it had when it was discovered) */
 	FDateTime PackageTimestamp;
+	/** The size of the package file (that it had when it was discovered), -1 if unknown */
+	int64 PackageFileSize = -1;
 
 	FGatheredPathData() = default;
-	FGatheredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp);
+	FGatheredPathData(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp, int64 InPackageFileSize);
 	explicit FGatheredPathData(const FDiscoveredPathData& DiscoveredData);
 	explicit FGatheredPathData(FDiscoveredPathData&& DiscoveredData);
-	void Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp);
+	void Assign(FStringView InLocalAbsPath, FStringView InLongPackageName, const FDateTime& InPackageTimestamp, int64 InPackageFileSize);
 	void Assign(const FDiscoveredPathData& DiscoveredData);
 
 	/**
@@ -232,6 +236,7 @@ struct FPathExistence
 	const FString& GetLocalAbsPath() const;
 	EType GetType();
 	FDateTime GetModificationTime();
+	int64 GetFileSize();
 
 	/** If the path is a directory or file, return the path. Otherwise return the parent directory, if it exists. */
 	FStringView GetLowestExistingPath();
@@ -242,6 +247,7 @@ struct FPathExistence
 private:
 	FString LocalAbsPath;
 	FDateTime ModificationTime;
+	int64 FileSize = -1;
 	EType PathType = EType::MissingParentDir;
 	bool bHasExistenceData = false;
 };
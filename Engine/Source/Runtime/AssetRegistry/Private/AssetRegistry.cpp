@@ -432,6 +432,20 @@ void FAssetRegistryImpl::Initialize(Impl::FInitializeContext& Context)
 		{
 			CachePathsFromState(Context.Events, State);
 		}
+
+		// Written next to AssetRegistry.bin by the cooker when bSerializeFlatAssetRegistry is set, and staged along with it
+		const FString FlatAssetRegistryFilename = FPaths::ProjectDir() + TEXT("AssetRegistry.flat");
+		if (IFileManager::Get().FileExists(*FlatAssetRegistryFilename))
+		{
+			if (FlatState.Load(*FlatAssetRegistryFilename))
+			{
+				UE_LOG(LogAssetRegistry, Log, TEXT("Loaded flat asset registry '%s', %d assets"), *FlatAssetRegistryFilename, FlatState.GetNumAssets());
+			}
+			else
+			{
+				UE_LOG(LogAssetRegistry, Warning, TEXT("Failed to load flat asset registry '%s'"), *FlatAssetRegistryFilename);
+			}
+		}
 #endif // ASSETREGISTRY_ENABLE_PREMADE_REGISTRY_IN_EDITOR 
 
 		TArray<TSharedRef<IPlugin>> ContentPlugins = IPluginManager::Get().GetEnabledPluginsWithContent();
@@ -780,6 +794,7 @@ void InitializeSerializationOptionsFromIni(FAssetRegistrySerializationOptions& O
 		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializeNameDependencies"), Options.bSerializeSearchableNameDependencies);
 		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializeManageDependencies"), Options.bSerializeManageDependencies);
 		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializePackageData"), Options.bSerializePackageData);
+		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializeFlatAssetRegistry"), Options.bSerializeFlatAssetRegistry);
 		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bFilterAssetDataWithNoTags"), Options.bFilterAssetDataWithNoTags);
 		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bFilterDependenciesWithNoTags"), Options.bFilterDependenciesWithNoTags);
 		EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bFilterSearchableNames"), Options.bFilterSearchableNames);
@@ -3349,6 +3364,13 @@ const FAssetRegistryState* UAssetRegistryImpl::GetAssetRegistryState() const
 	PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
+const FAssetRegistryFlatState* UAssetRegistryImpl::GetFlatAssetRegistryState() const
+{
+	FReadScopeLock InterfaceScopeLock(InterfaceLock);
+	const FAssetRegistryFlatState& FlatState = GuardedData.GetFlatState();
+	return FlatState.IsValid() ? &FlatState : nullptr;
+}
+
 TSet<FName> UAssetRegistryImpl::GetCachedEmptyPackagesCopy() const
 {
 	FReadScopeLock InterfaceScopeLock(InterfaceLock);
@@ -5249,6 +5271,11 @@ const FAssetRegistryState& FAssetRegistryImpl::GetState() const
 	return State;
 }
 
+const FAssetRegistryFlatState& FAssetRegistryImpl::GetFlatState() const
+{
+	return FlatState;
+}
+
 const FPathTree& FAssetRegistryImpl::GetCachedPathTree() const
 {
 	return CachedPathTree;
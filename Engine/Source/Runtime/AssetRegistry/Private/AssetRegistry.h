@@ -105,6 +105,7 @@ public:
 #endif
 
 	virtual const FAssetRegistryState* GetAssetRegistryState() const override;
+	virtual const FAssetRegistryFlatState* GetFlatAssetRegistryState() const override;
 	virtual TSet<FName> GetCachedEmptyPackagesCopy() const override;
 	virtual const TSet<FName>& GetCachedEmptyPackages() const override;
 	virtual bool ContainsTag(FName TagName) const override;
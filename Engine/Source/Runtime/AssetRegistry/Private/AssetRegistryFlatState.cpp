@@ -0,0 +1,587 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AssetRegistry/AssetRegistryFlatState.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "AssetRegistryPrivate.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/Archive.h"
+
+namespace UE::AssetRegistry::FlatState
+{
+	static constexpr uint32 Magic = 0x46524141; // 'AARF'
+	static constexpr uint32 Version = 1;
+	/** Sections start at multiples of this, so the entries of every section are aligned in the mapped file */
+	static constexpr uint64 SectionAlignment = 8;
+
+	static UTF8CHAR ToLowerAscii(UTF8CHAR Char)
+	{
+		return (Char >= 'A' && Char <= 'Z') ? UTF8CHAR(Char + ('a' - 'A')) : Char;
+	}
+
+	/** Names are compared ignoring the case of ASCII characters, other characters must match exactly */
+	static bool NameEquals(FUtf8StringView A, FUtf8StringView B)
+	{
+		if (A.Len() != B.Len())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Len(); ++Index)
+		{
+			if (ToLowerAscii(A[Index]) != ToLowerAscii(B[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static uint64 HashName(FUtf8StringView Name)
+	{
+		TArray<UTF8CHAR, TInlineAllocator<256>> LowerName;
+		LowerName.SetNumUninitialized(Name.Len());
+		for (int32 Index = 0; Index < Name.Len(); ++Index)
+		{
+			LowerName[Index] = ToLowerAscii(Name[Index]);
+		}
+		return CityHash64(reinterpret_cast<const char*>(LowerName.GetData()), LowerName.Num());
+	}
+
+	static FName MakeName(FUtf8StringView Name)
+	{
+		return FName(Name.Len(), Name.GetData());
+	}
+}
+
+struct FAssetRegistryFlatState::FHeader
+{
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 NumAssets = 0;
+	uint32 NumTags = 0;
+	uint32 NumChunkIDs = 0;
+	uint32 NumPackages = 0;
+	uint32 NumClasses = 0;
+	uint32 NumTagKeys = 0;
+	uint32 NumAssetListEntries = 0;
+	uint32 Padding = 0;
+	uint64 AssetsOffset = 0;
+	uint64 TagsOffset = 0;
+	uint64 ChunkIDsOffset = 0;
+	uint64 PackageIndexOffset = 0;
+	uint64 ClassIndexOffset = 0;
+	uint64 TagKeyIndexOffset = 0;
+	uint64 AssetListsOffset = 0;
+	uint64 StringsOffset = 0;
+	uint64 StringsSize = 0;
+};
+
+/** Assets are sorted by ObjectPathHash, the strings are offsets in the string table */
+struct FAssetRegistryFlatState::FFlatAsset
+{
+	uint64 ObjectPathHash = 0;
+	uint32 ObjectPath = 0;
+	uint32 PackageName = 0;
+	uint32 PackagePath = 0;
+	uint32 AssetName = 0;
+	uint32 AssetClass = 0;
+	uint32 PackageFlags = 0;
+	uint32 FirstTag = 0;
+	uint32 NumTags = 0;
+	uint32 FirstChunkID = 0;
+	uint32 NumChunkIDs = 0;
+};
+
+struct FAssetRegistryFlatState::FFlatTag
+{
+	uint32 Key = 0;
+	uint32 Value = 0;
+};
+
+/** Index entries are sorted by NameHash, the assets of an entry are a range of the asset lists */
+struct FAssetRegistryFlatState::FFlatIndexEntry
+{
+	uint64 NameHash = 0;
+	uint32 Name = 0;
+	uint32 FirstAsset = 0;
+	uint32 NumAssets = 0;
+	uint32 Padding = 0;
+};
+
+FAssetRegistryFlatState::FAssetRegistryFlatState()
+{
+	static_assert(sizeof(FHeader) == 112, "FHeader is stored in the flat asset registry");
+	static_assert(sizeof(FFlatAsset) == 48, "FFlatAsset is stored in the flat asset registry");
+	static_assert(sizeof(FFlatTag) == 8, "FFlatTag is stored in the flat asset registry");
+	static_assert(sizeof(FFlatIndexEntry) == 24, "FFlatIndexEntry is stored in the flat asset registry");
+}
+
+FAssetRegistryFlatState::~FAssetRegistryFlatState()
+{
+	Reset();
+}
+
+void FAssetRegistryFlatState::Save(const FAssetRegistryState& State, FArchive& Ar)
+{
+	using namespace UE::AssetRegistry::FlatState;
+
+	/** Strings are stored once, as their UTF-8 length followed by their UTF-8 characters, padded to 4 bytes */
+	struct FStringTableWriter
+	{
+		struct FCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, uint32, false>
+		{
+			static bool Matches(const FString& A, const FString& B)
+			{
+				return A.Equals(B, ESearchCase::CaseSensitive);
+			}
+
+			static uint32 GetKeyHash(const FString& Key)
+			{
+				return FCrc::StrCrc32(*Key);
+			}
+		};
+
+		TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Offsets;
+		TArray64<uint8> Data;
+
+		uint32 Add(FString&& String)
+		{
+			if (const uint32* Existing = Offsets.Find(String))
+			{
+				return *Existing;
+			}
+
+			FTCHARToUTF8 Utf8String(*String, String.Len());
+			const uint32 Offset = IntCastChecked<uint32>(Data.Num());
+			const uint32 Length = Utf8String.Length();
+			Data.Append(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+			Data.Append(reinterpret_cast<const uint8*>(Utf8String.Get()), Length);
+			Data.AddZeroed(Align(Data.Num(), 4) - Data.Num());
+			Offsets.Add(MoveTemp(String), Offset);
+			return Offset;
+		}
+	};
+
+	struct FIndexWriter
+	{
+		TMap<FName, TArray<uint32>> AssetsByName;
+
+		void Write(FStringTableWriter& Strings, TArray<FFlatIndexEntry>& OutEntries, TArray<uint32>& OutAssetLists)
+		{
+			OutEntries.Reserve(AssetsByName.Num());
+			for (TPair<FName, TArray<uint32>>& Pair : AssetsByName)
+			{
+				FString Name = Pair.Key.ToString();
+				FTCHARToUTF8 Utf8Name(*Name, Name.Len());
+
+				FFlatIndexEntry& Entry = OutEntries.AddDefaulted_GetRef();
+				Entry.NameHash = HashName(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8Name.Get()), Utf8Name.Length()));
+				Entry.Name = Strings.Add(MoveTemp(Name));
+				Entry.FirstAsset = OutAssetLists.Num();
+				Entry.NumAssets = Pair.Value.Num();
+				OutAssetLists.Append(Pair.Value);
+			}
+			Algo::Sort(OutEntries, [](const FFlatIndexEntry& A, const FFlatIndexEntry& B)
+			{
+				return A.NameHash != B.NameHash ? A.NameHash < B.NameHash : A.Name < B.Name;
+			});
+		}
+	};
+
+	// Sort the assets by the hash of their object path, which is how they are looked up
+	TArray<TPair<uint64, const FAssetData*>> SortedAssets;
+	const TMap<FName, const FAssetData*>& AssetDataMap = State.GetObjectPathToAssetDataMap();
+	SortedAssets.Reserve(AssetDataMap.Num());
+	for (const TPair<FName, const FAssetData*>& Pair : AssetDataMap)
+	{
+		FString ObjectPath = Pair.Value->ObjectPath.ToString();
+		FTCHARToUTF8 Utf8ObjectPath(*ObjectPath, ObjectPath.Len());
+		SortedAssets.Emplace(HashName(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8ObjectPath.Get()), Utf8ObjectPath.Length())), Pair.Value);
+	}
+	Algo::Sort(SortedAssets, [](const TPair<uint64, const FAssetData*>& A, const TPair<uint64, const FAssetData*>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value->ObjectPath.LexicalLess(B.Value->ObjectPath);
+	});
+
+	FStringTableWriter Strings;
+	TArray<FFlatAsset> FlatAssets;
+	TArray<FFlatTag> FlatTags;
+	TArray<int32> FlatChunkIDs;
+	FIndexWriter PackageIndexWriter;
+	FIndexWriter ClassIndexWriter;
+	FIndexWriter TagKeyIndexWriter;
+	FlatAssets.Reserve(SortedAssets.Num());
+	for (const TPair<uint64, const FAssetData*>& Pair : SortedAssets)
+	{
+		const FAssetData& AssetData = *Pair.Value;
+		const uint32 AssetIndex = FlatAssets.Num();
+
+		FFlatAsset& FlatAsset = FlatAssets.AddDefaulted_GetRef();
+		FlatAsset.ObjectPathHash = Pair.Key;
+		FlatAsset.ObjectPath = Strings.Add(AssetData.ObjectPath.ToString());
+		FlatAsset.PackageName = Strings.Add(AssetData.PackageName.ToString());
+		FlatAsset.PackagePath = Strings.Add(AssetData.PackagePath.ToString());
+		FlatAsset.AssetName = Strings.Add(AssetData.AssetName.ToString());
+		FlatAsset.AssetClass = Strings.Add(AssetData.AssetClass.ToString());
+		FlatAsset.PackageFlags = AssetData.PackageFlags;
+
+		FlatAsset.FirstTag = FlatTags.Num();
+		AssetData.TagsAndValues.ForEach([&](TPair<FName, FAssetTagValueRef> Tag)
+		{
+			FFlatTag& FlatTag = FlatTags.AddDefaulted_GetRef();
+			FlatTag.Key = Strings.Add(Tag.Key.ToString());
+			FlatTag.Value = Strings.Add(Tag.Value.ToLoose());
+			TagKeyIndexWriter.AssetsByName.FindOrAdd(Tag.Key).Add(AssetIndex);
+		});
+		FlatAsset.NumTags = FlatTags.Num() - FlatAsset.FirstTag;
+
+		FlatAsset.FirstChunkID = FlatChunkIDs.Num();
+		FlatAsset.NumChunkIDs = AssetData.ChunkIDs.Num();
+		FlatChunkIDs.Append(AssetData.ChunkIDs);
+
+		PackageIndexWriter.AssetsByName.FindOrAdd(AssetData.PackageName).Add(AssetIndex);
+		ClassIndexWriter.AssetsByName.FindOrAdd(AssetData.AssetClass).Add(AssetIndex);
+	}
+
+	TArray<FFlatIndexEntry> PackageIndexEntries;
+	TArray<FFlatIndexEntry> ClassIndexEntries;
+	TArray<FFlatIndexEntry> TagKeyIndexEntries;
+	TArray<uint32> AssetLists;
+	PackageIndexWriter.Write(Strings, PackageIndexEntries, AssetLists);
+	ClassIndexWriter.Write(Strings, ClassIndexEntries, AssetLists);
+	TagKeyIndexWriter.Write(Strings, TagKeyIndexEntries, AssetLists);
+
+	// Lay out the sections after the header
+	uint64 NextOffset = Align(sizeof(FHeader), SectionAlignment);
+	auto PlaceSection = [&NextOffset](uint64 Size)
+	{
+		const uint64 Offset = NextOffset;
+		NextOffset = Align(NextOffset + Size, SectionAlignment);
+		return Offset;
+	};
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.NumAssets = FlatAssets.Num();
+	Header.NumTags = FlatTags.Num();
+	Header.NumChunkIDs = FlatChunkIDs.Num();
+	Header.NumPackages = PackageIndexEntries.Num();
+	Header.NumClasses = ClassIndexEntries.Num();
+	Header.NumTagKeys = TagKeyIndexEntries.Num();
+	Header.NumAssetListEntries = AssetLists.Num();
+	Header.AssetsOffset = PlaceSection(FlatAssets.Num() * sizeof(FFlatAsset));
+	Header.TagsOffset = PlaceSection(FlatTags.Num() * sizeof(FFlatTag));
+	Header.ChunkIDsOffset = PlaceSection(FlatChunkIDs.Num() * sizeof(int32));
+	Header.PackageIndexOffset = PlaceSection(PackageIndexEntries.Num() * sizeof(FFlatIndexEntry));
+	Header.ClassIndexOffset = PlaceSection(ClassIndexEntries.Num() * sizeof(FFlatIndexEntry));
+	Header.TagKeyIndexOffset = PlaceSection(TagKeyIndexEntries.Num() * sizeof(FFlatIndexEntry));
+	Header.AssetListsOffset = PlaceSection(AssetLists.Num() * sizeof(uint32));
+	Header.StringsOffset = PlaceSection(Strings.Data.Num());
+	Header.StringsSize = Strings.Data.Num();
+
+	uint64 WrittenSize = 0;
+	auto WriteSection = [&Ar, &WrittenSize](uint64 Offset, const void* SectionData, uint64 Size)
+	{
+		static const uint8 Zeros[SectionAlignment] = {};
+		check(Offset >= WrittenSize && Offset - WrittenSize <= SectionAlignment);
+		Ar.Serialize(const_cast<uint8*>(Zeros), Offset - WrittenSize);
+		Ar.Serialize(const_cast<void*>(SectionData), Size);
+		WrittenSize = Offset + Size;
+	};
+	WriteSection(0, &Header, sizeof(Header));
+	WriteSection(Header.AssetsOffset, FlatAssets.GetData(), FlatAssets.Num() * sizeof(FFlatAsset));
+	WriteSection(Header.TagsOffset, FlatTags.GetData(), FlatTags.Num() * sizeof(FFlatTag));
+	WriteSection(Header.ChunkIDsOffset, FlatChunkIDs.GetData(), FlatChunkIDs.Num() * sizeof(int32));
+	WriteSection(Header.PackageIndexOffset, PackageIndexEntries.GetData(), PackageIndexEntries.Num() * sizeof(FFlatIndexEntry));
+	WriteSection(Header.ClassIndexOffset, ClassIndexEntries.GetData(), ClassIndexEntries.Num() * sizeof(FFlatIndexEntry));
+	WriteSection(Header.TagKeyIndexOffset, TagKeyIndexEntries.GetData(), TagKeyIndexEntries.Num() * sizeof(FFlatIndexEntry));
+	WriteSection(Header.AssetListsOffset, AssetLists.GetData(), AssetLists.Num() * sizeof(uint32));
+	WriteSection(Header.StringsOffset, Strings.Data.GetData(), Strings.Data.Num());
+}
+
+bool FAssetRegistryFlatState::Load(const TCHAR* Filename)
+{
+	Reset();
+
+	MappedFileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+	if (MappedFileHandle && MappedFileHandle->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+	}
+	if (MappedRegion)
+	{
+		return Initialize(FMemoryView(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()));
+	}
+
+	MappedFileHandle.Reset();
+	TArray64<uint8> LoadedData;
+	if (!FFileHelper::LoadFileToArray(LoadedData, Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+	FileData = MoveTemp(LoadedData);
+	return Initialize(MakeMemoryView(FileData));
+}
+
+bool FAssetRegistryFlatState::Initialize(FMemoryView InData)
+{
+	using namespace UE::AssetRegistry::FlatState;
+
+	Header = nullptr;
+	Data = InData;
+
+	const FHeader* NewHeader = GetSection<FHeader>(0, 1);
+	if (!NewHeader || NewHeader->Magic != Magic || NewHeader->Version != Version)
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("Flat asset registry data is not in the current format."));
+		Reset();
+		return false;
+	}
+
+	Assets = GetSection<FFlatAsset>(NewHeader->AssetsOffset, NewHeader->NumAssets);
+	Tags = GetSection<FFlatTag>(NewHeader->TagsOffset, NewHeader->NumTags);
+	ChunkIDs = GetSection<int32>(NewHeader->ChunkIDsOffset, NewHeader->NumChunkIDs);
+	PackageIndex = GetSection<FFlatIndexEntry>(NewHeader->PackageIndexOffset, NewHeader->NumPackages);
+	ClassIndex = GetSection<FFlatIndexEntry>(NewHeader->ClassIndexOffset, NewHeader->NumClasses);
+	TagKeyIndex = GetSection<FFlatIndexEntry>(NewHeader->TagKeyIndexOffset, NewHeader->NumTagKeys);
+	AssetLists = GetSection<uint32>(NewHeader->AssetListsOffset, NewHeader->NumAssetListEntries);
+	Strings = GetSection<uint8>(NewHeader->StringsOffset, NewHeader->StringsSize);
+	if (!Assets || !Tags || !ChunkIDs || !PackageIndex || !ClassIndex || !TagKeyIndex || !AssetLists || !Strings)
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("Flat asset registry data is truncated."));
+		Reset();
+		return false;
+	}
+
+	Header = NewHeader;
+	return true;
+}
+
+void FAssetRegistryFlatState::Reset()
+{
+	Header = nullptr;
+	Assets = nullptr;
+	Tags = nullptr;
+	ChunkIDs = nullptr;
+	PackageIndex = nullptr;
+	ClassIndex = nullptr;
+	TagKeyIndex = nullptr;
+	AssetLists = nullptr;
+	Strings = nullptr;
+	Data.Reset();
+
+	MappedRegion.Reset();
+	MappedFileHandle.Reset();
+	FileData.Empty();
+}
+
+template <typename T>
+const T* FAssetRegistryFlatState::GetSection(uint64 Offset, uint64 Count) const
+{
+	const uint64 DataSize = Data.GetSize();
+	if (Offset % alignof(T) != 0 || Offset > DataSize || Count > (DataSize - Offset) / sizeof(T))
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<const T*>(static_cast<const uint8*>(Data.GetData()) + Offset);
+}
+
+int32 FAssetRegistryFlatState::GetNumAssets() const
+{
+	return Header ? int32(Header->NumAssets) : 0;
+}
+
+FAssetRegistryFlatState::FAssetView FAssetRegistryFlatState::GetAsset(int32 AssetIndex) const
+{
+	checkf(AssetIndex >= 0 && AssetIndex < GetNumAssets(), TEXT("Asset index %d out of bounds, the flat asset registry has %d assets"), AssetIndex, GetNumAssets());
+	return FAssetView(*this, Assets[AssetIndex]);
+}
+
+FUtf8StringView FAssetRegistryFlatState::GetString(uint32 StringOffset) const
+{
+	uint32 Length = 0;
+	if (uint64(StringOffset) + sizeof(Length) > Header->StringsSize)
+	{
+		return FUtf8StringView();
+	}
+	FMemory::Memcpy(&Length, Strings + StringOffset, sizeof(Length));
+	if (uint64(StringOffset) + sizeof(Length) + Length > Header->StringsSize)
+	{
+		return FUtf8StringView();
+	}
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Strings + StringOffset + sizeof(Length)), Length);
+}
+
+int32 FAssetRegistryFlatState::FindAssetByObjectPath(FStringView ObjectPath) const
+{
+	using namespace UE::AssetRegistry::FlatState;
+
+	if (!Header)
+	{
+		return INDEX_NONE;
+	}
+
+	FTCHARToUTF8 Utf8ObjectPath(ObjectPath.GetData(), ObjectPath.Len());
+	const FUtf8StringView ObjectPathView(reinterpret_cast<const UTF8CHAR*>(Utf8ObjectPath.Get()), Utf8ObjectPath.Length());
+	const uint64 ObjectPathHash = HashName(ObjectPathView);
+
+	const TArrayView<const FFlatAsset> AssetsView(Assets, Header->NumAssets);
+	for (int32 AssetIndex = Algo::LowerBoundBy(AssetsView, ObjectPathHash, &FFlatAsset::ObjectPathHash);
+		AssetIndex < AssetsView.Num() && AssetsView[AssetIndex].ObjectPathHash == ObjectPathHash; ++AssetIndex)
+	{
+		if (NameEquals(GetString(AssetsView[AssetIndex].ObjectPath), ObjectPathView))
+		{
+			return AssetIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+TArrayView<const uint32> FAssetRegistryFlatState::FindInIndex(const FFlatIndexEntry* Index, uint32 NumEntries, FStringView Name) const
+{
+	using namespace UE::AssetRegistry::FlatState;
+
+	FTCHARToUTF8 Utf8Name(Name.GetData(), Name.Len());
+	const FUtf8StringView NameView(reinterpret_cast<const UTF8CHAR*>(Utf8Name.Get()), Utf8Name.Length());
+	const uint64 NameHash = HashName(NameView);
+
+	const TArrayView<const FFlatIndexEntry> IndexView(Index, NumEntries);
+	for (int32 EntryIndex = Algo::LowerBoundBy(IndexView, NameHash, &FFlatIndexEntry::NameHash);
+		EntryIndex < IndexView.Num() && IndexView[EntryIndex].NameHash == NameHash; ++EntryIndex)
+	{
+		const FFlatIndexEntry& Entry = IndexView[EntryIndex];
+		if (NameEquals(GetString(Entry.Name), NameView))
+		{
+			if (uint64(Entry.FirstAsset) + Entry.NumAssets > Header->NumAssetListEntries)
+			{
+				return TArrayView<const uint32>();
+			}
+			return TArrayView<const uint32>(AssetLists + Entry.FirstAsset, Entry.NumAssets);
+		}
+	}
+	return TArrayView<const uint32>();
+}
+
+TArrayView<const uint32> FAssetRegistryFlatState::FindAssetsByPackageName(FStringView PackageName) const
+{
+	return Header ? FindInIndex(PackageIndex, Header->NumPackages, PackageName) : TArrayView<const uint32>();
+}
+
+TArrayView<const uint32> FAssetRegistryFlatState::FindAssetsByClass(FStringView ClassName) const
+{
+	return Header ? FindInIndex(ClassIndex, Header->NumClasses, ClassName) : TArrayView<const uint32>();
+}
+
+TArrayView<const uint32> FAssetRegistryFlatState::FindAssetsByTagKey(FStringView TagKey) const
+{
+	return Header ? FindInIndex(TagKeyIndex, Header->NumTagKeys, TagKey) : TArrayView<const uint32>();
+}
+
+void FAssetRegistryFlatState::GetAssetData(TArrayView<const uint32> AssetIndices, TArray<FAssetData>& OutAssetData) const
+{
+	OutAssetData.Reserve(OutAssetData.Num() + AssetIndices.Num());
+	for (uint32 AssetIndex : AssetIndices)
+	{
+		OutAssetData.Add(GetAsset(int32(AssetIndex)).ToAssetData());
+	}
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetObjectPath() const
+{
+	return State.GetString(Asset.ObjectPath);
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetPackageName() const
+{
+	return State.GetString(Asset.PackageName);
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetPackagePath() const
+{
+	return State.GetString(Asset.PackagePath);
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetAssetName() const
+{
+	return State.GetString(Asset.AssetName);
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetAssetClass() const
+{
+	return State.GetString(Asset.AssetClass);
+}
+
+uint32 FAssetRegistryFlatState::FAssetView::GetPackageFlags() const
+{
+	return Asset.PackageFlags;
+}
+
+TArrayView<const int32> FAssetRegistryFlatState::FAssetView::GetChunkIDs() const
+{
+	if (uint64(Asset.FirstChunkID) + Asset.NumChunkIDs > State.Header->NumChunkIDs)
+	{
+		return TArrayView<const int32>();
+	}
+	return TArrayView<const int32>(State.ChunkIDs + Asset.FirstChunkID, Asset.NumChunkIDs);
+}
+
+int32 FAssetRegistryFlatState::FAssetView::GetNumTags() const
+{
+	if (uint64(Asset.FirstTag) + Asset.NumTags > State.Header->NumTags)
+	{
+		return 0;
+	}
+	return Asset.NumTags;
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetTagKey(int32 TagIndex) const
+{
+	check(TagIndex >= 0 && TagIndex < GetNumTags());
+	return State.GetString(State.Tags[Asset.FirstTag + TagIndex].Key);
+}
+
+FUtf8StringView FAssetRegistryFlatState::FAssetView::GetTagValue(int32 TagIndex) const
+{
+	check(TagIndex >= 0 && TagIndex < GetNumTags());
+	return State.GetString(State.Tags[Asset.FirstTag + TagIndex].Value);
+}
+
+bool FAssetRegistryFlatState::FAssetView::FindTag(FStringView TagKey, FUtf8StringView& OutValue) const
+{
+	using namespace UE::AssetRegistry::FlatState;
+
+	FTCHARToUTF8 Utf8TagKey(TagKey.GetData(), TagKey.Len());
+	const FUtf8StringView TagKeyView(reinterpret_cast<const UTF8CHAR*>(Utf8TagKey.Get()), Utf8TagKey.Length());
+	for (int32 TagIndex = 0, NumTags = GetNumTags(); TagIndex < NumTags; ++TagIndex)
+	{
+		if (NameEquals(GetTagKey(TagIndex), TagKeyView))
+		{
+			OutValue = GetTagValue(TagIndex);
+			return true;
+		}
+	}
+	return false;
+}
+
+FAssetData FAssetRegistryFlatState::FAssetView::ToAssetData() const
+{
+	using namespace UE::AssetRegistry::FlatState;
+
+	FAssetDataTagMap TagMap;
+	const int32 NumTags = GetNumTags();
+	TagMap.Reserve(NumTags);
+	for (int32 TagIndex = 0; TagIndex < NumTags; ++TagIndex)
+	{
+		const FUtf8StringView Value = GetTagValue(TagIndex);
+		TagMap.Add(MakeName(GetTagKey(TagIndex)), FString(Value.Len(), Value.GetData()));
+	}
+
+	return FAssetData(MakeName(GetPackageName()), MakeName(GetPackagePath()), MakeName(GetAssetName()), MakeName(GetAssetClass()),
+		MoveTemp(TagMap), GetChunkIDs(), GetPackageFlags());
+}
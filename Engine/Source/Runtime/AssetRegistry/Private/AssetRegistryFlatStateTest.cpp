@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AssetRegistry/AssetRegistryFlatState.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetRegistryFlatStateTest, "System.AssetRegistry.FlatState", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+bool FAssetRegistryFlatStateTest::RunTest(const FString& Parameters)
+{
+	FAssetRegistryState State;
+	const int32 NumPackages = 64;
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		const FName PackageName(*FString::Printf(TEXT("/Game/FlatStateTest/Package%d"), PackageIndex));
+		const FName AssetClass = (PackageIndex % 2) ? FName(TEXT("Texture2D")) : FName(TEXT("StaticMesh"));
+
+		FAssetDataTagMap Tags;
+		Tags.Add(FName(TEXT("Index")), FString::FromInt(PackageIndex));
+		if (PackageIndex % 4 == 0)
+		{
+			Tags.Add(FName(TEXT("Quarter")), TEXT("Yes"));
+		}
+		const int32 ChunkIDs[] = { PackageIndex % 3 };
+		State.AddAssetData(new FAssetData(PackageName, FName(TEXT("/Game/FlatStateTest")), FName(*FString::Printf(TEXT("Package%d"), PackageIndex)),
+			AssetClass, MoveTemp(Tags), ChunkIDs, PackageIndex));
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	FAssetRegistryFlatState::Save(State, Writer);
+
+	FAssetRegistryFlatState FlatState;
+	if (!TestTrue(TEXT("Initialize"), FlatState.Initialize(MakeMemoryView(Data))))
+	{
+		return false;
+	}
+	TestEqual(TEXT("GetNumAssets"), FlatState.GetNumAssets(), NumPackages);
+
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		const FString ObjectPath = FString::Printf(TEXT("/Game/FlatStateTest/Package%d.Package%d"), PackageIndex, PackageIndex);
+		const int32 AssetIndex = FlatState.FindAssetByObjectPath(ObjectPath);
+		if (!TestTrue(TEXT("FindAssetByObjectPath"), AssetIndex != INDEX_NONE))
+		{
+			continue;
+		}
+
+		const FAssetData AssetData = FlatState.GetAsset(AssetIndex).ToAssetData();
+		const FAssetData* ExpectedAssetData = State.GetAssetByObjectPath(FName(*ObjectPath));
+		TestEqual(TEXT("ObjectPath"), AssetData.ObjectPath, ExpectedAssetData->ObjectPath);
+		TestEqual(TEXT("AssetClass"), AssetData.AssetClass, ExpectedAssetData->AssetClass);
+		TestEqual(TEXT("PackageFlags"), AssetData.PackageFlags, ExpectedAssetData->PackageFlags);
+		TestTrue(TEXT("ChunkIDs"), AssetData.ChunkIDs == ExpectedAssetData->ChunkIDs);
+		TestEqual(TEXT("Index tag"), AssetData.GetTagValueRef<FString>(FName(TEXT("Index"))), FString::FromInt(PackageIndex));
+
+		TArrayView<const uint32> PackageAssets = FlatState.FindAssetsByPackageName(FString::Printf(TEXT("/game/flatstatetest/package%d"), PackageIndex));
+		TestTrue(TEXT("FindAssetsByPackageName ignores case"), PackageAssets.Num() == 1 && PackageAssets[0] == uint32(AssetIndex));
+	}
+
+	TestEqual(TEXT("FindAssetsByClass"), FlatState.FindAssetsByClass(TEXT("Texture2D")).Num(), NumPackages / 2);
+	TestEqual(TEXT("FindAssetsByTagKey"), FlatState.FindAssetsByTagKey(TEXT("Quarter")).Num(), NumPackages / 4);
+	TestEqual(TEXT("FindAssetsByTagKey missing"), FlatState.FindAssetsByTagKey(TEXT("Missing")).Num(), 0);
+	TestEqual(TEXT("FindAssetByObjectPath missing"), FlatState.FindAssetByObjectPath(TEXT("/Game/Missing.Missing")), int32(INDEX_NONE));
+
+	TArray<uint8> TruncatedData(Data.GetData(), Data.Num() / 2);
+	FAssetRegistryFlatState TruncatedFlatState;
+	AddExpectedError(TEXT("truncated"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Initialize truncated"), TruncatedFlatState.Initialize(MakeMemoryView(TruncatedData)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryFlatState.h"
 #include "AssetRegistry/AssetRegistryState.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "AssetRegistry/PathTree.h"
@@ -171,6 +172,7 @@ public:
 	void CopySerializationOptions(FAssetRegistrySerializationOptions& OutOptions, ESerializationTarget Target) const;
 
 	const FAssetRegistryState& GetState() const;
+	const FAssetRegistryFlatState& GetFlatState() const;
 	const FPathTree& GetCachedPathTree() const;
 	const TSet<FName>& GetCachedEmptyPackages() const;
 	/** Find the AssetPackageData for the given PackageName and return a pointer to it or nullptr if not found */
@@ -246,6 +248,9 @@ private:
 	/** Internal state of the cached asset registry */
 	FAssetRegistryState State;
 
+	/** Flat copy of the cooked registry, loaded during Initialize if the cooker wrote one; never modified afterwards */
+	FAssetRegistryFlatState FlatState;
+
 	/** Default options used for serialization */
 	FAssetRegistrySerializationOptions SerializationOptions;
 	FAssetRegistrySerializationOptions DevelopmentSerializationOptions;
@@ -10,6 +10,8 @@ class FDiskCachedAssetData
 {
 public:
 	FDateTime Timestamp;
+	/** Size of the package file, the cached data is only used if both the timestamp and the size of the file match */
+	int64 FileSize = -1;
 	FName Extension;
 	TArray<FAssetData> AssetDataList;
 	FPackageDependencyData DependencyData;
@@ -17,8 +19,9 @@ public:
 	FDiskCachedAssetData()
 	{}
 
-	FDiskCachedAssetData(const FDateTime& InTimestamp, FName InExtension)
+	FDiskCachedAssetData(const FDateTime& InTimestamp, int64 InFileSize, FName InExtension)
 		: Timestamp(InTimestamp)
+		, FileSize(InFileSize)
 		, Extension(InExtension)
 	{}
 
@@ -30,6 +33,7 @@ public:
 	void SerializeForCache(Archive&& Ar)
 	{
 		Ar << Timestamp;
+		Ar << FileSize;
 		Ar << Extension;
 	
 		int32 AssetDataCount = AssetDataList.Num();
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/StringView.h"
+#include "Memory/MemoryView.h"
+
+class FAssetRegistryState;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Read only view of the assets of a cooked asset registry, stored in a flat format that is queried in place.
+ *
+ * The format holds no pointers: assets, tags and the lookup tables are arrays of fixed size entries referencing each other by index, and
+ * strings are stored once as UTF-8 in a string table. The tables for package names, classes and tag keys are sorted by a hash of the
+ * lowercase name, so lookups are binary searches. Loading maps the file where the platform supports it (else reads it whole) and does no
+ * other work, FAssetData are only created for the assets that are asked for.
+ *
+ * The file is written by the cooker next to AssetRegistry.bin when [AssetRegistry] bSerializeFlatAssetRegistry is set, in the byte order of
+ * the cooking platform, and is staged along with it. The asset registry loads it at startup, see IAssetRegistry::GetFlatAssetRegistryState.
+ * Dependencies and package data are not stored.
+ */
+class ASSETREGISTRY_API FAssetRegistryFlatState
+{
+private:
+	struct FHeader;
+	struct FFlatAsset;
+	struct FFlatTag;
+	struct FFlatIndexEntry;
+
+public:
+	/** A view of an asset of the state, only valid as long as the state it was returned from */
+	class ASSETREGISTRY_API FAssetView
+	{
+	public:
+		FUtf8StringView GetObjectPath() const;
+		FUtf8StringView GetPackageName() const;
+		FUtf8StringView GetPackagePath() const;
+		FUtf8StringView GetAssetName() const;
+		FUtf8StringView GetAssetClass() const;
+		uint32 GetPackageFlags() const;
+		TArrayView<const int32> GetChunkIDs() const;
+
+		int32 GetNumTags() const;
+		FUtf8StringView GetTagKey(int32 TagIndex) const;
+		FUtf8StringView GetTagValue(int32 TagIndex) const;
+		/** Finds the value of a tag, tag keys are case insensitive like FNames */
+		bool FindTag(FStringView TagKey, FUtf8StringView& OutValue) const;
+
+		/** Creates the FAssetData of the asset, this allocates the tag map and adds the names to the name table */
+		FAssetData ToAssetData() const;
+
+	private:
+		friend class FAssetRegistryFlatState;
+
+		FAssetView(const FAssetRegistryFlatState& InState, const FFlatAsset& InAsset)
+			: State(InState)
+			, Asset(InAsset)
+		{
+		}
+
+		const FAssetRegistryFlatState& State;
+		const FFlatAsset& Asset;
+	};
+
+	FAssetRegistryFlatState();
+	~FAssetRegistryFlatState();
+
+	FAssetRegistryFlatState(const FAssetRegistryFlatState&) = delete;
+	FAssetRegistryFlatState& operator=(const FAssetRegistryFlatState&) = delete;
+
+	/** Writes the assets of State in the flat format */
+	static void Save(const FAssetRegistryState& State, FArchive& Ar);
+
+	/** Maps or reads a file written by Save, returns false if it can't be read or isn't in the current format */
+	bool Load(const TCHAR* Filename);
+
+	/** Uses data written by Save, which must stay valid and unchanged until the state is reset or destroyed */
+	bool Initialize(FMemoryView InData);
+
+	void Reset();
+
+	bool IsValid() const
+	{
+		return Header != nullptr;
+	}
+
+	int32 GetNumAssets() const;
+
+	FAssetView GetAsset(int32 AssetIndex) const;
+
+	/** Returns the index of the asset with the given object path, or INDEX_NONE */
+	int32 FindAssetByObjectPath(FStringView ObjectPath) const;
+
+	/** The indices of the assets of the package, in the mapped data */
+	TArrayView<const uint32> FindAssetsByPackageName(FStringView PackageName) const;
+
+	/** The indices of the assets of the class, in the mapped data */
+	TArrayView<const uint32> FindAssetsByClass(FStringView ClassName) const;
+
+	/** The indices of the assets having the tag, in the mapped data */
+	TArrayView<const uint32> FindAssetsByTagKey(FStringView TagKey) const;
+
+	/** Appends the FAssetData of the given assets to OutAssetData */
+	void GetAssetData(TArrayView<const uint32> AssetIndices, TArray<FAssetData>& OutAssetData) const;
+
+	/** The size of the data of the state, most of which is only resident once used when the file is mapped */
+	uint64 GetDataSize() const
+	{
+		return Data.GetSize();
+	}
+
+private:
+	FUtf8StringView GetString(uint32 StringOffset) const;
+	TArrayView<const uint32> FindInIndex(const FFlatIndexEntry* Index, uint32 NumEntries, FStringView Name) const;
+
+	template <typename T>
+	const T* GetSection(uint64 Offset, uint64 Count) const;
+
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> FileData;
+	FMemoryView Data;
+
+	const FHeader* Header = nullptr;
+	const FFlatAsset* Assets = nullptr;
+	const FFlatTag* Tags = nullptr;
+	const int32* ChunkIDs = nullptr;
+	const FFlatIndexEntry* PackageIndex = nullptr;
+	const FFlatIndexEntry* ClassIndex = nullptr;
+	const FFlatIndexEntry* TagKeyIndex = nullptr;
+	const uint32* AssetLists = nullptr;
+	const uint8* Strings = nullptr;
+};
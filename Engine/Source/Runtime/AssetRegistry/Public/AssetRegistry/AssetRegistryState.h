@@ -41,6 +41,9 @@ struct FAssetRegistrySerializationOptions
 	/** If true will read/write FAssetPackageData */
 	bool bSerializePackageData = false;
 
+	/** If true the cooker also writes the runtime registry in the format of FAssetRegistryFlatState next to it, the game loads it at startup */
+	bool bSerializeFlatAssetRegistry = false;
+
 	/** True if CookFilterlistTagsByClass is an allow list. False if it is a deny list. */
 	bool bUseAssetRegistryTagsAllowListInsteadOfDenyList = false;
 
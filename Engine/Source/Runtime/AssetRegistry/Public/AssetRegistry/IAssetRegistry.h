@@ -23,6 +23,7 @@ struct FARFilter;
 struct FARCompiledFilter;
 struct FAssetRegistrySerializationOptions;
 class FAssetRegistryState;
+class FAssetRegistryFlatState;
 class FDependsNode;
 struct FPackageFileSummary;
 
@@ -570,6 +571,13 @@ public:
 	UE_DEPRECATED(5.0, "Receiving a pointer is not threadsafe. Use other functions on IAssetRegistry to access the same data, or contact Epic Core team to add the threadsafe functions you require..")
 	virtual const FAssetRegistryState* GetAssetRegistryState() const = 0;
 
+	/**
+	 * Returns the flat asset registry of a cooked game, written by the cooker when [AssetRegistry] bSerializeFlatAssetRegistry is set and loaded
+	 * at startup from AssetRegistry.flat when it was staged, or null. It's read only and lives as long as the asset registry, so it can be
+	 * queried from any thread. It holds the same assets as the main cooked registry, excluding those of plugin registries.
+	 */
+	virtual const FAssetRegistryFlatState* GetFlatAssetRegistryState() const = 0;
+
 #if ASSET_REGISTRY_STATE_DUMPING_ENABLED
 	/**
 	 * Writes out the state in textual form. Use arguments to control which segments to emit.
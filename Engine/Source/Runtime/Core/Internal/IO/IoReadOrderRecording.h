@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "IO/IoDispatcher.h"
+#include "Templates/UniquePtr.h"
+
+class FArchive;
+
+/**
+ * One read issued through FIoDispatcher, in the order the reads were resolved.
+ *
+ * Recordings are written when running with -RecordIoReadOrder[=<file>] and consumed by IoStoreUtilities (-ReadOrderRecordings=),
+ * which lays out containers in the order chunks were actually read.
+ */
+struct FIoReadOrderRecordEntry
+{
+	FIoChunkId ChunkId;
+	uint64 Offset = 0;
+	/** The requested size, MAX_uint64 when reading to the end of the chunk */
+	uint64 Size = 0;
+	/** Milliseconds since the recording started */
+	uint32 TimeMs = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FIoReadOrderRecordEntry& Entry)
+	{
+		Ar << Entry.ChunkId;
+		Ar << Entry.Offset;
+		Ar << Entry.Size;
+		Ar << Entry.TimeMs;
+		return Ar;
+	}
+};
+
+/** Loads a recording written by FIoReadOrderRecorder, returns false if the file can't be read or isn't a recording */
+CORE_API bool LoadIoReadOrderRecording(const TCHAR* Filename, TArray<FIoReadOrderRecordEntry>& OutEntries);
+
+/**
+ * Appends the reads resolved by FIoDispatcher to a recording file.
+ * Entries are written in batches, so a recording cut short (e.g. by a crash) only loses its last reads.
+ */
+class FIoReadOrderRecorder
+{
+public:
+	/** Returns null unless recording was requested on the command line */
+	static TUniquePtr<FIoReadOrderRecorder> CreateFromCommandLine();
+
+	~FIoReadOrderRecorder();
+
+	/** Not thread safe, only called by the thread resolving requests */
+	void Record(const FIoChunkId& ChunkId, const FIoReadOptions& Options);
+
+private:
+	FIoReadOrderRecorder(TUniquePtr<FArchive>&& InFileArchive, const FString& InFilename);
+
+	void Flush();
+
+	TUniquePtr<FArchive> FileArchive;
+	FString Filename;
+	TArray<FIoReadOrderRecordEntry> PendingEntries;
+	double StartTime = 0.0;
+	uint64 EntryCount = 0;
+};
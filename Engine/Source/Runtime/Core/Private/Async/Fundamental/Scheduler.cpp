@@ -40,7 +40,7 @@ namespace LowLevelTasks
 		}
 	}
 
-	TUniquePtr<FThread> FScheduler::CreateWorker(bool bPermitBackgroundWork, FThread::EForkable IsForkable, FSleepEvent* ExternalWorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, EThreadPriority Priority, uint64 InAffinity)
+	TUniquePtr<FThread> FScheduler::CreateWorker(bool bPermitBackgroundWork, FThread::EForkable IsForkable, FSleepEvent* ExternalWorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, EThreadPriority Priority, uint64 InAffinity, bool bLatencyCritical)
 	{
 		uint32 WorkerId = NextWorkerId++;
 		const uint32 WaitTimes[8] = { 719, 991, 1361, 1237, 1597, 953, 587, 1439 };
@@ -80,15 +80,15 @@ namespace LowLevelTasks
 		
 		return MakeUnique<FThread>
 		(
-			bPermitBackgroundWork ? *FString::Printf(TEXT("Background Worker #%d"), WorkerId) : *FString::Printf(TEXT("Foreground Worker #%d"), WorkerId),
-			[this, ExternalWorkerEvent, ExternalWorkerLocalQueue, WaitTime, bPermitBackgroundWork]
+			bLatencyCritical ? *FString::Printf(TEXT("Latency Critical Worker #%d"), WorkerId) : bPermitBackgroundWork ? *FString::Printf(TEXT("Background Worker #%d"), WorkerId) : *FString::Printf(TEXT("Foreground Worker #%d"), WorkerId),
+			[this, ExternalWorkerEvent, ExternalWorkerLocalQueue, WaitTime, bPermitBackgroundWork, bLatencyCritical]
 			{ 
-				WorkerMain(ExternalWorkerEvent, ExternalWorkerLocalQueue, WaitTime, bPermitBackgroundWork);
+				WorkerMain(ExternalWorkerEvent, ExternalWorkerLocalQueue, WaitTime, bPermitBackgroundWork, bLatencyCritical);
 			}, 0, Priority, FThreadAffinity{ ThreadAffinityMask & ProcessorGroups.ThreadAffinities[CpuGroup], CpuGroup }, IsForkable
 		);
 	}
 
-	void FScheduler::StartWorkers(uint32 NumForegroundWorkers, uint32 NumBackgroundWorkers, FThread::EForkable IsForkable, EThreadPriority InWorkerPriority,  EThreadPriority InBackgroundPriority, uint64 InWorkerAffinity, uint64 InBackgroundAffinity)
+	void FScheduler::StartWorkers(uint32 NumForegroundWorkers, uint32 NumBackgroundWorkers, FThread::EForkable IsForkable, EThreadPriority InWorkerPriority,  EThreadPriority InBackgroundPriority, uint64 InWorkerAffinity, uint64 InBackgroundAffinity, uint32 NumLatencyCriticalWorkers, EThreadPriority InLatencyCriticalPriority)
 	{
 		if (NumForegroundWorkers == 0 && NumBackgroundWorkers == 0)
 		{
@@ -98,6 +98,7 @@ namespace LowLevelTasks
 
 		WorkerPriority = InWorkerPriority;
 		BackgroundPriority = InBackgroundPriority;
+		LatencyCriticalPriority = InLatencyCriticalPriority;
 
 		if (InWorkerAffinity)
 		{
@@ -119,9 +120,11 @@ namespace LowLevelTasks
 			check(!WorkerEvents.Num());		
 			check(NextWorkerId == 0);
 
-			WorkerThreads.Reserve(NumForegroundWorkers + NumBackgroundWorkers);
-			WorkerLocalQueues.Reserve(NumForegroundWorkers + NumBackgroundWorkers);
-			WorkerEvents.Reserve(NumForegroundWorkers + NumBackgroundWorkers);
+			// the local queues and events are referenced by the workers, so the arrays must not grow
+			const uint32 NumWorkerThreads = NumForegroundWorkers + NumBackgroundWorkers + NumLatencyCriticalWorkers;
+			WorkerThreads.Reserve(NumWorkerThreads);
+			WorkerLocalQueues.Reserve(NumWorkerThreads);
+			WorkerEvents.Reserve(NumWorkerThreads);
 			UE::Trace::ThreadGroupBegin(TEXT("Foreground Workers"));
 			for (uint32 WorkerId = 0; WorkerId < NumForegroundWorkers; ++WorkerId)
 			{
@@ -138,6 +141,14 @@ namespace LowLevelTasks
 				WorkerThreads.Add(CreateWorker(true, IsForkable, &WorkerEvents.Last(), &WorkerLocalQueues.Last(), BackgroundPriority, BackgroundAffinity));
 			}
 			UE::Trace::ThreadGroupEnd();
+			UE::Trace::ThreadGroupBegin(TEXT("Latency Critical Workers"));
+			for (uint32 WorkerId = 0; WorkerId < NumLatencyCriticalWorkers; ++WorkerId)
+			{
+				WorkerEvents.Emplace();
+				WorkerLocalQueues.Emplace(QueueRegistry, ELocalQueueType::ELatencyCritical, &WorkerEvents.Last());
+				WorkerThreads.Add(CreateWorker(false, IsForkable, &WorkerEvents.Last(), &WorkerLocalQueues.Last(), LatencyCriticalPriority, WorkerAffinity, true));
+			}
+			UE::Trace::ThreadGroupEnd();
 		}
 	}
 
@@ -149,6 +160,7 @@ namespace LowLevelTasks
 			FScopeLock Lock(&WorkerThreadsCS);
 			while (WakeUpWorker(true)) {}
 			while (WakeUpWorker(false)) {}
+			while (WakeUpWorkerFrom(LatencyCriticalSleepIndex)) {}
 
 			for (TUniquePtr<FThread>& Thread : WorkerThreads)
 			{
@@ -168,12 +180,12 @@ namespace LowLevelTasks
 			}
 		}
 	}
-	void FScheduler::RestartWorkers(uint32 NumForegroundWorkers, uint32 NumBackgroundWorkers, FThread::EForkable IsForkable, EThreadPriority InWorkerPriority, EThreadPriority InBackgroundPriority, uint64 InWorkerAffinity, uint64 InBackgroundAffinity)
+	void FScheduler::RestartWorkers(uint32 NumForegroundWorkers, uint32 NumBackgroundWorkers, FThread::EForkable IsForkable, EThreadPriority InWorkerPriority, EThreadPriority InBackgroundPriority, uint64 InWorkerAffinity, uint64 InBackgroundAffinity, uint32 NumLatencyCriticalWorkers, EThreadPriority InLatencyCriticalPriority)
 	{
 		FScopeLock Lock(&WorkerThreadsCS);
 		TemporaryShutdown.store(true, std::memory_order_release);
 		StopWorkers(false);
-		StartWorkers(NumForegroundWorkers, NumBackgroundWorkers, IsForkable, InWorkerPriority, InBackgroundPriority, InWorkerAffinity, InBackgroundAffinity);
+		StartWorkers(NumForegroundWorkers, NumBackgroundWorkers, IsForkable, InWorkerPriority, InBackgroundPriority, InWorkerAffinity, InBackgroundAffinity, NumLatencyCriticalWorkers, InLatencyCriticalPriority);
 		TemporaryShutdown.store(false, std::memory_order_release);
 	}
 
@@ -183,31 +195,36 @@ namespace LowLevelTasks
 		{			
 			const bool bIsBackgroundTask = Task.IsBackgroundTask();
 			const bool bIsBackgroundWorker = FSchedulerTls::IsBackgroundWorker();
+			const bool bIsLatencyCriticalTask = Task.GetPriority() == ETaskPriority::High;
 			if (bIsBackgroundTask && !bIsBackgroundWorker)
 			{
 				QueuePreference = EQueuePreference::GlobalQueuePreference;
 			}
+			else if (!bIsLatencyCriticalTask && FSchedulerTls::IsLatencyCriticalWorker())
+			{
+				// the local queue of a latency critical worker only holds tasks it can execute
+				QueuePreference = EQueuePreference::GlobalQueuePreference;
+			}
 
 			bWakeUpWorker |= FSchedulerTls::LocalQueue == nullptr;
 
+			bool bShouldWakeUpWorker;
 			if (FSchedulerTls::LocalQueue && QueuePreference != EQueuePreference::GlobalQueuePreference)
 			{
-				if (FSchedulerTls::LocalQueue->Enqueue(&Task, uint32(Task.GetPriority())))
-				{
-					if(bWakeUpWorker && !WakeUpWorker(bIsBackgroundTask) && !bIsBackgroundTask)
-					{
-						WakeUpWorker(true);
-					}
-				}
+				bShouldWakeUpWorker = FSchedulerTls::LocalQueue->Enqueue(&Task, uint32(Task.GetPriority()));
 			}
 			else
 			{
-				if (QueueRegistry.Enqueue(&Task, uint32(Task.GetPriority())))
+				bShouldWakeUpWorker = QueueRegistry.Enqueue(&Task, uint32(Task.GetPriority()));
+			}
+
+			// a sleeping latency critical worker picks the task up right away, while the other workers can be busy with long tasks
+			const bool bWokeUpLatencyCriticalWorker = bWakeUpWorker && bIsLatencyCriticalTask && WakeUpWorkerFrom(LatencyCriticalSleepIndex);
+			if (bWakeUpWorker && bShouldWakeUpWorker && !bWokeUpLatencyCriticalWorker)
+			{
+				if (!WakeUpWorker(bIsBackgroundTask) && !bIsBackgroundTask)
 				{
-					if (bWakeUpWorker && !WakeUpWorker(bIsBackgroundTask) && !bIsBackgroundTask)
-					{
-						WakeUpWorker(true);
-					}
+					WakeUpWorker(true);
 				}
 			}
 		}
@@ -285,13 +302,15 @@ namespace LowLevelTasks
 		return false;
 	}
 
-	void FScheduler::WorkerMain(FSleepEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork)
+	void FScheduler::WorkerMain(FSleepEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork, bool bLatencyCritical)
 	{
 		FTaskTagScope WorkerScope(ETaskTag::EWorkerThread);
 		FSchedulerTls::ActiveScheduler = this;
 
 		FMemory::SetupTLSCachesOnCurrentThread();
-		FSchedulerTls::WorkerType = bPermitBackgroundWork ? FSchedulerTls::EWorkerType::Background : FSchedulerTls::EWorkerType::Foreground;
+		FSchedulerTls::WorkerType = bLatencyCritical ? FSchedulerTls::EWorkerType::LatencyCritical : bPermitBackgroundWork ? FSchedulerTls::EWorkerType::Background : FSchedulerTls::EWorkerType::Foreground;
+		const ELocalQueueType QueueType = bLatencyCritical ? ELocalQueueType::ELatencyCritical : bPermitBackgroundWork ? ELocalQueueType::EBackground : ELocalQueueType::EForeground;
+		const uint32 SleepIndex = bLatencyCritical ? LatencyCriticalSleepIndex : bPermitBackgroundWork ? 1 : 0;
 
 		FSleepEvent LocalWorkerEvent;
 		if (!WorkerEvent)
@@ -306,14 +325,14 @@ namespace LowLevelTasks
 		}
 		else
 		{
-			FSchedulerTls::LocalQueue = FSchedulerTls::FLocalQueueType::AllocateLocalQueue(QueueRegistry, bPermitBackgroundWork ? ELocalQueueType::EBackground : ELocalQueueType::EForeground, WorkerEvent);
+			FSchedulerTls::LocalQueue = FSchedulerTls::FLocalQueueType::AllocateLocalQueue(QueueRegistry, QueueType, WorkerEvent);
 		}
 
 		FSchedulerTls::FLocalQueueType* WorkerLocalQueue = FSchedulerTls::LocalQueue;
 
 		bool bDrowsing = false;
 		uint32 WaitCount = 0;
-		FSchedulerTls::FQueueRegistry::FOutOfWork OutOfWork = QueueRegistry.GetOutOfWorkScope(bPermitBackgroundWork ? ELocalQueueType::EBackground : ELocalQueueType::EForeground);
+		FSchedulerTls::FQueueRegistry::FOutOfWork OutOfWork = QueueRegistry.GetOutOfWorkScope(QueueType);
 		while (true)
 		{
 			while(TryExecuteTaskFrom<&FSchedulerTls::FLocalQueueType::DequeueLocal,  false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork, bDrowsing)
@@ -344,7 +363,7 @@ namespace LowLevelTasks
 
 			if (WaitCount == 0 && !bDrowsing)
 			{
-				verifySlow(TrySleeping(WorkerEvent, OutOfWork.Start(), false, bPermitBackgroundWork));
+				verifySlow(TrySleeping(WorkerEvent, OutOfWork.Start(), false, SleepIndex));
 				WaitCount++;
 			}
 			else if (WaitCount < WorkerSpinCycles)
@@ -354,13 +373,13 @@ namespace LowLevelTasks
 			}
 			else
 			{
-				bDrowsing = TrySleeping(WorkerEvent, OutOfWork.Stop(), bDrowsing, bPermitBackgroundWork);
+				bDrowsing = TrySleeping(WorkerEvent, OutOfWork.Stop(), bDrowsing, SleepIndex);
 			}			
 		}
 
 		while (WakeUpWorker(bPermitBackgroundWork)) {}
 
-		FSchedulerTls::FLocalQueueType::DeleteLocalQueue(WorkerLocalQueue, bPermitBackgroundWork ? ELocalQueueType::EBackground : ELocalQueueType::EForeground, ExternalWorkerLocalQueue != nullptr);
+		FSchedulerTls::FLocalQueueType::DeleteLocalQueue(WorkerLocalQueue, QueueType, ExternalWorkerLocalQueue != nullptr);
 		FSchedulerTls::LocalQueue = nullptr;
 
 		FSchedulerTls::ActiveScheduler = nullptr;
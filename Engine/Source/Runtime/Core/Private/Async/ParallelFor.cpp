@@ -7,4 +7,18 @@ static FAutoConsoleVariableRef CVarParallelForBackgroundYieldingTimeout(
 	TEXT("Async.ParallelFor.YieldingTimeout"),
 	GParallelForBackgroundYieldingTimeoutMs,
 	TEXT("The timeout (in ms) when background priority parallel for task will yield execution to give higher priority tasks the chance to run.")
-);
\ No newline at end of file
+);
+
+CORE_API int32 GParallelForWorkStealing = 0;
+static FAutoConsoleVariableRef CVarParallelForWorkStealing(
+	TEXT("Async.ParallelFor.WorkStealing"),
+	GParallelForWorkStealing,
+	TEXT("If true, all parallel fors use work stealing (as with EParallelForFlags::WorkStealing) when the low level tasks scheduler is running.")
+);
+
+CORE_API int32 GParallelForStealingChunkMicroseconds = 20;
+static FAutoConsoleVariableRef CVarParallelForStealingChunkMicroseconds(
+	TEXT("Async.ParallelFor.StealingChunkMicroseconds"),
+	GParallelForStealingChunkMicroseconds,
+	TEXT("The duration (in microseconds) the batches of a work stealing parallel for adapt to, which is how often they offer work to idle workers.")
+);
@@ -109,6 +109,13 @@ static FAutoConsoleVariableRef CVarNumForegroundWorkers(
 	TEXT("Configures the number of foreground worker threads. Requires the scheduler to be restarted to have an affect")
 );
 
+int32 GNumLatencyCriticalWorkers = 0;
+static FAutoConsoleVariableRef CVarNumLatencyCriticalWorkers(
+	TEXT("TaskGraph.NumLatencyCriticalWorkers"),
+	GNumLatencyCriticalWorkers,
+	TEXT("Configures the number of latency critical worker threads, which only execute high priority tasks so those don't wait behind long running ones. They come in addition to the foreground and background workers. Requires the scheduler to be restarted to have an affect")
+);
+
 #if CREATE_HIPRI_TASK_THREADS || CREATE_BACKGROUND_TASK_THREADS
 	static void ThreadSwitchForABTest(const TArray<FString>& Args)
 	{
@@ -1898,7 +1905,7 @@ public:
 			int32 NumBackgroundWorkers = FMath::Max(1, NumWorkerThreads - FMath::Min<int>(GNumForegroundWorkers, NumWorkerThreads));
 			int32 NumForegroundWorkers =  FMath::Max(1, NumWorkerThreads - NumBackgroundWorkers);
 
-			LowLevelTasks::FScheduler::Get().StartWorkers(NumForegroundWorkers, NumBackgroundWorkers, FForkProcessHelper::IsForkedMultithreadInstance() ? FThread::Forkable : FThread::NonForkable, FPlatformAffinity::GetTaskThreadPriority(), FPlatformAffinity::GetTaskBPThreadPriority());
+			LowLevelTasks::FScheduler::Get().StartWorkers(NumForegroundWorkers, NumBackgroundWorkers, FForkProcessHelper::IsForkedMultithreadInstance() ? FThread::Forkable : FThread::NonForkable, FPlatformAffinity::GetTaskThreadPriority(), FPlatformAffinity::GetTaskBPThreadPriority(), 0, 0, GetNumLatencyCriticalWorkers(), FPlatformAffinity::GetTaskLatencyCriticalThreadPriority());
 
 			check(IsInGameThread()); // otherwise we can have a race on starting reserve workers below
 			if (GConfig == nullptr)
@@ -1990,7 +1997,7 @@ public:
 			int32 NumWorkers =  FMath::Max(1, NumWorkerThreads - NumBackgroundWorkers);
 
 			LowLevelTasks::FScheduler::Get().StopWorkers();
-			LowLevelTasks::FScheduler::Get().StartWorkers(NumWorkers, NumBackgroundWorkers, FForkProcessHelper::IsForkedMultithreadInstance() ? FThread::Forkable : FThread::NonForkable, Pri, FPlatformAffinity::GetTaskBPThreadPriority());
+			LowLevelTasks::FScheduler::Get().StartWorkers(NumWorkers, NumBackgroundWorkers, FForkProcessHelper::IsForkedMultithreadInstance() ? FThread::Forkable : FThread::NonForkable, Pri, FPlatformAffinity::GetTaskBPThreadPriority(), 0, 0, GetNumLatencyCriticalWorkers(), FPlatformAffinity::GetTaskLatencyCriticalThreadPriority());
 
 			if (bReserveWorkersEnabled)
 			{
@@ -2330,6 +2337,16 @@ private:
 		return *NamedThreads[Index].TaskGraphWorker;
 	}
 
+	uint32 GetNumLatencyCriticalWorkers() const
+	{
+		// forked processes and machines with few cores can't spare a thread
+		if (FForkProcessHelper::IsForkedMultithreadInstance() || NumWorkerThreads <= 3)
+		{
+			return 0;
+		}
+		return FMath::Max(GNumLatencyCriticalWorkers, 0);
+	}
+
 	void StartReserveWorkers()
 	{
 		if (bReserveWorkersEnabled)
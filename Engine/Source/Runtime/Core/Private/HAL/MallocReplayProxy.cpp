@@ -41,7 +41,7 @@ FMallocReplayProxy::FMallocReplayProxy(FMalloc* InMalloc)
 	// if it is null, we will silenty ignore saves
 	if (HistoryFile)
 	{
-		fprintf(HistoryFile, "Operation ResultPointer PointerIn SizeIn AlignmentIn\n");
+		fprintf(HistoryFile, "Operation ResultPointer PointerIn SizeIn AlignmentIn\t# OperationNumber ThreadId\n");
 
 		// GMalloc may not be destroyed, close history on exit ourselves
 		MallocReplayProxyCloserOnExit.InstanceToClose = this;
@@ -72,7 +72,7 @@ void FMallocReplayProxy::DumpHistoryToDisk()
 	{
 		for (int32 Idx = 0; Idx < CurrentCacheIdx; ++Idx)
 		{
-			fprintf(HistoryFile, "%s %llu %llu %llu %u\t# %llu\n", HistoryCache[Idx].Operation, (uint64)(HistoryCache[Idx].PointerOut), (uint64)(HistoryCache[Idx].PointerIn), (uint64)HistoryCache[Idx].Size, HistoryCache[Idx].Alignment, ++OperationNumber);
+			fprintf(HistoryFile, "%s %llu %llu %llu %u\t# %llu %u\n", HistoryCache[Idx].Operation, (uint64)(HistoryCache[Idx].PointerOut), (uint64)(HistoryCache[Idx].PointerIn), (uint64)HistoryCache[Idx].Size, HistoryCache[Idx].Alignment, ++OperationNumber, HistoryCache[Idx].ThreadId);
 		}
 	}
 
@@ -2,6 +2,7 @@
 
 #include "IO/IoDispatcher.h"
 #include "IO/IoDispatcherPrivate.h"
+#include "IO/IoReadOrderRecording.h"
 #include "IO/IoStore.h"
 #include "Misc/ScopeRWLock.h"
 #include "Misc/CommandLine.h"
@@ -338,6 +339,7 @@ public:
 			return;
 		}
 		bIsInitialized = true;
+		ReadOrderRecorder = FIoReadOrderRecorder::CreateFromCommandLine();
 		if (!Backends.IsEmpty())
 		{
 			for (const TSharedRef<IIoDispatcherBackend>& Backend : Backends)
@@ -761,6 +763,10 @@ private:
 					Request->ReleaseRef();
 					continue;
 				}
+				if (ReadOrderRecorder)
+				{
+					ReadOrderRecorder->Record(Request->ChunkId, Request->Options);
+				}
 			}
 			else
 			{
@@ -825,6 +831,7 @@ private:
 	uint64 PendingIoRequestsCount = 0;
 	int64 TotalLoaded = 0;
 	FIoRequestStats RequestStats;
+	TUniquePtr<FIoReadOrderRecorder> ReadOrderRecorder;
 	bool bIsInitialized = false;
 };
 
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IO/IoReadOrderRecording.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace IoReadOrderRecording
+{
+	static constexpr uint32 Magic = 0x4F524F49; // 'IORO'
+	static constexpr uint32 Version = 1;
+	static constexpr int32 EntriesPerFlush = 4096;
+}
+
+bool LoadIoReadOrderRecording(const TCHAR* Filename, TArray<FIoReadOrderRecordEntry>& OutEntries)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(Filename));
+	if (!Ar)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	*Ar << Magic;
+	*Ar << Version;
+	if (Ar->IsError() || Magic != IoReadOrderRecording::Magic || Version != IoReadOrderRecording::Version)
+	{
+		return false;
+	}
+
+	// Entries are appended until the process exits, a truncated last entry is dropped
+	constexpr int64 EntrySize = sizeof(FIoChunkId) + sizeof(uint64) + sizeof(uint64) + sizeof(uint32);
+	OutEntries.Reserve(OutEntries.Num() + int32((Ar->TotalSize() - Ar->Tell()) / EntrySize));
+	while (Ar->TotalSize() - Ar->Tell() >= EntrySize)
+	{
+		*Ar << OutEntries.AddDefaulted_GetRef();
+	}
+	return !Ar->IsError();
+}
+
+TUniquePtr<FIoReadOrderRecorder> FIoReadOrderRecorder::CreateFromCommandLine()
+{
+	FString Filename;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("RecordIoReadOrder="), Filename))
+	{
+		if (!FParse::Param(FCommandLine::Get(), TEXT("RecordIoReadOrder")))
+		{
+			return nullptr;
+		}
+		Filename = FPaths::ProfilingDir() / TEXT("IoReadOrder") / FString::Printf(TEXT("IoReadOrder-%s.uioro"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	}
+
+	TUniquePtr<FArchive> FileArchive(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileArchive)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to create I/O read order recording '%s'"), *Filename);
+		return nullptr;
+	}
+	uint32 Magic = IoReadOrderRecording::Magic;
+	uint32 Version = IoReadOrderRecording::Version;
+	*FileArchive << Magic;
+	*FileArchive << Version;
+
+	UE_LOG(LogIoDispatcher, Display, TEXT("Recording I/O read order to '%s'"), *Filename);
+	return TUniquePtr<FIoReadOrderRecorder>(new FIoReadOrderRecorder(MoveTemp(FileArchive), Filename));
+}
+
+FIoReadOrderRecorder::FIoReadOrderRecorder(TUniquePtr<FArchive>&& InFileArchive, const FString& InFilename)
+	: FileArchive(MoveTemp(InFileArchive))
+	, Filename(InFilename)
+	, StartTime(FPlatformTime::Seconds())
+{
+	PendingEntries.Reserve(IoReadOrderRecording::EntriesPerFlush);
+}
+
+FIoReadOrderRecorder::~FIoReadOrderRecorder()
+{
+	Flush();
+	FileArchive->Close();
+	UE_LOG(LogIoDispatcher, Display, TEXT("Recorded %llu I/O reads to '%s'"), EntryCount, *Filename);
+}
+
+void FIoReadOrderRecorder::Record(const FIoChunkId& ChunkId, const FIoReadOptions& Options)
+{
+	FIoReadOrderRecordEntry& Entry = PendingEntries.AddDefaulted_GetRef();
+	Entry.ChunkId = ChunkId;
+	Entry.Offset = Options.GetOffset();
+	Entry.Size = Options.GetSize();
+	Entry.TimeMs = uint32((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	if (PendingEntries.Num() >= IoReadOrderRecording::EntriesPerFlush)
+	{
+		Flush();
+	}
+}
+
+void FIoReadOrderRecorder::Flush()
+{
+	for (FIoReadOrderRecordEntry& Entry : PendingEntries)
+	{
+		*FileArchive << Entry;
+	}
+	FileArchive->Flush();
+	EntryCount += PendingEntries.Num();
+	PendingEntries.Reset();
+}
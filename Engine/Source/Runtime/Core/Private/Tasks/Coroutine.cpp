@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tasks/Coroutine.h"
+
+#if WITH_CPP_COROUTINES
+
+#include "Containers/LockFreeFixedSizeAllocator.h"
+
+namespace UE { namespace Tasks { namespace Private
+{
+	// coroutine frames are mostly short-lived and often freed on a different thread than the one allocated them, the same as graph events
+	static TLockFreeFixedSizeAllocator_TLSCache<256, PLATFORM_CACHE_LINE_SIZE> CoroutineFrameAllocator256;
+	static TLockFreeFixedSizeAllocator_TLSCache<512, PLATFORM_CACHE_LINE_SIZE> CoroutineFrameAllocator512;
+	static TLockFreeFixedSizeAllocator_TLSCache<1024, PLATFORM_CACHE_LINE_SIZE> CoroutineFrameAllocator1024;
+	static TLockFreeFixedSizeAllocator_TLSCache<2048, PLATFORM_CACHE_LINE_SIZE> CoroutineFrameAllocator2048;
+
+	void* AllocateCoroutineFrame(SIZE_T Size)
+	{
+		if (Size <= 256)
+		{
+			return CoroutineFrameAllocator256.Allocate();
+		}
+		else if (Size <= 512)
+		{
+			return CoroutineFrameAllocator512.Allocate();
+		}
+		else if (Size <= 1024)
+		{
+			return CoroutineFrameAllocator1024.Allocate();
+		}
+		else if (Size <= 2048)
+		{
+			return CoroutineFrameAllocator2048.Allocate();
+		}
+		return FMemory::Malloc(Size);
+	}
+
+	void FreeCoroutineFrame(void* Frame, SIZE_T Size)
+	{
+		if (Size <= 256)
+		{
+			CoroutineFrameAllocator256.Free(Frame);
+		}
+		else if (Size <= 512)
+		{
+			CoroutineFrameAllocator512.Free(Frame);
+		}
+		else if (Size <= 1024)
+		{
+			CoroutineFrameAllocator1024.Free(Frame);
+		}
+		else if (Size <= 2048)
+		{
+			CoroutineFrameAllocator2048.Free(Frame);
+		}
+		else
+		{
+			FMemory::Free(Frame);
+		}
+	}
+}}}
+
+#endif // WITH_CPP_COROUTINES
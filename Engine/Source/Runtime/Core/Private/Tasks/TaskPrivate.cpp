@@ -2,9 +2,135 @@
 
 #include "Tasks/TaskPrivate.h"
 #include "Tasks/Pipe.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
 
 namespace UE { namespace Tasks { namespace Private
 {
+	static bool GTaskPriorityInheritance = true;
+	static FAutoConsoleVariableRef CVarTaskPriorityInheritance(
+		TEXT("Tasks.PriorityInheritance"),
+		GTaskPriorityInheritance,
+		TEXT("If true, tasks inherit the priority of the tasks that depend on them (as prerequisites, in a pipe or by waiting for them), so high priority work doesn't wait behind lower priority tasks.")
+	);
+
+#if UE_TASK_TRACE_ENABLED
+	TRACE_DECLARE_INT_COUNTER(TasksQueueDelayHigh, TEXT("Tasks/QueueDelayMicroseconds/High"));
+	TRACE_DECLARE_INT_COUNTER(TasksQueueDelayNormal, TEXT("Tasks/QueueDelayMicroseconds/Normal"));
+	TRACE_DECLARE_INT_COUNTER(TasksQueueDelayBackgroundHigh, TEXT("Tasks/QueueDelayMicroseconds/BackgroundHigh"));
+	TRACE_DECLARE_INT_COUNTER(TasksQueueDelayBackgroundNormal, TEXT("Tasks/QueueDelayMicroseconds/BackgroundNormal"));
+	TRACE_DECLARE_INT_COUNTER(TasksQueueDelayBackgroundLow, TEXT("Tasks/QueueDelayMicroseconds/BackgroundLow"));
+
+	void FTaskBase::TraceQueueDelay(uint64 QueueDelayCycles) const
+	{
+		const int64 QueueDelayMicroseconds = int64(FPlatformTime::ToSeconds64(QueueDelayCycles) * 1000000.0);
+		switch (LowLevelTask.GetPriority())
+		{
+		case ETaskPriority::High:
+			TRACE_COUNTER_SET(TasksQueueDelayHigh, QueueDelayMicroseconds);
+			break;
+		case ETaskPriority::Normal:
+			TRACE_COUNTER_SET(TasksQueueDelayNormal, QueueDelayMicroseconds);
+			break;
+		case ETaskPriority::BackgroundHigh:
+			TRACE_COUNTER_SET(TasksQueueDelayBackgroundHigh, QueueDelayMicroseconds);
+			break;
+		case ETaskPriority::BackgroundNormal:
+			TRACE_COUNTER_SET(TasksQueueDelayBackgroundNormal, QueueDelayMicroseconds);
+			break;
+		case ETaskPriority::BackgroundLow:
+			TRACE_COUNTER_SET(TasksQueueDelayBackgroundLow, QueueDelayMicroseconds);
+			break;
+		default:
+			break;
+		}
+	}
+#endif
+
+	void FTaskBase::InheritPriority(ETaskPriority Priority, uint32 RecursionDepth)
+	{
+		// the recursion is bounded as in `TryRetractAndExecute`, the rest of a very long chain keeps its own priority
+		if (!GTaskPriorityInheritance || Priority >= ETaskPriority::Count || RecursionDepth == 200 || IsCompleted())
+		{
+			return;
+		}
+
+		ETaskPriority LocalEffectivePriority = EffectivePriority.load(std::memory_order_relaxed);
+		do
+		{
+			if (LocalEffectivePriority <= Priority)
+			{
+				return; // already inherited, and so by its prerequisites
+			}
+		} while (!EffectivePriority.compare_exchange_weak(LocalEffectivePriority, Priority, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+		// a scheduled task waits in the queue of its former priority, see `TrySchedule`
+		if (LowLevelTask.GetPriority() != InlineTaskPriority && bScheduled.load(std::memory_order_seq_cst) && bAvailableForExecution.load(std::memory_order_relaxed))
+		{
+			LaunchPriorityEscalation(Priority);
+		}
+
+		// prerequisites are kept alive by the queue while it's locked, and by these references afterwards
+		TArray<FTaskBase*, TInlineAllocator<16>> LocalPrerequisites;
+		{
+			TScopeLock<FSpinLock> ScopeLock(PrerequisitesLock);
+			Prerequisites.ForEach(
+				[&LocalPrerequisites](FTaskBase* Prerequisite)
+				{
+					Prerequisite->AddRef();
+					LocalPrerequisites.Add(Prerequisite);
+				}
+			);
+		}
+
+		for (FTaskBase* Prerequisite : LocalPrerequisites)
+		{
+			Prerequisite->InheritPriority(Priority, RecursionDepth + 1);
+			Prerequisite->Release();
+		}
+	}
+
+	void FTaskBase::LaunchPriorityEscalation(ETaskPriority Priority)
+	{
+		// a low-level task that tries to execute the task. the task is executed by whichever of the two low-level tasks starts first, 
+		// the other one fails to get execution permission and does nothing
+		struct FEscalation
+		{
+			LowLevelTasks::FTask LowLevelTask;
+			FTaskBase* Task;
+
+			void Destroy()
+			{
+				Task->Release();
+				delete this;
+			}
+		};
+
+		AddRef(); // released by the escalation when it's completed
+		FEscalation* Escalation = new FEscalation;
+		Escalation->Task = this;
+		Escalation->LowLevelTask.Init(TEXT("Task Priority Escalation"), Priority,
+			[Deleter = LowLevelTasks::TDeleter<FEscalation, &FEscalation::Destroy>{ Escalation }]
+			{
+				Deleter.GetValue()->Task->TryExecute();
+			}
+		);
+		verify(LowLevelTasks::TryLaunch(Escalation->LowLevelTask));
+	}
+
+	ETaskPriority FTaskBase::GetWaitingPriority()
+	{
+		if (const LowLevelTasks::FTask* ActiveTask = LowLevelTasks::FTask::GetActiveTask())
+		{
+			return ActiveTask->GetPriority();
+		}
+
+		// named threads drive the frame, anything they wait for is on the critical path
+		const ETaskTag CriticalThreads = ETaskTag::EGameThread | ETaskTag::ESlateThread | ETaskTag::ERenderingThread | ETaskTag::ERhiThread;
+		return EnumHasAnyFlags(FTaskTagScope::GetCurrentTag(), CriticalThreads) ? ETaskPriority::High : ETaskPriority::Normal;
+	}
+
 	FTaskBase* FTaskBase::PushIntoPipe()
 	{
 		return GetPipe()->PushIntoPipe(*this);
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/Benchmark.h"
+
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ParallelForTests
+{
+	// busy works 50 times longer for the second half of the range than for the first, so the second half holds most of the work
+	static void SkewedWork(int32 Index, int32 Num)
+	{
+		const double Seconds = Index < Num / 2 ? 0.000001 : 0.00005;
+		const double EndTime = FPlatformTime::Seconds() + Seconds;
+		while (FPlatformTime::Seconds() < EndTime)
+		{
+			FPlatformProcess::YieldCycles(100);
+		}
+	}
+
+	static bool CheckVisitedOnce(FAutomationTestBase& Test, const TArray<std::atomic<int32>>& Visits, const TCHAR* What)
+	{
+		for (int32 Index = 0; Index < Visits.Num(); Index++)
+		{
+			if (Visits[Index].load(std::memory_order_relaxed) != 1)
+			{
+				Test.AddError(FString::Printf(TEXT("%s: item %d visited %d times"), What, Index, Visits[Index].load(std::memory_order_relaxed)));
+				return false;
+			}
+		}
+		return true;
+	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForWorkStealingTest, "System.Core.Async.ParallelFor.WorkStealing", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FParallelForWorkStealingTest::RunTest(const FString& Parameters)
+	{
+		const EParallelForFlags Flags = EParallelForFlags::WorkStealing;
+
+		for (int32 Num : { 0, 1, 2, 7, 1000, 100000 })
+		{
+			TArray<std::atomic<int32>> Visits;
+			Visits.SetNumZeroed(Num);
+			ParallelFor(Num, [&Visits](int32 Index) { Visits[Index].fetch_add(1, std::memory_order_relaxed); }, Flags);
+			CheckVisitedOnce(*this, Visits, *FString::Printf(TEXT("%d items"), Num));
+		}
+
+		{	// skewed work
+			const int32 Num = 2000;
+			TArray<std::atomic<int32>> Visits;
+			Visits.SetNumZeroed(Num);
+			ParallelFor(Num, [&Visits, Num](int32 Index) { SkewedWork(Index, Num); Visits[Index].fetch_add(1, std::memory_order_relaxed); }, Flags);
+			CheckVisitedOnce(*this, Visits, TEXT("Skewed work"));
+		}
+
+		{	// nested
+			constexpr int32 NumOuter = 64;
+			constexpr int32 NumInner = 1000;
+			TArray<std::atomic<int32>> Visits;
+			Visits.SetNumZeroed(NumOuter * NumInner);
+			ParallelFor(NumOuter, [&Visits, Flags](int32 Outer)
+				{
+					ParallelFor(NumInner, [&Visits, Outer](int32 Inner) { Visits[Outer * NumInner + Inner].fetch_add(1, std::memory_order_relaxed); }, Flags);
+				}, Flags);
+			CheckVisitedOnce(*this, Visits, TEXT("Nested"));
+		}
+
+		{	// contexts, each of them used by a single thread at a time
+			const int32 Num = 100000;
+			TArray<int64> Contexts;
+			ParallelForWithTaskContext(Contexts, Num, [](int64& Sum, int32 Index) { Sum += Index; }, Flags);
+			int64 Total = 0;
+			for (int64 Sum : Contexts)
+			{
+				Total += Sum;
+			}
+			TestEqual(TEXT("Sum of the contexts"), Total, int64(Num) * (Num - 1) / 2);
+		}
+
+		return true;
+	}
+
+	template<EParallelForFlags Flags>
+	void SkewedParallelFor()
+	{
+		const int32 Num = 5000;
+		ParallelFor(Num, [Num](int32 Index) { SkewedWork(Index, Num); }, Flags);
+	}
+
+	template<EParallelForFlags Flags>
+	void NestedParallelFor()
+	{
+		std::atomic<int64> Total{ 0 };
+		ParallelFor(16, [&Total](int32 Outer)
+			{
+				ParallelFor(Outer * 1000, [&Total](int32 Inner) { Total.fetch_add(Inner, std::memory_order_relaxed); }, Flags);
+			}, Flags);
+	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForPerfTest, "System.Core.Async.ParallelFor.PerfTest", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled);
+
+	bool FParallelForPerfTest::RunTest(const FString& Parameters)
+	{
+		UE_BENCHMARK(5, SkewedParallelFor<EParallelForFlags::None>);
+		UE_BENCHMARK(5, SkewedParallelFor<EParallelForFlags::Unbalanced>);
+		UE_BENCHMARK(5, SkewedParallelFor<EParallelForFlags::WorkStealing>);
+
+		UE_BENCHMARK(5, NestedParallelFor<EParallelForFlags::None>);
+		UE_BENCHMARK(5, NestedParallelFor<EParallelForFlags::Unbalanced>);
+		UE_BENCHMARK(5, NestedParallelFor<EParallelForFlags::WorkStealing>);
+
+		return true;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
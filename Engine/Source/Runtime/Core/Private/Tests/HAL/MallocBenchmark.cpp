@@ -0,0 +1,207 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Array.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/UnrealMemory.h"
+#include "Logging/LogMacros.h"
+#include "Math/RandomStream.h"
+#include "Misc/CString.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+DEFINE_LOG_CATEGORY_STATIC(LogMallocBenchmark, Log, All);
+
+namespace MallocBenchmark
+{
+	struct FAllocation
+	{
+		uint8* Ptr = nullptr;
+		SIZE_T Size = 0;
+	};
+
+	struct FWorker
+	{
+		/** Allocations made by other workers that this worker frees, the way a server hands messages and packets between threads */
+		FCriticalSection MailboxLock;
+		TArray<FAllocation> Mailbox;
+
+		TArray<FAllocation> Live;
+		uint64 NumAllocs = 0;
+	};
+
+	/**
+	 * Server-like size distribution: mostly small objects (strings, containers, delegates), some medium buffers (packets,
+	 * property replication) and a few large ones (level streaming, serialization buffers).
+	 */
+	static SIZE_T RandomAllocationSize(FRandomStream& Random)
+	{
+		const float Bucket = Random.GetFraction();
+		if (Bucket < 0.70f)
+		{
+			return Random.RandRange(8, 128);
+		}
+		else if (Bucket < 0.90f)
+		{
+			return Random.RandRange(129, 4096);
+		}
+		else if (Bucket < 0.99f)
+		{
+			return Random.RandRange(4097, 64 * 1024);
+		}
+		return Random.RandRange(64 * 1024 + 1, 1024 * 1024);
+	}
+
+	static FAllocation Allocate(FRandomStream& Random)
+	{
+		FAllocation Allocation;
+		Allocation.Size = RandomAllocationSize(Random);
+		Allocation.Ptr = (uint8*)FMemory::Malloc(Allocation.Size);
+		// Touch every page so the memory is actually committed and counted as used
+		for (SIZE_T Offset = 0; Offset < Allocation.Size; Offset += 4096)
+		{
+			Allocation.Ptr[Offset] = 1;
+		}
+		return Allocation;
+	}
+
+	static void DrainMailbox(FWorker& Worker)
+	{
+		TArray<FAllocation> Mailbox;
+		{
+			FScopeLock Lock(&Worker.MailboxLock);
+			Swap(Mailbox, Worker.Mailbox);
+		}
+		for (const FAllocation& Allocation : Mailbox)
+		{
+			FMemory::Free(Allocation.Ptr);
+		}
+	}
+
+	static uint64 GetUsedPhysical()
+	{
+		return FPlatformMemory::GetStats().UsedPhysical;
+	}
+
+	/**
+	 * Runs a churn of allocations with random sizes and lifetimes on several threads, a part of which are freed by another thread,
+	 * and reports the throughput and the memory used for the live set. Compare allocators by running it in processes started with
+	 * -binnedmalloc2, -binnedmalloc3, -mimalloc, ... and on Linux with -numanode= to see the effect of NUMA locality.
+	 */
+	static void RunMallocBenchmark(const TArray<FString>& Args)
+	{
+		const int32 NumWorkers = FMath::Max(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : FPlatformMisc::NumberOfWorkerThreadsToSpawn(), 1);
+		const int32 NumAllocsPerWorker = FMath::Max(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1000000, 1);
+		const int32 NumLiveSlots = FMath::Max(Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 8192, 1);
+		const int32 NumAllocsPerFrame = 1000;
+		const float CrossThreadFreeFraction = 0.1f;
+
+		UE_LOG(LogMallocBenchmark, Display, TEXT("Running malloc benchmark with %s: %d workers, %d allocations per worker, %d live allocations per worker"),
+			GMalloc->GetDescriptiveName(), NumWorkers, NumAllocsPerWorker, NumLiveSlots);
+
+		GMalloc->Trim(true);
+		const uint64 UsedPhysicalBefore = GetUsedPhysical();
+
+		TArray<FWorker> Workers;
+		Workers.SetNum(NumWorkers);
+		for (FWorker& Worker : Workers)
+		{
+			Worker.Live.SetNum(NumLiveSlots);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(NumWorkers,
+			[&Workers, NumWorkers, NumAllocsPerWorker, NumLiveSlots, NumAllocsPerFrame, CrossThreadFreeFraction](int32 WorkerIndex)
+			{
+				FWorker& Worker = Workers[WorkerIndex];
+				FWorker& NextWorker = Workers[(WorkerIndex + 1) % NumWorkers];
+				FRandomStream Random(WorkerIndex + 1);
+				TArray<FAllocation> Outgoing;
+
+				for (int32 AllocIndex = 0; AllocIndex < NumAllocsPerWorker; ++AllocIndex)
+				{
+					FAllocation& Slot = Worker.Live[Random.RandHelper(NumLiveSlots)];
+					if (Slot.Ptr)
+					{
+						if (NumWorkers > 1 && Random.GetFraction() < CrossThreadFreeFraction)
+						{
+							Outgoing.Add(Slot);
+						}
+						else
+						{
+							FMemory::Free(Slot.Ptr);
+						}
+					}
+					Slot = Allocate(Random);
+					++Worker.NumAllocs;
+
+					if ((AllocIndex + 1) % NumAllocsPerFrame == 0)
+					{
+						if (Outgoing.Num())
+						{
+							FScopeLock Lock(&NextWorker.MailboxLock);
+							NextWorker.Mailbox.Append(Outgoing);
+						}
+						Outgoing.Reset();
+						DrainMailbox(Worker);
+					}
+				}
+
+				if (Outgoing.Num())
+				{
+					FScopeLock Lock(&NextWorker.MailboxLock);
+					NextWorker.Mailbox.Append(Outgoing);
+				}
+			},
+			EParallelForFlags::Unbalanced
+		);
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		uint64 NumAllocs = 0;
+		uint64 LiveBytes = 0;
+		for (FWorker& Worker : Workers)
+		{
+			DrainMailbox(Worker);
+			NumAllocs += Worker.NumAllocs;
+			for (const FAllocation& Allocation : Worker.Live)
+			{
+				LiveBytes += Allocation.Size;
+			}
+		}
+		const uint64 UsedPhysicalLive = GetUsedPhysical();
+
+		for (FWorker& Worker : Workers)
+		{
+			for (const FAllocation& Allocation : Worker.Live)
+			{
+				FMemory::Free(Allocation.Ptr);
+			}
+			Worker.Live.Empty();
+		}
+		GMalloc->Trim(true);
+		const uint64 UsedPhysicalAfter = GetUsedPhysical();
+
+		const double MB = 1024.0 * 1024.0;
+		const int64 LiveOverhead = int64(UsedPhysicalLive) - int64(UsedPhysicalBefore);
+		UE_LOG(LogMallocBenchmark, Display, TEXT("%s: %.2f M allocations/s (%llu allocations and frees in %.3f s)"),
+			GMalloc->GetDescriptiveName(), NumAllocs / ElapsedTime / 1000000.0, NumAllocs, ElapsedTime);
+		UE_LOG(LogMallocBenchmark, Display, TEXT("%s: live set of %.2f MB uses %.2f MB of physical memory (%.2fx), %.2f MB are still in use after freeing it"),
+			GMalloc->GetDescriptiveName(), LiveBytes / MB, LiveOverhead / MB, LiveBytes ? double(LiveOverhead) / LiveBytes : 0.0,
+			(int64(UsedPhysicalAfter) - int64(UsedPhysicalBefore)) / MB);
+	}
+
+	static FAutoConsoleCommand MallocBenchmarkCmd(
+		TEXT("Memory.MallocBenchmark"),
+		TEXT("Measures the throughput and the memory overhead of the allocator under a server-like workload. Usage: Memory.MallocBenchmark [NumWorkers] [NumAllocsPerWorker] [NumLiveAllocsPerWorker]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunMallocBenchmark)
+	);
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
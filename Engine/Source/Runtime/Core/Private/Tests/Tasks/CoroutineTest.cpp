@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Tasks/Coroutine.h"
+#include "IO/IoDispatcherCoroutine.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_CPP_COROUTINES
+
+namespace UE { namespace TasksTests
+{
+	using namespace Tasks;
+
+	TCoroutine<int32> AddAsync(int32 A, int32 B)
+	{
+		TTask<int32> TaskA = Launch(UE_SOURCE_LOCATION, [A] { return A; });
+		TTask<int32> TaskB = Launch(UE_SOURCE_LOCATION, [B] { return B; });
+		int32 Result = co_await TaskA;
+		Result += co_await TaskB;
+		co_return Result;
+	}
+
+	TCoroutine<int32> SumAsync(int32 Num)
+	{
+		int32 Sum = 0;
+		for (int32 Index = 0; Index != Num; ++Index)
+		{
+			Sum += co_await AddAsync(Index, 1);
+		}
+		co_return Sum;
+	}
+
+	FCoroutine WaitForEventAsync(FTaskEvent Event, std::atomic<bool>& bResumed)
+	{
+		co_await Event;
+		bResumed = true;
+	}
+
+	TCoroutine<TArray<uint8>> ReadFileAsync(IAsyncReadFileHandle& FileHandle, int64 Size)
+	{
+		TUniquePtr<IAsyncReadRequest> Request = co_await ReadAsync(FileHandle, 0, Size);
+		TArray<uint8> Data;
+		if (uint8* Results = Request->GetReadResults())
+		{
+			Data.Append(Results, int32(Size));
+			FMemory::Free(Results);
+		}
+		co_return Data;
+	}
+
+	// fails to issue any request, without calling the completion callback
+	class FFailingAsyncReadFileHandle final : public IAsyncReadFileHandle
+	{
+	public:
+		virtual IAsyncReadRequest* SizeRequest(FAsyncFileCallBack* CompleteCallback = nullptr) override
+		{
+			return nullptr;
+		}
+
+		virtual IAsyncReadRequest* ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags = AIOP_Normal, FAsyncFileCallBack* CompleteCallback = nullptr, uint8* UserSuppliedMemory = nullptr) override
+		{
+			return nullptr;
+		}
+	};
+
+	TCoroutine<bool> IsReadIssuedAsync(IAsyncReadFileHandle& FileHandle)
+	{
+		TUniquePtr<IAsyncReadRequest> Request = co_await ReadAsync(FileHandle, 0, 16);
+		co_return Request.IsValid();
+	}
+
+	TCoroutine<EIoErrorCode> ReadChunkAsync(FIoChunkId ChunkId)
+	{
+		TIoStatusOr<FIoBuffer> Result = co_await ReadAsync(ChunkId);
+		co_return Result.Status().GetErrorCode();
+	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTasksCoroutineTest, "System.Core.Tasks.Coroutine", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FTasksCoroutineTest::RunTest(const FString& Parameters)
+	{
+		{	// awaiting tasks and other coroutines
+			TCoroutine<int32> Coroutine = SumAsync(100);
+			check(Coroutine.GetResult() == 100 * 99 / 2 + 100);
+			check(Coroutine.IsCompleted());
+		}
+
+		{	// a coroutine is suspended until the awaited task event is triggered, and can be used as a task prerequisite
+			FTaskEvent Event{ UE_SOURCE_LOCATION };
+			std::atomic<bool> bResumed{ false };
+			FCoroutine Coroutine = WaitForEventAsync(Event, bResumed);
+			FTask Task = Launch(UE_SOURCE_LOCATION, [&bResumed] { check(bResumed); }, Coroutine.GetCompletionEvent());
+			FPlatformProcess::Sleep(0.01f);
+			check(!Coroutine.IsCompleted() && !bResumed);
+			Event.Trigger();
+			Task.Wait();
+			check(Coroutine.IsCompleted() && bResumed);
+		}
+
+		{	// the coroutine frame outlives a released `TCoroutine` until the coroutine returns
+			FTaskEvent Event{ UE_SOURCE_LOCATION };
+			std::atomic<bool> bResumed{ false };
+			WaitForEventAsync(Event, bResumed).Reset();
+			Event.Trigger();
+			while (!bResumed)
+			{
+				FPlatformProcess::Yield();
+			}
+		}
+
+		{	// awaiting an async file read
+			const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("CoroutineTest"));
+			TArray<uint8> FileData;
+			for (int32 Index = 0; Index != 4096; ++Index)
+			{
+				FileData.Add(uint8(Index * 7));
+			}
+			verify(FFileHelper::SaveArrayToFile(FileData, *Filename));
+
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			{
+				TUniquePtr<IAsyncReadFileHandle> FileHandle(PlatformFile.OpenAsyncRead(*Filename));
+				check(FileHandle.IsValid());
+				TCoroutine<TArray<uint8>> Coroutine = ReadFileAsync(*FileHandle, FileData.Num());
+				check(Coroutine.GetResult() == FileData);
+			}
+			PlatformFile.DeleteFile(*Filename);
+		}
+
+		{	// the coroutine is resumed with a null request if the read can't be issued
+			FFailingAsyncReadFileHandle FileHandle;
+			TCoroutine<bool> Coroutine = IsReadIssuedAsync(FileHandle);
+			check(Coroutine.IsCompleted());
+			check(!Coroutine.GetResult());
+		}
+
+		if (FIoDispatcher::IsInitialized())
+		{	// awaiting an IoDispatcher read, of a chunk that doesn't exist
+			TCoroutine<EIoErrorCode> Coroutine = ReadChunkAsync(CreateIoChunkId(MAX_uint64, MAX_uint16, EIoChunkType::BulkData));
+			check(Coroutine.GetResult() == EIoErrorCode::NotFound);
+		}
+
+		return true;
+	}
+}}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_CPP_COROUTINES
@@ -843,6 +843,23 @@ namespace UE { namespace TasksTests
 		return WorkerBlockers;
 	}
 
+	// blocks all background workers until given event is triggered. Returns blocking tasks. Foreground workers don't execute background
+	// tasks, so more blockers than background workers are launched and the ones left in the queue keep lower priority background tasks
+	// from being executed until the event is triggered
+	TArray<FTask> BlockBackgroundWorkers(FTaskEvent& ResumeEvent)
+	{
+		const uint32 NumWorkers = LowLevelTasks::FScheduler::Get().GetNumWorkers();
+
+		TArray<FTask> WorkerBlockers;
+		WorkerBlockers.Reserve(NumWorkers);
+		for (uint32 i = 0; i != NumWorkers; ++i)
+		{
+			WorkerBlockers.Add(Launch(UE_SOURCE_LOCATION, [&ResumeEvent] { ResumeEvent.Wait(); }, ETaskPriority::BackgroundHigh));
+		}
+
+		return WorkerBlockers;
+	}
+
 	// two levels of prerequisites and two levels of nested tasks
 	void TwoLevelsDeepRetractionTest()
 	{
@@ -978,6 +995,61 @@ namespace UE { namespace TasksTests
 		}
 	}
 
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTasksPriorityInheritanceTest, "System.Core.Tasks.PriorityInheritance", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FTasksPriorityInheritanceTest::RunTest(const FString& Parameters)
+	{
+		{	// a high priority task inherits its priority to a blocked low priority prerequisite, that is escalated once scheduled
+			FTaskEvent Block{ UE_SOURCE_LOCATION };
+			std::atomic<int32> NumExecuted{ 0 };
+			FTask Prereq = Launch(UE_SOURCE_LOCATION, [&NumExecuted] { NumExecuted.fetch_add(1, std::memory_order_relaxed); }, Block, ETaskPriority::BackgroundLow);
+			FTask Task = Launch(UE_SOURCE_LOCATION, [&NumExecuted] { NumExecuted.fetch_add(1, std::memory_order_relaxed); }, Prereq, ETaskPriority::High);
+			Block.Trigger();
+			Task.Wait();
+			check(Prereq.IsCompleted());
+			check(NumExecuted.load(std::memory_order_relaxed) == 2); // executed only once even if escalated
+		}
+
+		{	// with all background workers blocked, low priority prerequisites of high priority tasks are only executed if they inherit 
+			// the priority, as the foreground workers can execute them then
+			if (LowLevelTasks::FScheduler::Get().GetNumWorkers() == 0)
+			{
+				return true;
+			}
+
+			FTaskEvent ResumeEvent{ UE_SOURCE_LOCATION };
+			TArray<FTask> WorkerBlockers = BlockBackgroundWorkers(ResumeEvent);
+
+			// a scheduled prerequisite, escalated by a substitute task
+			FTask Prereq = Launch(UE_SOURCE_LOCATION, [] {}, ETaskPriority::BackgroundLow);
+			FTask Task = Launch(UE_SOURCE_LOCATION, [] {}, Prereq, ETaskPriority::High);
+
+			// a chain of piped tasks, each one inheriting the priority when it's scheduled
+			FPipe Pipe{ UE_SOURCE_LOCATION };
+			FTask LastPiped;
+			for (int32 Index = 0; Index != 100; ++Index)
+			{
+				LastPiped = Pipe.Launch(UE_SOURCE_LOCATION, [] {}, ETaskPriority::BackgroundLow);
+			}
+			FTask PipeTask = Launch(UE_SOURCE_LOCATION, [] {}, LastPiped, ETaskPriority::High);
+
+			// not waited, as waiting would retract the prerequisites and execute them on this thread
+			UE::FTimeout Timeout{ FTimespan::FromSeconds(5) };
+			while (!(Task.IsCompleted() && PipeTask.IsCompleted()) && !Timeout)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+			check(Prereq.IsCompleted() && Task.IsCompleted());
+			check(LastPiped.IsCompleted() && PipeTask.IsCompleted());
+			check(WorkerBlockers.ContainsByPredicate([](const FTask& Blocker) { return !Blocker.IsCompleted(); }));
+
+			ResumeEvent.Trigger();
+			verify(Wait(WorkerBlockers, FTimespan::FromSeconds(1)));
+		}
+
+		return true;
+	}
+
 	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTasksNestedTasksStressTest, "System.Core.Tasks.NestedTasks.Stress", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
 
 	bool FTasksNestedTasksStressTest::RunTest(const FString& Parameters)
@@ -0,0 +1,381 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Async/AsyncFileHandle.h"
+#include "Async/AsyncWork.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/ScopeLock.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+class FUnixReadRequest;
+class FUnixAsyncReadFileHandle;
+
+/**
+ * Async read support for FUnixPlatformFile.
+ *
+ * Unlike the generic async handle, which opens (or serializes on a cached) IFileHandle and seeks+reads for each request,
+ * requests share a single file descriptor and read with pread, so any number of them can be in flight on GIOThreadPool at once.
+ * The kernel is also told about each read as soon as it is issued (posix_fadvise WILLNEED), so readahead starts before a pool thread picks it up.
+ * The descriptor is only open while requests are in flight, so idle handles don't count against the process' file descriptor limit.
+ */
+class FUnixReadRequestWorker : public FNonAbandonableTask
+{
+	FUnixReadRequest& ReadRequest;
+public:
+	FUnixReadRequestWorker(FUnixReadRequest* InReadRequest)
+		: ReadRequest(*InReadRequest)
+	{
+	}
+	void DoWork();
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FUnixReadRequestWorker, STATGROUP_ThreadPoolAsyncTasks);
+	}
+};
+
+class FUnixReadRequest : public IAsyncReadRequest
+{
+	FAsyncTask<FUnixReadRequestWorker>* Task;
+	FUnixAsyncReadFileHandle* Owner;
+	/** The owner's descriptor, acquired for the duration of the read, or -1 */
+	int32 FileHandle;
+	int64 Offset;
+	int64 BytesToRead;
+	EAsyncIOPriorityAndFlags PriorityAndFlags;
+public:
+	FUnixReadRequest(FUnixAsyncReadFileHandle* InOwner, FAsyncFileCallBack* CompleteCallback, uint8* InUserSuppliedMemory, int64 InOffset, int64 InBytesToRead, EAsyncIOPriorityAndFlags InPriorityAndFlags);
+	virtual ~FUnixReadRequest();
+
+	bool CheckForPrecache();
+	void PerformRequest();
+	void ReleaseFileHandle();
+
+	uint8* GetContainedSubblock(uint8* UserSuppliedMemory, int64 InOffset, int64 InBytesToRead)
+	{
+		if (InOffset >= Offset && InOffset + InBytesToRead <= Offset + BytesToRead &&
+			this->PollCompletion() && Memory)
+		{
+			check(Memory);
+			if (!UserSuppliedMemory)
+			{
+				UserSuppliedMemory = (uint8*)FMemory::Malloc(InBytesToRead);
+				INC_MEMORY_STAT_BY(STAT_AsyncFileMemory, InBytesToRead);
+			}
+			FMemory::Memcpy(UserSuppliedMemory, Memory + InOffset - Offset, InBytesToRead);
+			return UserSuppliedMemory;
+		}
+		return nullptr;
+	}
+
+	void Start()
+	{
+		if (FPlatformProcess::SupportsMultithreading())
+		{
+			Task->StartBackgroundTask(GIOThreadPool);
+		}
+		else
+		{
+			Task->StartSynchronousTask();
+			WaitCompletionImpl(0.0f); // might as well finish it now
+		}
+	}
+
+	virtual void WaitCompletionImpl(float TimeLimitSeconds) override
+	{
+		if (Task)
+		{
+			bool bResult;
+			if (TimeLimitSeconds <= 0.0f)
+			{
+				Task->EnsureCompletion();
+				bResult = true;
+			}
+			else
+			{
+				bResult = Task->WaitCompletionWithTimeout(TimeLimitSeconds);
+			}
+			if (bResult)
+			{
+				check(bCompleteAndCallbackCalled);
+				delete Task;
+				Task = nullptr;
+			}
+		}
+	}
+
+	virtual void CancelImpl() override
+	{
+		if (Task)
+		{
+			if (Task->Cancel())
+			{
+				delete Task;
+				Task = nullptr;
+				ReleaseFileHandle();
+				SetComplete();
+			}
+		}
+	}
+};
+
+void FUnixReadRequestWorker::DoWork()
+{
+	ReadRequest.PerformRequest();
+}
+
+class FUnixSizeRequest : public IAsyncReadRequest
+{
+public:
+	FUnixSizeRequest(FAsyncFileCallBack* CompleteCallback, int64 InFileSize)
+		: IAsyncReadRequest(CompleteCallback, true, nullptr)
+	{
+		Size = InFileSize;
+		SetComplete();
+	}
+
+	virtual void WaitCompletionImpl(float TimeLimitSeconds) override
+	{
+		// Even though SetComplete called in the constructor and sets bCompleteAndCallbackCalled=true, we still need to implement WaitComplete as
+		// the CompleteCallback can end up starting async tasks that can overtake the constructor execution and need to wait for the constructor to finish.
+		while (!*(volatile bool*)&bCompleteAndCallbackCalled);
+	}
+
+	virtual void CancelImpl() override
+	{
+	}
+};
+
+class FUnixAsyncReadFileHandle final : public IAsyncReadFileHandle
+{
+public:
+	/** The size of the file, or -1 if the file does not exist */
+	const int64 FileSize;
+	const FString Filename;
+private:
+	TArray<FUnixReadRequest*> LiveRequests; // linear searches could be improved
+
+	FCriticalSection LiveRequestsCritical;
+
+	/** The descriptor shared by all requests in flight, or -1 if there are none */
+	int32 FileHandle;
+	int32 NumFileHandleUsers;
+
+	FCriticalSection FileHandleCritical;
+public:
+	FUnixAsyncReadFileHandle(int64 InFileSize, const TCHAR* InFilename)
+		: FileSize(InFileSize)
+		, Filename(InFilename)
+		, FileHandle(-1)
+		, NumFileHandleUsers(0)
+	{
+	}
+
+	~FUnixAsyncReadFileHandle()
+	{
+#if DO_CHECK
+		FScopeLock Lock(&LiveRequestsCritical);
+		check(!LiveRequests.Num()); // must delete all requests before you delete the handle
+#endif
+		check(!NumFileHandleUsers && FileHandle == -1);
+	}
+
+	/** Returns the shared descriptor, opening it for the first request in flight, or -1 if the file could not be opened */
+	int32 AcquireFileHandle()
+	{
+		FScopeLock Lock(&FileHandleCritical);
+		if (NumFileHandleUsers == 0)
+		{
+			FileHandle = open(TCHAR_TO_UTF8(*Filename), O_RDONLY | O_CLOEXEC);
+			if (FileHandle == -1)
+			{
+				UE_LOG(LogUnixPlatformFile, Warning, TEXT("Could not open '%s' for async reading: errno=%d"), *Filename, errno);
+				return -1;
+			}
+		}
+		NumFileHandleUsers++;
+		return FileHandle;
+	}
+
+	/** Closes the shared descriptor once the last request in flight is done with it */
+	void ReleaseFileHandle()
+	{
+		FScopeLock Lock(&FileHandleCritical);
+		check(NumFileHandleUsers > 0);
+		if (--NumFileHandleUsers == 0)
+		{
+			close(FileHandle);
+			FileHandle = -1;
+		}
+	}
+
+	void RemoveRequest(FUnixReadRequest* Req)
+	{
+		FScopeLock Lock(&LiveRequestsCritical);
+		verify(LiveRequests.Remove(Req) == 1);
+	}
+
+	uint8* GetPrecachedBlock(uint8* UserSuppliedMemory, int64 InOffset, int64 InBytesToRead)
+	{
+		FScopeLock Lock(&LiveRequestsCritical);
+		uint8* Result = nullptr;
+		for (FUnixReadRequest* Req : LiveRequests)
+		{
+			Result = Req->GetContainedSubblock(UserSuppliedMemory, InOffset, InBytesToRead);
+			if (Result)
+			{
+				break;
+			}
+		}
+		return Result;
+	}
+
+	virtual IAsyncReadRequest* SizeRequest(FAsyncFileCallBack* CompleteCallback = nullptr) override
+	{
+		return new FUnixSizeRequest(CompleteCallback, FileSize);
+	}
+
+	virtual IAsyncReadRequest* ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags = AIOP_Normal, FAsyncFileCallBack* CompleteCallback = nullptr, uint8* UserSuppliedMemory = nullptr) override
+	{
+		FUnixReadRequest* Result = new FUnixReadRequest(this, CompleteCallback, UserSuppliedMemory, Offset, BytesToRead, PriorityAndFlags);
+		if (PriorityAndFlags & AIOP_FLAG_PRECACHE) // only precache requests are tracked for possible reuse
+		{
+			FScopeLock Lock(&LiveRequestsCritical);
+			LiveRequests.Add(Result);
+		}
+		return Result;
+	}
+};
+
+FUnixReadRequest::FUnixReadRequest(FUnixAsyncReadFileHandle* InOwner, FAsyncFileCallBack* CompleteCallback, uint8* InUserSuppliedMemory, int64 InOffset, int64 InBytesToRead, EAsyncIOPriorityAndFlags InPriorityAndFlags)
+	: IAsyncReadRequest(CompleteCallback, false, InUserSuppliedMemory)
+	, Task(nullptr)
+	, Owner(InOwner)
+	, FileHandle(-1)
+	, Offset(InOffset)
+	, BytesToRead(InBytesToRead)
+	, PriorityAndFlags(InPriorityAndFlags)
+{
+	check(Offset >= 0 && BytesToRead > 0);
+	if (Owner->FileSize < 0)
+	{
+		// The file doesn't exist, which is reported as a canceled request like the generic handle does
+		bCanceled = true;
+		SetComplete();
+	}
+	else
+	{
+		if (BytesToRead == MAX_int64)
+		{
+			BytesToRead = Owner->FileSize - Offset;
+			check(BytesToRead > 0);
+		}
+		if (CheckForPrecache())
+		{
+			SetComplete();
+		}
+		else
+		{
+			FileHandle = Owner->AcquireFileHandle();
+			if (FileHandle == -1)
+			{
+				bCanceled = true;
+				SetComplete();
+			}
+			else
+			{
+				// Start kernel readahead now, rather than when a pool thread gets to the request
+				posix_fadvise(FileHandle, Offset, BytesToRead, POSIX_FADV_WILLNEED);
+
+				Task = new FAsyncTask<FUnixReadRequestWorker>(this);
+				Start();
+			}
+		}
+	}
+}
+
+FUnixReadRequest::~FUnixReadRequest()
+{
+	if (Task)
+	{
+		Task->EnsureCompletion(); // if the user polls, then we might never actual sync completion of the task until now, this will almost always be done, however we need to be sure the task is clear
+		delete Task;
+	}
+	if (Memory)
+	{
+		// this can happen with a race on cancel, it is ok, they didn't take the memory, free it now
+		if (!bUserSuppliedMemory)
+		{
+			DEC_MEMORY_STAT_BY(STAT_AsyncFileMemory, BytesToRead);
+			FMemory::Free(Memory);
+		}
+		Memory = nullptr;
+	}
+	if (PriorityAndFlags & AIOP_FLAG_PRECACHE) // only precache requests are tracked for possible reuse
+	{
+		Owner->RemoveRequest(this);
+	}
+	Owner = nullptr;
+}
+
+bool FUnixReadRequest::CheckForPrecache()
+{
+	if ((PriorityAndFlags & AIOP_FLAG_PRECACHE) == 0)  // only non-precache requests check for existing blocks to copy from
+	{
+		check(!Memory || bUserSuppliedMemory);
+		uint8* Result = Owner->GetPrecachedBlock(Memory, Offset, BytesToRead);
+		if (Result)
+		{
+			check(!bUserSuppliedMemory || Memory == Result);
+			Memory = Result;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FUnixReadRequest::PerformRequest()
+{
+	LLM_SCOPE(ELLMTag::FileSystem);
+
+	if (!bCanceled)
+	{
+		if (!bUserSuppliedMemory)
+		{
+			check(!Memory);
+			Memory = (uint8*)FMemory::Malloc(BytesToRead);
+			INC_MEMORY_STAT_BY(STAT_AsyncFileMemory, BytesToRead);
+		}
+		check(Memory);
+
+		int64 TotalBytesRead = 0;
+		while (TotalBytesRead < BytesToRead)
+		{
+			// pread doesn't touch the shared file offset, so requests don't need to be serialized
+			const ssize_t BytesRead = pread(FileHandle, Memory + TotalBytesRead, BytesToRead - TotalBytesRead, Offset + TotalBytesRead);
+			if (BytesRead > 0)
+			{
+				TotalBytesRead += BytesRead;
+			}
+			else if (BytesRead == 0 || errno != EINTR)
+			{
+				const int ErrNo = BytesRead < 0 ? errno : 0;
+				UE_LOG(LogUnixPlatformFile, Error, TEXT("FUnixReadRequest failed reading %lld bytes at offset %lld of '%s' (read %lld, errno=%d)"), BytesToRead, Offset, *Owner->Filename, TotalBytesRead, ErrNo);
+				break;
+			}
+		}
+	}
+	ReleaseFileHandle();
+	SetComplete();
+}
+
+void FUnixReadRequest::ReleaseFileHandle()
+{
+	if (FileHandle != -1)
+	{
+		Owner->ReleaseFileHandle();
+		FileHandle = -1;
+	}
+}
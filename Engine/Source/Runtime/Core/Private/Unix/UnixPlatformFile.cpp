@@ -7,15 +7,42 @@
 #include "Containers/LruCache.h"
 #include "Logging/LogMacros.h"
 #include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/MappedFileHandle.h"
 #include <sys/file.h>
+#include <sys/mman.h>
+#include <atomic>
 
 #include "HAL/PlatformFileCommon.h"
 #include "HAL/PlatformFileManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnixPlatformFile, Log, All);
 
+#include "Unix/UnixAsyncIO.h"
+
 #define UNIX_PLATFORM_FILE_SPEEDUP_FILE_OPERATIONS	((!WITH_EDITOR && !IS_PROGRAM) || !PLATFORM_LINUX) 
 
+static int32 GUnixNativeAsyncReadHandles = 1;
+static FAutoConsoleVariableRef CVarUnixNativeAsyncReadHandles(
+	TEXT("AsyncReadFile.UnixNativeHandles"),
+	GUnixNativeAsyncReadHandles,
+	TEXT("Control how async read handles are implemented by the Unix platform file.\n")
+	TEXT("0: Use the generic async read handle, which reads through IFileHandles on the IO thread pool.\n")
+	TEXT("1: Use native async read handles, which share a file descriptor between concurrent pread calls (default).\n"),
+	ECVF_Default
+);
+
+static int32 GUnixMappedFileAdvice = 0;
+static FAutoConsoleVariableRef CVarUnixMappedFileAdvice(
+	TEXT("MappedFile.UnixAdvice"),
+	GUnixMappedFileAdvice,
+	TEXT("The madvise hint given for newly mapped file regions by the Unix platform file, which controls kernel readahead.\n")
+	TEXT("0: Default readahead (default).\n")
+	TEXT("1: Random access, no readahead.\n")
+	TEXT("2: Sequential access, aggressive readahead.\n"),
+	ECVF_Default
+);
+
 // make an FTimeSpan object that represents the "epoch" for time_t (from a stat struct)
 const FDateTime UnixEpoch(1970, 1, 1);
 
@@ -684,6 +711,105 @@ public:
 
 FUnixFileMapper GCaseInsensMapper;
 
+class FMappedFileRegionUnix final : public IMappedFileRegion
+{
+	class FMappedFileHandleUnix* Parent;
+	const uint8* AlignedMappedPtr;
+	size_t AlignedMappedSize;
+public:
+	FMappedFileRegionUnix(const uint8* InMappedPtr, const uint8* InAlignedMappedPtr, size_t InMappedSize, size_t InAlignedMappedSize, const FString& InDebugFilename, size_t InDebugOffsetRelativeToFile, class FMappedFileHandleUnix* InParent)
+		: IMappedFileRegion(InMappedPtr, InMappedSize, InDebugFilename, InDebugOffsetRelativeToFile)
+		, Parent(InParent)
+		, AlignedMappedPtr(InAlignedMappedPtr)
+		, AlignedMappedSize(InAlignedMappedSize)
+	{
+	}
+
+	~FMappedFileRegionUnix();
+
+	virtual void PreloadHint(int64 PreloadOffset = 0, int64 BytesToPreload = MAX_int64) override
+	{
+		const int64 MappedSize = GetMappedSize();
+		if (PreloadOffset < 0 || PreloadOffset >= MappedSize)
+		{
+			return;
+		}
+		BytesToPreload = FMath::Min(BytesToPreload, MappedSize - PreloadOffset);
+
+		// Have the kernel start reading the pages in asynchronously, rather than faulting them in one at a time
+		const uint8* PreloadPtr = GetMappedPtr() + PreloadOffset;
+		const uint8* AlignedPreloadPtr = AlignDown(PreloadPtr, FPlatformMemory::GetConstants().PageSize);
+		madvise((void*)AlignedPreloadPtr, BytesToPreload + (PreloadPtr - AlignedPreloadPtr), MADV_WILLNEED);
+	}
+};
+
+class FMappedFileHandleUnix final : public IMappedFileHandle
+{
+	int32 FileHandle;
+	FString DebugFilename;
+	std::atomic<int32> NumOutstandingRegions;
+public:
+	FMappedFileHandleUnix(int32 InFileHandle, int64 Size, const TCHAR* InDebugFilename)
+		: IMappedFileHandle(Size)
+		, FileHandle(InFileHandle)
+		, DebugFilename(InDebugFilename)
+		, NumOutstandingRegions(0)
+	{
+		check(Size >= 0);
+		check(FileHandle != -1);
+	}
+
+	~FMappedFileHandleUnix()
+	{
+		check(!NumOutstandingRegions); // can't delete the file before you delete all outstanding regions
+		close(FileHandle);
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset = 0, int64 BytesToMap = MAX_int64, bool bPreloadHint = false) override
+	{
+		check(Offset < GetFileSize()); // don't map zero bytes and don't map off the end of the file
+		BytesToMap = FMath::Min<int64>(BytesToMap, GetFileSize() - Offset);
+		check(BytesToMap > 0); // don't map zero bytes
+
+		const int64 AlignedOffset = AlignDown(Offset, FPlatformMemory::GetConstants().PageSize);
+		const int64 AlignedSize = BytesToMap + Offset - AlignedOffset;
+
+		void* AlignedMapPtr = mmap(nullptr, AlignedSize, PROT_READ, MAP_PRIVATE, FileHandle, AlignedOffset);
+		if (AlignedMapPtr == MAP_FAILED)
+		{
+			int ErrNo = errno;
+			UE_LOG(LogUnixPlatformFile, Warning, TEXT("mmap('%s', Offset=%lld, Size=%lld) failed: errno=%d (%s)"), *DebugFilename, AlignedOffset, AlignedSize, ErrNo, UTF8_TO_TCHAR(strerror(ErrNo)));
+			return nullptr;
+		}
+
+		if (GUnixMappedFileAdvice == 1 || GUnixMappedFileAdvice == 2)
+		{
+			madvise(AlignedMapPtr, AlignedSize, GUnixMappedFileAdvice == 1 ? MADV_RANDOM : MADV_SEQUENTIAL);
+		}
+
+		const uint8* MapPtr = (const uint8*)AlignedMapPtr + Offset - AlignedOffset;
+		FMappedFileRegionUnix* Result = new FMappedFileRegionUnix(MapPtr, (const uint8*)AlignedMapPtr, BytesToMap, AlignedSize, DebugFilename, Offset, this);
+		NumOutstandingRegions++;
+		if (bPreloadHint)
+		{
+			Result->PreloadHint();
+		}
+		return Result;
+	}
+
+	void UnMap(FMappedFileRegionUnix* Region)
+	{
+		check(NumOutstandingRegions > 0);
+		NumOutstandingRegions--;
+	}
+};
+
+FMappedFileRegionUnix::~FMappedFileRegionUnix()
+{
+	munmap((void*)AlignedMappedPtr, AlignedMappedSize);
+	Parent->UnMap(this);
+}
+
 /**
  * Unix File I/O implementation
 **/
@@ -931,6 +1057,48 @@ IFileHandle* FUnixPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite
 	return GFileRegistry.InitialOpenFile(*NormalizeFilename(Filename, false));
 }
 
+IAsyncReadFileHandle* FUnixPlatformFile::OpenAsyncRead(const TCHAR* Filename)
+{
+	if (!GUnixNativeAsyncReadHandles)
+	{
+		return IPhysicalPlatformFile::OpenAsyncRead(Filename);
+	}
+
+	// The descriptor is only kept open while requests are in flight (see FUnixAsyncReadFileHandle::AcquireFileHandle), this only resolves
+	// the name and size of the file
+	FString MappedToName;
+	const int32 Handle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(Filename, false), MappedToName);
+	int64 Size = -1;
+	if (Handle != -1)
+	{
+		struct stat FileInfo;
+		if (fstat(Handle, &FileInfo) != -1)
+		{
+			Size = FileInfo.st_size;
+		}
+		close(Handle);
+	}
+	return new FUnixAsyncReadFileHandle(Size, Size != -1 ? *MappedToName : Filename);
+}
+
+IMappedFileHandle* FUnixPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	FString MappedToName;
+	int32 Handle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(Filename, false), MappedToName);
+	if (Handle == -1)
+	{
+		return nullptr;
+	}
+
+	struct stat FileInfo;
+	if (fstat(Handle, &FileInfo) == -1 || FileInfo.st_size < 1)
+	{
+		close(Handle);
+		return nullptr;
+	}
+	return new FMappedFileHandleUnix(Handle, FileInfo.st_size, *MappedToName);
+}
+
 IFileHandle* FUnixPlatformFile::OpenWrite(const TCHAR* Filename, bool bAppend, bool bAllowRead)
 {
 	int Flags = O_CREAT | O_CLOEXEC;	// prevent children from inheriting this
@@ -19,6 +19,7 @@
 #include "HAL/MallocJemalloc.h"
 #include "HAL/MallocBinned.h"
 #include "HAL/MallocBinned2.h"
+#include "HAL/MallocBinned3.h"
 #include "HAL/MallocReplayProxy.h"
 #include "HAL/MallocStomp.h"
 #include "HAL/PlatformMallocCrash.h"
@@ -30,6 +31,8 @@
 #endif
 #include <sys/file.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sched.h>
 
 #include "GenericPlatform/OSAllocationPool.h"
 #include "Misc/ScopeLock.h"
@@ -51,6 +54,11 @@
 // Set rather to use BinnedMalloc2 for binned malloc, can be overridden below
 #define USE_MALLOC_BINNED2 (1)
 
+// Set to use BinnedMalloc3 by default on 64 bit, can be overridden on the command line with -binnedmalloc3
+#ifndef USE_MALLOC_BINNED3
+	#define USE_MALLOC_BINNED3 (0)
+#endif
+
 // Used in UnixPlatformStackwalk to skip the crash handling callstack frames.
 bool CORE_API GFullCrashCallstack = false;
 
@@ -89,6 +97,75 @@ namespace
 	// The max allowed to be set for the caching
 	const int32 MaximumAllowedMaxNumFileMappingCache = 1000000;
 	bool GEnableProtectForkedPages = false;
+
+	// NUMA node requested with -numanode=, and whether the process could be bound to it
+	int32 GNumaNode = -1;
+	bool GNumaNodeBound = false;
+
+	/**
+	 * Restricts the process to the CPUs of a NUMA node and makes its memory come from that node. Threads inherit both, so the pools
+	 * of the allocator and the per-thread caches of every thread are backed by node local memory, which avoids cross node traffic
+	 * on multi-socket servers (run one server process per node). Called from BaseAllocator() before main(), so it can't allocate.
+	 */
+	bool BindToNumaNode(int32 Node)
+	{
+#if PLATFORM_LINUX && defined(SYS_set_mempolicy)
+		const int32 MaxNumaNodes = 1024;
+		if (Node < 0 || Node >= MaxNumaNodes)
+		{
+			return false;
+		}
+
+		char CpuListPath[128];
+		snprintf(CpuListPath, sizeof(CpuListPath), "/sys/devices/system/node/node%d/cpulist", Node);
+		FILE* CpuListFile = fopen(CpuListPath, "r");
+		if (CpuListFile == nullptr)
+		{
+			return false;
+		}
+		char CpuList[4096];
+		const bool bReadCpuList = fgets(CpuList, sizeof(CpuList), CpuListFile) != nullptr;
+		fclose(CpuListFile);
+		if (!bReadCpuList)
+		{
+			return false;
+		}
+
+		// The list is made of comma separated ranges, e.g. "0-15,32-47". Nodes without CPUs have an empty list.
+		cpu_set_t CpuSet;
+		CPU_ZERO(&CpuSet);
+		int32 NumCpus = 0;
+		for (const char* Range = CpuList; *Range >= '0' && *Range <= '9';)
+		{
+			char* RangeEnd = nullptr;
+			const long FirstCpu = strtol(Range, &RangeEnd, 10);
+			long LastCpu = FirstCpu;
+			if (*RangeEnd == '-')
+			{
+				LastCpu = strtol(RangeEnd + 1, &RangeEnd, 10);
+			}
+			for (long Cpu = FirstCpu; Cpu <= LastCpu && Cpu < CPU_SETSIZE; ++Cpu)
+			{
+				CPU_SET(Cpu, &CpuSet);
+				++NumCpus;
+			}
+			Range = (*RangeEnd == ',') ? RangeEnd + 1 : RangeEnd;
+		}
+		if (NumCpus == 0 || sched_setaffinity(0, sizeof(CpuSet), &CpuSet) != 0)
+		{
+			return false;
+		}
+
+		// MPOL_PREFERRED rather than MPOL_BIND, so allocations fall back to other nodes rather than failing once the node is full.
+		// The syscall is used directly to avoid a dependency on libnuma.
+		const int MemPolicyPreferred = 1;
+		unsigned long NodeMask[MaxNumaNodes / (8 * sizeof(unsigned long))] = {};
+		NodeMask[Node / (8 * sizeof(unsigned long))] |= 1UL << (Node % (8 * sizeof(unsigned long)));
+		return syscall(SYS_set_mempolicy, MemPolicyPreferred, NodeMask, (unsigned long)(sizeof(NodeMask) * 8 + 1)) == 0;
+#else
+		return false;
+#endif // PLATFORM_LINUX && defined(SYS_set_mempolicy)
+	}
 }
 
 /** Controls growth of pools - see PooledVirtualMemoryAllocator.cpp */
@@ -110,6 +187,17 @@ void FUnixPlatformMemory::Init()
 	UE_LOG(LogInit, Log, TEXT(" - VirtualMemoryAllocator pools will grow at scale %g"), GVMAPoolScale);
 	UE_LOG(LogInit, Log, TEXT(" - MemoryRangeDecommit() will %s"), 
 		GMemoryRangeDecommitIsNoOp ? TEXT("be a no-op (re-run with -vmapoolevict to change)") : TEXT("will evict the memory from RAM (re-run with -novmapoolevict to change)"));
+	if (GNumaNode >= 0)
+	{
+		if (GNumaNodeBound)
+		{
+			UE_LOG(LogInit, Log, TEXT(" - Process is bound to the CPUs and memory of NUMA node %d"), GNumaNode);
+		}
+		else
+		{
+			UE_LOG(LogInit, Warning, TEXT(" - Could not bind the process to NUMA node %d, it will run on all nodes"), GNumaNode);
+		}
+	}
 }
 
 bool FUnixPlatformMemory::HasForkPageProtectorEnabled()
@@ -135,6 +223,13 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 	bool bAddReplayProxy = false;
 #endif // UE_USE_MALLOC_REPLAY_PROXY
 
+#if PLATFORM_64BITS
+	if (USE_MALLOC_BINNED3)
+	{
+		AllocatorToUse = EMemoryAllocatorToUse::Binned3;
+	}
+	else
+#endif
 	if (USE_MALLOC_BINNED2)
 	{
 		AllocatorToUse = EMemoryAllocatorToUse::Binned2;
@@ -199,6 +294,14 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 					break;
 				}
 
+#if PLATFORM_64BITS
+				if (FCStringAnsi::Stricmp(Arg, "-binnedmalloc3") == 0)
+				{
+					AllocatorToUse = EMemoryAllocatorToUse::Binned3;
+					break;
+				}
+#endif
+
 				if (FCStringAnsi::Stricmp(Arg, "-fullcrashcallstack") == 0)
 				{
 					GFullCrashCallstack = true;
@@ -285,12 +388,24 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 				{
 					GEnableProtectForkedPages = true;
 				}
+
+				const char NumaNodeSwitch[] = "-numanode=";
+				if (const char* Cmd = FCStringAnsi::Stristr(Arg, NumaNodeSwitch))
+				{
+					GNumaNode = FCStringAnsi::Atoi(Cmd + sizeof(NumaNodeSwitch) - 1);
+				}
 			}
 			free(Arg);
 			fclose(CmdLineFile);
 		}
 	}
 
+	// Bind before the allocator reserves its pools and before any other thread is started, so everything inherits the node
+	if (GNumaNode >= 0)
+	{
+		GNumaNodeBound = BindToNumaNode(GNumaNode);
+	}
+
 	FMalloc * Allocator = NULL;
 
 	switch (AllocatorToUse)
@@ -321,6 +436,12 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 		Allocator = new FMallocBinned2();
 		break;
 
+#if PLATFORM_64BITS
+	case EMemoryAllocatorToUse::Binned3:
+		Allocator = new FMallocBinned3();
+		break;
+#endif
+
 	default:	// intentional fall-through
 	case EMemoryAllocatorToUse::Binned:
 		Allocator = new FMallocBinned(FPlatformMemory::GetConstants().BinnedPageSize & MAX_uint32, 0x100000000);
@@ -595,9 +716,44 @@ FUnixPlatformMemory::FPlatformVirtualMemoryBlock FUnixPlatformMemory::FPlatformV
 	Result.VMSizeDivVirtualSizeAlignment = InSize / GetVirtualSizeAlignment();
 
 	size_t Alignment = FMath::Max(InAlignment, GetVirtualSizeAlignment());
-	check(Alignment <= GetVirtualSizeAlignment());
+	check(FMath::IsPowerOfTwo(Alignment));
+
+	// Only reserve the address space: the range is inaccessible and not charged against the commit limit until Commit() makes
+	// pages of it accessible. FMallocBinned3 reserves its whole pool range (tens of GB) up front with this.
+	const int ReserveProtection = PROT_NONE;
+	const int ReserveFlags = MAP_PRIVATE | MAP_ANON | MAP_NORESERVE;
+
+	if (Alignment > GetVirtualSizeAlignment())
+	{
+		// mmap() only aligns to the page size (FMallocBinned3 asks for more for its large allocations), so reserve enough
+		// to carve out an aligned range and unmap the excess on both sides, leaving a single mapping of the requested size
+		const size_t ReserveSize = Result.GetActualSize() + Alignment - GetVirtualSizeAlignment();
+		void* ReservedPtr = mmap(nullptr, ReserveSize, ReserveProtection, ReserveFlags, -1, 0);
+		if (LIKELY(ReservedPtr != MAP_FAILED))
+		{
+			uint8* AlignedPtr = Align((uint8*)ReservedPtr, Alignment);
+			const size_t HeadSize = AlignedPtr - (uint8*)ReservedPtr;
+			const size_t TailSize = ReserveSize - HeadSize - Result.GetActualSize();
+			if (HeadSize > 0)
+			{
+				munmap(ReservedPtr, HeadSize);
+			}
+			if (TailSize > 0)
+			{
+				munmap(AlignedPtr + Result.GetActualSize(), TailSize);
+			}
+			Result.Ptr = AlignedPtr;
+		}
+		else
+		{
+			Result.Ptr = MAP_FAILED;
+		}
+	}
+	else
+	{
+		Result.Ptr = mmap(nullptr, Result.GetActualSize(), ReserveProtection, ReserveFlags, -1, 0);
+	}
 
-	Result.Ptr = mmap(nullptr, Result.GetActualSize(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
 	if (LIKELY(Result.Ptr != MAP_FAILED))
 	{
 		MarkMappedMemoryMergable(Result.Ptr, Result.GetActualSize());
@@ -637,6 +793,13 @@ void FUnixPlatformMemory::FPlatformVirtualMemoryBlock::Commit(size_t InOffset, s
 {
 	check(IsAligned(InOffset, GetCommitAlignment()) && IsAligned(InSize, GetCommitAlignment()));
 	check(InOffset >= 0 && InSize >= 0 && InOffset + InSize <= GetActualSize() && Ptr);
+
+	// the reservation is PROT_NONE, so make the range accessible; physical pages are only backed on first touch
+	if (UNLIKELY(mprotect(((uint8*)Ptr) + InOffset, InSize, PROT_READ | PROT_WRITE) != 0))
+	{
+		// splitting the mapping can run out of VMAs
+		FPlatformMemory::OnOutOfMemory(InSize, 0);
+	}
 }
 
 void FUnixPlatformMemory::FPlatformVirtualMemoryBlock::Decommit(size_t InOffset, size_t InSize)
@@ -645,7 +808,9 @@ void FUnixPlatformMemory::FPlatformVirtualMemoryBlock::Decommit(size_t InOffset,
 	check(InOffset >= 0 && InSize >= 0 && InOffset + InSize <= GetActualSize() && Ptr);
 	if (!LIKELY(GMemoryRangeDecommitIsNoOp))
 	{
-		if (madvise(((uint8*)Ptr) + InOffset, InSize, MADV_DONTNEED) != 0)
+		// release the physical pages, then return the range to the reserved (inaccessible) state so stray accesses fault
+		if (madvise(((uint8*)Ptr) + InOffset, InSize, MADV_DONTNEED) != 0 ||
+			mprotect(((uint8*)Ptr) + InOffset, InSize, PROT_NONE) != 0)
 		{
 			// we can ran out of VMAs here too!
 			FPlatformMemory::OnOutOfMemory(InSize, 0);
@@ -125,6 +125,7 @@ enum class ELocalQueueType
 	EBackground,
 	EForeground,
 	EBusyWait,
+	ELatencyCritical, //only takes high priority tasks, is not throttled nor counted as an active worker
 };
 
 /********************************************************************************************************************************************
@@ -241,7 +242,7 @@ public:
 		friend class TLocalQueueRegistry;
 
 	public:
-		TLocalQueue(TLocalQueueRegistry& InRegistry, ELocalQueueType QueueType, FSleepEvent* InSleepEvent) : Registry(&InRegistry), SleepEvent(InSleepEvent)
+		TLocalQueue(TLocalQueueRegistry& InRegistry, ELocalQueueType QueueType, FSleepEvent* InSleepEvent) : Registry(&InRegistry), SleepEvent(InSleepEvent), bLatencyCritical(QueueType == ELocalQueueType::ELatencyCritical)
 		{
 			checkSlow(Registry);
 			StealHazard = FStealHazard(Registry->QueueCollection, Registry->HazardsCollection);
@@ -300,7 +301,7 @@ public:
 
 		inline FTask* DequeueLocal(bool GetBackGroundTasks, bool bDisableThrottleStealing)
 		{
-			int32 MaxPriority = GetBackGroundTasks ? int32(ETaskPriority::Count) : int32(ETaskPriority::ForegroundCount);
+			int32 MaxPriority = GetMaxPriority(GetBackGroundTasks);
 			for (int32 PriorityIndex = 0; PriorityIndex < MaxPriority; PriorityIndex++)
 			{
 				FTask* Item;
@@ -314,9 +315,9 @@ public:
 
 		inline FTask* DequeueGlobal(bool GetBackGroundTasks, bool bDisableThrottleStealing)
 		{
-			if (bDisableThrottleStealing || (Registry->NumActiveWorkers[GetBackGroundTasks].load(std::memory_order_relaxed) >= (2 * Registry->NumWorkersLookingForWork[GetBackGroundTasks].load(std::memory_order_relaxed) - 1)) || ((Random.GetUnsignedInt() % 4) == 0))
+			if (bDisableThrottleStealing || bLatencyCritical || (Registry->NumActiveWorkers[GetBackGroundTasks].load(std::memory_order_relaxed) >= (2 * Registry->NumWorkersLookingForWork[GetBackGroundTasks].load(std::memory_order_relaxed) - 1)) || ((Random.GetUnsignedInt() % 4) == 0))
 			{
-				int32 MaxPriority = GetBackGroundTasks ? int32(ETaskPriority::Count) : int32(ETaskPriority::ForegroundCount);
+				int32 MaxPriority = GetMaxPriority(GetBackGroundTasks);
 				for (int32 PriorityIndex = 0; PriorityIndex < MaxPriority; PriorityIndex++)
 				{
 					FTask* Item = Registry->OverflowQueues[PriorityIndex].dequeue(DequeueHazards[PriorityIndex]);
@@ -331,14 +332,14 @@ public:
 
 		inline FTask* DequeueSteal(bool GetBackGroundTasks, bool bDisableThrottleStealing)
 		{
-			if (bDisableThrottleStealing || (Registry->NumActiveWorkers[GetBackGroundTasks].load(std::memory_order_relaxed) >= (2 * Registry->NumWorkersLookingForWork[GetBackGroundTasks].load(std::memory_order_relaxed) - 1)) || ((Random.GetUnsignedInt() % 4) == 0))
+			if (bDisableThrottleStealing || bLatencyCritical || (Registry->NumActiveWorkers[GetBackGroundTasks].load(std::memory_order_relaxed) >= (2 * Registry->NumWorkersLookingForWork[GetBackGroundTasks].load(std::memory_order_relaxed) - 1)) || ((Random.GetUnsignedInt() % 4) == 0))
 			{
 				if (CachedRandomIndex == InvalidIndex)
 				{
 					CachedRandomIndex = Random.GetUnsignedInt();
 				}
 
-				FTask* Result = Registry->StealItem(StealHazard, CachedRandomIndex, CachedPriorityIndex, GetBackGroundTasks);
+				FTask* Result = Registry->StealItem(StealHazard, CachedRandomIndex, CachedPriorityIndex, GetMaxPriority(GetBackGroundTasks));
 				if (Result)
 				{
 					return Result;
@@ -358,6 +359,16 @@ public:
 		}
 
 	private:
+		//latency critical queues only take high priority tasks, so they are never busy with long running ones
+		inline int32 GetMaxPriority(bool GetBackGroundTasks) const
+		{
+			if (bLatencyCritical)
+			{
+				return int32(ETaskPriority::High) + 1;
+			}
+			return GetBackGroundTasks ? int32(ETaskPriority::Count) : int32(ETaskPriority::ForegroundCount);
+		}
+
 		inline void EnqueueAffinity(FTask* Item)
 		{
 			check(SleepEvent != nullptr);
@@ -387,6 +398,7 @@ public:
 		uint32					CachedRandomIndex = InvalidIndex;
 		uint32					CachedPriorityIndex = 0;
 		uint32					AffinityIndex = ~0;
+		bool					bLatencyCritical;
 	};
 
 	TLocalQueueRegistry()
@@ -398,7 +410,7 @@ private:
 	// add a queue to the Registry
 	uint32 AddLocalQueue(FStealHazard& Hazard, TLocalQueue* QueueToAdd, ELocalQueueType QueueType)
 	{
-		if (QueueType != ELocalQueueType::EBusyWait)
+		if (QueueType == ELocalQueueType::EForeground || QueueType == ELocalQueueType::EBackground)
 		{
 			NumActiveWorkers[QueueType == ELocalQueueType::EBackground].fetch_add(1, std::memory_order_relaxed);
 		}
@@ -422,7 +434,7 @@ private:
 	// remove a queue from the Registry
 	void DeleteLocalQueue(FStealHazard& Hazard, TLocalQueue* QueueToRemove, ELocalQueueType QueueType, bool WorkerOwned)
 	{
-		if (QueueType != ELocalQueueType::EBusyWait)
+		if (QueueType == ELocalQueueType::EForeground || QueueType == ELocalQueueType::EBackground)
 		{
 			NumActiveWorkers[QueueType == ELocalQueueType::EBackground].fetch_sub(1, std::memory_order_relaxed);
 		}
@@ -449,11 +461,11 @@ private:
 	}
 
 	// StealItem tries to steal an Item from a Registered LocalQueue
-	FTask* StealItem(FStealHazard& Hazard, uint32& CachedRandomIndex, uint32& CachedPriorityIndex, bool GetBackGroundTasks)
+	FTask* StealItem(FStealHazard& Hazard, uint32& CachedRandomIndex, uint32& CachedPriorityIndex, uint32 MaxPriority)
 	{
 		FLocalQueueCollection* Queues = Hazard.Get();
 		uint32 NumQueues = Queues->LocalQueues.Num();
-		uint32 MaxPriority = GetBackGroundTasks ? int32(ETaskPriority::Count) : int32(ETaskPriority::ForegroundCount);
+		CachedPriorityIndex = CachedPriorityIndex < MaxPriority ? CachedPriorityIndex : 0;
 		CachedRandomIndex = CachedRandomIndex % NumQueues;
 
 		for(uint32 i = 0; i < NumQueues; i++)
@@ -520,6 +532,10 @@ public:
 
 	inline FOutOfWork GetOutOfWorkScope(ELocalQueueType QueueType)
 	{
+		if (QueueType == ELocalQueueType::ELatencyCritical)
+		{
+			return FOutOfWork(NumLatencyCriticalWorkersLookingForWork);
+		}
 		return FOutOfWork(NumWorkersLookingForWork[QueueType == ELocalQueueType::EBackground]);
 	}
 
@@ -541,6 +557,7 @@ private:
 	std::atomic<FLocalQueueCollection*>	QueueCollection;
 	std::atomic_int NumWorkersLookingForWork[2] = { {0}, {0} };
 	std::atomic_int NumActiveWorkers[2] = { {0}, {0} };
+	std::atomic_int NumLatencyCriticalWorkersLookingForWork { 0 };
 };
 
 template<uint32 NumLocalItems>
@@ -98,6 +98,7 @@ namespace LowLevelTasks
 			None,
 			Background,
 			Foreground,
+			LatencyCritical,
 		};
 
 		static thread_local FSchedulerTls* ActiveScheduler;
@@ -120,12 +121,19 @@ namespace LowLevelTasks
 		{
 			return WorkerType == EWorkerType::Background;
 		}
+
+		inline static bool IsLatencyCriticalWorker()
+		{
+			return WorkerType == EWorkerType::LatencyCritical;
+		}
 	};
 
 	class FScheduler final : public FSchedulerTls
 	{
 		UE_NONCOPYABLE(FScheduler);
 		static constexpr uint32 WorkerSpinCycles = 53;
+		// index of the sleeping latency critical workers in SleepEventStack, after the foreground (0) and background (1) ones
+		static constexpr uint32 LatencyCriticalSleepIndex = 2;
 
 		static CORE_API FScheduler Singleton;
 
@@ -145,9 +153,11 @@ namespace LowLevelTasks
 		FORCEINLINE_DEBUGGABLE static FScheduler& Get();
 
 		//start number of workers where 0 is the system default
-		CORE_API void StartWorkers(uint32 NumForegroundWorkers = 0, uint32 NumBackgroundWorkers = 0, FThread::EForkable IsForkable = FThread::NonForkable, EThreadPriority InWorkerPriority = EThreadPriority::TPri_Normal, EThreadPriority InBackgroundPriority = EThreadPriority::TPri_BelowNormal, uint64 InWorkerAffinity = 0, uint64 InBackgroundAffinity = 0);
+		//latency critical workers only execute high priority tasks, so those don't wait for the foreground workers to finish long tasks.
+		//they are not counted in GetNumWorkers as they don't take part in the bulk of the work.
+		CORE_API void StartWorkers(uint32 NumForegroundWorkers = 0, uint32 NumBackgroundWorkers = 0, FThread::EForkable IsForkable = FThread::NonForkable, EThreadPriority InWorkerPriority = EThreadPriority::TPri_Normal, EThreadPriority InBackgroundPriority = EThreadPriority::TPri_BelowNormal, uint64 InWorkerAffinity = 0, uint64 InBackgroundAffinity = 0, uint32 NumLatencyCriticalWorkers = 0, EThreadPriority InLatencyCriticalPriority = EThreadPriority::TPri_Normal);
 		CORE_API void StopWorkers(bool DrainGlobalQueue = true);
-		CORE_API void RestartWorkers(uint32 NumForegroundWorkers = 0, uint32 NumBackgroundWorkers = 0, FThread::EForkable IsForkable = FThread::NonForkable, EThreadPriority WorkerPriority = EThreadPriority::TPri_Normal, EThreadPriority BackgroundPriority = EThreadPriority::TPri_BelowNormal, uint64 InWorkerAffinity = 0, uint64 InBackgroundAffinity = 0);
+		CORE_API void RestartWorkers(uint32 NumForegroundWorkers = 0, uint32 NumBackgroundWorkers = 0, FThread::EForkable IsForkable = FThread::NonForkable, EThreadPriority WorkerPriority = EThreadPriority::TPri_Normal, EThreadPriority BackgroundPriority = EThreadPriority::TPri_BelowNormal, uint64 InWorkerAffinity = 0, uint64 InBackgroundAffinity = 0, uint32 NumLatencyCriticalWorkers = 0, EThreadPriority InLatencyCriticalPriority = EThreadPriority::TPri_Normal);
 
 		//try to launch the task, the return value will specify if the task was in the ready state and has been launhced
 		inline bool TryLaunch(FTask& Task, EQueuePreference QueuePreference = EQueuePreference::DefaultPreference, bool bWakeUpWorker = true);	
@@ -179,12 +189,13 @@ namespace LowLevelTasks
 		~FScheduler();
 
 	private: 
-		TUniquePtr<FThread> CreateWorker(bool bPermitBackgroundWork = false, FThread::EForkable IsForkable = FThread::NonForkable, FSleepEvent* ExternalWorkerEvent = nullptr, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue = nullptr, EThreadPriority Priority = EThreadPriority::TPri_Normal, uint64 InAffinity = 0);
-		void WorkerMain(struct FSleepEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork);
+		TUniquePtr<FThread> CreateWorker(bool bPermitBackgroundWork = false, FThread::EForkable IsForkable = FThread::NonForkable, FSleepEvent* ExternalWorkerEvent = nullptr, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue = nullptr, EThreadPriority Priority = EThreadPriority::TPri_Normal, uint64 InAffinity = 0, bool bLatencyCritical = false);
+		void WorkerMain(struct FSleepEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork, bool bLatencyCritical);
 		CORE_API void LaunchInternal(FTask& Task, EQueuePreference QueuePreference, bool bWakeUpWorker);
 		CORE_API void BusyWaitInternal(const FConditional& Conditional, bool ForceAllowBackgroundWork);
-		FORCENOINLINE bool TrySleeping(FSleepEvent* WorkerEvent, bool bStopOutOfWorkScope, bool Drowsing, bool bBackgroundWorker);
+		FORCENOINLINE bool TrySleeping(FSleepEvent* WorkerEvent, bool bStopOutOfWorkScope, bool Drowsing, uint32 SleepIndex);
 		inline bool WakeUpWorker(bool bBackgroundWorker);
+		inline bool WakeUpWorkerFrom(uint32 SleepIndex);
 
 		template<FTask* (FSchedulerTls::FLocalQueueType::*DequeueFunction)(bool, bool), bool bIsBusyWaiting>
 		bool TryExecuteTaskFrom(FSchedulerTls::FLocalQueueType* Queue, FSchedulerTls::FQueueRegistry::FOutOfWork& OutOfWork, bool bPermitBackgroundWork, bool bDisableThrottleStealing);
@@ -192,7 +203,7 @@ namespace LowLevelTasks
 	private:
 		template<typename ElementType>
 		using TAlignedArray = TArray<ElementType, TAlignedHeapAllocator<alignof(ElementType)>>;
-		TEventStack<FSleepEvent> 						SleepEventStack[2];
+		TEventStack<FSleepEvent> 						SleepEventStack[3];
 		FSchedulerTls::FQueueRegistry 					QueueRegistry;
 		FCriticalSection 								WorkerThreadsCS;
 		TArray<TUniquePtr<FThread>>						WorkerThreads;
@@ -204,6 +215,7 @@ namespace LowLevelTasks
 		uint64											BackgroundAffinity = 0;
 		EThreadPriority									WorkerPriority = EThreadPriority::TPri_Normal;
 		EThreadPriority									BackgroundPriority = EThreadPriority::TPri_BelowNormal;
+		EThreadPriority									LatencyCriticalPriority = EThreadPriority::TPri_Normal;
 		std::atomic_bool								TemporaryShutdown{ false };
 	};
 
@@ -307,7 +319,7 @@ namespace LowLevelTasks
 		}
 	}
 
-	inline bool FScheduler::TrySleeping(FSleepEvent* WorkerEvent, bool bStopOutOfWorkScope, bool bDrowsing, bool bBackgroundWorker)
+	inline bool FScheduler::TrySleeping(FSleepEvent* WorkerEvent, bool bStopOutOfWorkScope, bool bDrowsing, uint32 SleepIndex)
 	{
 		ESleepState DrowsingState1 = ESleepState::Drowsing;
 		ESleepState DrowsingState2 = ESleepState::Drowsing;
@@ -332,7 +344,7 @@ namespace LowLevelTasks
 		else if(WorkerEvent->SleepState.compare_exchange_strong(RunningState, ESleepState::Drowsing, std::memory_order_release))
 		{
 			bDrowsing = true;
-			SleepEventStack[bBackgroundWorker].Push(WorkerEvent); // State one: (Running -> Drowsing)
+			SleepEventStack[SleepIndex].Push(WorkerEvent); // State one: (Running -> Drowsing)
 		}
 		else
 		{
@@ -344,7 +356,12 @@ namespace LowLevelTasks
 
 	inline bool FScheduler::WakeUpWorker(bool bBackgroundWorker)
 	{
-		while (FSleepEvent* WorkerEvent = SleepEventStack[bBackgroundWorker].Pop())
+		return WakeUpWorkerFrom(bBackgroundWorker ? 1 : 0);
+	}
+
+	inline bool FScheduler::WakeUpWorkerFrom(uint32 SleepIndex)
+	{
+		while (FSleepEvent* WorkerEvent = SleepEventStack[SleepIndex].Pop())
 		{
 			ESleepState SleepState = WorkerEvent->SleepState.exchange(ESleepState::Running, std::memory_order_acquire);
 			if (SleepState == ESleepState::Sleeping)
@@ -259,6 +259,10 @@ namespace LowLevelTasks
 		template<typename TRunnable>
 		inline void Init(const TCHAR* InDebugName, TRunnable&& InRunnable, bool bAllowBusyWaiting = true);
 
+		//change the priority of a task that was not launched yet, must not be called concurrently with launching the task.
+		//returns false if the task was launched already
+		inline bool TrySetPriority(ETaskPriority InPriority);
+
 		inline const TCHAR* GetDebugName() const;
 		inline ETaskPriority GetPriority() const;
 		inline bool IsBackgroundTask() const;
@@ -300,6 +304,20 @@ namespace LowLevelTasks
 		return PackedData.load(std::memory_order_relaxed).GetPriority(); 
 	}
 
+	inline bool FTask::TrySetPriority(ETaskPriority InPriority)
+	{
+		checkSlow(InPriority < ETaskPriority::Count);
+		FPackedData LocalPackedData = PackedData.load(std::memory_order_relaxed);
+		while (LocalPackedData.GetState() == ETaskState::Ready || LocalPackedData.GetState() == ETaskState::CanceledAndReady)
+		{
+			if (PackedData.compare_exchange_weak(LocalPackedData, FPackedData(LocalPackedData.GetDebugName(), InPriority, LocalPackedData.GetState(), LocalPackedData.AllowBusyWaiting()), std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	inline void FTask::InheritParentData(ETaskPriority& Priority)
 	{
 		const FTask* LocalActiveTask = FTask::GetActiveTask();
@@ -14,6 +14,7 @@
 #include "Templates/SharedPointer.h"
 #include "Templates/RefCounting.h"
 #include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeLock.h"
 #include "Stats/Stats.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "Misc/App.h"
@@ -23,6 +24,8 @@
 #include "Experimental/ConcurrentLinearAllocator.h"
 
 extern CORE_API int32 GParallelForBackgroundYieldingTimeoutMs;
+extern CORE_API int32 GParallelForWorkStealing;
+extern CORE_API int32 GParallelForStealingChunkMicroseconds;
 
 // Flags controlling the ParallelFor's behavior.
 enum class EParallelForFlags
@@ -42,6 +45,10 @@ enum class EParallelForFlags
 
 	// tasks should run on background priority threads
 	BackgroundPriority = 8,
+
+	// Splits the range recursively for idle workers to steal, with a batch size adapting to the cost of the items.
+	// This should be used for tasks with skewed computational time, and for ParallelFors that can be nested.
+	WorkStealing = 16,
 };
 
 ENUM_CLASS_FLAGS(EParallelForFlags)
@@ -297,6 +304,35 @@ namespace ParallelForImpl
 		return ENamedThreads::AnyBackgroundThreadNormalTask;
 	}
 
+	inline LowLevelTasks::ETaskPriority GetTaskPriority(EParallelForFlags Flags)
+	{
+		//Try to inherit the Priority from the caller
+		// Anything scheduled by the task graph is latency sensitive because it might impact the frame rate. Anything else is not (i.e. Worker / Background threads).
+		const ETaskTag LatencySensitiveTasks = 
+			ETaskTag::EStaticInit | 
+			ETaskTag::EGameThread | 
+			ETaskTag::ESlateThread | 
+#if !UE_AUDIO_THREAD_AS_PIPE
+			ETaskTag::EAudioThread | 
+#endif
+			ETaskTag::ERenderingThread | 
+			ETaskTag::ERhiThread;
+
+		const bool bBackgroundPriority = (Flags & EParallelForFlags::BackgroundPriority) != EParallelForFlags::None;
+		const bool bIsLatencySensitive = (FTaskTagScope::GetCurrentTag() & LatencySensitiveTasks) != ETaskTag::ENone;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Inherit;
+		if (bIsLatencySensitive && !bBackgroundPriority)
+		{
+			Priority =  LowLevelTasks::ETaskPriority::High;
+		}
+		else if (bBackgroundPriority)
+		{
+			Priority = LowLevelTasks::ETaskPriority::BackgroundNormal;
+		}
+		return Priority;
+	}
+
 	inline int32 GetNumberOfThreadTasks(int32 Num, EParallelForFlags Flags)
 	{
 		int32 NumThreadTasks = 0;
@@ -436,30 +472,7 @@ namespace ParallelForImpl
 		NumWorkers--; //Decrement one because this function will work on it locally
 		checkSlow(BatchSize * NumBatches >= Num);
 
-		//Try to inherit the Priority from the caller
-		// Anything scheduled by the task graph is latency sensitive because it might impact the frame rate. Anything else is not (i.e. Worker / Background threads).
-		const ETaskTag LatencySensitiveTasks = 
-			ETaskTag::EStaticInit | 
-			ETaskTag::EGameThread | 
-			ETaskTag::ESlateThread | 
-#if !UE_AUDIO_THREAD_AS_PIPE
-			ETaskTag::EAudioThread | 
-#endif
-			ETaskTag::ERenderingThread | 
-			ETaskTag::ERhiThread;
-
-		const bool bBackgroundPriority = (Flags & EParallelForFlags::BackgroundPriority) != EParallelForFlags::None;
-		const bool bIsLatencySensitive = (FTaskTagScope::GetCurrentTag() & LatencySensitiveTasks) != ETaskTag::ENone;
-
-		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Inherit;
-		if (bIsLatencySensitive && !bBackgroundPriority)
-		{
-			Priority =  LowLevelTasks::ETaskPriority::High;
-		}
-		else if (bBackgroundPriority)
-		{
-			Priority = LowLevelTasks::ETaskPriority::BackgroundNormal;
-		}
+		const LowLevelTasks::ETaskPriority Priority = GetTaskPriority(Flags);
 		
 		//shared data between tasks
 		struct alignas(PLATFORM_CACHE_LINE_SIZE) FParallelForData : public TConcurrentLinearObject<FParallelForData, FTaskGraphBlockAllocationTag>, public FThreadSafeRefCountedObject
@@ -643,12 +656,297 @@ namespace ParallelForImpl
 		checkSlow(LocalExecutor.GetData()->BatchItem.load(std::memory_order_relaxed) * LocalExecutor.GetData()->BatchSize >= LocalExecutor.GetData()->Num);
 	}
 
+	/** 
+		*	Work stealing parallel for that uses the low level tasks scheduler, see EParallelForFlags::WorkStealing
+		*	The range starts split in one piece per worker. Each executor runs its piece in batches and, as long as no split piece is
+		*	waiting to be picked up, splits the rest of its piece in two between batches, so workers that run out of work find some to
+		*	steal until the end. Split pieces are launched to the local queue of the worker, which other workers only steal from when
+		*	idle, and which the worker runs itself otherwise. The batch size of each executor adapts to the cost of its items so that
+		*	it checks for splitting about every GParallelForStealingChunkMicroseconds.
+		*	Nested calls (from workers or from busy-waiting threads) don't split up front and wait by executing other tasks rather than
+		*	blocking, so they don't take workers away from the outer work nor need additional threads. Other callers block on an event
+		*	once they run out of items, leaving the rest of the work to the workers.
+		*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+		*	@param Body; Function to call from multiple threads
+		*	@param CurrentThreadWorkToDoBeforeHelping; The work is performed on the main thread before it starts helping with the ParallelFor proper
+		*	@param Flags; Used to customize the behavior of the ParallelFor if needed.
+		*   @param Contexts; Optional per thread contexts to accumulate data concurrently.
+	**/
+	template<typename BodyType, typename PreWorkType, typename ContextType>
+	inline void StealingParallelForInternal(int32 Num, BodyType Body, PreWorkType CurrentThreadWorkToDoBeforeHelping, EParallelForFlags Flags, const TArrayView<ContextType>& Contexts)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+		check(Num >= 0);
+
+		//single threaded mode
+		const bool bIsMultithread = FApp::ShouldUseThreadingForPerformance() || FForkProcessHelper::IsForkedMultithreadInstance();
+		if ((Num <= 1) || ((Flags & EParallelForFlags::ForceSingleThread) == EParallelForFlags::ForceSingleThread) || !bIsMultithread)
+		{
+			// do the prework
+			CurrentThreadWorkToDoBeforeHelping();
+			// no threads, just do it and return
+			for(int32 Index = 0; Index < Num; Index++)
+			{
+				CallBody(Body, Contexts, 0, Index);
+			}
+			return;
+		}
+
+		//an executor per worker at most, each of them owning a task and a context
+		LowLevelTasks::FScheduler& Scheduler = LowLevelTasks::FScheduler::Get();
+		const bool bIsNested = Scheduler.IsWorkerThread() || LowLevelTasks::FScheduler::IsBusyWaiting();
+		int32 MaxExecutors = int32(Scheduler.GetNumWorkers());
+		if (!Scheduler.IsWorkerThread())
+		{
+			MaxExecutors++; //named threads help with the work
+		}
+		if (Contexts.Num() > 0)
+		{
+			MaxExecutors = FMath::Min(MaxExecutors, Contexts.Num());
+		}
+		MaxExecutors = FMath::Clamp(MaxExecutors, 1, Num);
+
+		const bool bPumpRenderingThread = (Flags & EParallelForFlags::PumpRenderingThread) != EParallelForFlags::None && IsInActualRenderingThread();
+		const LowLevelTasks::ETaskPriority Priority = GetTaskPriority(Flags);
+		const uint64 ChunkCycles = FMath::Max<uint64>(uint64(FMath::Max(GParallelForStealingChunkMicroseconds, 1) * 1e-6 / FPlatformTime::GetSecondsPerCycle64()), 1);
+
+		//shared data between executors
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FStealingData : public TConcurrentLinearObject<FStealingData, FTaskGraphBlockAllocationTag>, public FThreadSafeRefCountedObject
+		{
+			FStealingData(int32 InNum, int32 InMaxExecutors, const TArrayView<ContextType>& InContexts, const BodyType& InBody, FEventRef& InFinishedSignal, bool bInTriggerFinishedSignal, LowLevelTasks::ETaskPriority InPriority, uint64 InChunkCycles)
+				: Num(InNum)
+				, Contexts(InContexts)
+				, Body(InBody)
+				, FinishedSignal(InFinishedSignal)
+				, bTriggerFinishedSignal(bInTriggerFinishedSignal)
+				, Priority(InPriority)
+				, ChunkCycles(InChunkCycles)
+			{
+				Tasks.AddDefaulted(InMaxExecutors);
+				//slot 0 is the one of the calling thread
+				FreeSlots.Reserve(InMaxExecutors);
+				for (int32 Slot = InMaxExecutors - 1; Slot > 0; Slot--)
+				{
+					FreeSlots.Add(Slot);
+				}
+			}
+
+			int32 TryReserveSlot()
+			{
+				FScopeLock Lock(&FreeSlotsCS);
+				return FreeSlots.Num() ? FreeSlots.Pop(false) : INDEX_NONE;
+			}
+
+			void ReleaseSlot(int32 Slot)
+			{
+				FScopeLock Lock(&FreeSlotsCS);
+				FreeSlots.Add(Slot);
+			}
+
+			bool IsDone() const
+			{
+				return NumCompletedItems.load(std::memory_order_acquire) == Num;
+			}
+
+			std::atomic_int NumCompletedItems { 0 };
+			// executors launched that didn't start yet, there is no need to split while there are some
+			std::atomic_int NumPendingExecutors { 0 };
+			int32 Num;
+			TArrayView<ContextType> Contexts;
+			const BodyType& Body;
+			FEventRef& FinishedSignal;
+			bool bTriggerFinishedSignal;
+			LowLevelTasks::ETaskPriority Priority;
+			uint64 ChunkCycles;
+			FCriticalSection FreeSlotsCS;
+			TArray<int32, TConcurrentLinearArrayAllocator<FTaskGraphBlockAllocationTag>> FreeSlots;
+			TArray<LowLevelTasks::FTask, TConcurrentLinearArrayAllocator<FTaskGraphBlockAllocationTag>> Tasks;
+		};
+		using FDataHandle = TRefCountPtr<FStealingData>;
+
+		//each executor owns a slot (its task and its context) and a range of the items
+		class FStealingExecutor
+		{
+			FDataHandle Data;
+			int32 Slot;
+			mutable int32 Begin;
+			mutable int32 End;
+			mutable int32 BatchSize;
+			mutable bool bRelaunch = false;
+
+		public:
+			inline FStealingExecutor(FDataHandle&& InData, int32 InSlot, int32 InBegin, int32 InEnd, int32 InBatchSize)
+				: Data(MoveTemp(InData))
+				, Slot(InSlot)
+				, Begin(InBegin)
+				, End(InEnd)
+				, BatchSize(InBatchSize)
+			{
+			}
+
+			FStealingExecutor(const FStealingExecutor&) = delete;
+			inline FStealingExecutor(FStealingExecutor&& Other)
+				: Data(MoveTemp(Other.Data))
+				, Slot(Other.Slot)
+				, Begin(Other.Begin)
+				, End(Other.End)
+				, BatchSize(Other.BatchSize)
+				, bRelaunch(Other.bRelaunch)
+			{
+			}
+
+			~FStealingExecutor()
+			{
+				// the task of the slot is completed by now, so it can be reused
+				if (Data.IsValid())
+				{
+					if (bRelaunch)
+					{
+						FStealingExecutor::LaunchTask(MoveTemp(Data), Slot, Begin, End, BatchSize);
+					}
+					else
+					{
+						Data->ReleaseSlot(Slot);
+					}
+				}
+			}
+
+			inline bool operator()(const bool bIsMaster = false) const noexcept
+			{
+				FMemMark Mark(FMemStack::Get());
+				TRACE_CPUPROFILER_EVENT_SCOPE(ParallelFor);
+
+				FStealingData& LocalData = *Data;
+				if (!bIsMaster)
+				{
+					LocalData.NumPendingExecutors.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				const bool bIsBackgroundPriority = !bIsMaster && (LocalData.Priority >= LowLevelTasks::ETaskPriority::BackgroundNormal);
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				const uint64 YieldingCycles = bIsBackgroundPriority ? uint64(FMath::Max(0, GParallelForBackgroundYieldingTimeoutMs) * 1e-3 / FPlatformTime::GetSecondsPerCycle64()) : 0;
+
+				while (Begin < End)
+				{
+					//offer the upper half of the rest to idle workers
+					if (End - Begin > BatchSize && LocalData.NumPendingExecutors.load(std::memory_order_relaxed) == 0)
+					{
+						const int32 SplitSlot = LocalData.TryReserveSlot();
+						if (SplitSlot != INDEX_NONE)
+						{
+							const int32 Middle = Begin + (End - Begin) / 2;
+							FStealingExecutor::LaunchTask(FDataHandle(Data), SplitSlot, Middle, End, BatchSize);
+							End = Middle;
+						}
+					}
+
+					const int32 BatchEnd = Begin + FMath::Min(BatchSize, End - Begin);
+					const uint64 BatchStartCycles = FPlatformTime::Cycles64();
+					for (int32 Index = Begin; Index < BatchEnd; Index++)
+					{
+						CallBody(LocalData.Body, LocalData.Contexts, Slot, Index);
+					}
+					const uint64 BatchEndCycles = FPlatformTime::Cycles64();
+					const int32 NumItems = BatchEnd - Begin;
+					Begin = BatchEnd;
+
+					if (LocalData.NumCompletedItems.fetch_add(NumItems, std::memory_order_acq_rel) + NumItems == LocalData.Num)
+					{
+						if (!bIsMaster && LocalData.bTriggerFinishedSignal)
+						{
+							LocalData.FinishedSignal->Trigger();
+						}
+						return true;
+					}
+
+					//adapt the batch size to the cost of the items
+					const uint64 BatchCycles = BatchEndCycles - BatchStartCycles;
+					if (BatchCycles < LocalData.ChunkCycles / 2 && BatchSize <= MAX_int32 / 2)
+					{
+						BatchSize *= 2;
+					}
+					else if (BatchCycles > LocalData.ChunkCycles * 2 && BatchSize > 1)
+					{
+						BatchSize /= 2;
+					}
+
+					if (bIsBackgroundPriority && Begin < End && BatchEndCycles - StartCycles > YieldingCycles)
+					{
+						//abort and relaunch the rest (in the destructor, once the task of the slot completed) to give higher priority tasks a chance to run
+						bRelaunch = true;
+						return false;
+					}
+				}
+				return false;
+			}
+
+			static void LaunchTask(FDataHandle&& InData, int32 InSlot, int32 InBegin, int32 InEnd, int32 InBatchSize)
+			{
+				InData->NumPendingExecutors.fetch_add(1, std::memory_order_relaxed);
+				LowLevelTasks::FTask& Task = InData->Tasks[InSlot];
+				const LowLevelTasks::ETaskPriority TaskPriority = InData->Priority;
+				Task.Init(TEXT("FStealingExecutor"), TaskPriority, FStealingExecutor(MoveTemp(InData), InSlot, InBegin, InEnd, InBatchSize));
+				verify(LowLevelTasks::TryLaunch(Task, LowLevelTasks::EQueuePreference::LocalQueuePreference));
+			}
+		};
+
+		//launch a piece per worker, nested calls leave it to the splitting
+		FEventRef FinishedSignal { EEventMode::ManualReset };
+		FDataHandle Data = new FStealingData(Num, MaxExecutors, Contexts, Body, FinishedSignal, bPumpRenderingThread || !bIsNested, Priority, ChunkCycles);
+		const int32 NumPieces = bIsNested ? 1 : MaxExecutors;
+		for (int32 Piece = 1; Piece < NumPieces; Piece++)
+		{
+			const int32 PieceBegin = int32(int64(Num) * Piece / NumPieces);
+			const int32 PieceEnd = int32(int64(Num) * (Piece + 1) / NumPieces);
+			FStealingExecutor::LaunchTask(FDataHandle(Data), Data->TryReserveSlot(), PieceBegin, PieceEnd, 1);
+		}
+
+		// do the prework
+		CurrentThreadWorkToDoBeforeHelping();
+
+		//help with the parallel-for to prevent deadlocks
+		bool bFinishedLast = false;
+		{
+			FStealingExecutor LocalExecutor(FDataHandle(Data), 0, 0, int32(int64(Num) / NumPieces), 1);
+			bFinishedLast = LocalExecutor(true);
+		}
+
+		if (!bFinishedLast)
+		{
+			if (bPumpRenderingThread)
+			{
+				while (!FinishedSignal->Wait(1))
+				{
+					FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GetRenderThread_Local());
+				}
+			}
+			else if (bIsNested)
+			{
+				//run other tasks, among which the pieces of this ParallelFor left in the local queue, until all the items are done
+				LowLevelTasks::BusyWaitUntil([&Data]() { return Data->IsDone(); });
+			}
+			else
+			{
+				//the executor completing the last item triggers the signal, FinishedSignal must outlive it
+				FinishedSignal->Wait();
+			}
+		}
+		checkSlow(Data->IsDone());
+	}
+
 	template<typename FunctionType, typename PreWorkType, typename ContextType>
 	inline void ParallelForInternal(int32 Num, FunctionType Body, PreWorkType CurrentThreadWorkToDoBeforeHelping, EParallelForFlags Flags, const TArrayView<ContextType>& Contexts)
 	{
 		if (LowLevelTasks::FScheduler::Get().GetNumWorkers())
 		{
-			NewParallelForInternal<FunctionType, PreWorkType, ContextType>(Num, Body, CurrentThreadWorkToDoBeforeHelping, Flags, Contexts);
+			if (GParallelForWorkStealing || (Flags & EParallelForFlags::WorkStealing) != EParallelForFlags::None)
+			{
+				StealingParallelForInternal<FunctionType, PreWorkType, ContextType>(Num, Body, CurrentThreadWorkToDoBeforeHelping, Flags, Contexts);
+			}
+			else
+			{
+				NewParallelForInternal<FunctionType, PreWorkType, ContextType>(Num, Body, CurrentThreadWorkToDoBeforeHelping, Flags, Contexts);
+			}
 		}
 		else
 		{
@@ -80,6 +80,19 @@ public:
 		return Value;
 	}
 
+	// calls the given functor for every item in the queue, without dequeueing them. Can be called only by the consumer, as items can't be
+	// dequeued concurrently
+	template<typename FunctorType>
+	void ForEach(FunctorType&& Functor)
+	{
+		FNode* Node = Tail.load(std::memory_order_relaxed)->Next.load(std::memory_order_acquire);
+		while (Node != nullptr)
+		{
+			Functor(*(ElementType*)&Node->Value);
+			Node = Node->Next.load(std::memory_order_acquire);
+		}
+	}
+
 private:
 	struct FNode
 	{
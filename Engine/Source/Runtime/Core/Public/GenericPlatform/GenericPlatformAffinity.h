@@ -159,6 +159,12 @@ public:
 	{
 		return TPri_BelowNormal;
 	}
+
+	/** The latency critical workers only execute high priority tasks, above the other workers so they preempt them */
+	static EThreadPriority GetTaskLatencyCriticalThreadPriority()
+	{
+		return TPri_Normal;
+	}
 };
 
 
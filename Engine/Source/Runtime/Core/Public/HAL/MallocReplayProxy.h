@@ -6,6 +6,7 @@
 #include "Misc/AssertionMacros.h"
 #include "HAL/MemoryBase.h"
 #include "HAL/UnrealMemory.h"
+#include "HAL/PlatformTLS.h"
 #include "Misc/ScopeLock.h"
 
 #if !defined(UE_USE_MALLOC_REPLAY_PROXY)
@@ -45,6 +46,8 @@ private:
 		SIZE_T			Size;
 		/** Alignment as passed in - only valid for malloc/realloc. */
 		uint32			Alignment;
+		/** Thread that did the operation, so it can be replayed on as many threads. */
+		uint32			ThreadId;
 	};
 
 	/** Size of history not yet dumped to disk */
@@ -65,6 +68,7 @@ private:
 	/** Adds operation to history*/
 	void AddToHistory(const char *Op, void * PtrOut, void * PtrIn, SIZE_T Size, SIZE_T Alignment)
 	{
+		const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
 		FScopeLock Lock(&HistoryLock);
 
 		HistoryCache[CurrentCacheIdx].Operation = Op;
@@ -72,6 +76,7 @@ private:
 		HistoryCache[CurrentCacheIdx].PointerIn = PtrIn;
 		HistoryCache[CurrentCacheIdx].Size = Size;
 		HistoryCache[CurrentCacheIdx].Alignment = Alignment;
+		HistoryCache[CurrentCacheIdx].ThreadId = ThreadId;
 
 		++CurrentCacheIdx;
 		if (CurrentCacheIdx > HistoryCacheSize - 1)
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+#if WITH_CPP_COROUTINES
+
+#include "Tasks/Coroutine.h"
+#include "IO/IoDispatcher.h"
+
+namespace UE { namespace Tasks
+{
+	namespace Private
+	{
+		// issues an IoDispatcher read and suspends the coroutine until it's completed
+		class FIoReadAwaiter
+		{
+		public:
+			FIoReadAwaiter(const FIoChunkId& InChunkId, const FIoReadOptions& InOptions, int32 InPriority)
+				: ChunkId(InChunkId)
+				, Options(InOptions)
+				, Priority(InPriority)
+			{
+			}
+
+			bool await_ready() const
+			{
+				return false;
+			}
+
+			void await_suspend(CoroutineStd::coroutine_handle<> Continuation)
+			{
+				// the callback is called on the IoDispatcher thread, nothing of the awaiter is used after issuing the batch as the coroutine
+				// can be already resumed by then
+				FIoBatch Batch = FIoDispatcher::Get().NewBatch();
+				Batch.ReadWithCallback(ChunkId, Options, Priority,
+					[this, Continuation, ContinuationPriority = FTaskBase::GetWaitingPriority()](TIoStatusOr<FIoBuffer> InResult)
+					{
+						Result = MoveTemp(InResult);
+						ResumeCoroutine(Continuation, ContinuationPriority);
+					}
+				);
+				Batch.Issue();
+			}
+
+			TIoStatusOr<FIoBuffer> await_resume()
+			{
+				return MoveTemp(Result);
+			}
+
+		private:
+			FIoChunkId ChunkId;
+			FIoReadOptions Options;
+			int32 Priority;
+			TIoStatusOr<FIoBuffer> Result;
+		};
+	}
+
+	// reads the chunk by the IoDispatcher, the coroutine is resumed when the read is completed:
+	//	TIoStatusOr<FIoBuffer> Result = co_await UE::Tasks::ReadAsync(ChunkId);
+	inline Private::FIoReadAwaiter ReadAsync(const FIoChunkId& ChunkId, const FIoReadOptions& Options = FIoReadOptions(), int32 Priority = IoDispatcherPriority_Medium)
+	{
+		return Private::FIoReadAwaiter{ ChunkId, Options, Priority };
+	}
+}}
+
+#endif // WITH_CPP_COROUTINES
@@ -0,0 +1,423 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+#if WITH_CPP_COROUTINES
+
+#include "Tasks/Task.h"
+#include "Async/AsyncFileHandle.h"
+#include "Templates/UniquePtr.h"
+#include "Misc/Optional.h"
+
+#include <atomic>
+#include <type_traits>
+
+// MSVC provides the standard header, Clang only the Coroutines TS one (see `bEnableCppCoroutinesForEvaluation` in UBT)
+#if defined(__cpp_impl_coroutine) || (defined(_MSC_VER) && !defined(__clang__))
+	#include <coroutine>
+	namespace UE { namespace Tasks { namespace CoroutineStd = ::std; } }
+#else
+	#include <experimental/coroutine>
+	namespace UE { namespace Tasks { namespace CoroutineStd = ::std::experimental; } }
+#endif
+
+// C++20 coroutines integration with UE::Tasks. A function returning `TCoroutine<ResultType>` can `co_await` tasks, other coroutines and
+// async file reads, its execution is suspended without blocking the thread and is resumed by a task once the awaited operation is completed:
+//
+//	UE::Tasks::TCoroutine<int32> LoadAsync(IAsyncReadFileHandle& File)
+//	{
+//		UE::Tasks::TTask<int32> Parse = UE::Tasks::Launch(UE_SOURCE_LOCATION, [] { return 42; });
+//		TUniquePtr<IAsyncReadRequest> Request = co_await UE::Tasks::ReadAsync(File, 0, 1024);
+//		int32 Result = co_await Parse;
+//		co_return Result;
+//	}
+//
+// The coroutine starts executing immediately on the calling thread, as a regular function, up to the first suspension. It's resumed on a
+// worker thread, with the priority of the task (or the thread) that suspended it (see `FTaskBase::GetWaitingPriority`). Coroutine frames
+// are allocated from pools, see `AllocateCoroutineFrame`.
+
+namespace UE { namespace Tasks
+{
+	template<typename ResultType>
+	class TCoroutine;
+
+	namespace Private
+	{
+		// allocates coroutine frames of up to a couple of KBs from fixed size pools with per-thread caches, larger ones from the heap
+		CORE_API void* AllocateCoroutineFrame(SIZE_T Size);
+		CORE_API void FreeCoroutineFrame(void* Frame, SIZE_T Size);
+
+		// resumes the coroutine by a task of the given priority, so the thread that completed the awaited operation (e.g. an IO thread)
+		// doesn't execute it
+		inline void ResumeCoroutine(CoroutineStd::coroutine_handle<> Continuation, ETaskPriority Priority)
+		{
+			Launch(TEXT("Coroutine Continuation"), [Continuation] { Continuation.resume(); }, Priority);
+		}
+
+		// resumes the coroutine by a task of the given priority once the given task is completed
+		template<typename TaskType>
+		void ResumeCoroutineAfter(const TaskType& Prerequisite, CoroutineStd::coroutine_handle<> Continuation, ETaskPriority Priority)
+		{
+			Launch(TEXT("Coroutine Continuation"), [Continuation] { Continuation.resume(); }, Prerequisite, Priority);
+		}
+
+		class FCoroutinePromiseBase
+		{
+		public:
+			static void* operator new(SIZE_T Size)
+			{
+				return AllocateCoroutineFrame(Size);
+			}
+
+			static void operator delete(void* Frame, SIZE_T Size)
+			{
+				FreeCoroutineFrame(Frame, Size);
+			}
+
+			// starts executing right away, as a regular function call
+			CoroutineStd::suspend_never initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			// flags the coroutine as completed, the frame is destroyed when both the coroutine and its `TCoroutine` are done with it
+			struct FFinalAwaiter
+			{
+				bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				template<typename PromiseType>
+				void await_suspend(CoroutineStd::coroutine_handle<PromiseType> Handle) noexcept
+				{
+					Handle.promise().CompletionEvent.Trigger();
+					Release(Handle);
+				}
+
+				void await_resume() const noexcept
+				{
+				}
+			};
+
+			FFinalAwaiter final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void unhandled_exception()
+			{
+				checkNoEntry(); // exceptions are not supported
+			}
+
+			template<typename PromiseType>
+			static void Release(CoroutineStd::coroutine_handle<PromiseType> Handle)
+			{
+				if (Handle.promise().RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					Handle.destroy();
+				}
+			}
+
+			FTaskEvent CompletionEvent{ TEXT("Coroutine") };
+			std::atomic<uint32> RefCount{ 2 }; // one for the coroutine and one for its `TCoroutine`
+		};
+
+		template<typename ResultType>
+		class TCoroutinePromise : public FCoroutinePromiseBase
+		{
+		public:
+			TCoroutine<ResultType> get_return_object()
+			{
+				return TCoroutine<ResultType>{ CoroutineStd::coroutine_handle<TCoroutinePromise>::from_promise(*this) };
+			}
+
+			template<typename ValueType>
+			void return_value(ValueType&& Value)
+			{
+				Result.Emplace(Forward<ValueType>(Value));
+			}
+
+			TOptional<ResultType> Result;
+		};
+
+		template<>
+		class TCoroutinePromise<void> : public FCoroutinePromiseBase
+		{
+		public:
+			TCoroutine<void> get_return_object();
+
+			void return_void()
+			{
+			}
+		};
+	}
+
+	// The return type of a coroutine. References the coroutine's frame and provides access to its completion and result, can be `co_await`ed
+	// by other coroutines and used as a task prerequisite by `GetCompletionEvent()`. Destroying it doesn't cancel the coroutine.
+	template<typename ResultType>
+	class TCoroutine
+	{
+	public:
+		using promise_type = Private::TCoroutinePromise<ResultType>;
+
+		TCoroutine() = default;
+
+		TCoroutine(TCoroutine&& Other)
+			: Handle(Other.Handle)
+		{
+			Other.Handle = nullptr;
+		}
+
+		TCoroutine& operator=(TCoroutine&& Other)
+		{
+			if (this != &Other)
+			{
+				Reset();
+				Handle = Other.Handle;
+				Other.Handle = nullptr;
+			}
+			return *this;
+		}
+
+		TCoroutine(const TCoroutine&) = delete;
+		TCoroutine& operator=(const TCoroutine&) = delete;
+
+		~TCoroutine()
+		{
+			Reset();
+		}
+
+		bool IsValid() const
+		{
+			return (bool)Handle;
+		}
+
+		// checks if the coroutine has returned, returns true if it's not valid
+		bool IsCompleted() const
+		{
+			return !IsValid() || Handle.promise().CompletionEvent.IsCompleted();
+		}
+
+		// blocks the current thread until the coroutine returns or the timeout expires. Don't call it from a coroutine, `co_await` instead
+		bool Wait(FTimespan Timeout = FTimespan::MaxValue())
+		{
+			return !IsValid() || Handle.promise().CompletionEvent.Wait(Timeout);
+		}
+
+		// the task completed when the coroutine returns, to use the coroutine as a task prerequisite
+		const FTaskEvent& GetCompletionEvent() const
+		{
+			check(IsValid());
+			return Handle.promise().CompletionEvent;
+		}
+
+		// waits for the coroutine completion and returns the result
+		template<typename T = ResultType>
+		std::enable_if_t<!std::is_void_v<T>, T&> GetResult()
+		{
+			check(IsValid());
+			Wait();
+			return Handle.promise().Result.GetValue();
+		}
+
+		// releases the coroutine's frame, it's destroyed once the coroutine returns
+		void Reset()
+		{
+			if (Handle)
+			{
+				promise_type::Release(Handle);
+				Handle = nullptr;
+			}
+		}
+
+	private:
+		friend promise_type;
+
+		explicit TCoroutine(CoroutineStd::coroutine_handle<promise_type> InHandle)
+			: Handle(InHandle)
+		{
+		}
+
+		CoroutineStd::coroutine_handle<promise_type> Handle;
+	};
+
+	using FCoroutine = TCoroutine<void>;
+
+	namespace Private
+	{
+		inline TCoroutine<void> TCoroutinePromise<void>::get_return_object()
+		{
+			return TCoroutine<void>{ CoroutineStd::coroutine_handle<TCoroutinePromise>::from_promise(*this) };
+		}
+
+		// `co_await` on a task (or a task event) suspends the coroutine until the task is completed and returns the task's result, that
+		// is valid as long as the task is referenced (see `TTask::GetResult()`)
+		template<typename ResultType>
+		class TTaskAwaiter
+		{
+		public:
+			explicit TTaskAwaiter(const TTask<ResultType>& InTask)
+				: Task(InTask)
+			{
+			}
+
+			bool await_ready() const
+			{
+				return Task.IsCompleted();
+			}
+
+			void await_suspend(CoroutineStd::coroutine_handle<> Continuation)
+			{
+				ResumeCoroutineAfter(Task, Continuation, FTaskBase::GetWaitingPriority());
+			}
+
+			decltype(auto) await_resume()
+			{
+				return Task.GetResult();
+			}
+
+		private:
+			TTask<ResultType> Task;
+		};
+
+		// `co_await` on another coroutine suspends the awaiting one until the awaited one returns, and returns its result. The result is
+		// moved out of a temporary coroutine and copied from an lvalue one
+		template<typename ResultType, bool bMoveResult>
+		class TCoroutineAwaiter
+		{
+		public:
+			explicit TCoroutineAwaiter(TCoroutine<ResultType>& InCoroutine)
+				: Coroutine(InCoroutine)
+			{
+			}
+
+			bool await_ready() const
+			{
+				return Coroutine.IsCompleted();
+			}
+
+			void await_suspend(CoroutineStd::coroutine_handle<> Continuation)
+			{
+				ResumeCoroutineAfter(Coroutine.GetCompletionEvent(), Continuation, FTaskBase::GetWaitingPriority());
+			}
+
+			ResultType await_resume()
+			{
+				if constexpr (std::is_void_v<ResultType>)
+				{
+					return;
+				}
+				else if constexpr (bMoveResult)
+				{
+					return MoveTemp(Coroutine.GetResult());
+				}
+				else
+				{
+					return Coroutine.GetResult();
+				}
+			}
+
+		private:
+			TCoroutine<ResultType>& Coroutine;
+		};
+
+		// issues an async request that takes a completion callback (like `IAsyncReadRequest` or `IBulkDataIORequest`) and suspends the
+		// coroutine until it's completed. Returns the request, that is owned by the caller, or null if the request couldn't be issued.
+		// `IssueRequest` returns the issued request, null if it failed to issue it, in which case the callback isn't called later
+		template<typename RequestType, typename CallbackType, typename IssueRequestType>
+		class TAsyncRequestAwaiter
+		{
+		public:
+			explicit TAsyncRequestAwaiter(IssueRequestType&& InIssueRequest)
+				: IssueRequest(MoveTemp(InIssueRequest))
+			{
+			}
+
+			bool await_ready() const
+			{
+				return false;
+			}
+
+			bool await_suspend(CoroutineStd::coroutine_handle<> InContinuation)
+			{
+				Continuation = InContinuation;
+				Priority = FTaskBase::GetWaitingPriority();
+
+				// the callback is called on an IO thread, or synchronously from `IssueRequest`. the coroutine is resumed only once both
+				// the callback and `IssueRequest` have returned, by whichever of them finishes second. the awaiter is destroyed by the
+				// resumed coroutine, so the first one doesn't touch it anymore after flagging that it's done
+				CallbackType Callback = [this](bool /*bWasCancelled*/, RequestType* InRequest)
+				{
+					Request = InRequest;
+					if (bIssuedOrCompleted.exchange(true, std::memory_order_acq_rel))
+					{
+						ResumeCoroutine(Continuation, Priority);
+					}
+				};
+
+				if (IssueRequest(&Callback) == nullptr)
+				{
+					// nothing was issued, so the callback won't be called anymore: resume the coroutine on this thread right away
+					return false;
+				}
+
+				if (bIssuedOrCompleted.exchange(true, std::memory_order_acq_rel))
+				{
+					ResumeCoroutine(Continuation, Priority);
+				}
+				return true;
+			}
+
+			TUniquePtr<RequestType> await_resume()
+			{
+				if (Request != nullptr)
+				{
+					// the request is flagged as completed only after its callback returns, and can't be deleted before that
+					Request->WaitCompletion();
+				}
+				return TUniquePtr<RequestType>(Request);
+			}
+
+		private:
+			IssueRequestType IssueRequest;
+			CoroutineStd::coroutine_handle<> Continuation;
+			ETaskPriority Priority = ETaskPriority::Normal;
+			RequestType* Request = nullptr;
+			std::atomic<bool> bIssuedOrCompleted{ false };
+		};
+	}
+
+	template<typename ResultType>
+	Private::TTaskAwaiter<ResultType> operator co_await(const TTask<ResultType>& Task)
+	{
+		return Private::TTaskAwaiter<ResultType>{ Task };
+	}
+
+	template<typename ResultType>
+	Private::TCoroutineAwaiter<ResultType, false> operator co_await(TCoroutine<ResultType>& Coroutine)
+	{
+		return Private::TCoroutineAwaiter<ResultType, false>{ Coroutine };
+	}
+
+	template<typename ResultType>
+	Private::TCoroutineAwaiter<ResultType, true> operator co_await(TCoroutine<ResultType>&& Coroutine)
+	{
+		return Private::TCoroutineAwaiter<ResultType, true>{ Coroutine };
+	}
+
+	// reads from the file asynchronously, the coroutine is resumed when the read is completed. The returned request is completed,
+	// `GetReadResults()` returns the data or null if the read failed or was cancelled. The request is null if it couldn't be issued
+	inline auto ReadAsync(IAsyncReadFileHandle& FileHandle, int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags = AIOP_Normal, uint8* UserSuppliedMemory = nullptr)
+	{
+		auto IssueRequest = [&FileHandle, Offset, BytesToRead, PriorityAndFlags, UserSuppliedMemory](FAsyncFileCallBack* Callback)
+		{
+			return FileHandle.ReadRequest(Offset, BytesToRead, PriorityAndFlags, Callback, UserSuppliedMemory);
+		};
+		return Private::TAsyncRequestAwaiter<IAsyncReadRequest, FAsyncFileCallBack, decltype(IssueRequest)>{ MoveTemp(IssueRequest) };
+	}
+}}
+
+#endif // WITH_CPP_COROUTINES
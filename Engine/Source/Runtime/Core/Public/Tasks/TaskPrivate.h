@@ -16,6 +16,7 @@
 #include "Math/NumericLimits.h"
 #include "Misc/SpinLock.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
 
 #include <atomic>
 #include <type_traits>
@@ -102,6 +103,7 @@ namespace UE { namespace Tasks
 						TryExecute();
 					}
 				);
+				EffectivePriority.store(LowLevelTask.GetPriority(), std::memory_order_relaxed);
 			}
 
 			// The task will be executed only when all prerequisites are completed. The task type must be a task handle that holds a pointer to
@@ -122,6 +124,7 @@ namespace UE { namespace Tasks
 					Prerequisites.Enqueue(&Prerequisite);
 					// keep it alive until this task's execution
 					Prerequisite.AddRef();
+					Prerequisite.InheritPriority(EffectivePriority.load(std::memory_order_relaxed));
 				}
 				else
 				{
@@ -173,6 +176,7 @@ namespace UE { namespace Tasks
 						Prerequisites.Enqueue(Prerequisite);
 						// keep it alive until this task's execution
 						Prerequisite->AddRef();
+						Prerequisite->InheritPriority(EffectivePriority.load(std::memory_order_relaxed));
 					}
 					else
 					{
@@ -253,8 +257,12 @@ namespace UE { namespace Tasks
 
 					// prerequisites are "consumed" here even if their retraction fails. retraction can fail only if task execution has 
 					// already started, and it can't become "retractable" again, so no need to keep them
+					// `Prerequisites` can be iterated concurrently by priority inheritance, so dequeueing is locked
+					TScopeLock<FSpinLock> ScopeLock(PrerequisitesLock);
 					while (TOptional<FTaskBase*> Prerequisite = Prerequisites.Dequeue())
 					{
+						TScopeUnlock<FSpinLock> ScopeUnlock(PrerequisitesLock); // only `Prerequisites.Dequeue()` needs to be locked
+
 						Prerequisite.GetValue()->TryRetractAndExecute(RecursionDepth);
 						Prerequisite.GetValue()->Release();
 					}
@@ -347,6 +355,7 @@ namespace UE { namespace Tasks
 				TaskTrace::FWaitingScope WaitingScope(GetTraceId());
 				TRACE_CPUPROFILER_EVENT_SCOPE(Tasks::Wait);
 
+				InheritPriority(GetWaitingPriority());
 				if (TryRetractAndExecute())
 				{
 					return true;
@@ -375,6 +384,7 @@ namespace UE { namespace Tasks
 				TaskTrace::FWaitingScope WaitingScope(GetTraceId());
 				TRACE_CPUPROFILER_EVENT_SCOPE(Tasks::BusyWait);
 				
+				InheritPriority(GetWaitingPriority());
 				if (!TryRetractAndExecute())
 				{
 					LowLevelTasks::BusyWaitUntil([this] { return IsCompleted(); });
@@ -389,6 +399,7 @@ namespace UE { namespace Tasks
 
 				FTimeout Timeout{ InTimeout };
 				
+				InheritPriority(GetWaitingPriority());
 				if (TryRetractAndExecute())
 				{
 					return true;
@@ -405,6 +416,7 @@ namespace UE { namespace Tasks
 				TaskTrace::FWaitingScope WaitingScope(GetTraceId());
 				TRACE_CPUPROFILER_EVENT_SCOPE(Tasks::BusyWait);
 
+				InheritPriority(GetWaitingPriority());
 				if (TryRetractAndExecute())
 				{
 					return true;
@@ -428,6 +440,15 @@ namespace UE { namespace Tasks
 			// returns the task that is being currently exeucuted by this thread, if any
 			static FTaskBase* GetCurrentTask();
 
+			// Raises the priority of the task, and of its prerequisites that hold it back, to the given one if it's higher. Is called for 
+			// the prerequisites of a task, for the previous task of a pipe and for waited tasks, so high priority work doesn't wait behind 
+			// lower priority tasks it depends on. A task that is already in the scheduler's queue is executed by a substitute low-level task
+			// launched with the new priority, whichever of them starts first.
+			void InheritPriority(ETaskPriority Priority, uint32 RecursionDepth = 0);
+
+			// returns the priority of the work that is held back by the current thread waiting
+			static ETaskPriority GetWaitingPriority();
+
 		private:
 			// sets the current task and returns the previous current task
 			static FTaskBase* ExchangeCurrentTask(FTaskBase* Task);
@@ -475,6 +496,19 @@ namespace UE { namespace Tasks
 					return true;
 				}
 
+#if UE_TASK_TRACE_ENABLED
+				ScheduledCycles.store(FPlatformTime::Cycles64(), std::memory_order_relaxed);
+#endif
+
+				// the priority inherited from now on goes to a substitute task (see `InheritPriority`), the one inherited so far is applied here.
+				// sequentially consistent, so that at least one of this and `InheritPriority` sees the change made by the other
+				bScheduled.store(true, std::memory_order_seq_cst);
+				const ETaskPriority LocalEffectivePriority = EffectivePriority.load(std::memory_order_seq_cst);
+				if (LocalEffectivePriority < LowLevelTask.GetPriority())
+				{
+					verify(LowLevelTask.TrySetPriority(LocalEffectivePriority));
+				}
+
 				verify(LowLevelTasks::TryLaunch(LowLevelTask)); // schedule the task
 
 				return true;
@@ -521,10 +555,23 @@ namespace UE { namespace Tasks
 			{
 				AddRef(); // for the reference hold by nested tasks, is released when the task is closed
 
+#if UE_TASK_TRACE_ENABLED
+				const uint64 LocalScheduledCycles = ScheduledCycles.load(std::memory_order_relaxed);
+				if (LocalScheduledCycles != 0) // not retracted before being scheduled
+				{
+					TraceQueueDelay(FPlatformTime::Cycles64() - LocalScheduledCycles);
+				}
+#endif
+
 				// release prerequisites refs as they are not needed anymore
-				while (TOptional<FTaskBase*> Prerequisite = Prerequisites.Dequeue())
+				// `Prerequisites` can be iterated concurrently by priority inheritance, so dequeueing is locked
 				{
-					Prerequisite.GetValue()->Release();
+					TScopeLock<FSpinLock> ScopeLock(PrerequisitesLock);
+					while (TOptional<FTaskBase*> Prerequisite = Prerequisites.Dequeue())
+					{
+						TScopeUnlock<FSpinLock> ScopeUnlock(PrerequisitesLock); // only `Prerequisites.Dequeue()` needs to be locked
+						Prerequisite.GetValue()->Release();
+					}
 				}
 
 				checkSlow(Pipe == nullptr ? NumLocks.load(std::memory_order_relaxed) == 1 : NumLocks.load(std::memory_order_relaxed) == 0);
@@ -576,6 +623,7 @@ namespace UE { namespace Tasks
 
 					Prerequisites.Enqueue(PrevPipedTask);
 					// no need to AddRef as it's already sorted in `FPipe::PushIntoPipe`
+					PrevPipedTask->InheritPriority(EffectivePriority.load(std::memory_order_relaxed));
 					return false;
 				}
 
@@ -591,6 +639,14 @@ namespace UE { namespace Tasks
 			// closes task by unlocking its subsequents and flagging it as completed
 			void Close();
 
+			// launches a low-level task with the given priority that executes this task if it's not executed yet
+			void LaunchPriorityEscalation(ETaskPriority Priority);
+
+#if UE_TASK_TRACE_ENABLED
+			// reports the time the task waited in the scheduler's queue, per priority
+			void TraceQueueDelay(uint64 QueueDelayCycles) const;
+#endif
+
 		private:
 			LowLevelTasks::FTask LowLevelTask;
 			TUniqueFunction<void()> TaskBody;
@@ -622,8 +678,14 @@ namespace UE { namespace Tasks
 
 			FPipe* Pipe{ nullptr };
 
+			// the priority of the task, raised by the tasks that depend on it (see `InheritPriority`)
+			std::atomic<ETaskPriority> EffectivePriority{ InlineTaskPriority };
+			// set once the low-level task is about to be launched, its priority can't change anymore afterwards
+			std::atomic<bool> bScheduled{ false };
+
 #if UE_TASK_TRACE_ENABLED
 			TaskTrace::FId TraceId = TaskTrace::GenerateTaskId();
+			std::atomic<uint64> ScheduledCycles{ 0 };
 #endif
 
 		// some projects are still built on macOS before v.10.14 that doesn't have aligned new/delete operators
@@ -645,6 +707,15 @@ namespace UE { namespace Tasks
 			FTimeout Timeout{ InTimeout };
 			bool bResult = true;
 
+			const ETaskPriority WaitingPriority = FTaskBase::GetWaitingPriority();
+			for (auto& Task : Tasks)
+			{
+				if (Task.IsValid())
+				{
+					Task.Pimpl->InheritPriority(WaitingPriority);
+				}
+			}
+
 			for (auto& Task : Tasks)
 			{
 				if (Task.IsValid() && !Task.Pimpl->TryRetractAndExecute())
@@ -62,6 +62,7 @@ typedef FUnixPlatformTypes FPlatformTypes;
 #define PLATFORM_HAS_BSD_SOCKET_FEATURE_IOCTL			1
 #define PLATFORM_HAS_BSD_SOCKET_FEATURE_MSG_DONTWAIT	1
 #define PLATFORM_HAS_BSD_SOCKET_FEATURE_RECVMMSG		1
+#define PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG		1
 #define PLATFORM_HAS_BSD_SOCKET_FEATURE_TIMESTAMP		1
 #define PLATFORM_SUPPORTS_MIMALLOC						PLATFORM_64BITS
 #define PLATFORM_SUPPORTS_STACK_SYMBOLS					1
@@ -13,6 +13,7 @@
 #include "HAL/RunnableThread.h"
 #include "HAL/PlatformMisc.h"
 #include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
 #include "Stats/StatsMisc.h"
 #include "Misc/CoreStats.h"
 #include "HAL/IConsoleManager.h"
@@ -190,6 +191,15 @@ void FindAllRuntimeScriptPackages(TArray<UPackage*>& OutPackages)
 #define ALT2_LOG_VERBOSE DO_CHECK
 #endif
 
+static int32 GAsyncLoading2_WorkerCount = 0;
+static FAutoConsoleVariableRef CVar_AsyncLoadingThreadWorkerCount(
+	TEXT("s.AsyncLoadingThreadWorkerCount"),
+	GAsyncLoading2_WorkerCount,
+	TEXT("Number of worker threads processing export bundles (creating and serializing exports) alongside the async loading thread.\n")
+	TEXT("Bundles of packages that don't depend on each other are then processed in parallel. 0 processes all export bundles on the async loading thread.\n")
+	TEXT("Only used when the async loading thread is enabled, and read when it is started."),
+	ECVF_Default);
+
 static TSet<FPackageId> GAsyncLoading2_DebugPackageIds;
 static FString GAsyncLoading2_DebugPackageNamesString;
 static TSet<FPackageId> GAsyncLoading2_VerbosePackageIds;
@@ -448,6 +458,8 @@ struct FGlobalImportStore
 	TMap<FPackageObjectIndex, UObject*> ScriptObjects;
 	TMap<FPublicExportKey, int32> PublicExportToObjectIndex;
 	TMap<int32, FPublicExportKey> ObjectIndexToPublicExport;
+	// Guards the public export maps while exports are created on async loading thread workers, GC removes exports with all of them suspended
+	FRWLock PublicExportsLock;
 	// Temporary initial load data
 	TArray<FScriptObjectEntry> ScriptObjectEntries;
 	TMap<FPackageObjectIndex, FScriptObjectEntry*> ScriptObjectEntriesMap;
@@ -575,6 +587,7 @@ struct FGlobalImportStore
 
 	inline UObject* FindPublicExportObject(const FPublicExportKey& Key)
 	{
+		FReadScopeLock ReadLock(PublicExportsLock);
 		UObject* Object = FindPublicExportObjectUnchecked(Key);
 		checkf(!Object || !Object->IsUnreachable(), TEXT("%s"), Object ? *Object->GetFullName() : TEXT("null"));
 		return Object;
@@ -603,6 +616,7 @@ struct FGlobalImportStore
 		check(ExportHash != 0);
 		int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
 		FPublicExportKey Key = FPublicExportKey::MakeKey(PackageId, ExportHash);
+		FWriteScopeLock WriteLock(PublicExportsLock);
 #if DO_CHECK
 		{
 			UObject* ExistingObject = FindPublicExportObjectUnchecked(Key);
@@ -1904,6 +1918,11 @@ public:
 	{
 	}
 
+	~FAsyncLoadingThreadWorker()
+	{
+		delete Thread;
+	}
+
 	void StartThread();
 	
 	void StopThread()
@@ -1932,7 +1951,10 @@ public:
 private:
 	virtual bool Init() override { return true; }
 	virtual uint32 Run() override;
-	virtual void Stop() override {};
+	virtual void Stop() override
+	{
+		StopThread();
+	}
 
 	FZenaphore& Zenaphore;
 	FAsyncLoadEventQueue2& EventQueue;
@@ -2060,10 +2082,23 @@ public:
 
 	/** [EDL] Event queue */
 	FZenaphore AltZenaphore;
-	TArray<FZenaphore> WorkerZenaphores;
+	FZenaphore WorkerZenaphore;
 	FAsyncLoadEventGraphAllocator GraphAllocator;
 	FAsyncLoadEventQueue2 EventQueue;
 	FAsyncLoadEventQueue2 MainThreadEventQueue;
+	/** Export bundles ready to be processed, drained by the workers if there are any, else by the async loading thread */
+	FAsyncLoadEventQueue2 ExportBundleEventQueue;
+	/** Serializes ConditionalPostLoadSubobjects on export templates, which can be shared by packages processed on different workers */
+	FCriticalSection TemplateSubobjectsCritical;
+	/**
+	 * Keeps export creation/serialization on the workers from overlapping PostLoad on the async loading thread, the same as when both
+	 * run on the async loading thread. PostLoad can touch objects that are being created or serialized for another package (e.g. CDO
+	 * subobjects, or exports of packages it imports), so workers hold it shared for each export, and the async loading thread holds it
+	 * exclusively while it post loads an export bundle. Only used when there are workers.
+	 */
+	FRWLock ExportProcessingLock;
+	/** The number of PostLoad events waiting for ExportProcessingLock, workers back off while it's non zero so they can't starve them */
+	TAtomic<int32> PostLoadWaitingCount { 0 };
 	TArray<FAsyncLoadEventQueue2*> AltEventQueues;
 	TArray<FAsyncLoadEventSpec> EventSpecs;
 
@@ -2292,6 +2327,7 @@ public:
 
 private:
 
+	void StartWorkers();
 	void SuspendWorkers();
 	void ResumeWorkers();
 
@@ -3025,10 +3061,21 @@ uint32 FAsyncLoadingThreadWorker::Run()
 						bDidSomething = true;
 						break;
 					}
+					if (ThreadState.CurrentEventNode)
+					{
+						// The event timed out because garbage collection or PostLoad on the async loading thread is waiting,
+						// release the GC guard before retrying it
+						break;
+					}
 				} while (bDidSomething);
 				--ActiveWorkersCount;
 			}
-			if (!bDidSomething)
+			if (ThreadState.CurrentEventNode)
+			{
+				// Give garbage collection a chance to suspend the workers, or PostLoad a chance to take ExportProcessingLock
+				FPlatformProcess::SleepNoStats(0.001f);
+			}
+			else if (!bDidSomething)
 			{
 				ThreadState.ProcessDeferredFrees();
 				Waiter.Wait();
@@ -3539,7 +3586,18 @@ EAsyncPackageState::Type FAsyncPackage2::Event_SetupDependencies(FAsyncLoadingTh
 		Package->SetupSerializedArcs();
 	}
 	Package->AsyncPackageLoadingState = EAsyncPackageLoadingState2::ProcessExportBundles;
-	for (int32 ExportBundleIndex = 0, ExportBundleCount = Package->Data.ExportInfo.ExportBundleCount; ExportBundleIndex < ExportBundleCount; ++ExportBundleIndex)
+	const int32 ExportBundleCount = Package->Data.ExportInfo.ExportBundleCount;
+	if (Package->AsyncLoadingThread.Workers.Num() > 0)
+	{
+		// The export bundles of a package share the entry index, the export data pointer and the package's constructed objects
+		// and external reads, so when they're processed by workers each one waits for the previous one, the same as they would
+		// be processed in order on the async loading thread
+		for (int32 ExportBundleIndex = 1; ExportBundleIndex < ExportBundleCount; ++ExportBundleIndex)
+		{
+			Package->GetExportBundleNode(ExportBundle_Process, ExportBundleIndex).DependsOn(&Package->GetExportBundleNode(ExportBundle_Process, ExportBundleIndex - 1));
+		}
+	}
+	for (int32 ExportBundleIndex = 0; ExportBundleIndex < ExportBundleCount; ++ExportBundleIndex)
 	{
 		Package->GetExportBundleNode(ExportBundle_Process, ExportBundleIndex).ReleaseBarrier();
 	}
@@ -3621,12 +3679,23 @@ EAsyncPackageState::Type FAsyncPackage2::Event_ProcessExportBundle(FAsyncLoading
 		const FExportBundleEntry* BundleEntry = BundleEntries + Package->ExportBundleEntryIndex;
 		const FExportBundleEntry* BundleEntryEnd = BundleEntries + ExportBundle->EntryCount;
 		check(BundleEntry <= BundleEntryEnd);
+		const bool bHasWorkers = Package->AsyncLoadingThread.Workers.Num() > 0;
 		while (BundleEntry < BundleEntryEnd)
 		{
 			if (ThreadState.IsTimeLimitExceeded(TEXT("Event_ProcessExportBundle")))
 			{
 				return EAsyncPackageState::TimeOut;
 			}
+			// Give way to PostLoad on the async loading thread, the worker retries the event once it has slept
+			if (bHasWorkers && Package->AsyncLoadingThread.PostLoadWaitingCount.Load(EMemoryOrder::Relaxed) > 0)
+			{
+				return EAsyncPackageState::TimeOut;
+			}
+			TOptional<FReadScopeLock> ExportProcessingLock;
+			if (bHasWorkers)
+			{
+				ExportProcessingLock.Emplace(Package->AsyncLoadingThread.ExportProcessingLock);
+			}
 			const FExportMapEntry& ExportMapEntry = Package->ExportMap[BundleEntry->LocalExportIndex];
 			FExportObject& Export = Package->Data.Exports[BundleEntry->LocalExportIndex];
 			Export.bFiltered = FilterExport(ExportMapEntry.FilterFlags);
@@ -3692,6 +3761,8 @@ EAsyncPackageState::Type FAsyncPackage2::Event_ProcessExportBundle(FAsyncLoading
 			check(Package->AsyncPackageLoadingState == EAsyncPackageLoadingState2::ProcessExportBundles);
 			Package->AsyncPackageLoadingState = EAsyncPackageLoadingState2::WaitingForExternalReads;
 			Package->AsyncLoadingThread.ExternalReadQueue.Enqueue(Package);
+			// The async loading thread polls the external reads, which may be waiting for events when this runs on a worker
+			Package->AsyncLoadingThread.AltZenaphore.NotifyOne();
 		}
 	}
 
@@ -3853,7 +3924,15 @@ void FAsyncPackage2::EventDrivenCreateExport(int32 LocalExportIndex)
 	else
 	{
 		// we also need to ensure that the template has set up any instances
-		ExportObject.TemplateObject->ConditionalPostLoadSubobjects();
+		if (AsyncLoadingThread.Workers.Num() > 0)
+		{
+			FScopeLock TemplateSubobjectsLock(&AsyncLoadingThread.TemplateSubobjectsCritical);
+			ExportObject.TemplateObject->ConditionalPostLoadSubobjects();
+		}
+		else
+		{
+			ExportObject.TemplateObject->ConditionalPostLoadSubobjects();
+		}
 
 		check(!GVerifyObjectReferencesOnly); // not supported with the event driven loader
 		// Create the export object, marking it with the appropriate flags to
@@ -4307,6 +4386,16 @@ EAsyncPackageState::Type FAsyncPackage2::Event_PostLoadExportBundle(FAsyncLoadin
 		const bool bAsyncPostLoadEnabled = FAsyncLoadingThreadSettings::Get().bAsyncPostLoadEnabled;
 		const bool bIsMultithreaded = Package->AsyncLoadingThread.IsMultithreaded();
 
+		// Exports are created and serialized on the workers while this runs, keep them from touching objects being post loaded
+		const bool bHasWorkers = Package->AsyncLoadingThread.Workers.Num() > 0;
+		TOptional<FWriteScopeLock> ExportProcessingLock;
+		if (bHasWorkers)
+		{
+			++Package->AsyncLoadingThread.PostLoadWaitingCount;
+			ExportProcessingLock.Emplace(Package->AsyncLoadingThread.ExportProcessingLock);
+			--Package->AsyncLoadingThread.PostLoadWaitingCount;
+		}
+
 		const FExportBundleHeader* ExportBundle = Package->Data.ExportBundleHeaders + InExportBundleIndex;
 		const FExportBundleEntry* BundleEntries = Package->Data.ExportBundleEntries + ExportBundle->FirstEntryIndex;
 		const FExportBundleEntry* BundleEntry = BundleEntries + Package->ExportBundleEntryIndex;
@@ -4924,6 +5013,7 @@ FAsyncLoadingThread2::FAsyncLoadingThread2(FIoDispatcher& InIoDispatcher, IAsync
 #endif
 
 	AltEventQueues.Add(&EventQueue);
+	AltEventQueues.Add(&ExportBundleEventQueue);
 	for (FAsyncLoadEventQueue2* Queue : AltEventQueues)
 	{
 		Queue->SetZenaphore(&AltZenaphore);
@@ -4934,7 +5024,7 @@ FAsyncLoadingThread2::FAsyncLoadingThread2(FIoDispatcher& InIoDispatcher, IAsync
 	EventSpecs[EEventLoadNode2::Package_SetupDependencies] = { &FAsyncPackage2::Event_SetupDependencies, &EventQueue, false };
 	EventSpecs[EEventLoadNode2::Package_ExportsSerialized] = { &FAsyncPackage2::Event_ExportsDone, &EventQueue, true };
 
-	EventSpecs[EEventLoadNode2::Package_NumPhases + EEventLoadNode2::ExportBundle_Process] = { &FAsyncPackage2::Event_ProcessExportBundle, &EventQueue, false };
+	EventSpecs[EEventLoadNode2::Package_NumPhases + EEventLoadNode2::ExportBundle_Process] = { &FAsyncPackage2::Event_ProcessExportBundle, &ExportBundleEventQueue, false };
 	EventSpecs[EEventLoadNode2::Package_NumPhases + EEventLoadNode2::ExportBundle_PostLoad] = { &FAsyncPackage2::Event_PostLoadExportBundle, &EventQueue, false };
 	EventSpecs[EEventLoadNode2::Package_NumPhases + EEventLoadNode2::ExportBundle_DeferredPostLoad] = { &FAsyncPackage2::Event_DeferredPostLoadExportBundle, &MainThreadEventQueue, false };
 
@@ -4971,6 +5061,7 @@ void FAsyncLoadingThread2::ShutdownLoading()
 
 	delete Thread;
 	Thread = nullptr;
+	Workers.Empty();
 	FPlatformProcess::ReturnSynchEventToPool(CancelLoadingEvent);
 	CancelLoadingEvent = nullptr;
 	FPlatformProcess::ReturnSynchEventToPool(ThreadSuspendedEvent);
@@ -4993,6 +5084,7 @@ void FAsyncLoadingThread2::StartThread()
 		UE_LOG(LogStreaming, Log, TEXT("Starting Async Loading Thread."));
 		bThreadStarted = true;
 		FPlatformMisc::MemoryBarrier();
+		StartWorkers();
 		UE::Trace::ThreadGroupBegin(TEXT("AsyncLoading"));
 		Thread = FRunnableThread::Create(this, TEXT("FAsyncLoadingThread"), 0, TPri_Normal);
 		UE::Trace::ThreadGroupEnd();
@@ -5008,6 +5100,34 @@ bool FAsyncLoadingThread2::Init()
 	return true;
 }
 
+void FAsyncLoadingThread2::StartWorkers()
+{
+	const int32 WorkerCount = FMath::Min(GAsyncLoading2_WorkerCount, FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1);
+	if (WorkerCount <= 0 || !FPlatformProcess::SupportsMultithreading())
+	{
+		return;
+	}
+
+	UE_LOG(LogStreaming, Log, TEXT("Starting %d Async Loading Thread workers."), WorkerCount);
+
+	// Export bundles are only processed by the workers from now on, leaving the async loading thread to the other events.
+	// It still suspends the workers whenever it suspends itself (for garbage collection or SuspendLoading).
+	// This is called before the async loading thread is created, as it owns AltEventQueues from then on.
+	AltEventQueues.Remove(&ExportBundleEventQueue);
+	ExportBundleEventQueue.SetZenaphore(&WorkerZenaphore);
+
+	// The workers are FRunnables, so the array must not be reallocated once they have been started
+	Workers.Reserve(WorkerCount);
+	for (int32 WorkerIndex = 0; WorkerIndex < WorkerCount; ++WorkerIndex)
+	{
+		Workers.Emplace(GraphAllocator, ExportBundleEventQueue, IoDispatcher, WorkerZenaphore, ActiveWorkersCount);
+	}
+	for (FAsyncLoadingThreadWorker& Worker : Workers)
+	{
+		Worker.StartThread();
+	}
+}
+
 void FAsyncLoadingThread2::SuspendWorkers()
 {
 	if (bWorkersSuspended)
@@ -0,0 +1,545 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/BulkDataChunkStreamer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+FBulkDataStreamedChunk::~FBulkDataStreamedChunk()
+{
+	FMemory::Free(const_cast<uint8*>(Data));
+}
+
+void FBulkDataStreamedRange::CopyTo(void* Dst) const
+{
+	check(IsOk());
+
+	uint8* DstBytes = static_cast<uint8*>(Dst);
+	const int64 RangeEnd = Offset + Size;
+	for (const FBulkDataStreamedChunkRef& Chunk : Chunks)
+	{
+		const int64 CopyStart = FMath::Max(Offset, Chunk->Offset);
+		const int64 CopyEnd = FMath::Min(RangeEnd, Chunk->Offset + Chunk->Size);
+		if (CopyStart < CopyEnd)
+		{
+			FMemory::Memcpy(DstBytes + (CopyStart - Offset), Chunk->Data + (CopyStart - Chunk->Offset), CopyEnd - CopyStart);
+		}
+	}
+}
+
+FBulkDataChunkStreamer::FBulkDataChunkStreamer(const FBulkDataInterface& InBulkData, const FSettings& InSettings)
+	: FBulkDataChunkStreamer(InBulkData.GetBulkDataSize(),
+		[&InBulkData](int64 Offset, int64 Size, EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* Callback, uint8* UserSuppliedMemory)
+		{
+			return InBulkData.CreateStreamingRequest(Offset, Size, Priority, Callback, UserSuppliedMemory);
+		},
+		InSettings)
+{
+}
+
+FBulkDataChunkStreamer::FBulkDataChunkStreamer(int64 InDataSize, FIssueReadFunction&& InIssueRead, const FSettings& InSettings)
+	: IssueReadFunction(MoveTemp(InIssueRead))
+	, Settings(InSettings)
+	, BulkDataSize(InDataSize)
+{
+	check(Settings.ChunkSize > 0);
+	check(Settings.MaxReadsInFlight > 0);
+	Chunks.SetNum(IntCastChecked<int32>(FMath::DivideAndRoundUp(BulkDataSize, Settings.ChunkSize)));
+}
+
+FBulkDataChunkStreamer::~FBulkDataChunkStreamer()
+{
+	TArray<FCompletedRequest> CompletedRequests;
+	TArray<IBulkDataIORequest*> IORequestsToWaitFor;
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		TArray<FRequestId> RequestIds;
+		Requests.GetKeys(RequestIds);
+		for (FRequestId RequestId : RequestIds)
+		{
+			CompleteRequest(RequestId, EBulkDataStreamStatus::Cancelled, CompletedRequests);
+		}
+		check(QueuedChunks.IsEmpty());
+
+		for (const FChunk& Chunk : Chunks)
+		{
+			if (Chunk.State == EChunkState::Reading)
+			{
+				checkf(Chunk.IORequest, TEXT("FBulkDataChunkStreamer destroyed while a read is being issued"));
+				IORequestsToWaitFor.Add(Chunk.IORequest);
+			}
+		}
+	}
+
+	CallCallbacks(CompletedRequests);
+
+	// The reads were cancelled when their chunks lost their last waiter, wait for their callbacks before deleting them
+	for (IBulkDataIORequest* IORequest : IORequestsToWaitFor)
+	{
+		IORequest->WaitCompletion();
+	}
+	check(ReadsInFlight == 0);
+	for (IBulkDataIORequest* IORequest : FinishedIORequests)
+	{
+		IORequest->WaitCompletion();
+		delete IORequest;
+	}
+	FinishedIORequests.Empty();
+}
+
+FBulkDataChunkStreamer::FRequestId FBulkDataChunkStreamer::RequestRange(int64 Offset, int64 Size, EAsyncIOPriorityAndFlags Priority, FBulkDataStreamedRangeCallback&& Callback)
+{
+	checkf(Offset >= 0 && Size >= 0 && Offset + Size <= BulkDataSize, TEXT("Requested range [%lld, %lld) is outside of the bulk data [0, %lld)"), Offset, Offset + Size, BulkDataSize);
+
+	DeleteFinishedIORequests();
+
+	FRequestId RequestId;
+	TArray<FCompletedRequest> CompletedRequests;
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		RequestId = NextRequestId++;
+		if (NextRequestId == 0)
+		{
+			NextRequestId = 1;
+		}
+
+		FRequest& Request = Requests.Add(RequestId);
+		Request.Callback = MoveTemp(Callback);
+		Request.Range.Offset = Offset;
+		Request.Range.Size = Size;
+		Request.Priority = Priority & AIOP_PRIORITY_MASK;
+		if (Size > 0)
+		{
+			Request.FirstChunk = int32(Offset / Settings.ChunkSize);
+			Request.LastChunk = int32((Offset + Size - 1) / Settings.ChunkSize);
+		}
+
+		for (int32 ChunkIndex = Request.FirstChunk; ChunkIndex <= Request.LastChunk; ++ChunkIndex)
+		{
+			FChunk& Chunk = Chunks[ChunkIndex];
+			Chunk.Waiters.Add(RequestId);
+			if (Chunk.State == EChunkState::Resident)
+			{
+				UpdateLru(ChunkIndex);
+				continue;
+			}
+
+			++Request.ChunksRemaining;
+			if (Chunk.State == EChunkState::NotResident)
+			{
+				QueueChunk(ChunkIndex);
+			}
+			else if (Chunk.State == EChunkState::Queued && Chunk.Priority < Request.Priority)
+			{
+				Chunk.Priority = Request.Priority;
+			}
+		}
+
+		if (Request.ChunksRemaining == 0)
+		{
+			CompleteRequest(RequestId, EBulkDataStreamStatus::Ok, CompletedRequests);
+		}
+	}
+
+	CallCallbacks(CompletedRequests);
+	PumpReads();
+	return RequestId;
+}
+
+void FBulkDataChunkStreamer::UpdatePriority(FRequestId RequestId, EAsyncIOPriorityAndFlags Priority)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FRequest* Request = Requests.Find(RequestId);
+	if (!Request)
+	{
+		return;
+	}
+	Request->Priority = Priority & AIOP_PRIORITY_MASK;
+	for (int32 ChunkIndex = Request->FirstChunk; ChunkIndex <= Request->LastChunk; ++ChunkIndex)
+	{
+		UpdateChunkPriority(ChunkIndex);
+	}
+}
+
+void FBulkDataChunkStreamer::CancelRequest(FRequestId RequestId)
+{
+	DeleteFinishedIORequests();
+
+	TArray<FCompletedRequest> CompletedRequests;
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (Requests.Contains(RequestId))
+		{
+			CompleteRequest(RequestId, EBulkDataStreamStatus::Cancelled, CompletedRequests);
+		}
+	}
+	CallCallbacks(CompletedRequests);
+}
+
+TSharedPtr<const FBulkDataStreamedChunk, ESPMode::ThreadSafe> FBulkDataChunkStreamer::TryGetResidentChunk(int32 ChunkIndex)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FChunk& Chunk = Chunks[ChunkIndex];
+	if (Chunk.State != EChunkState::Resident)
+	{
+		return nullptr;
+	}
+	UpdateLru(ChunkIndex);
+	return Chunk.Resident;
+}
+
+void FBulkDataChunkStreamer::TrimResidentChunks()
+{
+	DeleteFinishedIORequests();
+
+	FScopeLock Lock(&CriticalSection);
+	EvictChunks(0);
+}
+
+void FBulkDataChunkStreamer::OnReadComplete(int32 ChunkIndex, uint32 ReadSerial, bool bWasCancelled, IBulkDataIORequest* IORequest)
+{
+	TArray<FCompletedRequest> CompletedRequests;
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		FinishedIORequests.Add(IORequest);
+		FChunk& Chunk = Chunks[ChunkIndex];
+		check(Chunk.State == EChunkState::Reading && Chunk.ReadSerial == ReadSerial);
+		FinishRead(ChunkIndex, bWasCancelled, CompletedRequests);
+	}
+
+	CallCallbacks(CompletedRequests);
+	PumpReads();
+}
+
+void FBulkDataChunkStreamer::FinishRead(int32 ChunkIndex, bool bWasCancelled, TArray<FCompletedRequest>& OutCompletedRequests)
+{
+	FChunk& Chunk = Chunks[ChunkIndex];
+	Chunk.IORequest = nullptr;
+	--ReadsInFlight;
+
+	const bool bCancelIssued = Chunk.bCancelIssued;
+	Chunk.bCancelIssued = false;
+
+	if (!bWasCancelled)
+	{
+		Chunk.Resident = MakeShared<FBulkDataStreamedChunk, ESPMode::ThreadSafe>(ChunkIndex, GetChunkOffset(ChunkIndex), GetSizeOfChunk(ChunkIndex), Chunk.ReadBuffer);
+		Chunk.ReadBuffer = nullptr;
+		Chunk.State = EChunkState::Resident;
+		UpdateLru(ChunkIndex);
+		CompleteChunk(ChunkIndex, false, OutCompletedRequests);
+		EvictChunks(Settings.MaxResidentSize);
+		return;
+	}
+
+	FMemory::Free(Chunk.ReadBuffer);
+	Chunk.ReadBuffer = nullptr;
+	ResidentSize -= GetSizeOfChunk(ChunkIndex);
+	Chunk.State = EChunkState::NotResident;
+
+	if (!bCancelIssued)
+	{
+		// Cancelled by the I/O system, which is how read errors are reported
+		CompleteChunk(ChunkIndex, true, OutCompletedRequests);
+	}
+	else if (!Chunk.Waiters.IsEmpty())
+	{
+		// Requested again after its read was cancelled
+		QueueChunk(ChunkIndex);
+	}
+}
+
+void FBulkDataChunkStreamer::CompleteChunk(int32 ChunkIndex, bool bFailed, TArray<FCompletedRequest>& OutCompletedRequests)
+{
+	// Every waiter of a chunk that wasn't resident is waiting for it
+	TArray<FRequestId, TInlineAllocator<8>> RequestsToComplete;
+	for (FRequestId RequestId : Chunks[ChunkIndex].Waiters)
+	{
+		FRequest& Request = Requests.FindChecked(RequestId);
+		Request.bFailed |= bFailed;
+		if (--Request.ChunksRemaining == 0)
+		{
+			RequestsToComplete.Add(RequestId);
+		}
+	}
+
+	for (FRequestId RequestId : RequestsToComplete)
+	{
+		const bool bRequestFailed = Requests.FindChecked(RequestId).bFailed;
+		CompleteRequest(RequestId, bRequestFailed ? EBulkDataStreamStatus::Failed : EBulkDataStreamStatus::Ok, OutCompletedRequests);
+	}
+}
+
+void FBulkDataChunkStreamer::CompleteRequest(FRequestId RequestId, EBulkDataStreamStatus Status, TArray<FCompletedRequest>& OutCompletedRequests)
+{
+	FRequest Request;
+	verify(Requests.RemoveAndCopyValue(RequestId, Request));
+
+	FCompletedRequest& CompletedRequest = OutCompletedRequests.AddDefaulted_GetRef();
+	CompletedRequest.Callback = MoveTemp(Request.Callback);
+	CompletedRequest.Range = MoveTemp(Request.Range);
+	CompletedRequest.Range.Status = Status;
+
+	for (int32 ChunkIndex = Request.FirstChunk; ChunkIndex <= Request.LastChunk; ++ChunkIndex)
+	{
+		FChunk& Chunk = Chunks[ChunkIndex];
+		if (Status == EBulkDataStreamStatus::Ok)
+		{
+			CompletedRequest.Range.Chunks.Add(Chunk.Resident.ToSharedRef());
+		}
+		verify(Chunk.Waiters.RemoveSingleSwap(RequestId, false) == 1);
+		ReleaseChunk(ChunkIndex);
+		UpdateLru(ChunkIndex);
+	}
+}
+
+void FBulkDataChunkStreamer::QueueChunk(int32 ChunkIndex)
+{
+	FChunk& Chunk = Chunks[ChunkIndex];
+	check(Chunk.State == EChunkState::NotResident);
+	Chunk.State = EChunkState::Queued;
+	Chunk.QueuedTick = NextTick++;
+	UpdateChunkPriority(ChunkIndex);
+	QueuedChunks.Add(ChunkIndex);
+}
+
+void FBulkDataChunkStreamer::ReleaseChunk(int32 ChunkIndex)
+{
+	FChunk& Chunk = Chunks[ChunkIndex];
+	if (!Chunk.Waiters.IsEmpty())
+	{
+		UpdateChunkPriority(ChunkIndex);
+		return;
+	}
+
+	if (Chunk.State == EChunkState::Queued)
+	{
+		QueuedChunks.RemoveSingle(ChunkIndex);
+		Chunk.State = EChunkState::NotResident;
+	}
+	else if (Chunk.State == EChunkState::Reading && !Chunk.bCancelIssued)
+	{
+		// If the read is still being issued it is cancelled by IssueRead once it has been
+		Chunk.bCancelIssued = true;
+		if (Chunk.IORequest)
+		{
+			Chunk.IORequest->Cancel();
+		}
+	}
+}
+
+void FBulkDataChunkStreamer::UpdateChunkPriority(int32 ChunkIndex)
+{
+	FChunk& Chunk = Chunks[ChunkIndex];
+	if (Chunk.State != EChunkState::Queued)
+	{
+		return;
+	}
+
+	Chunk.Priority = AIOP_MIN;
+	for (FRequestId RequestId : Chunk.Waiters)
+	{
+		Chunk.Priority = FMath::Max(Chunk.Priority, Requests.FindChecked(RequestId).Priority);
+	}
+}
+
+void FBulkDataChunkStreamer::UpdateLru(int32 ChunkIndex)
+{
+	UnlinkLru(ChunkIndex);
+
+	FChunk& Chunk = Chunks[ChunkIndex];
+	if (Chunk.State != EChunkState::Resident || !Chunk.Waiters.IsEmpty())
+	{
+		return;
+	}
+
+	// Link as the most recently used
+	Chunk.bInLru = true;
+	Chunk.LruPrev = LruTail;
+	Chunk.LruNext = INDEX_NONE;
+	if (LruTail != INDEX_NONE)
+	{
+		Chunks[LruTail].LruNext = ChunkIndex;
+	}
+	else
+	{
+		LruHead = ChunkIndex;
+	}
+	LruTail = ChunkIndex;
+}
+
+void FBulkDataChunkStreamer::UnlinkLru(int32 ChunkIndex)
+{
+	FChunk& Chunk = Chunks[ChunkIndex];
+	if (!Chunk.bInLru)
+	{
+		return;
+	}
+
+	if (Chunk.LruPrev != INDEX_NONE)
+	{
+		Chunks[Chunk.LruPrev].LruNext = Chunk.LruNext;
+	}
+	else
+	{
+		LruHead = Chunk.LruNext;
+	}
+	if (Chunk.LruNext != INDEX_NONE)
+	{
+		Chunks[Chunk.LruNext].LruPrev = Chunk.LruPrev;
+	}
+	else
+	{
+		LruTail = Chunk.LruPrev;
+	}
+	Chunk.LruPrev = INDEX_NONE;
+	Chunk.LruNext = INDEX_NONE;
+	Chunk.bInLru = false;
+}
+
+void FBulkDataChunkStreamer::EvictChunks(int64 TargetResidentSize)
+{
+	int32 ChunkIndex = LruHead;
+	while (ResidentSize > TargetResidentSize && ChunkIndex != INDEX_NONE)
+	{
+		FChunk& Chunk = Chunks[ChunkIndex];
+		const int32 NextChunkIndex = Chunk.LruNext;
+
+		// Chunks still referenced outside of the streamer are skipped, they're evicted by a later call once released
+		if (Chunk.Resident.GetSharedReferenceCount() == 1)
+		{
+			UnlinkLru(ChunkIndex);
+			Chunk.Resident.Reset();
+			Chunk.State = EChunkState::NotResident;
+			ResidentSize -= GetSizeOfChunk(ChunkIndex);
+		}
+		ChunkIndex = NextChunkIndex;
+	}
+}
+
+void FBulkDataChunkStreamer::PumpReads()
+{
+	for (;;)
+	{
+		TArray<FReadToIssue, TInlineAllocator<8>> ReadsToIssue;
+		{
+			FScopeLock Lock(&CriticalSection);
+
+			while (ReadsInFlight < Settings.MaxReadsInFlight && !QueuedChunks.IsEmpty())
+			{
+				int32 BestQueueIndex = 0;
+				for (int32 QueueIndex = 1; QueueIndex < QueuedChunks.Num(); ++QueueIndex)
+				{
+					const FChunk& Best = Chunks[QueuedChunks[BestQueueIndex]];
+					const FChunk& Candidate = Chunks[QueuedChunks[QueueIndex]];
+					if (Candidate.Priority > Best.Priority || (Candidate.Priority == Best.Priority && Candidate.QueuedTick < Best.QueuedTick))
+					{
+						BestQueueIndex = QueueIndex;
+					}
+				}
+				const int32 ChunkIndex = QueuedChunks[BestQueueIndex];
+				QueuedChunks.RemoveAtSwap(BestQueueIndex, 1, false);
+
+				const int64 ChunkSize = GetSizeOfChunk(ChunkIndex);
+				EvictChunks(Settings.MaxResidentSize - ChunkSize);
+
+				FChunk& Chunk = Chunks[ChunkIndex];
+				{
+					LLM_SCOPE(Settings.LLMTag);
+					Chunk.ReadBuffer = static_cast<uint8*>(FMemory::Malloc(ChunkSize));
+				}
+				Chunk.State = EChunkState::Reading;
+				++Chunk.ReadSerial;
+				ResidentSize += ChunkSize;
+				++ReadsInFlight;
+
+				ReadsToIssue.Add({ ChunkIndex, Chunk.ReadSerial, Chunk.ReadBuffer, Chunk.Priority });
+			}
+		}
+
+		if (ReadsToIssue.IsEmpty())
+		{
+			return;
+		}
+
+		// Reads are issued outside of the lock, as their callbacks can be called on other threads before CreateStreamingRequest returns
+		TArray<FCompletedRequest> CompletedRequests;
+		for (const FReadToIssue& Read : ReadsToIssue)
+		{
+			IssueRead(Read, CompletedRequests);
+		}
+		CallCallbacks(CompletedRequests);
+	}
+}
+
+void FBulkDataChunkStreamer::IssueRead(const FReadToIssue& Read, TArray<FCompletedRequest>& OutCompletedRequests)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBulkDataChunkStreamer::IssueRead);
+
+	const int32 ChunkIndex = Read.ChunkIndex;
+	const uint32 ReadSerial = Read.ReadSerial;
+	FBulkDataIORequestCallBack Callback = [this, ChunkIndex, ReadSerial](bool bWasCancelled, IBulkDataIORequest* IORequest)
+	{
+		OnReadComplete(ChunkIndex, ReadSerial, bWasCancelled, IORequest);
+	};
+	IBulkDataIORequest* IORequest = IssueReadFunction(GetChunkOffset(ChunkIndex), GetSizeOfChunk(ChunkIndex), Read.Priority, &Callback, Read.ReadBuffer);
+
+	FScopeLock Lock(&CriticalSection);
+
+	FChunk& Chunk = Chunks[ChunkIndex];
+	if (Chunk.State != EChunkState::Reading || Chunk.ReadSerial != ReadSerial)
+	{
+		// Already completed, the callback owns the request
+		return;
+	}
+
+	if (!IORequest)
+	{
+		UE_LOG(LogSerialization, Warning, TEXT("FBulkDataChunkStreamer failed to issue the read of chunk %d"), ChunkIndex);
+		Chunk.bCancelIssued = false;
+		FinishRead(ChunkIndex, true, OutCompletedRequests);
+		return;
+	}
+
+	Chunk.IORequest = IORequest;
+	if (Chunk.bCancelIssued)
+	{
+		IORequest->Cancel();
+	}
+}
+
+void FBulkDataChunkStreamer::DeleteFinishedIORequests()
+{
+	TArray<IBulkDataIORequest*> IORequestsToDelete;
+	{
+		FScopeLock Lock(&CriticalSection);
+		for (int32 Index = FinishedIORequests.Num() - 1; Index >= 0; --Index)
+		{
+			// A request is only complete once its callback has returned, which may be running the caller
+			if (FinishedIORequests[Index]->PollCompletion())
+			{
+				IORequestsToDelete.Add(FinishedIORequests[Index]);
+				FinishedIORequests.RemoveAtSwap(Index, 1, false);
+			}
+		}
+	}
+
+	for (IBulkDataIORequest* IORequest : IORequestsToDelete)
+	{
+		delete IORequest;
+	}
+}
+
+void FBulkDataChunkStreamer::CallCallbacks(TArray<FCompletedRequest>& CompletedRequests)
+{
+	for (FCompletedRequest& CompletedRequest : CompletedRequests)
+	{
+		if (CompletedRequest.Callback)
+		{
+			CompletedRequest.Callback(MoveTemp(CompletedRequest.Range));
+		}
+	}
+	CompletedRequests.Reset();
+}
@@ -0,0 +1,257 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/BulkDataChunkStreamer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BulkDataChunkStreamerTest
+{
+	#define TEST_NAME_ROOT "System.CoreUObject.Serialization.BulkDataChunkStreamer"
+	constexpr const uint32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	constexpr int64 TestChunkSize = 16;
+	constexpr int64 TestDataSize = 100;
+
+	uint8 GetTestByte(int64 Offset)
+	{
+		return uint8(Offset * 7 + 3);
+	}
+
+	// A read that completes when the test says so, on the test thread
+	class FTestIORequest final : public IBulkDataIORequest
+	{
+	public:
+		FTestIORequest(int64 InOffset, int64 InSize, EAsyncIOPriorityAndFlags InPriority, const FBulkDataIORequestCallBack& InCallback, uint8* InMemory)
+			: Offset(InOffset)
+			, Size(InSize)
+			, Priority(InPriority)
+			, Callback(InCallback)
+			, Memory(InMemory)
+		{
+		}
+
+		virtual bool PollCompletion() const override
+		{
+			return bCompleted;
+		}
+
+		virtual bool WaitCompletion(float TimeLimitSeconds = 0.0f) override
+		{
+			check(bCompleted);
+			return true;
+		}
+
+		virtual uint8* GetReadResults() override
+		{
+			return bCompleted && !bCancelled ? Memory : nullptr;
+		}
+
+		virtual int64 GetSize() const override
+		{
+			return bCompleted && !bCancelled ? Size : -1;
+		}
+
+		virtual void Cancel() override
+		{
+			bCancelled = true;
+		}
+
+		/** The streamer owns the request and can delete it any time after this */
+		void Complete()
+		{
+			if (!bCancelled)
+			{
+				for (int64 Index = 0; Index < Size; ++Index)
+				{
+					Memory[Index] = GetTestByte(Offset + Index);
+				}
+			}
+			Callback(bCancelled, this);
+			bCompleted = true;
+		}
+
+		const int64 Offset;
+		const int64 Size;
+		const EAsyncIOPriorityAndFlags Priority;
+		bool bCancelled = false;
+
+	private:
+		FBulkDataIORequestCallBack Callback;
+		uint8* Memory;
+		bool bCompleted = false;
+	};
+
+	// Issues FTestIORequests and keeps track of the ones in flight
+	struct FTestReads
+	{
+		FBulkDataChunkStreamer::FIssueReadFunction GetIssueReadFunction()
+		{
+			return [this](int64 Offset, int64 Size, EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* Callback, uint8* UserSuppliedMemory) -> IBulkDataIORequest*
+			{
+				FTestIORequest* Request = new FTestIORequest(Offset, Size, Priority, *Callback, UserSuppliedMemory);
+				InFlight.Add(Request);
+				IssuedOffsets.Add(Offset);
+				return Request;
+			};
+		}
+
+		/** Completes the oldest read in flight */
+		void CompleteNext()
+		{
+			check(!InFlight.IsEmpty());
+			FTestIORequest* Request = InFlight[0];
+			InFlight.RemoveAt(0);
+			Request->Complete();
+		}
+
+		void CompleteAll()
+		{
+			while (!InFlight.IsEmpty())
+			{
+				CompleteNext();
+			}
+		}
+
+		TArray<FTestIORequest*> InFlight;
+		TArray<int64> IssuedOffsets;
+	};
+
+	FBulkDataChunkStreamer::FSettings MakeTestSettings(int64 MaxResidentSize, int32 MaxReadsInFlight)
+	{
+		FBulkDataChunkStreamer::FSettings Settings;
+		Settings.ChunkSize = TestChunkSize;
+		Settings.MaxResidentSize = MaxResidentSize;
+		Settings.MaxReadsInFlight = MaxReadsInFlight;
+		return Settings;
+	}
+
+	bool IsRangeDataValid(const FBulkDataStreamedRange& Range)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(IntCastChecked<int32>(Range.Size));
+		Range.CopyTo(Data.GetData());
+		for (int32 Index = 0; Index < Data.Num(); ++Index)
+		{
+			if (Data[Index] != GetTestByte(Range.Offset + Index))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Cancelling a request calls its callback and cancels the reads no other request is waiting for
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataChunkStreamerTestCancel, TEST_NAME_ROOT ".Cancel", TestFlags)
+	bool FBulkDataChunkStreamerTestCancel::RunTest(const FString& Parameters)
+	{
+		FTestReads Reads;
+		FBulkDataChunkStreamer Streamer(TestDataSize, Reads.GetIssueReadFunction(), MakeTestSettings(TestDataSize, 1));
+
+		TOptional<EBulkDataStreamStatus> StatusA;
+		TOptional<EBulkDataStreamStatus> StatusB;
+		TOptional<EBulkDataStreamStatus> StatusC;
+		const FBulkDataChunkStreamer::FRequestId RequestA = Streamer.RequestRange(0, TestChunkSize, AIOP_Normal, [&StatusA](FBulkDataStreamedRange&& Range) { StatusA = Range.Status; });
+		const FBulkDataChunkStreamer::FRequestId RequestB = Streamer.RequestRange(TestChunkSize, TestChunkSize, AIOP_Normal, [&StatusB](FBulkDataStreamedRange&& Range) { StatusB = Range.Status; });
+		Streamer.RequestRange(TestChunkSize + 4, 4, AIOP_Normal, [&StatusC](FBulkDataStreamedRange&& Range) { StatusC = Range.Status; });
+		TestEqual(TEXT("Only one read should be in flight"), Reads.InFlight.Num(), 1);
+
+		// The queued chunk is still wanted by the third request
+		Streamer.CancelRequest(RequestB);
+		TestTrue(TEXT("Cancelling a request should call its callback"), StatusB.IsSet() && StatusB.GetValue() == EBulkDataStreamStatus::Cancelled);
+		TestFalse(TEXT("Cancelling a request should not complete the other requests"), StatusC.IsSet());
+
+		Streamer.CancelRequest(RequestA);
+		TestTrue(TEXT("Cancelling a request should call its callback"), StatusA.IsSet() && StatusA.GetValue() == EBulkDataStreamStatus::Cancelled);
+		TestTrue(TEXT("The read of a chunk nobody waits for should be cancelled"), Reads.InFlight[0]->bCancelled);
+
+		// The cancelled read frees its slot for the chunk the third request waits for
+		Reads.CompleteNext();
+		TestEqual(TEXT("The chunk of the remaining request should be read next"), Reads.IssuedOffsets, TArray<int64>{ 0, TestChunkSize });
+		Reads.CompleteAll();
+		TestTrue(TEXT("The remaining request should complete"), StatusC.IsSet() && StatusC.GetValue() == EBulkDataStreamStatus::Ok);
+		TestTrue(TEXT("The cancelled chunk should not be resident"), !Streamer.TryGetResidentChunk(0).IsValid());
+		TestEqual(TEXT("Only the read chunk should be resident"), Streamer.GetResidentSize(), TestChunkSize);
+
+		// Cancelling a completed request does nothing
+		Streamer.CancelRequest(RequestA);
+
+		return true;
+	}
+
+	// The least recently used chunks are evicted first, and chunks referenced outside of the streamer aren't evicted
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataChunkStreamerTestEviction, TEST_NAME_ROOT ".Eviction", TestFlags)
+	bool FBulkDataChunkStreamerTestEviction::RunTest(const FString& Parameters)
+	{
+		FTestReads Reads;
+		FBulkDataChunkStreamer Streamer(TestDataSize, Reads.GetIssueReadFunction(), MakeTestSettings(2 * TestChunkSize, 8));
+
+		bool bRangeValid = false;
+		for (int32 ChunkIndex = 0; ChunkIndex < 2; ++ChunkIndex)
+		{
+			Streamer.RequestRange(ChunkIndex * TestChunkSize, TestChunkSize, AIOP_Normal, [&bRangeValid](FBulkDataStreamedRange&& Range) { bRangeValid = Range.IsOk() && IsRangeDataValid(Range); });
+			Reads.CompleteAll();
+			TestTrue(TEXT("The read range should hold the bulk data"), bRangeValid);
+		}
+		TestEqual(TEXT("Both chunks should be resident"), Streamer.GetResidentSize(), 2 * TestChunkSize);
+
+		// Chunk 0 becomes the most recently used, so reading chunk 2 evicts chunk 1
+		TestTrue(TEXT("Chunk 0 should be resident"), Streamer.TryGetResidentChunk(0).IsValid());
+		Streamer.RequestRange(2 * TestChunkSize, TestChunkSize, AIOP_Normal, [](FBulkDataStreamedRange&& Range) {});
+		Reads.CompleteAll();
+		TestTrue(TEXT("The least recently used chunk should be evicted"), !Streamer.TryGetResidentChunk(1).IsValid());
+		TestTrue(TEXT("The most recently used chunk should stay resident"), Streamer.TryGetResidentChunk(0).IsValid());
+		TestEqual(TEXT("The resident size should stay under the limit"), Streamer.GetResidentSize(), 2 * TestChunkSize);
+
+		// A range held by the caller keeps its chunks resident, even when they are the least recently used
+		TOptional<FBulkDataStreamedRange> HeldRange;
+		Streamer.RequestRange(2 * TestChunkSize, 1, AIOP_Normal, [&HeldRange](FBulkDataStreamedRange&& Range) { HeldRange = MoveTemp(Range); });
+		TestTrue(TEXT("A resident range should complete immediately"), HeldRange.IsSet() && HeldRange->IsOk());
+		TestTrue(TEXT("Chunk 0 should be resident"), Streamer.TryGetResidentChunk(0).IsValid());
+		Streamer.RequestRange(3 * TestChunkSize, TestChunkSize, AIOP_Normal, [](FBulkDataStreamedRange&& Range) {});
+		Reads.CompleteAll();
+		TestTrue(TEXT("A chunk referenced by the caller should not be evicted"), Streamer.TryGetResidentChunk(2).IsValid());
+		TestTrue(TEXT("The unreferenced chunk should be evicted instead"), !Streamer.TryGetResidentChunk(0).IsValid());
+
+		Streamer.TrimResidentChunks();
+		TestEqual(TEXT("Trimming should only keep the referenced chunk"), Streamer.GetResidentSize(), TestChunkSize);
+		HeldRange.Reset();
+		Streamer.TrimResidentChunks();
+		TestEqual(TEXT("Trimming should free the released chunk"), Streamer.GetResidentSize(), int64(0));
+
+		return true;
+	}
+
+	// Raising the priority of a request makes its queued chunks be read before the chunks queued earlier
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataChunkStreamerTestPriority, TEST_NAME_ROOT ".Priority", TestFlags)
+	bool FBulkDataChunkStreamerTestPriority::RunTest(const FString& Parameters)
+	{
+		FTestReads Reads;
+		FBulkDataChunkStreamer Streamer(TestDataSize, Reads.GetIssueReadFunction(), MakeTestSettings(TestDataSize, 1));
+
+		TArray<int32> CompletionOrder;
+		FBulkDataChunkStreamer::FRequestId RequestIds[3];
+		for (int32 ChunkIndex = 0; ChunkIndex < 3; ++ChunkIndex)
+		{
+			RequestIds[ChunkIndex] = Streamer.RequestRange(ChunkIndex * TestChunkSize, TestChunkSize, AIOP_Low,
+				[this, ChunkIndex, &CompletionOrder](FBulkDataStreamedRange&& Range)
+				{
+					TestTrue(TEXT("The read range should hold the bulk data"), Range.IsOk() && IsRangeDataValid(Range));
+					CompletionOrder.Add(ChunkIndex);
+				});
+		}
+
+		Streamer.UpdatePriority(RequestIds[2], AIOP_High);
+		Reads.CompleteNext();
+		TestEqual(TEXT("The raised chunk should be issued next"), Reads.InFlight.Num() == 1 ? Reads.InFlight[0]->Offset : -1, 2 * TestChunkSize);
+		TestTrue(TEXT("The raised chunk should be issued at the raised priority"), Reads.InFlight.Num() == 1 && Reads.InFlight[0]->Priority == AIOP_High);
+		Reads.CompleteAll();
+		TestEqual(TEXT("The requests should complete in priority order"), CompletionOrder, TArray<int32>{ 0, 2, 1 });
+
+		return true;
+	}
+
+	#undef TEST_NAME_ROOT
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
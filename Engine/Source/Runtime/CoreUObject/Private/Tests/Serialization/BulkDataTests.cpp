@@ -2,6 +2,8 @@
 
 #include "Misc/AutomationTest.h"
 #include "Serialization/BulkData.h"
+#include "Serialization/BulkDataCoroutine.h"
+#include "HAL/PlatformProcess.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -82,6 +84,114 @@ namespace BulkDataTest
 		return true;
 	}
 
+#if WITH_CPP_COROUTINES
+	// Completed by a task, after its completion callback returns
+	class FTestBulkDataIORequest final : public IBulkDataIORequest
+	{
+	public:
+		virtual bool PollCompletion() const override
+		{
+			return bCompleted;
+		}
+
+		virtual bool WaitCompletion(float TimeLimitSeconds = 0.0f) override
+		{
+			while (!bCompleted)
+			{
+				FPlatformProcess::Yield();
+			}
+			return true;
+		}
+
+		virtual uint8* GetReadResults() override
+		{
+			return nullptr;
+		}
+
+		virtual int64 GetSize() const override
+		{
+			return 0;
+		}
+
+		virtual void Cancel() override
+		{
+		}
+
+		std::atomic<bool> bCompleted{ false };
+	};
+
+	// Streams through FTestBulkDataIORequest, or fails to issue the request without calling the completion callback
+	struct FTestStreamingBulkData
+	{
+		IBulkDataIORequest* CreateStreamingRequest(EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* CompleteCallback, uint8* UserSuppliedMemory) const
+		{
+			return CreateStreamingRequest(0, 0, Priority, CompleteCallback, UserSuppliedMemory);
+		}
+
+		IBulkDataIORequest* CreateStreamingRequest(int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* CompleteCallback, uint8* UserSuppliedMemory) const
+		{
+			if (!bCanIssue)
+			{
+				return nullptr;
+			}
+
+			FTestBulkDataIORequest* Request = new FTestBulkDataIORequest;
+			UE::Tasks::Launch(UE_SOURCE_LOCATION, [Callback = *CompleteCallback, Request]() mutable
+				{
+					Callback(false, Request);
+					Request->bCompleted = true;
+				});
+			return Request;
+		}
+
+		bool bCanIssue = true;
+	};
+
+	template<typename BulkDataType>
+	UE::Tasks::TCoroutine<bool> IsStreamingRequestIssuedAsync(const BulkDataType& BulkData, bool bReadRange)
+	{
+		TUniquePtr<IBulkDataIORequest> Request;
+		if (bReadRange)
+		{
+			Request = co_await UE::Tasks::ReadAsync(BulkData, 0, 0);
+		}
+		else
+		{
+			Request = co_await UE::Tasks::ReadAsync(BulkData);
+		}
+		co_return Request.IsValid();
+	}
+
+	// Test that awaiting a bulk data read resumes the coroutine both when the request completes and when it can't be issued at all
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataTestCoroutine, TEST_NAME_ROOT ".Coroutine", TestFlags)
+	bool FBulkDataTestCoroutine::RunTest(const FString& Parameters)
+	{
+		FTestStreamingBulkData StreamingBulkData;
+
+		for (bool bReadRange : { false, true })
+		{
+			StreamingBulkData.bCanIssue = true;
+			TestTrue(TEXT("Awaiting an issued request should return it once completed"), IsStreamingRequestIssuedAsync(StreamingBulkData, bReadRange).GetResult());
+
+			StreamingBulkData.bCanIssue = false;
+			UE::Tasks::TCoroutine<bool> Coroutine = IsStreamingRequestIssuedAsync(StreamingBulkData, bReadRange);
+			TestTrue(TEXT("Awaiting a request that couldn't be issued should resume the coroutine immediately"), Coroutine.IsCompleted());
+			TestFalse(TEXT("Awaiting a request that couldn't be issued should return null"), Coroutine.GetResult());
+		}
+
+#if USE_NEW_BULKDATA // Only BulkData2 handles streaming from a BulkData object that doesn't reference a file on disk
+		FByteBulkData BulkData;
+
+		AddExpectedError(TEXT("Attempting to stream a BulkData object that cannot be loaded from disk"), EAutomationExpectedErrorFlags::Exact, 1);
+		UE::Tasks::TCoroutine<bool> Coroutine = IsStreamingRequestIssuedAsync(BulkData, false);
+		TestTrue(TEXT("Streaming a BulkData object that cannot be loaded from disk should resume the coroutine immediately"), Coroutine.IsCompleted());
+		TestFalse(TEXT("Streaming a BulkData object that cannot be loaded from disk should return null"), Coroutine.GetResult());
+#endif //USE_NEW_BULKDATA
+
+		return true;
+	}
+#endif // WITH_CPP_COROUTINES
+
 	#undef TEST_NAME_ROOT
 }
 
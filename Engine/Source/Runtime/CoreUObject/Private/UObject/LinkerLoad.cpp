@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UObject/LinkerLoad.h"
+#include "Containers/RingBuffer.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 #include "Stats/StatsMisc.h"
@@ -87,6 +88,149 @@ static FAutoConsoleVariableRef CVarTreatVerifyImportErrorsAsWarnings(
 	TEXT("If true, the errors emitted due to verify import failures will be warnings instead."),
 	ECVF_Default
 );
+
+int32 GLinkerLoadImportPrefetchCount = 256;
+static FAutoConsoleVariableRef CVarLinkerLoadImportPrefetchCount(
+	TEXT("linker.ImportPrefetchCount"),
+	GLinkerLoadImportPrefetchCount,
+	TEXT("Maximum number of import packages opened and primed ahead of their linkers when loading uncooked packages without the event driven loader. 0 disables import prefetching."),
+	ECVF_Default
+);
+
+/**
+ * Import packages opened ahead of their linkers.
+ * When a linker has fixed up its import map, the files of its imported packages are opened and their headers read on task graph threads,
+ * the same way the cooker preloads packages (see FLinkerLoad::TryGetPreloadedLoader), so that the loads of the imports mostly find their
+ * headers in memory instead of each doing its own synchronous open and reads. Prefetched packages that don't get loaded are dropped,
+ * oldest first, once more than linker.ImportPrefetchCount are pending, and all of them are closed when the outermost load ends so that
+ * no file handles are kept open between loads (e.g. while packages are saved or deleted).
+ */
+namespace LinkerLoadImportPrefetch
+{
+	struct FPrefetchedPackage
+	{
+		/** Written by the open on a task graph thread, only read after Archive has finished initializing */
+		FOpenPackageResult OpenResult;
+		TUniquePtr<FPreloadableArchive> Archive;
+		/** Identifies this prefetch in PrefetchOrder, which still holds the entries of prefetches that were taken */
+		uint64 Serial = 0;
+	};
+
+	static FCriticalSection CriticalSection;
+	static TMap<FName, TUniquePtr<FPrefetchedPackage>> PrefetchedPackages;
+	/** The package names and serials of the prefetches, oldest first. Entries of taken prefetches are skipped when they reach the front. */
+	static TRingBuffer<TPair<FName, uint64>> PrefetchOrder;
+	static uint64 NextSerial = 0;
+
+	static bool IsEnabled()
+	{
+		return GLinkerLoadImportPrefetchCount > 0 &&
+			!GEventDrivenLoaderEnabled &&
+			!FPlatformProperties::RequiresCookedData() &&
+			!GAllowCookedDataInEditorBuilds &&
+			!FLinkerLoad::GetPreloadingEnabled(); // The cooker schedules its own preloads
+	}
+
+	static void Prefetch(FName PackageName)
+	{
+		FPackagePath PackagePath;
+		if (!FPackagePath::TryFromPackageName(PackageName, PackagePath))
+		{
+			return;
+		}
+
+		TUniquePtr<FPrefetchedPackage> PrefetchedPackage;
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (PrefetchedPackages.Contains(PackageName))
+			{
+				return;
+			}
+			while (PrefetchedPackages.Num() >= GLinkerLoadImportPrefetchCount && !PrefetchOrder.IsEmpty())
+			{
+				const TPair<FName, uint64> Oldest = PrefetchOrder.PopFrontValue();
+				const TUniquePtr<FPrefetchedPackage>* OldestPackage = PrefetchedPackages.Find(Oldest.Key);
+				if (OldestPackage && (*OldestPackage)->Serial == Oldest.Value)
+				{
+					PrefetchedPackage = PrefetchedPackages.FindAndRemoveChecked(Oldest.Key);
+					break;
+				}
+			}
+		}
+		// Destroy the evicted package outside of the lock, as it waits for its open to finish
+		PrefetchedPackage.Reset();
+
+		PrefetchedPackage = MakeUnique<FPrefetchedPackage>();
+		TStringBuilder<256> PackageNameString;
+		PackageName.ToString(PackageNameString);
+		PrefetchedPackage->Archive = MakeUnique<FPreloadableArchive>(PackageNameString.ToView());
+		PrefetchedPackage->Archive->InitializeAsync([PackagePath, OpenResult = &PrefetchedPackage->OpenResult]()
+			{
+				FOpenPackageResult Result = IPackageResourceManager::Get().OpenReadPackage(PackagePath);
+				if (Result.Archive)
+				{
+					OpenResult->CopyMetaData(Result);
+				}
+				return Result.Archive.Release();
+			},
+			FPreloadableArchive::Flags::PreloadHandle | FPreloadableArchive::Flags::Prime, FPreloadableArchive::DefaultPageSize);
+
+		FScopeLock Lock(&CriticalSection);
+		if (!PrefetchedPackages.Contains(PackageName))
+		{
+			PrefetchedPackage->Serial = NextSerial++;
+			PrefetchOrder.Emplace(PackageName, PrefetchedPackage->Serial);
+			PrefetchedPackages.Add(PackageName, MoveTemp(PrefetchedPackage));
+		}
+	}
+
+	static bool TryTake(const FPackagePath& PackagePath, FOpenPackageResult& OutResult)
+	{
+		TUniquePtr<FPrefetchedPackage> PrefetchedPackage;
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (PrefetchedPackages.IsEmpty() || !PrefetchedPackages.RemoveAndCopyValue(PackagePath.GetPackageFName(), PrefetchedPackage))
+			{
+				return false;
+			}
+			if (PrefetchedPackages.IsEmpty())
+			{
+				PrefetchOrder.Reset();
+			}
+		}
+
+		// The open is already in flight, waiting for it is cheaper than opening the package again
+		PrefetchedPackage->Archive->WaitForInitialization();
+		if (PrefetchedPackage->Archive->TotalSize() < 0)
+		{
+			return false;
+		}
+		OutResult.CopyMetaData(PrefetchedPackage->OpenResult);
+		OutResult.Archive.Reset(PrefetchedPackage->Archive->DetachLowerLevel());
+		return OutResult.Archive.IsValid();
+	}
+
+	static void Flush()
+	{
+		TMap<FName, TUniquePtr<FPrefetchedPackage>> UnusedPackages;
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (PrefetchedPackages.IsEmpty())
+			{
+				return;
+			}
+			UnusedPackages = MoveTemp(PrefetchedPackages);
+			PrefetchedPackages.Reset();
+			PrefetchOrder.Reset();
+		}
+		// Destroyed outside of the lock, as they wait for their opens to finish
+	}
+}
+
+void FLinkerLoad::FlushImportPrefetches()
+{
+	LinkerLoadImportPrefetch::Flush();
+}
 #endif // WITH_EDITOR
 
 
@@ -1064,6 +1208,10 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::CreateLoader(
 			{
 				// OpenResult set by TryGetPreloadedLoader
 			}
+			else if (LinkerLoadImportPrefetch::TryTake(GetPackagePath(), OpenResult))
+			{
+				// OpenResult set by the linker that imports this package, see PrefetchImportPackages
+			}
 			else
 #endif
 			{
@@ -1856,12 +2004,42 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::FixupImportMap()
 			}
 		}
 
+#if WITH_EDITOR
+		PrefetchImportPackages();
+#endif
+
 		// Avoid duplicate work in async case.
 		bHasFixedUpImportMap = true;
 	}
 	return IsTimeLimitExceeded( TEXT("fixing up import map") ) ? LINKER_TimedOut : LINKER_Loaded;
 }
 
+#if WITH_EDITOR
+void FLinkerLoad::PrefetchImportPackages()
+{
+	if (!LinkerLoadImportPrefetch::IsEnabled() || IsTextFormat())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FLinkerLoad::PrefetchImportPackages);
+	for (const FObjectImport& Import : ImportMap)
+	{
+		if (!Import.OuterIndex.IsNull() || Import.ClassName != NAME_Package || Import.ObjectName.IsNone())
+		{
+			continue;
+		}
+		TStringBuilder<256> ImportPackageName;
+		Import.ObjectName.ToString(ImportPackageName);
+		if (FPackageName::IsScriptPackage(ImportPackageName.ToView()) || FindObjectFast<UPackage>(nullptr, Import.ObjectName))
+		{
+			continue;
+		}
+		LinkerLoadImportPrefetch::Prefetch(Import.ObjectName);
+	}
+}
+#endif
+
 FLinkerLoad::ELinkerStatus FLinkerLoad::PopulateInstancingContext()
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FLinkerLoad::PopulateInstancingContext"), STAT_LinkerLoad_PopulateInstancingContext, STATGROUP_LinkerLoad);
@@ -1832,6 +1832,9 @@ void EndLoad(FUObjectSerializeContext* LoadContext, TArray<UPackage*>* OutLoaded
 		{
 			LoadContext->DetachFromLinkers();
 		}
+#if WITH_EDITOR
+		FLinkerLoad::FlushImportPrefetches();
+#endif
 	}
 
 	if (OutLoadedPackages)
@@ -0,0 +1,266 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include "Serialization/BulkData.h"
+
+/** A resident chunk of streamed bulk data. The chunk isn't evicted while references to it are held. */
+struct COREUOBJECT_API FBulkDataStreamedChunk
+{
+	FBulkDataStreamedChunk(int32 InIndex, int64 InOffset, int64 InSize, uint8* InData)
+		: Index(InIndex)
+		, Offset(InOffset)
+		, Size(InSize)
+		, Data(InData)
+	{
+	}
+
+	~FBulkDataStreamedChunk();
+
+	FBulkDataStreamedChunk(const FBulkDataStreamedChunk&) = delete;
+	FBulkDataStreamedChunk& operator=(const FBulkDataStreamedChunk&) = delete;
+
+	TArrayView<const uint8> GetView() const
+	{
+		return TArrayView<const uint8>(Data, IntCastChecked<int32>(Size));
+	}
+
+	/** Index of the chunk in the bulk data */
+	const int32 Index;
+	/** Offset of the chunk in the bulk data */
+	const int64 Offset;
+	const int64 Size;
+	const uint8* const Data;
+};
+
+using FBulkDataStreamedChunkRef = TSharedRef<const FBulkDataStreamedChunk, ESPMode::ThreadSafe>;
+
+enum class EBulkDataStreamStatus : uint8
+{
+	Ok,
+	/** The request was cancelled, or the streamer was destroyed before the request completed */
+	Cancelled,
+	/** At least one chunk of the range could not be read */
+	Failed,
+};
+
+/** The result of a range request, holds references to the chunks covering the range */
+struct COREUOBJECT_API FBulkDataStreamedRange
+{
+	EBulkDataStreamStatus Status = EBulkDataStreamStatus::Cancelled;
+	/** The requested range, the chunks may extend before and after it */
+	int64 Offset = 0;
+	int64 Size = 0;
+	/** The chunks covering the range in order, empty unless Status is Ok */
+	TArray<FBulkDataStreamedChunkRef> Chunks;
+
+	bool IsOk() const
+	{
+		return Status == EBulkDataStreamStatus::Ok;
+	}
+
+	/** Copies the requested range out of the chunks, Dst must hold at least Size bytes */
+	void CopyTo(void* Dst) const;
+};
+
+using FBulkDataStreamedRangeCallback = TUniqueFunction<void(FBulkDataStreamedRange&& Range)>;
+
+/**
+ * Streams a bulk data payload in fixed size chunks.
+ *
+ * Any number of ranges of the payload can be requested at once. Each request is split into the chunks covering it, chunks that are already
+ * resident are reused and the missing ones are read through FBulkDataInterface::CreateStreamingRequest, so both the IoDispatcher and the
+ * file based loading paths are supported. Reads are issued highest priority first and at most MaxReadsInFlight at a time, the priority of a
+ * chunk being the highest of the requests waiting for it.
+ *
+ * Read chunks stay resident until more than MaxResidentSize bytes are resident, at which point the least recently used chunks that aren't
+ * referenced outside of the streamer are freed. Chunk memory is tracked under the LLM tag given in the settings.
+ *
+ * The bulk data must outlive the streamer, and must be loadable from disk. Data that isn't stored in bulk data can be streamed by providing
+ * the function issuing the reads instead.
+ */
+class COREUOBJECT_API FBulkDataChunkStreamer
+{
+public:
+	struct FSettings
+	{
+		/** The size of the chunks the bulk data is split into, the last chunk may be smaller */
+		int64 ChunkSize = 256 * 1024;
+		/** Resident chunks are evicted past this size, chunks that are referenced or being read are not evicted and may exceed it */
+		int64 MaxResidentSize = 16 * 1024 * 1024;
+		/** Maximum number of chunk reads in flight */
+		int32 MaxReadsInFlight = 8;
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		ELLMTag LLMTag = ELLMTag::StreamingManager;
+#endif
+	};
+
+	/** Identifies a range request, 0 is never a valid id */
+	using FRequestId = uint32;
+
+	/** Issues the read of a range of the data into the given memory, with the same contract as FBulkDataInterface::CreateStreamingRequest */
+	using FIssueReadFunction = TFunction<IBulkDataIORequest*(int64 Offset, int64 Size, EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* Callback, uint8* UserSuppliedMemory)>;
+
+	FBulkDataChunkStreamer(const FBulkDataInterface& InBulkData, const FSettings& InSettings);
+
+	/** Streams DataSize bytes read by IssueRead */
+	FBulkDataChunkStreamer(int64 InDataSize, FIssueReadFunction&& InIssueRead, const FSettings& InSettings);
+
+	/** Cancels the pending requests, calling their callbacks, and waits for the reads in flight */
+	~FBulkDataChunkStreamer();
+
+	FBulkDataChunkStreamer(const FBulkDataChunkStreamer&) = delete;
+	FBulkDataChunkStreamer& operator=(const FBulkDataChunkStreamer&) = delete;
+
+	int64 GetChunkSize() const
+	{
+		return Settings.ChunkSize;
+	}
+
+	int32 GetNumChunks() const
+	{
+		return Chunks.Num();
+	}
+
+	int64 GetBulkDataSize() const
+	{
+		return BulkDataSize;
+	}
+
+	/**
+	 * Requests a range of the bulk data.
+	 *
+	 * @param Offset		Offset of the range in the bulk data.
+	 * @param Size			Size of the range, the range must be contained in the bulk data.
+	 * @param Priority		Priority of the reads of the range, only the priority bits are used.
+	 * @param Callback		Always called exactly once, on the calling thread if the whole range is resident, else from the thread completing
+	 *						the last read of the range or cancelling the request. The callback can make new requests.
+	 * @return				The id of the request, which can be used to change its priority or cancel it until the callback is called.
+	 */
+	FRequestId RequestRange(int64 Offset, int64 Size, EAsyncIOPriorityAndFlags Priority, FBulkDataStreamedRangeCallback&& Callback);
+
+	/** Changes the priority of the reads of a request that haven't been issued yet */
+	void UpdatePriority(FRequestId RequestId, EAsyncIOPriorityAndFlags Priority);
+
+	/** Cancels a request, its callback is called with EBulkDataStreamStatus::Cancelled unless it has already completed */
+	void CancelRequest(FRequestId RequestId);
+
+	/** Returns the chunk if it is resident, without reading it */
+	TSharedPtr<const FBulkDataStreamedChunk, ESPMode::ThreadSafe> TryGetResidentChunk(int32 ChunkIndex);
+
+	/** Frees all resident chunks that aren't referenced outside of the streamer */
+	void TrimResidentChunks();
+
+	/** The memory used by resident chunks and reads in flight */
+	int64 GetResidentSize() const
+	{
+		FScopeLock Lock(&CriticalSection);
+		return ResidentSize;
+	}
+
+private:
+	enum class EChunkState : uint8
+	{
+		NotResident,
+		Queued,
+		Reading,
+		Resident,
+	};
+
+	struct FChunk
+	{
+		TSharedPtr<const FBulkDataStreamedChunk, ESPMode::ThreadSafe> Resident;
+		/** Set once the read is issued, null while it is being issued */
+		IBulkDataIORequest* IORequest = nullptr;
+		uint8* ReadBuffer = nullptr;
+		/** The pending requests covering the chunk, the chunk isn't evicted while it has waiters */
+		TArray<FRequestId, TInlineAllocator<2>> Waiters;
+		/** Neighbours in the eviction order, which links the resident chunks without waiters from least to most recently used */
+		int32 LruPrev = INDEX_NONE;
+		int32 LruNext = INDEX_NONE;
+		bool bInLru = false;
+		/** Tick of the queuing of the chunk, reads of the same priority are issued in queuing order */
+		uint64 QueuedTick = 0;
+		/** Incremented when a read is issued, to tell the issuing thread whether the read completed while it was being issued */
+		uint32 ReadSerial = 0;
+		EAsyncIOPriorityAndFlags Priority = AIOP_MIN;
+		EChunkState State = EChunkState::NotResident;
+		/** The read was cancelled because no request needs the chunk anymore */
+		bool bCancelIssued = false;
+	};
+
+	struct FRequest
+	{
+		FBulkDataStreamedRangeCallback Callback;
+		FBulkDataStreamedRange Range;
+		int32 FirstChunk = 0;
+		int32 LastChunk = -1;
+		int32 ChunksRemaining = 0;
+		EAsyncIOPriorityAndFlags Priority = AIOP_MIN;
+		bool bFailed = false;
+	};
+
+	struct FCompletedRequest
+	{
+		FBulkDataStreamedRangeCallback Callback;
+		FBulkDataStreamedRange Range;
+	};
+
+	struct FReadToIssue
+	{
+		int32 ChunkIndex;
+		uint32 ReadSerial;
+		uint8* ReadBuffer;
+		EAsyncIOPriorityAndFlags Priority;
+	};
+
+	int64 GetChunkOffset(int32 ChunkIndex) const
+	{
+		return int64(ChunkIndex) * Settings.ChunkSize;
+	}
+
+	int64 GetSizeOfChunk(int32 ChunkIndex) const
+	{
+		return FMath::Min(Settings.ChunkSize, BulkDataSize - GetChunkOffset(ChunkIndex));
+	}
+
+	void OnReadComplete(int32 ChunkIndex, uint32 ReadSerial, bool bWasCancelled, IBulkDataIORequest* IORequest);
+	void FinishRead(int32 ChunkIndex, bool bWasCancelled, TArray<FCompletedRequest>& OutCompletedRequests);
+	void CompleteChunk(int32 ChunkIndex, bool bFailed, TArray<FCompletedRequest>& OutCompletedRequests);
+	void CompleteRequest(FRequestId RequestId, EBulkDataStreamStatus Status, TArray<FCompletedRequest>& OutCompletedRequests);
+	void QueueChunk(int32 ChunkIndex);
+	void ReleaseChunk(int32 ChunkIndex);
+	void UpdateChunkPriority(int32 ChunkIndex);
+	void UpdateLru(int32 ChunkIndex);
+	void UnlinkLru(int32 ChunkIndex);
+	void EvictChunks(int64 TargetResidentSize);
+	void PumpReads();
+	void IssueRead(const FReadToIssue& Read, TArray<FCompletedRequest>& OutCompletedRequests);
+	void DeleteFinishedIORequests();
+	static void CallCallbacks(TArray<FCompletedRequest>& CompletedRequests);
+
+	const FIssueReadFunction IssueReadFunction;
+	const FSettings Settings;
+	const int64 BulkDataSize;
+
+	mutable FCriticalSection CriticalSection;
+	TArray<FChunk> Chunks;
+	TMap<FRequestId, FRequest> Requests;
+	/** Chunks waiting for their read to be issued */
+	TArray<int32> QueuedChunks;
+	/** The least and most recently used chunks which can be evicted */
+	int32 LruHead = INDEX_NONE;
+	int32 LruTail = INDEX_NONE;
+	/** Reads whose callback has been called, deleted by the next call on the streamer as they can't be deleted from their callback */
+	TArray<IBulkDataIORequest*> FinishedIORequests;
+	int64 ResidentSize = 0;
+	int32 ReadsInFlight = 0;
+	FRequestId NextRequestId = 1;
+	uint64 NextTick = 1;
+};
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+#if WITH_CPP_COROUTINES
+
+#include "Tasks/Coroutine.h"
+#include "Serialization/BulkData.h"
+
+namespace UE { namespace Tasks
+{
+	// streams the bulk data (or a range of it) asynchronously, the coroutine is resumed when the request is completed. The returned request
+	// is completed, `GetReadResults()` returns the data or null if the read failed or was cancelled. The request is null if it couldn't be
+	// issued, e.g. if the bulk data can't be loaded from disk:
+	//	TUniquePtr<IBulkDataIORequest> Request = co_await UE::Tasks::ReadAsync(BulkData, AIOP_Normal);
+	// Accepts both `FBulkDataBase` and `FUntypedBulkData`.
+	template<typename BulkDataType, decltype(std::declval<const BulkDataType&>().CreateStreamingRequest(AIOP_Normal, nullptr, nullptr))* = nullptr>
+	auto ReadAsync(const BulkDataType& BulkData, EAsyncIOPriorityAndFlags Priority = AIOP_Normal, uint8* UserSuppliedMemory = nullptr)
+	{
+		auto IssueRequest = [&BulkData, Priority, UserSuppliedMemory](FBulkDataIORequestCallBack* Callback)
+		{
+			return BulkData.CreateStreamingRequest(Priority, Callback, UserSuppliedMemory);
+		};
+		return Private::TAsyncRequestAwaiter<IBulkDataIORequest, FBulkDataIORequestCallBack, decltype(IssueRequest)>{ MoveTemp(IssueRequest) };
+	}
+
+	template<typename BulkDataType, decltype(std::declval<const BulkDataType&>().CreateStreamingRequest(AIOP_Normal, nullptr, nullptr))* = nullptr>
+	auto ReadAsync(const BulkDataType& BulkData, int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority = AIOP_Normal, uint8* UserSuppliedMemory = nullptr)
+	{
+		auto IssueRequest = [&BulkData, OffsetInBulkData, BytesToRead, Priority, UserSuppliedMemory](FBulkDataIORequestCallBack* Callback)
+		{
+			return BulkData.CreateStreamingRequest(OffsetInBulkData, BytesToRead, Priority, Callback, UserSuppliedMemory);
+		};
+		return Private::TAsyncRequestAwaiter<IBulkDataIORequest, FBulkDataIORequestCallBack, decltype(IssueRequest)>{ MoveTemp(IssueRequest) };
+	}
+}}
+
+#endif // WITH_CPP_COROUTINES
@@ -704,6 +704,8 @@ public:
 	COREUOBJECT_API static bool TryGetPreloadedLoader(const FPackagePath& InPackagePath, FOpenPackageResult& OutResult);
 	UE_DEPRECATED(5.0, "Use version that takes a PackagePath instead")
 	COREUOBJECT_API static bool TryGetPreloadedLoader(FArchive*& OutLoader, const TCHAR* FileName);
+	/** Closes import packages which were prefetched but not loaded (see linker.ImportPrefetchCount), called when the outermost load ends */
+	static void FlushImportPrefetches();
 	private:
 		static bool bPreloadingEnabled;
 	public:
@@ -1040,6 +1042,13 @@ private:
 	 */
 	ELinkerStatus FixupImportMap();
 
+#if WITH_EDITOR
+	/**
+	 * Starts opening the imported packages so their headers are read while this package is still loading.
+	 */
+	void PrefetchImportPackages();
+#endif
+
 	/**
 	 * Generate remapping for the instancing context if this is an instanced package.
 	 */
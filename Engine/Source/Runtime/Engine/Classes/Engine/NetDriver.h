@@ -16,6 +16,8 @@
 #include "Channel.h"
 #include "Net/Core/Misc/DDoSDetection.h"
 #include "IPAddress.h"
+#include "SocketTypes.h"
+#include "Net/NetReceiveThread.h"
 #include "Net/NetAnalyticsTypes.h"
 #include "Net/NetConnectionIdHandler.h"
 
@@ -340,6 +342,8 @@ extern ENGINE_API TAutoConsoleVariable<int32> CVarNetAllowEncryption;
 extern ENGINE_API int32 GNumSaturatedConnections;
 extern ENGINE_API int32 GNumSharedSerializationHit;
 extern ENGINE_API int32 GNumSharedSerializationMiss;
+extern ENGINE_API int64 GNumSharedSerializationBitsSaved;
+extern ENGINE_API int64 GNumFastArrayDeltaBitsSaved;
 extern ENGINE_API int32 GNumReplicateActorCalls;
 extern ENGINE_API bool GReplicateActorTimingEnabled;
 extern ENGINE_API bool GReceiveRPCTimingEnabled;
@@ -590,6 +594,66 @@ struct FCompareFActorPriority
 	}
 };
 
+/**
+ * Result of the relevancy/priority gather for one considered actor and connection.
+ * Gathering does not modify channel state, so that it can run on worker threads (see net.ParallelPrioritizeActors) -
+ * any channel changes it decides on are recorded here, and applied on the game thread in consider list order.
+ */
+struct FGatheredActorPriority
+{
+	/** The actor priority, if the actor should be prioritized for the connection */
+	FActorPriority	ActorPriority;
+
+	/** The actor is not owned by/relevant to the connection, and its channel should be closed */
+	bool			bCloseChannel;
+
+	/** The actor's channel should start becoming dormant */
+	bool			bStartBecomingDormant;
+
+	FGatheredActorPriority()
+		: bCloseChannel(false)
+		, bStartBecomingDormant(false)
+	{
+	}
+};
+
+/** The viewers and gathered actors for one connection, used when prioritizing connections in parallel */
+struct FConnectionGatheredActors
+{
+	/** The viewers for the connection (the connection, and its children) */
+	TArray<struct FNetViewer>		Viewers;
+
+	/** The gathered actors, in consider list order */
+	TArray<FGatheredActorPriority>	GatheredActors;
+
+	/** Whether or not actors were gathered for the connection this frame */
+	bool							bGathered = false;
+};
+
+/**
+ * Time spent in each phase of server replication, accumulated by a net driver while timing is enabled (see UNetDriver::SetReplicationPhaseTimings).
+ * Used for benchmarking replication, e.g. by UReplicationBenchmarkCommandlet.
+ */
+struct FNetReplicationPhaseTimings
+{
+	/** Time spent building the consider list, in FPlatformTime::Cycles64 */
+	uint64 BuildConsiderListCycles = 0;
+
+	/** Time spent gathering and prioritizing actors for each connection, in FPlatformTime::Cycles64 */
+	uint64 PrioritizeActorsCycles = 0;
+
+	/** Time spent replicating the prioritized actors for each connection, in FPlatformTime::Cycles64 */
+	uint64 ReplicatePropertiesCycles = 0;
+
+	/** Time spent ticking connections and flushing their send buffers in TickFlush, in FPlatformTime::Cycles64 */
+	uint64 FlushNetCycles = 0;
+
+	void Reset()
+	{
+		*this = FNetReplicationPhaseTimings();
+	}
+};
+
 /** Used to specify properties of a channel type */
 USTRUCT()
 struct ENGINE_API FChannelDefinition
@@ -876,7 +940,7 @@ public:
 	void ReleaseToChannelPool(UChannel* Channel);
 
 	/** Change the NetDriver's NetDriverName. This will also reinit packet simulation settings so that settings can be qualified to a specific driver. */
-	void SetNetDriverName(FName NewNetDriverNamed);
+	ENGINE_API void SetNetDriverName(FName NewNetDriverNamed);
 
 	void InitPacketSimulationSettings();
 
@@ -903,6 +967,34 @@ private:
 	/** Whether or not the NetDriver is ticking */
 	bool bInTick;
 
+	/** Whether or not outgoing packets are currently being collected for a batched send (see net.BatchedSend) */
+	bool bBatchingSends;
+
+	/** Packets queued for a batched send, for a single socket */
+	struct FBatchedSendQueue
+	{
+		/** The socket the packets will be sent on */
+		FSocket* Socket = nullptr;
+
+		/** The queued packets */
+		TUniquePtr<FSendMulti> SendData;
+	};
+
+	/** Batched send queues for each socket used by this net driver (typically only one) */
+	TArray<FBatchedSendQueue> BatchedSendQueues;
+
+	/** Receive threads started with StartReceiveThread, for each socket used by this net driver */
+	TArray<TUniquePtr<FNetReceiveThread>> ReceiveThreads;
+
+	/** Per-connection gather results for ServerReplicateActors, persisted between frames to avoid reallocation */
+	TArray<FConnectionGatheredActors> ConnectionGatheredActors;
+
+	/** The number of connection updates where the parallel gather differed from a serial gather (see net.ParallelPrioritizeActors.Validate) */
+	uint32 ParallelGatherMismatches = 0;
+
+	/** Receives the time spent in each replication phase, while replication phase timing is enabled */
+	FNetReplicationPhaseTimings* ReplicationPhaseTimings = nullptr;
+
 	bool bPendingDestruction;
 
 public:
@@ -1369,6 +1461,111 @@ public:
 	ENGINE_API virtual void LowLevelSend(TSharedPtr<const FInternetAddr> Address, void* Data, int32 CountBits, FOutPacketTraits& Traits)
 		PURE_VIRTUAL(UNetDriver::LowLevelSend,);
 
+	/** Whether or not considered actors are indexed by the net relevancy grid, to accelerate relevancy checks (see net.RelevancyGrid) */
+	ENGINE_API bool IsRelevancyGridEnabled() const;
+
+	/** Whether or not actors which haven't replicated anything for a while are moved into the quiescent set, and skipped until woken (see net.QuiescentActors) */
+	ENGINE_API bool AreQuiescentActorsEnabled() const;
+
+	/**
+	 * Whether or not fully processed outgoing packets should be queued with QueueBatchedSend, instead of being sent immediately.
+	 * Batching is only active during TickFlush, so that every connection's flushed packets are sent together at the end of the tick.
+	 */
+	ENGINE_API bool IsBatchedSendEnabled() const;
+
+	/**
+	 * Queues a fully processed packet (i.e. after PacketHandler processing) to be sent with FSocket::SendMulti at the end of TickFlush.
+	 * Net driver/connection subclasses which send through FSocket should call this in place of FSocket::SendTo, when batching is enabled.
+	 *
+	 * @param Socket		The socket the packet should be sent on
+	 * @param Address		The address the packet should be sent to
+	 * @param Data			The packet data
+	 * @param CountBytes	The size of the packet data, in bytes
+	 * @return				Whether or not the packet was queued - if false, the caller must send the packet itself
+	 */
+	ENGINE_API bool QueueBatchedSend(FSocket* Socket, const TSharedRef<const FInternetAddr>& Address, const uint8* Data, int32 CountBytes);
+
+	/**
+	 * Sends all packets queued by QueueBatchedSend, using as few socket calls as the platform allows
+	 */
+	ENGINE_API virtual void FlushBatchedSends();
+
+	/**
+	 * Sends any packets queued for the specified socket, and forgets the socket. Queues only hold a raw FSocket pointer,
+	 * so subclasses which close or destroy a socket passed to QueueBatchedSend must call this first.
+	 *
+	 * @param Socket	The socket which is about to be closed
+	 */
+	ENGINE_API void RemoveBatchedSends(FSocket* Socket);
+
+protected:
+	/** Sends any queued packets and releases every batched send queue - called from Shutdown and FinishDestroy, before sockets are destroyed */
+	ENGINE_API void ClearBatchedSends();
+
+private:
+	/** Sends the packets queued in a single batched send queue */
+	void FlushBatchedSendQueue(FBatchedSendQueue& Queue);
+
+public:
+
+	/** Whether or not net driver subclasses should receive packets on a dedicated receive thread (see net.ReceiveThread) */
+	ENGINE_API bool IsReceiveThreadEnabled() const;
+
+	/**
+	 * Starts a receive thread for the specified socket. Packets received by the thread are dispatched to connections
+	 * by UNetDriver::TickDispatch, and net driver subclasses should no longer read from the socket themselves.
+	 * StopReceiveThreads must be called before the socket is closed.
+	 *
+	 * @param Socket		The socket to receive from
+	 * @param PreProcess	Optional function run on the receive thread for each packet, e.g. to filter packets.
+	 *						PacketHandler processing always runs on the game thread, as handler components are not thread safe.
+	 * @return				The receive thread, or nullptr if it could not be started
+	 */
+	ENGINE_API FNetReceiveThread* StartReceiveThread(FSocket* Socket, FNetReceiveThread::FPreProcessFunc&& PreProcess=nullptr);
+
+	/** Stops all receive threads, and discards any packets which were not dispatched */
+	ENGINE_API void StopReceiveThreads();
+
+	/** Whether or not any receive threads are running */
+	bool HasReceiveThreads() const
+	{
+		return ReceiveThreads.Num() > 0;
+	}
+
+	/**
+	 * Dispatches all packets queued by receive threads to their connections, in the order they were received.
+	 * Called by UNetDriver::TickDispatch, after the connections' PreTickDispatch.
+	 */
+	ENGINE_API void DispatchReceiveThreadPackets();
+
+	/**
+	 * Enables accumulating the time spent in each phase of ServerReplicateActors and TickFlush into the specified timings,
+	 * or disables it if nullptr. The timings must remain valid until timing is disabled.
+	 *
+	 * @param InTimings		The timings to accumulate into
+	 */
+	void SetReplicationPhaseTimings(FNetReplicationPhaseTimings* InTimings)
+	{
+		ReplicationPhaseTimings = InTimings;
+	}
+
+	/** The number of connection updates where the parallel and serial actor gathers differed, while net.ParallelPrioritizeActors.Validate is enabled */
+	uint32 GetParallelGatherMismatches() const
+	{
+		return ParallelGatherMismatches;
+	}
+
+protected:
+	/**
+	 * Handles a packet dequeued from a receive thread, which does not belong to a connection - e.g. a connectionless handshake packet
+	 * or a socket error. The default implementation drops the packet.
+	 *
+	 * @param Packet	The received packet
+	 */
+	ENGINE_API virtual void ProcessReceiveThreadUnmappedPacket(FNetReceivedPacket& Packet);
+
+public:
+
 	/**
 	 * Process any local talker packets that need to be sent to clients
 	 */
@@ -1436,6 +1633,13 @@ public:
 	/** Force this actor to be relevant for at least one update */
 	ENGINE_API void ForceActorRelevantNextUpdate(AActor* Actor);
 
+	/**
+	 * Wakes a quiescent actor, so that it's considered for replication again (see net.QuiescentActors).
+	 * Push model property changes, RPCs, ForceNetUpdate and dormancy changes wake actors automatically,
+	 * but changes to properties which don't use push model need this (when net.QuiescentActorsAllowNonPushModel is enabled).
+	 */
+	ENGINE_API void WakeQuiescentActor(AActor* Actor);
+
 	/** Tells the net driver about a networked actor that was spawned */
 	ENGINE_API void AddNetworkActor(AActor* Actor);
 
@@ -1670,7 +1874,13 @@ protected:
 	int32 ServerReplicateActors_PrepConnections( const float DeltaSeconds );
 	void ServerReplicateActors_BuildConsiderList( TArray<FNetworkObjectInfo*>& OutConsiderList, const float ServerTickTime );
 	int32 ServerReplicateActors_PrioritizeActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*> ConsiderList, const bool bCPUSaturated, FActorPriority*& OutPriorityList, FActorPriority**& OutPriorityActors );
+	void ServerReplicateActors_GatherActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*>& ConsiderList, TArray<FGatheredActorPriority>& OutGatheredActors ) const;
+	void ServerReplicateActors_GatherActorsParallel( const int32 NumClientsToTick, const TArray<FNetworkObjectInfo*>& ConsiderList, const float DeltaSeconds );
+	bool ServerReplicateActors_ValidateGatheredActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*>& ConsiderList, const TArray<FGatheredActorPriority>& GatheredActors ) const;
+	int32 ServerReplicateActors_PrioritizeGatheredActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FGatheredActorPriority>& GatheredActors, FActorPriority*& OutPriorityList, FActorPriority**& OutPriorityActors );
 	int32 ServerReplicateActors_ProcessPrioritizedActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, FActorPriority** PriorityActors, const int32 FinalSortedCount, int32& OutUpdated );
+	void ServerReplicateActors_WakeQuiescentActors();
+	bool ServerReplicateActors_CanActorBecomeQuiescent( FNetworkObjectInfo& ActorInfo ) const;
 #endif
 
 	/** Used to handle any NetDriver specific cleanup once a level has been removed from the world. */
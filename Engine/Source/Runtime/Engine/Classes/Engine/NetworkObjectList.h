@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Engine/NetConnection.h"
+#include "Net/NetRelevancyGrid.h"
 
 class AActor;
 class FArchive;
+class FReplicationChangelistMgr;
 
 /**
  * Struct to store an actor pointer and any internal metadata for that actor used
@@ -51,9 +53,24 @@ struct FNetworkObjectInfo
 	/** Should channel swap roles while calling ReplicateActor */
 	uint8 bSwapRolesOnReplicate : 1;
 
+	/** Is this object quiescent, in which case it isn't considered for replication until woken (see net.QuiescentActors) */
+	uint8 bQuiescent : 1;
+
+	/** Was this object woken from quiescence, and not yet considered for replication since */
+	uint8 bWokenFromQuiescence : 1;
+
 	/** Force this object to be considered relevant for at least one update */
 	uint32 ForceRelevantFrame = 0;
 
+	/** Index of this object within the net relevancy grid, or INDEX_NONE if not indexed (see FNetRelevancyGrid) */
+	int32 RelevancyGridIndex = INDEX_NONE;
+
+	/** Last time this object became quiescent, based on World->TimeSeconds */
+	double QuiescentTime = 0.0;
+
+	/** Changelist managers for the push model replicated objects (the actor and its subobjects) of a quiescent object, which wake it when dirtied */
+	TArray<TWeakPtr<FReplicationChangelistMgr>> QuiescentChangelistMgrs;
+
 	FNetworkObjectInfo()
 		: Actor(nullptr)
 		, NextUpdateTime(0.0)
@@ -62,7 +79,9 @@ struct FNetworkObjectInfo
 		, LastNetUpdateTimestamp(0.0)
 		, bPendingNetUpdate(false)
 		, bDirtyForReplay(false)
-		, bSwapRolesOnReplicate(false) {}
+		, bSwapRolesOnReplicate(false)
+		, bQuiescent(false)
+		, bWokenFromQuiescence(false) {}
 
 	FNetworkObjectInfo(AActor* InActor)
 		: Actor(InActor)
@@ -73,7 +92,9 @@ struct FNetworkObjectInfo
 		, LastNetUpdateTimestamp(0.0)
 		, bPendingNetUpdate(false)
 		, bDirtyForReplay(false)
-		, bSwapRolesOnReplicate(false) {}
+		, bSwapRolesOnReplicate(false)
+		, bQuiescent(false)
+		, bWokenFromQuiescence(false) {}
 
 	void CountBytes(FArchive& Ar) const;
 };
@@ -171,6 +192,15 @@ public:
 	/** Clears all state related to dormancy */
 	void ResetDormancyState();
 
+	/** Moves this object from the active list to the quiescent list, where it isn't considered for replication until woken */
+	void MarkQuiescent(AActor* const Actor);
+
+	/** Moves this object from the quiescent list back to the active list. Returns true if the object was quiescent. */
+	bool WakeQuiescent(AActor* const Actor);
+
+	/** Moves all quiescent objects back to the active list */
+	void WakeAllQuiescent();
+
 	/** Returns a const reference to the entire set of tracked actors. */
 	const FNetworkObjectSet& GetAllObjects() const { return AllNetworkObjects; }
 
@@ -180,19 +210,32 @@ public:
 	/** Returns a const reference to the entire set of dormant actors. */
 	const FNetworkObjectSet& GetDormantObjectsOnAllConnections() const { return ObjectsDormantOnAllConnections; }
 
+	/** Returns a const reference to the set of quiescent actors, which aren't considered for replication until woken. */
+	const FNetworkObjectSet& GetQuiescentObjects() const { return QuiescentNetworkObjects; }
+
 	int32 GetNumDormantActorsForConnection( UNetConnection* const Connection ) const;
 
 	/** Force this actor to be relevant for at least one update */
 	void ForceActorRelevantNextUpdate(AActor* const Actor, UNetDriver* NetDriver);
+
+	/** Returns the spatial index of tracked actor locations, used to accelerate relevancy checks (see net.RelevancyGrid) */
+	FNetRelevancyGrid& GetRelevancyGrid() { return RelevancyGrid; }
+	const FNetRelevancyGrid& GetRelevancyGrid() const { return RelevancyGrid; }
 		
 	void Reset();
 
 	void CountBytes(FArchive& Ar) const;
 
 private:
+	/** Moves a quiescent object back to the active list */
+	void WakeQuiescentInternal(const TSharedPtr<FNetworkObjectInfo>& NetworkObjectInfo);
+
 	FNetworkObjectSet AllNetworkObjects;
 	FNetworkObjectSet ActiveNetworkObjects;
 	FNetworkObjectSet ObjectsDormantOnAllConnections;
+	FNetworkObjectSet QuiescentNetworkObjects;
 
 	TMap<TWeakObjectPtr<UNetConnection>, int32 > NumDormantObjectsPerConnection;
+
+	FNetRelevancyGrid RelevancyGrid;
 };
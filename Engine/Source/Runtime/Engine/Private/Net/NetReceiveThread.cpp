@@ -0,0 +1,270 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Net/NetReceiveThread.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "IPAddress.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "UObject/CoreNet.h"
+
+static int32 GNetReceiveThreadRecvMultiPackets = 128;
+static FAutoConsoleVariableRef CVarNetReceiveThreadRecvMultiPackets(
+	TEXT("net.ReceiveThreadRecvMultiPackets"),
+	GNetReceiveThreadRecvMultiPackets,
+	TEXT("The maximum number of packets received per FSocket::RecvMulti call, by net receive threads. Only applies to newly started threads."),
+	ECVF_Default);
+
+static int32 GNetReceiveThreadWaitTimeMS = 10;
+static FAutoConsoleVariableRef CVarNetReceiveThreadWaitTimeMS(
+	TEXT("net.ReceiveThreadWaitTimeMS"),
+	GNetReceiveThreadWaitTimeMS,
+	TEXT("The maximum time net receive threads block waiting for data, before checking whether they should exit. Only applies to newly started threads."),
+	ECVF_Default);
+
+
+FNetReceiveThread::FNetReceiveThread(FSocket* InSocket, ISocketSubsystem* InSocketSubsystem, int32 InMaxQueuedPackets, FPreProcessFunc&& InPreProcess)
+	: Socket(InSocket)
+	, SocketSubsystem(InSocketSubsystem)
+	, PreProcess(MoveTemp(InPreProcess))
+	, NumQueuedPackets(0)
+	, NumDroppedPackets(0)
+	, bStopRequested(false)
+	, MaxQueuedPackets(FMath::Max(InMaxQueuedPackets, 1))
+	, WaitTime(FTimespan::FromMilliseconds(FMath::Max(GNetReceiveThreadWaitTimeMS, 1)))
+	, Thread(nullptr)
+{
+	check(Socket != nullptr);
+	check(SocketSubsystem != nullptr);
+
+	if (SocketSubsystem->IsSocketRecvMultiSupported())
+	{
+		RecvMultiState = SocketSubsystem->CreateRecvMulti(FMath::Max(GNetReceiveThreadRecvMultiPackets, 1), MAX_PACKET_SIZE);
+	}
+}
+
+FNetReceiveThread::~FNetReceiveThread()
+{
+	StopThread();
+}
+
+bool FNetReceiveThread::StartThread(const TCHAR* ThreadName)
+{
+	check(Thread == nullptr);
+
+	bStopRequested = false;
+	Thread = FRunnableThread::Create(this, ThreadName, 128 * 1024, TPri_AboveNormal);
+
+	return Thread != nullptr;
+}
+
+void FNetReceiveThread::StopThread()
+{
+	if (Thread != nullptr)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+int32 FNetReceiveThread::DequeuePackets(TFunctionRef<void(FNetReceivedPacket&)> PacketFunc, int32 MaxPackets)
+{
+	int32 NumDequeued = 0;
+
+	while (NumDequeued < MaxPackets)
+	{
+		TOptional<TUniquePtr<FNetReceivedPacket>> Packet = ReceivedPackets.Dequeue();
+
+		if (!Packet.IsSet())
+		{
+			break;
+		}
+
+		NumQueuedPackets.fetch_sub(1, std::memory_order_relaxed);
+		NumDequeued++;
+
+		PacketFunc(*Packet.GetValue());
+
+		FreePackets.Enqueue(MoveTemp(Packet.GetValue()));
+	}
+
+	return NumDequeued;
+}
+
+uint32 FNetReceiveThread::Run()
+{
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		const double WaitStartTime = FPlatformTime::Seconds();
+
+		if (Socket->Wait(ESocketWaitConditions::WaitForRead, WaitTime))
+		{
+			if (RecvMultiState.IsValid())
+			{
+				ReceiveMulti();
+			}
+			else
+			{
+				ReceiveSingle();
+			}
+		}
+		else if (FPlatformTime::Seconds() - WaitStartTime < WaitTime.GetTotalSeconds() * 0.5)
+		{
+			// Wait returned well before timing out, so it failed (e.g. the socket was closed) - retrying immediately would spin
+			const ESocketErrors Error = SocketSubsystem->GetLastErrorCode();
+			TUniquePtr<FNetReceivedPacket> Packet = AllocPacket();
+
+			Packet->Address->SetAnyAddress();
+
+			EnqueueSocketError(MoveTemp(Packet), Error);
+
+			if (Error == SE_EBADF || Error == SE_ENOTSOCK)
+			{
+				break;
+			}
+
+			FPlatformProcess::SleepNoStats(WaitTime.GetTotalSeconds());
+		}
+	}
+
+	return 0;
+}
+
+void FNetReceiveThread::Stop()
+{
+	bStopRequested = true;
+}
+
+void FNetReceiveThread::ReceiveMulti()
+{
+	FRecvMulti& RecvMulti = *RecvMultiState;
+
+	// Keep draining full batches, so that a burst of packets doesn't wait on another Wait call
+	while (!bStopRequested.load(std::memory_order_relaxed) && Socket->RecvMulti(RecvMulti))
+	{
+		const int32 NumPackets = RecvMulti.GetNumPackets();
+		const double ReceiveTime = FPlatformTime::Seconds();
+
+		for (int32 PacketIdx = 0; PacketIdx < NumPackets; PacketIdx++)
+		{
+			FReceivedPacketView PacketView;
+
+			RecvMulti.GetPacket(PacketIdx, PacketView);
+
+			TUniquePtr<FNetReceivedPacket> Packet = AllocPacket();
+			const int32 NumBytes = PacketView.DataView.NumBytes();
+
+			Packet->Data.SetNumUninitialized(NumBytes, false);
+			FMemory::Memcpy(Packet->Data.GetData(), PacketView.DataView.GetData(), NumBytes);
+
+			// RecvMulti reuses its address objects for each call, so the game thread needs its own copy
+			Packet->NumBytes = NumBytes;
+			Packet->Address = PacketView.Address->Clone();
+			Packet->ReceiveTime = ReceiveTime;
+
+			EnqueuePacket(MoveTemp(Packet));
+		}
+
+		if (NumPackets < RecvMulti.MaxNumPackets)
+		{
+			return;
+		}
+	}
+
+	if (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		// RecvMulti doesn't report which address an error is associated with, so the error is passed on with an unspecified address
+		const ESocketErrors Error = SocketSubsystem->GetLastErrorCode();
+		TUniquePtr<FNetReceivedPacket> Packet = AllocPacket();
+
+		Packet->Address->SetAnyAddress();
+
+		EnqueueSocketError(MoveTemp(Packet), Error);
+	}
+}
+
+void FNetReceiveThread::ReceiveSingle()
+{
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		TUniquePtr<FNetReceivedPacket> Packet = AllocPacket();
+		int32 BytesRead = 0;
+
+		Packet->Data.SetNumUninitialized(MAX_PACKET_SIZE, false);
+
+		const bool bReceived = Socket->RecvFrom(Packet->Data.GetData(), MAX_PACKET_SIZE, BytesRead, *Packet->Address);
+
+		if (bReceived && BytesRead > 0)
+		{
+			Packet->NumBytes = BytesRead;
+			Packet->ReceiveTime = FPlatformTime::Seconds();
+
+			EnqueuePacket(MoveTemp(Packet));
+		}
+		else
+		{
+			if (bReceived)
+			{
+				FreePackets.Enqueue(MoveTemp(Packet));
+			}
+			else
+			{
+				EnqueueSocketError(MoveTemp(Packet), SocketSubsystem->GetLastErrorCode());
+			}
+
+			break;
+		}
+	}
+}
+
+TUniquePtr<FNetReceivedPacket> FNetReceiveThread::AllocPacket()
+{
+	TOptional<TUniquePtr<FNetReceivedPacket>> FreePacket = FreePackets.Dequeue();
+	TUniquePtr<FNetReceivedPacket> Packet = FreePacket.IsSet() ? MoveTemp(FreePacket.GetValue()) : MakeUnique<FNetReceivedPacket>();
+
+	// The game thread may have kept a reference to the address (e.g. for a new connection), in which case it can't be reused
+	if (!Packet->Address.IsValid() || !Packet->Address.IsUnique())
+	{
+		Packet->Address = SocketSubsystem->CreateInternetAddr();
+	}
+
+	Packet->NumBytes = 0;
+	Packet->Error = SE_NO_ERROR;
+
+	return Packet;
+}
+
+void FNetReceiveThread::EnqueueSocketError(TUniquePtr<FNetReceivedPacket>&& Packet, ESocketErrors Error)
+{
+	// Errors such as SE_ECONNRESET are passed on to the game thread to be handled
+	if (Error != SE_NO_ERROR && Error != SE_EWOULDBLOCK && Error != SE_EINTR)
+	{
+		Packet->NumBytes = 0;
+		Packet->Error = Error;
+		Packet->ReceiveTime = FPlatformTime::Seconds();
+
+		EnqueuePacket(MoveTemp(Packet));
+	}
+	else
+	{
+		FreePackets.Enqueue(MoveTemp(Packet));
+	}
+}
+
+void FNetReceiveThread::EnqueuePacket(TUniquePtr<FNetReceivedPacket>&& Packet)
+{
+	// The game thread is falling behind - drop the packet here rather than grow the queue without bound, as the socket buffer would
+	if (NumQueuedPackets.load(std::memory_order_relaxed) >= MaxQueuedPackets || (PreProcess && !PreProcess(*Packet)))
+	{
+		NumDroppedPackets.fetch_add(1, std::memory_order_relaxed);
+		FreePackets.Enqueue(MoveTemp(Packet));
+
+		return;
+	}
+
+	NumQueuedPackets.fetch_add(1, std::memory_order_relaxed);
+	ReceivedPackets.Enqueue(MoveTemp(Packet));
+}
@@ -0,0 +1,285 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Net/NetRelevancyGrid.h"
+#include "Engine/NetworkObjectList.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/Pawn.h"
+#include "Components/SceneComponent.h"
+#include "HAL/IConsoleManager.h"
+
+static float GNetRelevancyGridCellSize = 10000.f;
+static FAutoConsoleVariableRef CVarNetRelevancyGridCellSize(
+	TEXT("net.RelevancyGrid.CellSize"),
+	GNetRelevancyGridCellSize,
+	TEXT("The size of net relevancy grid cells along the X/Y axes, in world units. Only applies when the grid is empty."),
+	ECVF_Default);
+
+static float GNetRelevancyGridMaxCullDistance = 30000.f;
+static FAutoConsoleVariableRef CVarNetRelevancyGridMaxCullDistance(
+	TEXT("net.RelevancyGrid.MaxCullDistance"),
+	GNetRelevancyGridMaxCullDistance,
+	TEXT("Actors with a net cull distance larger than this are not indexed by the net relevancy grid (and are always tested with IsNetRelevantFor), ")
+	TEXT("as they would increase the number of cells visited by every query."),
+	ECVF_Default);
+
+
+FNetRelevancyGrid::FNetRelevancyGrid()
+	: ConsiderFrame(1)
+	, CellSize(GNetRelevancyGridCellSize)
+	, MaxCullDistanceSquared(0.f)
+{
+}
+
+bool FNetRelevancyGrid::IsActorIndexable(const AActor* Actor)
+{
+	if (Actor == nullptr || Actor->bAlwaysRelevant || Actor->bOnlyRelevantToOwner || Actor->bNetUseOwnerRelevancy)
+	{
+		return false;
+	}
+
+	// Owned/instigated actors can be relevant through their owner or instigator, regardless of distance
+	if (Actor->GetOwner() != nullptr || Actor->GetInstigator() != nullptr)
+	{
+		return false;
+	}
+
+	// Attached actors can be relevant through their attach parent
+	const USceneComponent* RootComponent = Actor->GetRootComponent();
+
+	if (RootComponent == nullptr || RootComponent->GetAttachParent() != nullptr)
+	{
+		return false;
+	}
+
+	// These classes override IsNetRelevantFor with non-distance based relevancy
+	if (Actor->IsA<APawn>() || Actor->IsA<AController>() || Actor->IsA<AInfo>())
+	{
+		return false;
+	}
+
+	const float MaxIndexedCullDistance = GNetRelevancyGridMaxCullDistance;
+
+	return Actor->NetCullDistanceSquared <= (MaxIndexedCullDistance * MaxIndexedCullDistance);
+}
+
+void FNetRelevancyGrid::UpdateActor(FNetworkObjectInfo& ObjectInfo)
+{
+	const AActor* Actor = ObjectInfo.Actor;
+
+	if (IsActorIndexable(Actor))
+	{
+		Update(ObjectInfo, Actor->GetActorLocation(), Actor->NetCullDistanceSquared);
+	}
+	else
+	{
+		Remove(ObjectInfo);
+	}
+}
+
+void FNetRelevancyGrid::Update(FNetworkObjectInfo& ObjectInfo, const FVector& Location, float CullDistanceSquared)
+{
+	const FIntPoint NewCell = GetCell(Location);
+	int32 EntryIndex = ObjectInfo.RelevancyGridIndex;
+
+	if (EntryIndex == INDEX_NONE)
+	{
+		EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(false) : Entries.AddDefaulted();
+
+		FEntry& NewEntry = Entries[EntryIndex];
+
+		NewEntry.ObjectInfo = &ObjectInfo;
+		NewEntry.Cell = NewCell;
+
+		Cells.FindOrAdd(NewCell).Add(EntryIndex);
+
+		ObjectInfo.RelevancyGridIndex = EntryIndex;
+	}
+	else
+	{
+		FEntry& Entry = Entries[EntryIndex];
+
+		check(Entry.ObjectInfo == &ObjectInfo);
+
+		if (Entry.Cell != NewCell)
+		{
+			RemoveFromCell(Entry.Cell, EntryIndex);
+			Cells.FindOrAdd(NewCell).Add(EntryIndex);
+
+			Entry.Cell = NewCell;
+		}
+	}
+
+	FEntry& Entry = Entries[EntryIndex];
+
+	Entry.Location = Location;
+	Entry.CullDistanceSquared = CullDistanceSquared;
+
+	MaxCullDistanceSquared = FMath::Max(MaxCullDistanceSquared, CullDistanceSquared);
+}
+
+void FNetRelevancyGrid::Remove(FNetworkObjectInfo& ObjectInfo)
+{
+	const int32 EntryIndex = ObjectInfo.RelevancyGridIndex;
+
+	if (EntryIndex != INDEX_NONE)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+
+		check(Entry.ObjectInfo == &ObjectInfo);
+
+		RemoveFromCell(Entry.Cell, EntryIndex);
+
+		Entry = FEntry();
+		FreeEntries.Add(EntryIndex);
+
+		ObjectInfo.RelevancyGridIndex = INDEX_NONE;
+
+		if (Num() == 0)
+		{
+			// Shrink the query radius back, but keep the consider list which may be in the middle of being built
+			Entries.Reset();
+			FreeEntries.Reset();
+			Cells.Reset();
+
+			CellSize = FMath::Max(GNetRelevancyGridCellSize, 1.f);
+			MaxCullDistanceSquared = 0.f;
+		}
+	}
+}
+
+bool FNetRelevancyGrid::IsIndexed(const FNetworkObjectInfo& ObjectInfo)
+{
+	return ObjectInfo.RelevancyGridIndex != INDEX_NONE;
+}
+
+void FNetRelevancyGrid::ResetConsidered()
+{
+	UnindexedConsidered.Reset();
+	ConsiderFrame++;
+}
+
+void FNetRelevancyGrid::AddConsideredActor(FNetworkObjectInfo& ObjectInfo)
+{
+	UpdateActor(ObjectInfo);
+	AddConsidered(ObjectInfo);
+}
+
+void FNetRelevancyGrid::AddConsidered(FNetworkObjectInfo& ObjectInfo)
+{
+	if (IsIndexed(ObjectInfo))
+	{
+		Entries[ObjectInfo.RelevancyGridIndex].ConsideredFrame = ConsiderFrame;
+	}
+	else
+	{
+		UnindexedConsidered.Add(&ObjectInfo);
+	}
+}
+
+void FNetRelevancyGrid::GatherConsideredObjects(TArrayView<const FVector> ViewLocations, TArray<FNetworkObjectInfo*>& OutObjects, TBitArray<>& OutGathered) const
+{
+	OutObjects.Reset();
+	OutObjects.Append(UnindexedConsidered);
+	OutGathered.Init(false, Entries.Num());
+
+	if (Cells.Num() == 0)
+	{
+		return;
+	}
+
+	const float QueryRadius = FMath::Sqrt(MaxCullDistanceSquared);
+
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		const FIntPoint MinCell = GetCell(ViewLocation - FVector(QueryRadius, QueryRadius, 0.f));
+		const FIntPoint MaxCell = GetCell(ViewLocation + FVector(QueryRadius, QueryRadius, 0.f));
+
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+			{
+				const TArray<int32>* CellEntries = Cells.Find(FIntPoint(CellX, CellY));
+
+				if (CellEntries == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 EntryIndex : *CellEntries)
+				{
+					const FEntry& Entry = Entries[EntryIndex];
+
+					// Matches AActor::IsWithinNetRelevancyDistance
+					if (Entry.ConsideredFrame == ConsiderFrame && !OutGathered[EntryIndex] && FVector::DistSquared(ViewLocation, Entry.Location) < Entry.CullDistanceSquared)
+					{
+						OutGathered[EntryIndex] = true;
+						OutObjects.Add(Entry.ObjectInfo);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FNetRelevancyGrid::GatherConsideredObject(const FNetworkObjectInfo& ObjectInfo, TArray<FNetworkObjectInfo*>& InOutObjects, TBitArray<>& InOutGathered) const
+{
+	const int32 EntryIndex = ObjectInfo.RelevancyGridIndex;
+
+	if (EntryIndex != INDEX_NONE && Entries[EntryIndex].ConsideredFrame == ConsiderFrame && !InOutGathered[EntryIndex])
+	{
+		InOutGathered[EntryIndex] = true;
+		InOutObjects.Add(Entries[EntryIndex].ObjectInfo);
+	}
+}
+
+void FNetRelevancyGrid::Reset()
+{
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.ObjectInfo != nullptr)
+		{
+			Entry.ObjectInfo->RelevancyGridIndex = INDEX_NONE;
+		}
+	}
+
+	Entries.Reset();
+	FreeEntries.Reset();
+	UnindexedConsidered.Reset();
+	Cells.Reset();
+
+	CellSize = FMath::Max(GNetRelevancyGridCellSize, 1.f);
+	MaxCullDistanceSquared = 0.f;
+}
+
+void FNetRelevancyGrid::CountBytes(FArchive& Ar) const
+{
+	Entries.CountBytes(Ar);
+	FreeEntries.CountBytes(Ar);
+	UnindexedConsidered.CountBytes(Ar);
+	Cells.CountBytes(Ar);
+
+	for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Cell.Value.CountBytes(Ar);
+	}
+}
+
+FIntPoint FNetRelevancyGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void FNetRelevancyGrid::RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex)
+{
+	if (TArray<int32>* CellEntries = Cells.Find(Cell))
+	{
+		CellEntries->RemoveSingleSwap(EntryIndex, false);
+
+		if (CellEntries->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Net/NetReceiveThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "IPAddress.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetReceiveThreadTest, "Net.ReceiveThreadTest", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNetReceiveThreadTest::RunTest(const FString& Parameters)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	if (!FPlatformProcess::SupportsMultithreading() || !TestNotNull(TEXT("Platform socket subsystem must exist"), SocketSubsystem))
+	{
+		return true;
+	}
+
+	const int32 NumPackets = 64;
+
+	FSocket* RecvSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("NetReceiveThreadTest Recv"), FNetworkProtocolTypes::IPv4);
+	FSocket* SendSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("NetReceiveThreadTest Send"), FNetworkProtocolTypes::IPv4);
+	TSharedRef<FInternetAddr> RecvAddr = SocketSubsystem->CreateInternetAddr(FNetworkProtocolTypes::IPv4);
+	TSharedRef<FInternetAddr> SendAddr = SocketSubsystem->CreateInternetAddr(FNetworkProtocolTypes::IPv4);
+
+	RecvAddr->SetLoopbackAddress();
+	RecvAddr->SetPort(0);
+	SendAddr->SetLoopbackAddress();
+	SendAddr->SetPort(0);
+
+	if (TestNotNull(TEXT("Receive socket must be created"), RecvSocket) && TestNotNull(TEXT("Send socket must be created"), SendSocket) &&
+		TestTrue(TEXT("Receive socket must bind to loopback"), RecvSocket->Bind(*RecvAddr)) &&
+		TestTrue(TEXT("Send socket must bind to loopback"), SendSocket->Bind(*SendAddr)))
+	{
+		RecvSocket->SetNonBlocking(true);
+		RecvSocket->GetAddress(*RecvAddr);
+		RecvAddr->SetLoopbackAddress();
+		SendSocket->GetAddress(*SendAddr);
+
+		// The pre-process function runs on the receive thread, and drops every packet starting with 0xFF
+		std::atomic<int32> NumPreProcessed(0);
+
+		FNetReceiveThread ReceiveThread(RecvSocket, SocketSubsystem, NumPackets * 2, [&NumPreProcessed](FNetReceivedPacket& Packet)
+			{
+				NumPreProcessed++;
+
+				return Packet.NumBytes == 0 || Packet.Data[0] != 0xFF;
+			});
+
+		if (TestTrue(TEXT("Receive thread must start"), ReceiveThread.StartThread(TEXT("NetReceiveThreadTest"))))
+		{
+			for (int32 PacketIdx = 0; PacketIdx < NumPackets; PacketIdx++)
+			{
+				uint8 Packet[2] = { (uint8)PacketIdx, (uint8)(PacketIdx * 3) };
+				int32 BytesSent = 0;
+
+				SendSocket->SendTo(Packet, sizeof(Packet), BytesSent, *RecvAddr);
+
+				if (PacketIdx % 8 == 0)
+				{
+					const uint8 DroppedPacket[1] = { 0xFF };
+
+					SendSocket->SendTo(DroppedPacket, sizeof(DroppedPacket), BytesSent, *RecvAddr);
+				}
+			}
+
+			const int32 NumDroppedSent = NumPackets / 8;
+			const double EndTime = FPlatformTime::Seconds() + 5.0;
+			int32 NumReceived = 0;
+			bool bInOrder = true;
+			bool bFromSender = true;
+
+			while (NumReceived < NumPackets && FPlatformTime::Seconds() < EndTime)
+			{
+				const int32 NumDequeued = ReceiveThread.DequeuePackets([&](FNetReceivedPacket& Packet)
+					{
+						if (Packet.Error != SE_NO_ERROR)
+						{
+							AddError(FString::Printf(TEXT("Unexpected socket error %s"), SocketSubsystem->GetSocketError(Packet.Error)));
+							return;
+						}
+
+						bInOrder &= Packet.NumBytes == 2 && Packet.Data[0] == (uint8)NumReceived && Packet.Data[1] == (uint8)(NumReceived * 3);
+						bFromSender &= Packet.Address.IsValid() && Packet.Address->GetPort() == SendAddr->GetPort();
+
+						NumReceived++;
+					});
+
+				if (NumDequeued == 0)
+				{
+					FPlatformProcess::Sleep(0.001f);
+				}
+			}
+
+			TestEqual(TEXT("Every packet must be dispatched"), NumReceived, NumPackets);
+			TestTrue(TEXT("Packets must be dispatched in order, with their contents"), bInOrder);
+			TestTrue(TEXT("Packets must carry the sender's address"), bFromSender);
+			TestEqual(TEXT("Every packet must be pre-processed"), NumPreProcessed.load(), NumPackets + NumDroppedSent);
+			TestEqual(TEXT("Packets rejected by the pre-process function must be dropped"), (int32)ReceiveThread.ConsumeNumDroppedPackets(), NumDroppedSent);
+			TestEqual(TEXT("No packets must remain queued"), ReceiveThread.GetNumQueuedPackets(), 0);
+
+			// The thread must be stopped before its socket is closed
+			ReceiveThread.StopThread();
+		}
+	}
+
+	if (SendSocket != nullptr)
+	{
+		SocketSubsystem->DestroySocket(SendSocket);
+	}
+
+	if (RecvSocket != nullptr)
+	{
+		SocketSubsystem->DestroySocket(RecvSocket);
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
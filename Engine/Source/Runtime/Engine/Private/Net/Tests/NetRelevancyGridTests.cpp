@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Net/NetRelevancyGrid.h"
+#include "Engine/NetworkObjectList.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetRelevancyGridTest, "Net.RelevancyGridTest", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNetRelevancyGridTest::RunTest(const FString& Parameters)
+{
+	FNetRelevancyGrid Grid;
+
+	const float CullDistance = 15000.f;
+	const float CullDistanceSq = CullDistance * CullDistance;
+
+	FNetworkObjectInfo Near;
+	FNetworkObjectInfo Far;
+	FNetworkObjectInfo Edge;
+	FNetworkObjectInfo Unindexed;
+
+	Grid.Update(Near, FVector(100.f, 200.f, 0.f), CullDistanceSq);
+	Grid.Update(Far, FVector(100000.f, -100000.f, 0.f), CullDistanceSq);
+	Grid.Update(Edge, FVector(CullDistance + 1.f, 0.f, 0.f), CullDistanceSq);
+
+	TestEqual(TEXT("All objects indexed"), Grid.Num(), 3);
+
+	auto Gather = [&Grid](TArrayView<const FVector> ViewLocations, const FNetworkObjectInfo& ChannelObject = FNetworkObjectInfo())
+	{
+		TArray<FNetworkObjectInfo*> Gathered;
+		TBitArray<> GatheredBits;
+
+		Grid.GatherConsideredObjects(ViewLocations, Gathered, GatheredBits);
+		Grid.GatherConsideredObject(ChannelObject, Gathered, GatheredBits);
+
+		return Gathered;
+	};
+
+	// Indexed objects are only gathered once added to the consider list
+	{
+		const FVector ViewLocations[] = { FVector::ZeroVector };
+
+		TestEqual(TEXT("Nothing gathered before being considered"), Gather(ViewLocations).Num(), 0);
+	}
+
+	Grid.ResetConsidered();
+	Grid.AddConsidered(Near);
+	Grid.AddConsidered(Far);
+	Grid.AddConsidered(Edge);
+	Grid.AddConsidered(Unindexed);
+
+	TestEqual(TEXT("Unindexed object kept out of the grid"), Grid.NumUnindexedConsidered(), 1);
+
+	// Query from the origin
+	{
+		const FVector ViewLocations[] = { FVector::ZeroVector };
+		const TArray<FNetworkObjectInfo*> Gathered = Gather(ViewLocations);
+
+		TestTrue(TEXT("Near object is within cull distance"), Gathered.Contains(&Near));
+		TestFalse(TEXT("Far object is outside cull distance"), Gathered.Contains(&Far));
+		TestFalse(TEXT("Edge object is just outside cull distance"), Gathered.Contains(&Edge));
+		TestTrue(TEXT("Unindexed object is always gathered"), Gathered.Contains(&Unindexed));
+
+		const TArray<FNetworkObjectInfo*> GatheredWithChannel = Gather(ViewLocations, Far);
+
+		TestTrue(TEXT("Object with a channel is gathered regardless of distance"), GatheredWithChannel.Contains(&Far));
+		TestEqual(TEXT("Objects gathered once"), GatheredWithChannel.Num(), 3);
+	}
+
+	// Multiple viewers, with the far object moved into range of the second viewer
+	{
+		Grid.Update(Far, FVector(90000.f, 0.f, 0.f), CullDistanceSq);
+
+		const FVector ViewLocations[] = { FVector::ZeroVector, FVector(100000.f, 0.f, 0.f), FVector(95000.f, 0.f, 0.f) };
+		const TArray<FNetworkObjectInfo*> Gathered = Gather(ViewLocations);
+
+		TestTrue(TEXT("Near object is within cull distance of first viewer"), Gathered.Contains(&Near));
+		TestTrue(TEXT("Moved object is within cull distance of second viewer"), Gathered.Contains(&Far));
+		TestEqual(TEXT("Objects near several viewers gathered once"), Gathered.Num(), 3);
+	}
+
+	// Objects not added to the latest consider list are not gathered
+	{
+		Grid.ResetConsidered();
+		Grid.AddConsidered(Far);
+
+		const FVector ViewLocations[] = { FVector::ZeroVector, FVector(100000.f, 0.f, 0.f) };
+		const TArray<FNetworkObjectInfo*> Gathered = Gather(ViewLocations);
+
+		TestEqual(TEXT("Only the considered object gathered"), Gathered.Num(), 1);
+		TestTrue(TEXT("Considered object gathered"), Gathered.Contains(&Far));
+	}
+
+	// Removal and index reuse
+	{
+		Grid.Remove(Near);
+
+		TestFalse(TEXT("Removed object is no longer indexed"), FNetRelevancyGrid::IsIndexed(Near));
+		TestEqual(TEXT("Two objects indexed"), Grid.Num(), 2);
+
+		FNetworkObjectInfo Reused;
+
+		Grid.Update(Reused, FVector::ZeroVector, CullDistanceSq);
+
+		TestEqual(TEXT("Free index reused"), Grid.Num(), 3);
+
+		Grid.Reset();
+
+		TestEqual(TEXT("Grid empty after reset"), Grid.Num(), 0);
+		TestFalse(TEXT("Reset clears object indices"), FNetRelevancyGrid::IsIndexed(Reused));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1355,6 +1355,8 @@ void UNetConnection::UpdateLevelVisibilityInternal(const FUpdateLevelVisibilityL
 					if (LevelWorld->PersistentLevel)
 					{
 						FNetworkObjectList& NetworkObjectList = Driver->GetNetworkObjectList();
+						const bool bHasQuiescentActors = NetworkObjectList.GetQuiescentObjects().Num() > 0;
+
 						for (AActor* Actor : LevelWorld->PersistentLevel->Actors)
 						{
 							// Dormant Initial actors have no changes. Dormant Never and Awake will be sent normal, so we only need
@@ -1363,6 +1365,11 @@ void UNetConnection::UpdateLevelVisibilityInternal(const FUpdateLevelVisibilityL
 							{
 								NetworkObjectList.MarkActive(Actor, this, Driver);
 							}
+							// Quiescent actors aren't sent normally until woken
+							else if (bHasQuiescentActors && Actor && Actor->GetIsReplicated())
+							{
+								NetworkObjectList.WakeQuiescent(Actor);
+							}
 						}
 					}
 				}
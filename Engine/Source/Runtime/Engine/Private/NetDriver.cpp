@@ -59,6 +59,7 @@
 #include "Engine/ChildConnection.h"
 #include "Net/Core/Trace/NetTrace.h"
 #include "Misc/ScopeExit.h"
+#include "Async/ParallelFor.h"
 #include "Net/DataChannel.h"
 #include "GameFramework/PlayerState.h"
 #include "Net/PerfCountersHelpers.h"
@@ -115,6 +116,7 @@ DEFINE_STAT(STAT_NumActors);
 DEFINE_STAT(STAT_NumNetActors);
 DEFINE_STAT(STAT_NumDormantActors);
 DEFINE_STAT(STAT_NumInitiallyDormantActors);
+DEFINE_STAT(STAT_NumQuiescentActors);
 DEFINE_STAT(STAT_NumNetGUIDsAckd);
 DEFINE_STAT(STAT_NumNetGUIDsPending);
 DEFINE_STAT(STAT_NumNetGUIDsUnAckd);
@@ -150,6 +152,11 @@ DECLARE_CYCLE_STAT(TEXT("Process Prioritized Actors Time"), STAT_NetProcessPrior
 DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush"), STAT_NetTickFlush, STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush GatherStats"), STAT_NetTickFlushGatherStats, STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush GatherStatsPerfCounters"), STAT_NetTickFlushGatherStatsPerfCounters, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("NetDriver FlushBatchedSends"), STAT_NetFlushBatchedSends, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("NetDriver DispatchReceiveThreadPackets"), STAT_NetDispatchReceiveThreadPackets, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Gather Actors Time"), STAT_NetGatherActorsTime, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Gather Actors Parallel Time"), STAT_NetGatherActorsParallelTime, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Wake Quiescent Actors Time"), STAT_NetWakeQuiescentActorsTime, STATGROUP_Game);
 
 DEFINE_LOG_CATEGORY_STATIC(LogNetSyncLoads, Log, All);
 
@@ -158,6 +165,8 @@ CSV_DEFINE_CATEGORY(Networking, true);
 int32 GNumSaturatedConnections; // Counter for how many connections are skipped/early out due to bandwidth saturation
 int32 GNumSharedSerializationHit;
 int32 GNumSharedSerializationMiss;
+int64 GNumSharedSerializationBitsSaved; // Number of serialized property bits copied from shared serialization data, instead of being serialized again
+int64 GNumFastArrayDeltaBitsSaved; // Number of Fast Array item bits saved by sending items relative to a connection's acked baseline, instead of in full
 int32 GNumSkippedObjectEmptyUpdates;
 
 extern int32 GNetRPCDebug;
@@ -337,6 +346,69 @@ static FAutoConsoleVariableRef CVarNetControlChannelDestructionInfo(
 	TEXT("0: Old behavior, use an actor channel. 1: New behavior, use the control channel"),
 	ECVF_Default);
 
+static int32 GNetParallelPrioritizeActors = 0;
+static FAutoConsoleVariableRef CVarNetParallelPrioritizeActors(
+	TEXT("net.ParallelPrioritizeActors"),
+	GNetParallelPrioritizeActors,
+	TEXT("If enabled, the relevancy and priority gather for each connection in ServerReplicateActors runs in parallel on task graph workers, ")
+	TEXT("before the connections are processed in order on the game thread. IsNetRelevantFor/GetNetPriority/GetNetDormancy overrides ")
+	TEXT("must be safe to call concurrently for different connections. Unlike the serial path, every connection is gathered before any ")
+	TEXT("connection replicates, so state changed while replicating to one connection (e.g. by OnActorChannelOpen or ReplicateSubobjects ")
+	TEXT("overrides) is only seen by the other connections on the next frame. See net.ParallelPrioritizeActors.Validate."),
+	ECVF_Default);
+
+static int32 GNetParallelPrioritizeActorsValidate = 0;
+static FAutoConsoleVariableRef CVarNetParallelPrioritizeActorsValidate(
+	TEXT("net.ParallelPrioritizeActors.Validate"),
+	GNetParallelPrioritizeActorsValidate,
+	TEXT("If enabled along with net.ParallelPrioritizeActors, each connection's actors are also gathered serially right before it replicates, ")
+	TEXT("and any difference from the parallel gather is logged. Used to check that a game's relevancy/priority/dormancy logic doesn't ")
+	TEXT("depend on state changed while replicating to other connections."),
+	ECVF_Default);
+
+static int32 GNetUseRelevancyGrid = 0;
+static FAutoConsoleVariableRef CVarNetUseRelevancyGrid(
+	TEXT("net.RelevancyGrid"),
+	GNetUseRelevancyGrid,
+	TEXT("If enabled, considered actors are indexed in a spatial grid, and each connection only visits the grid cells around its viewers, ")
+	TEXT("instead of the whole consider list. Only actors using the default distance based relevancy are indexed ")
+	TEXT("(see FNetRelevancyGrid::IsActorIndexable), the others are always visited."),
+	ECVF_Default);
+
+static int32 GNetQuiescentActors = 0;
+static FAutoConsoleVariableRef CVarNetQuiescentActors(
+	TEXT("net.QuiescentActors"),
+	GNetQuiescentActors,
+	TEXT("If enabled, actors which haven't replicated anything for net.QuiescentActorIdleTime are moved into a quiescent set, where they aren't ")
+	TEXT("considered for replication (or compared) until woken - by a push model property change, an RPC, ForceNetUpdate, a dormancy change, ")
+	TEXT("a new connection, or net.QuiescentActorMaxSleepTime elapsing. Only actors whose replicated objects fully use push model are eligible, ")
+	TEXT("unless net.QuiescentActorsAllowNonPushModel is enabled."),
+	ECVF_Default);
+
+static float GNetQuiescentActorIdleTime = 10.f;
+static FAutoConsoleVariableRef CVarNetQuiescentActorIdleTime(
+	TEXT("net.QuiescentActorIdleTime"),
+	GNetQuiescentActorIdleTime,
+	TEXT("The number of seconds an actor must go without replicating anything, before it can become quiescent (see net.QuiescentActors)."),
+	ECVF_Default);
+
+static float GNetQuiescentActorMaxSleepTime = 2.f;
+static FAutoConsoleVariableRef CVarNetQuiescentActorMaxSleepTime(
+	TEXT("net.QuiescentActorMaxSleepTime"),
+	GNetQuiescentActorMaxSleepTime,
+	TEXT("The maximum number of seconds an actor stays quiescent before it's considered again, so that relevancy changes (e.g. viewers moving into range) ")
+	TEXT("are picked up - and changes to non push model properties, with net.QuiescentActorsAllowNonPushModel. Values <= 0 disable the limit, ")
+	TEXT("in which case quiescent actors only become relevant to new viewers when woken by another event."),
+	ECVF_Default);
+
+static int32 GNetQuiescentActorsAllowNonPushModel = 0;
+static FAutoConsoleVariableRef CVarNetQuiescentActorsAllowNonPushModel(
+	TEXT("net.QuiescentActorsAllowNonPushModel"),
+	GNetQuiescentActorsAllowNonPushModel,
+	TEXT("If enabled, actors with replicated objects which don't fully use push model can also become quiescent. Changes to their non push model properties ")
+	TEXT("are only replicated after net.QuiescentActorMaxSleepTime, or when woken by UNetDriver::WakeQuiescentActor or another event."),
+	ECVF_Default);
+
 static int32 GNetResetAckStatePostSeamlessTravel = 0;
 static FAutoConsoleVariableRef CVarNetResetAckStatePostSeamlessTravel(
 	TEXT("net.ResetAckStatePostSeamlessTravel"),
@@ -367,6 +439,7 @@ UNetDriver::UNetDriver(const FObjectInitializer& ObjectInitializer)
 ,   Notify(nullptr)
 ,	ElapsedTime( 0.0 )
 ,	bInTick(false)
+,	bBatchingSends(false)
 ,	bPendingDestruction(false)
 ,	LastTickDispatchRealtime( 0.f )
 ,   bIsPeer(false)
@@ -665,6 +738,38 @@ void UNetDriver::CancelAdaptiveReplication(FNetworkObjectInfo& InNetworkActor)
 	}
 }
 
+static int32 GNetBatchedSend = 0;
+static FAutoConsoleVariableRef CVarNetBatchedSend(
+	TEXT("net.BatchedSend"),
+	GNetBatchedSend,
+	TEXT("If enabled, packets flushed by connections during TickFlush are collected and sent together at the end of the tick, ")
+	TEXT("using FSocket::SendMulti (sendmmsg on supported platforms) to reduce the number of socket calls.\n")
+	TEXT("0: Send each packet immediately. 1: Batch sends. 2: Batch sends, and coalesce same-size packets with UDP segmentation offload where supported."),
+	ECVF_Default);
+
+static int32 GNetBatchedSendMaxPackets = 256;
+static FAutoConsoleVariableRef CVarNetBatchedSendMaxPackets(
+	TEXT("net.BatchedSendMaxPackets"),
+	GNetBatchedSendMaxPackets,
+	TEXT("The maximum number of packets which are sent per FSocket::SendMulti call, when net.BatchedSend is enabled. ")
+	TEXT("Queues which fill up are sent early. Only applies to newly created queues."),
+	ECVF_Default);
+
+static int32 GNetReceiveThread = 0;
+static FAutoConsoleVariableRef CVarNetReceiveThread(
+	TEXT("net.ReceiveThread"),
+	GNetReceiveThread,
+	TEXT("If enabled, net drivers which support it receive packets on a dedicated thread (using FSocket::RecvMulti where supported), ")
+	TEXT("and the game thread only dispatches the queued packets to connections during TickDispatch. Only applies to newly initialized net drivers."),
+	ECVF_Default);
+
+static int32 GNetReceiveThreadMaxQueuedPackets = 16384;
+static FAutoConsoleVariableRef CVarNetReceiveThreadMaxQueuedPackets(
+	TEXT("net.ReceiveThreadMaxQueuedPackets"),
+	GNetReceiveThreadMaxQueuedPackets,
+	TEXT("The maximum number of packets a net receive thread queues for the game thread, before further packets are dropped."),
+	ECVF_Default);
+
 static TAutoConsoleVariable<int32> CVarOptimizedRemapping( TEXT( "net.OptimizedRemapping" ), 1, TEXT( "Uses optimized path to remap unmapped network guids" ) );
 static TAutoConsoleVariable<int32> CVarMaxClientGuidRemaps( TEXT( "net.MaxClientGuidRemaps" ), 100, TEXT( "Max client resolves of unmapped network guids per tick" ) );
 TAutoConsoleVariable<int32> CVarFilterGuidRemapping( TEXT( "net.FilterGuidRemapping" ), 1, TEXT( "Remove destroyed and parent guids from unmapped list" ) );
@@ -685,6 +790,28 @@ bool ShouldEnableScopeSecondsTimers()
 #endif
 }
 
+/** Accumulates the time spent in a scope into one phase of FNetReplicationPhaseTimings, if replication phase timing is enabled */
+struct FScopedReplicationPhaseTimer
+{
+	FScopedReplicationPhaseTimer(FNetReplicationPhaseTimings* Timings, uint64 FNetReplicationPhaseTimings::* PhaseMember)
+		: PhaseCycles(Timings != nullptr ? &(Timings->*PhaseMember) : nullptr)
+		, StartCycles(PhaseCycles != nullptr ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FScopedReplicationPhaseTimer()
+	{
+		if (PhaseCycles != nullptr)
+		{
+			*PhaseCycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+	}
+
+private:
+	uint64* PhaseCycles;
+	uint64 StartCycles;
+};
+
 void UNetDriver::TickFlush(float DeltaSeconds)
 {
 	TGuardValue<bool> GuardInNetTick(bInTick, true);
@@ -698,6 +825,8 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 	}
 	FSimpleScopeSecondsCounter ScopedTimer(GTickFlushGameDriverTimeSeconds, bEnableTimer);
 
+	TGuardValue<bool> GuardBatchingSends(bBatchingSends, GNetBatchedSend != 0);
+
 	if (IsServer() && ClientConnections.Num() > 0 && !bSkipServerReplicateActors)
 	{
 		// Update all clients.
@@ -1150,6 +1279,7 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 	}
 	{
 		QUICK_SCOPE_CYCLE_COUNTER(STAT_NetDriver_TickClientConnections)
+		FScopedReplicationPhaseTimer PhaseTimer(ReplicationPhaseTimings, &FNetReplicationPhaseTimings::FlushNetCycles);
 
 		for (UNetConnection* Connection : ClientConnections)
 		{
@@ -1164,6 +1294,13 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 		FlushHandler();
 	}
 
+	if (bBatchingSends)
+	{
+		FScopedReplicationPhaseTimer PhaseTimer(ReplicationPhaseTimings, &FNetReplicationPhaseTimings::FlushNetCycles);
+
+		FlushBatchedSends();
+	}
+
 	if (CVarNetDebugDraw.GetValueOnAnyThread() > 0)
 	{
 		DrawNetDriverDebug();
@@ -1520,6 +1657,207 @@ void UNetDriver::ProcessLocalClientPackets()
 	}
 }
 
+bool UNetDriver::IsRelevancyGridEnabled() const
+{
+	// Without distance based relevancy, every actor using the default relevancy is relevant, and the grid can't reject anything
+	return GNetUseRelevancyGrid != 0 && GetDefault<AGameNetworkManager>()->bUseDistanceBasedRelevancy;
+}
+
+bool UNetDriver::AreQuiescentActorsEnabled() const
+{
+	// Replication drivers schedule actors themselves, and replay connections need every actor to be recorded
+	return GNetQuiescentActors != 0 && ReplicationDriver == nullptr && !HasReplayConnection();
+}
+
+bool UNetDriver::IsBatchedSendEnabled() const
+{
+	return bBatchingSends;
+}
+
+bool UNetDriver::QueueBatchedSend(FSocket* Socket, const TSharedRef<const FInternetAddr>& Address, const uint8* Data, int32 CountBytes)
+{
+	if (!bBatchingSends || Socket == nullptr || CountBytes > MAX_PACKET_SIZE)
+	{
+		return false;
+	}
+
+	FBatchedSendQueue* Queue = BatchedSendQueues.FindByPredicate([Socket](const FBatchedSendQueue& CurQueue)
+		{
+			return CurQueue.Socket == Socket;
+		});
+
+	if (Queue == nullptr)
+	{
+		ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
+
+		if (SocketSubsystem == nullptr)
+		{
+			return false;
+		}
+
+		const ESendMultiFlags SendFlags = (GNetBatchedSend >= 2) ? ESendMultiFlags::SegmentationOffload : ESendMultiFlags::None;
+		TUniquePtr<FSendMulti> SendData = SocketSubsystem->CreateSendMulti(FMath::Max(1, GNetBatchedSendMaxPackets), MAX_PACKET_SIZE, SendFlags);
+
+		if (!SendData.IsValid())
+		{
+			return false;
+		}
+
+		Queue = &BatchedSendQueues.AddDefaulted_GetRef();
+		Queue->Socket = Socket;
+		Queue->SendData = MoveTemp(SendData);
+	}
+
+	if (Queue->SendData->IsFull())
+	{
+		FlushBatchedSends();
+	}
+
+	return Queue->SendData->AddPacket(Data, CountBytes, Address);
+}
+
+void UNetDriver::FlushBatchedSends()
+{
+	SCOPE_CYCLE_COUNTER(STAT_NetFlushBatchedSends);
+
+	for (FBatchedSendQueue& Queue : BatchedSendQueues)
+	{
+		FlushBatchedSendQueue(Queue);
+	}
+}
+
+void UNetDriver::FlushBatchedSendQueue(FBatchedSendQueue& Queue)
+{
+	FSendMulti& SendData = *Queue.SendData;
+	const int32 NumQueued = SendData.GetNumPackets();
+
+	if (NumQueued > 0)
+	{
+		int32 NumSent = 0;
+
+		if (!Queue.Socket->SendMulti(SendData, NumSent))
+		{
+			ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
+
+			// Like a failed SendTo, the remaining packets are dropped and recovered by the reliability layer
+			UE_LOG(LogNet, Verbose, TEXT("%s: Batched send failed after %i of %i packets, error: %s"), *GetDescription(), NumSent, NumQueued,
+					SocketSubsystem != nullptr ? SocketSubsystem->GetSocketError(SendData.GetLastSendError()) : TEXT("Unknown"));
+		}
+
+		SendData.Reset();
+	}
+}
+
+void UNetDriver::RemoveBatchedSends(FSocket* Socket)
+{
+	const int32 QueueIdx = BatchedSendQueues.IndexOfByPredicate([Socket](const FBatchedSendQueue& CurQueue)
+		{
+			return CurQueue.Socket == Socket;
+		});
+
+	if (QueueIdx != INDEX_NONE)
+	{
+		FlushBatchedSendQueue(BatchedSendQueues[QueueIdx]);
+		BatchedSendQueues.RemoveAtSwap(QueueIdx);
+	}
+}
+
+void UNetDriver::ClearBatchedSends()
+{
+	FlushBatchedSends();
+	BatchedSendQueues.Empty();
+}
+
+bool UNetDriver::IsReceiveThreadEnabled() const
+{
+	return GNetReceiveThread != 0 && FPlatformProcess::SupportsMultithreading();
+}
+
+FNetReceiveThread* UNetDriver::StartReceiveThread(FSocket* Socket, FNetReceiveThread::FPreProcessFunc&& PreProcess)
+{
+	ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
+
+	if (Socket == nullptr || SocketSubsystem == nullptr)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FNetReceiveThread> ReceiveThread = MakeUnique<FNetReceiveThread>(Socket, SocketSubsystem, GNetReceiveThreadMaxQueuedPackets, MoveTemp(PreProcess));
+	const FString ThreadName = FString::Printf(TEXT("NetReceiveThread_%s"), *NetDriverName.ToString());
+
+	if (!ReceiveThread->StartThread(*ThreadName))
+	{
+		UE_LOG(LogNet, Warning, TEXT("%s: Failed to start receive thread, falling back to receiving on the game thread."), *GetDescription());
+
+		return nullptr;
+	}
+
+	UE_LOG(LogNet, Log, TEXT("%s: Started receive thread."), *GetDescription());
+
+	return ReceiveThreads.Add_GetRef(MoveTemp(ReceiveThread)).Get();
+}
+
+void UNetDriver::StopReceiveThreads()
+{
+	for (TUniquePtr<FNetReceiveThread>& ReceiveThread : ReceiveThreads)
+	{
+		ReceiveThread->StopThread();
+	}
+
+	ReceiveThreads.Empty();
+}
+
+void UNetDriver::DispatchReceiveThreadPackets()
+{
+	SCOPE_CYCLE_COUNTER(STAT_NetDispatchReceiveThreadPackets);
+
+	for (const TUniquePtr<FNetReceiveThread>& ReceiveThread : ReceiveThreads)
+	{
+		ReceiveThread->DequeuePackets([this](FNetReceivedPacket& Packet)
+			{
+				UNetConnection* Connection = nullptr;
+
+				if (Packet.Error == SE_NO_ERROR)
+				{
+					if (ServerConnection != nullptr)
+					{
+						if (ServerConnection->RemoteAddr.IsValid() && *ServerConnection->RemoteAddr == *Packet.Address)
+						{
+							Connection = ServerConnection;
+						}
+					}
+					else
+					{
+						Connection = MappedClientConnections.FindRef(Packet.Address.ToSharedRef());
+					}
+				}
+
+				if (Connection != nullptr && IsValid(Connection) && Connection->GetConnectionState() != USOCK_Closed)
+				{
+					Connection->ReceivedRawPacket(Packet.Data.GetData(), Packet.NumBytes);
+				}
+				else
+				{
+					ProcessReceiveThreadUnmappedPacket(Packet);
+				}
+			});
+
+		if (const uint32 NumDropped = ReceiveThread->ConsumeNumDroppedPackets())
+		{
+			UE_LOG(LogNet, Verbose, TEXT("%s: Receive thread dropped %u packets."), *GetDescription(), NumDropped);
+		}
+	}
+}
+
+void UNetDriver::ProcessReceiveThreadUnmappedPacket(FNetReceivedPacket& Packet)
+{
+	ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
+
+	UE_LOG(LogNet, VeryVerbose, TEXT("%s: Dropping receive thread packet from unmapped address %s (Size: %i, Error: %s)"), *GetDescription(),
+		*Packet.Address->ToString(true), Packet.NumBytes,
+		(Packet.Error != SE_NO_ERROR && SocketSubsystem != nullptr) ? SocketSubsystem->GetSocketError(Packet.Error) : TEXT("None"));
+}
+
 void UNetDriver::PostTickFlush()
 {
 	if (World)
@@ -1730,6 +2068,9 @@ static FAutoConsoleVariableRef CVarLogPendingGuidsOnShutdown(
 /** Shutdown all connections managed by this net driver */
 void UNetDriver::Shutdown()
 {
+	StopReceiveThreads();
+	ClearBatchedSends();
+
 	// Client closing connection to server
 	if (ServerConnection)
 	{
@@ -1980,6 +2321,11 @@ void UNetDriver::TickDispatch( float DeltaTime )
 		ServerConnection->PreTickDispatch();
 	}
 
+	if (ReceiveThreads.Num() > 0)
+	{
+		DispatchReceiveThreadPackets();
+	}
+
 #if RPC_CSV_TRACKER
 	GReceiveRPCTimingEnabled = (NetDriverName == NAME_GameNetDriver && ShouldEnableScopeSecondsTimers()) && (ServerConnection==nullptr);
 #endif
@@ -2736,6 +3082,8 @@ void UNetDriver::FinishDestroy()
 			ClientConnection->CleanUp();
 		}
 		// Low level destroy.
+		StopReceiveThreads();
+		ClearBatchedSends();
 		LowLevelDestroy();
 
 		// Delete the guid cache
@@ -3028,6 +3376,16 @@ bool UNetDriver::HandleNetDumpDormancy(const TCHAR* Cmd, FOutputDevice& Ar)
 		Ar.Logf(TEXT("Logging network dormancy for %d dormant network objects"), Actors.Num());
 		Ar.Logf(TEXT(""));
 	}
+	else if (FParse::Command(&Cmd, TEXT("QUIESCENT")))
+	{
+		for (auto It = GetNetworkObjectList().GetQuiescentObjects().CreateConstIterator(); It; ++It)
+		{
+			FNetworkObjectInfo* ActorInfo = (*It).Get();
+			Actors.Add(ActorInfo->Actor);
+		}
+		Ar.Logf(TEXT("Logging network dormancy for %d quiescent network objects"), Actors.Num());
+		Ar.Logf(TEXT(""));
+	}
 	else
 	{
 		for (auto It = GetNetworkObjectList().GetAllObjects().CreateConstIterator(); It; ++It)
@@ -3555,6 +3913,8 @@ void UNetDriver::NotifyActorTearOff(AActor* Actor)
 	{
 		ReplicationDriver->NotifyActorTearOff(Actor);
 	}
+
+	WakeQuiescentActor(Actor);
 }
 
 void UNetDriver::ForceNetUpdate(AActor* Actor)
@@ -3570,6 +3930,11 @@ void UNetDriver::ForceNetUpdate(AActor* Actor)
 	if (FNetworkObjectInfo* NetActor = FindNetworkObjectInfo(Actor))
 	{
 		NetActor->NextUpdateTime = World ? (World->TimeSeconds - 0.01f) : 0.0;
+
+		if (NetActor->bQuiescent)
+		{
+			GetNetworkObjectList().WakeQuiescent(Actor);
+		}
 	}
 }
 
@@ -3638,6 +4003,10 @@ void UNetDriver::NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDorman
 void UNetDriver::FlushActorDormancyInternal(AActor *Actor)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_NetDriver_FlushActorDormancy);
+
+	// Dormancy changes are processed while replicating, which quiescent actors don't do
+	WakeQuiescentActor(Actor);
+
 	// Go through each connection and remove the actor from the dormancy list
 	for (int32 i=0; i < ClientConnections.Num(); ++i)
 	{
@@ -3654,6 +4023,8 @@ void UNetDriver::ForcePropertyCompare( AActor* Actor )
 #if WITH_SERVER_CODE
 	check( Actor );
 
+	WakeQuiescentActor( Actor );
+
 	for ( int32 i=0; i < ClientConnections.Num(); ++i )
 	{
 		UNetConnection *NetConnection = ClientConnections[i];
@@ -3671,9 +4042,18 @@ void UNetDriver::ForceActorRelevantNextUpdate(AActor* Actor)
 	check(Actor);
 	
 	GetNetworkObjectList().ForceActorRelevantNextUpdate(Actor, this);
+	WakeQuiescentActor(Actor);
 #endif // WITH_SERVER_CODE
 }
 
+void UNetDriver::WakeQuiescentActor(AActor* Actor)
+{
+	if (Actor != nullptr)
+	{
+		GetNetworkObjectList().WakeQuiescent(Actor);
+	}
+}
+
 UChildConnection* UNetDriver::CreateChild(UNetConnection* Parent)
 {
 	UE_LOG(LogNet, Log, TEXT("Creating child connection with %s parent"), *Parent->GetName());
@@ -4247,7 +4627,31 @@ void UNetDriver::ServerReplicateActors_BuildConsiderList( TArray<FNetworkObjectI
 
 	const bool bUseAdapativeNetFrequency = IsAdaptiveNetUpdateFrequencyEnabled();
 
+	FNetRelevancyGrid& RelevancyGrid = GetNetworkObjectList().GetRelevancyGrid();
+	const bool bUseRelevancyGrid = IsRelevancyGridEnabled();
+
+	if ( bUseRelevancyGrid )
+	{
+		RelevancyGrid.ResetConsidered();
+	}
+	else if ( RelevancyGrid.Num() > 0 || RelevancyGrid.NumUnindexedConsidered() > 0 )
+	{
+		RelevancyGrid.Reset();
+	}
+
+	const bool bUseQuiescentActors = AreQuiescentActorsEnabled();
+
+	if ( bUseQuiescentActors )
+	{
+		ServerReplicateActors_WakeQuiescentActors();
+	}
+	else if ( GetNetworkObjectList().GetQuiescentObjects().Num() > 0 )
+	{
+		GetNetworkObjectList().WakeAllQuiescent();
+	}
+
 	TArray<AActor*> ActorsToRemove;
+	TArray<AActor*> ActorsToMakeQuiescent;
 
 	for ( const TSharedPtr<FNetworkObjectInfo>& ObjectInfo : GetNetworkObjectList().GetActiveObjects() )
 	{
@@ -4320,6 +4724,17 @@ void UNetDriver::ServerReplicateActors_BuildConsiderList( TArray<FNetworkObjectI
 			ActorInfo->OptimalNetUpdateDelta = 1.0f / Actor->NetUpdateFrequency;
 		}
 
+		// Actors which haven't replicated anything for a while stop being considered, until something wakes them.
+		// Woken actors are always considered once first, so that whatever woke them is replicated.
+		if ( bUseQuiescentActors && !ActorInfo->bWokenFromQuiescence && !ActorInfo->bPendingNetUpdate && ActorInfo->ForceRelevantFrame < ReplicationFrame &&
+			( World->TimeSeconds - ActorInfo->LastNetReplicateTime ) > GNetQuiescentActorIdleTime && ServerReplicateActors_CanActorBecomeQuiescent( *ActorInfo ) )
+		{
+			ActorsToMakeQuiescent.Add( Actor );
+			continue;
+		}
+
+		ActorInfo->bWokenFromQuiescence = false;
+
 		const float ScaleDownStartTime = 2.0f;
 		const float ScaleDownTimeRange = 5.0f;
 
@@ -4369,6 +4784,11 @@ void UNetDriver::ServerReplicateActors_BuildConsiderList( TArray<FNetworkObjectI
 
 		// Call PreReplication on all actors that will be considered
 		Actor->CallPreReplication( this );
+
+		if ( bUseRelevancyGrid )
+		{
+			RelevancyGrid.AddConsideredActor( *ActorInfo );
+		}
 	}
 
 	for ( AActor* Actor : ActorsToRemove )
@@ -4376,9 +4796,128 @@ void UNetDriver::ServerReplicateActors_BuildConsiderList( TArray<FNetworkObjectI
 		RemoveNetworkActor( Actor );
 	}
 
+	for ( AActor* Actor : ActorsToMakeQuiescent )
+	{
+		if ( FNetworkObjectInfo* ActorInfo = FindNetworkObjectInfo( Actor ) )
+		{
+			ActorInfo->QuiescentTime = World->TimeSeconds;
+		}
+
+		GetNetworkObjectList().MarkQuiescent( Actor );
+	}
+
 	// Update stats
 	SET_DWORD_STAT( STAT_NumInitiallyDormantActors, NumInitiallyDormant );
 	SET_DWORD_STAT( STAT_NumConsideredActors, OutConsiderList.Num() );
+	SET_DWORD_STAT( STAT_NumQuiescentActors, GetNetworkObjectList().GetQuiescentObjects().Num() );
+}
+
+void UNetDriver::ServerReplicateActors_WakeQuiescentActors()
+{
+	SCOPE_CYCLE_COUNTER( STAT_NetWakeQuiescentActorsTime );
+
+	const FNetworkObjectList::FNetworkObjectSet& QuiescentObjects = GetNetworkObjectList().GetQuiescentObjects();
+
+	if ( QuiescentObjects.Num() == 0 )
+	{
+		return;
+	}
+
+	TArray<AActor*> ActorsToWake;
+
+	for ( const TSharedPtr<FNetworkObjectInfo>& ObjectInfo : QuiescentObjects )
+	{
+		const FNetworkObjectInfo* ActorInfo = ObjectInfo.Get();
+
+		bool bWake = ActorInfo->bPendingNetUpdate || ActorInfo->ForceRelevantFrame >= ReplicationFrame ||
+			( GNetQuiescentActorMaxSleepTime > 0.f && ( World->TimeSeconds - ActorInfo->QuiescentTime ) >= GNetQuiescentActorMaxSleepTime );
+
+#if WITH_PUSH_MODEL
+		// Push model dirtiness persists until the object is next replicated, so this can't miss changes made between checks
+		for ( int32 MgrIdx = 0; !bWake && MgrIdx < ActorInfo->QuiescentChangelistMgrs.Num(); MgrIdx++ )
+		{
+			TSharedPtr<FReplicationChangelistMgr> ChangelistMgr = ActorInfo->QuiescentChangelistMgrs[MgrIdx].Pin();
+
+			bWake = !ChangelistMgr.IsValid() || ChangelistMgr->GetRepChangelistState()->HasAnyDirtyProperties();
+		}
+#endif
+
+		if ( bWake )
+		{
+			ActorsToWake.Add( ActorInfo->Actor );
+		}
+	}
+
+	for ( AActor* Actor : ActorsToWake )
+	{
+		GetNetworkObjectList().WakeQuiescent( Actor );
+	}
+}
+
+bool UNetDriver::ServerReplicateActors_CanActorBecomeQuiescent( FNetworkObjectInfo& ActorInfo ) const
+{
+	const AActor* Actor = ActorInfo.Actor;
+
+	// Dormancy is processed while replicating, and torn off actors need to replicate their tear off
+	if ( Actor->NetDormancy > DORM_Awake || Actor->GetTearOff() )
+	{
+		return false;
+	}
+
+	ActorInfo.QuiescentChangelistMgrs.Reset();
+
+	// Connections without a channel don't need to be checked - they only need the actor once it becomes relevant, which quiescence doesn't affect
+	for ( UNetConnection* Connection : ClientConnections )
+	{
+		UActorChannel* Channel = Connection != nullptr ? Connection->FindActorChannelRef( ActorInfo.WeakActor ) : nullptr;
+
+		if ( Channel == nullptr )
+		{
+			continue;
+		}
+
+		// Channels which are opening, closing or waiting on reliable data still need ReplicateActor calls to make progress
+		if ( !Channel->OpenAcked || Channel->Closing || Channel->bPendingDormancy || Channel->bPausedUntilReliableACK )
+		{
+			return false;
+		}
+
+		for ( const auto& ReplicatorPair : Channel->ReplicationMap )
+		{
+			const FObjectReplicator& Replicator = ReplicatorPair.Value.Get();
+
+			// Queued unreliable RPCs are only sent with the next replication update
+			if ( Replicator.RemoteFunctions != nullptr && Replicator.RemoteFunctions->GetNumBits() > 0 )
+			{
+				return false;
+			}
+
+			const FSendingRepState* SendingRepState = Replicator.RepState.IsValid() ? Replicator.RepState->GetSendingRepState() : nullptr;
+
+			// Lost property data is only resent with the next replication update
+			if ( SendingRepState != nullptr && SendingRepState->NumNaks > 0 )
+			{
+				return false;
+			}
+
+			const bool bFullPushModel = Replicator.RepLayout.IsValid() && ( Replicator.RepLayout->IsEmpty() || EnumHasAnyFlags( Replicator.RepLayout->GetFlags(), ERepLayoutFlags::FullPushSupport ) );
+
+			if ( bFullPushModel )
+			{
+				if ( Replicator.ChangelistMgr.IsValid() )
+				{
+					ActorInfo.QuiescentChangelistMgrs.AddUnique( Replicator.ChangelistMgr );
+				}
+			}
+			else if ( !GNetQuiescentActorsAllowNonPushModel )
+			{
+				// Changes to non push model properties can only be found by comparing, which is what quiescence skips
+				return false;
+			}
+		}
+	}
+
+	return true;
 }
 
 // Returns true if this actor should replicate to *any* of the passed in connections
@@ -4456,37 +4995,82 @@ int32 UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connec
 {
 	SCOPE_CYCLE_COUNTER( STAT_NetPrioritizeActorsTime );
 
-	// Get list of visible/relevant actors.
-
-	NetTag++;
-
-	// Set up to skip all sent temporary actors
-	for ( int32 j = 0; j < Connection->SentTemporaries.Num(); j++ )
+	// Serial path - gather into a single reused list, then apply on the same thread. This shares all relevancy/priority logic with
+	// the parallel path, but unlike the parallel path, it sees any state changed while replicating to the previous connections.
+	if ( ConnectionGatheredActors.Num() == 0 )
 	{
-		Connection->SentTemporaries[j]->NetTag = NetTag;
+		ConnectionGatheredActors.AddDefaulted();
 	}
 
+	TArray<FGatheredActorPriority>& GatheredActors = ConnectionGatheredActors[0].GatheredActors;
+
+	ServerReplicateActors_GatherActors( Connection, ConnectionViewers, ConsiderList, GatheredActors );
+
+	return ServerReplicateActors_PrioritizeGatheredActors( Connection, ConnectionViewers, GatheredActors, OutPriorityList, OutPriorityActors );
+}
+
+void UNetDriver::ServerReplicateActors_GatherActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*>& ConsiderList, TArray<FGatheredActorPriority>& OutGatheredActors ) const
+{
+	SCOPE_CYCLE_COUNTER( STAT_NetGatherActorsTime );
+
+	// NOTE: This may run on worker threads (net.ParallelPrioritizeActors), so it must not modify anything outside of the passed in
+	//	connection - channel changes are recorded in OutGatheredActors, and applied by ServerReplicateActors_PrioritizeGatheredActors.
+	OutGatheredActors.Reset( ConsiderList.Num() );
+
 	// Make list of all actors to consider.
 	check( World == Connection->OwningActor->GetWorld() );
 
-	int32 FinalSortedCount = 0;
-	int32 DeletedCount = 0;
-
 	// Make weak ptr once for IsActorDormant call
 	TWeakObjectPtr<UNetConnection> WeakConnection(Connection);
 
-	const int32 MaxSortedActors = ConsiderList.Num() + DestroyedStartupOrDormantActors.Num();
-	if ( MaxSortedActors > 0 )
+	if ( ConsiderList.Num() > 0 )
 	{
-		OutPriorityList = new ( FMemStack::Get(), MaxSortedActors ) FActorPriority;
-		OutPriorityActors = new ( FMemStack::Get(), MaxSortedActors ) FActorPriority*;
-
 		check( World == Connection->ViewTarget->GetWorld() );
 
+		// With the relevancy grid, only the considered actors which may be relevant to this connection are visited: the unindexed ones,
+		// the indexed ones within cull distance of a viewer, and the indexed ones which are relevant regardless of distance
+		const FNetRelevancyGrid& RelevancyGrid = GetNetworkObjectList().GetRelevancyGrid();
+		const bool bUseRelevancyGrid = IsRelevancyGridEnabled();
+		TArray<FNetworkObjectInfo*> RelevancyGridConsiderList;
+
+		if ( bUseRelevancyGrid )
+		{
+			TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+			for ( const FNetViewer& Viewer : ConnectionViewers )
+			{
+				ViewLocations.Add( Viewer.ViewLocation );
+			}
+
+			TBitArray<> RelevancyGridGathered;
+			RelevancyGrid.GatherConsideredObjects( ViewLocations, RelevancyGridConsiderList, RelevancyGridGathered );
+
+			// Actors with a channel are gathered regardless of relevancy, as their channel is only closed once relevancy times out
+			for ( FActorChannelMap::TConstIterator It = Connection->ActorChannelConstIterator(); It; ++It )
+			{
+				if ( const FNetworkObjectInfo* ChannelActorInfo = FindNetworkObjectInfo( It.Key().Get() ) )
+				{
+					RelevancyGrid.GatherConsideredObject( *ChannelActorInfo, RelevancyGridConsiderList, RelevancyGridGathered );
+				}
+			}
+
+			// Viewers and view targets are always relevant (see AActor::IsNetRelevantFor)
+			for ( const FNetViewer& Viewer : ConnectionViewers )
+			{
+				for ( const AActor* ViewerActor : { Viewer.InViewer.Get(), Viewer.ViewTarget.Get() } )
+				{
+					if ( const FNetworkObjectInfo* ViewerActorInfo = FindNetworkObjectInfo( ViewerActor ) )
+					{
+						RelevancyGrid.GatherConsideredObject( *ViewerActorInfo, RelevancyGridConsiderList, RelevancyGridGathered );
+					}
+				}
+			}
+		}
+
 		AGameNetworkManager* const NetworkManager = World->NetworkManager;
 		const bool bLowNetBandwidth = NetworkManager ? NetworkManager->IsInLowBandwidthMode() : false;
 
-		for ( FNetworkObjectInfo* ActorInfo : ConsiderList )
+		for ( FNetworkObjectInfo* ActorInfo : ( bUseRelevancyGrid ? RelevancyGridConsiderList : ConsiderList ) )
 		{
 			AActor* Actor = ActorInfo->Actor;
 
@@ -4512,6 +5096,7 @@ int32 UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connec
 			}
 
 			UNetConnection* PriorityConnection = Connection;
+			bool bStartBecomingDormant = false;
 
 			if ( Actor->bOnlyRelevantToOwner )
 			{
@@ -4527,7 +5112,11 @@ int32 UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connec
 					//	This is to give all connections a chance to own it
 					if ( !bHasNullViewTarget && Channel != NULL && ElapsedTime - Channel->RelevantTime >= RelevantTimeout )
 					{
-						Channel->Close(EChannelCloseReason::Relevancy);
+						FGatheredActorPriority& CloseEntry = OutGatheredActors.AddDefaulted_GetRef();
+
+						CloseEntry.ActorPriority.ActorInfo = ActorInfo;
+						CloseEntry.ActorPriority.Channel = Channel;
+						CloseEntry.bCloseChannel = true;
 					}
 
 					// This connection doesn't own this actor
@@ -4543,14 +5132,139 @@ int32 UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connec
 				}
 
 				// See of actor wants to try and go dormant
-				if ( ShouldActorGoDormant( Actor, ConnectionViewers, Channel, ElapsedTime, bLowNetBandwidth ) )
+				bStartBecomingDormant = ShouldActorGoDormant( Actor, ConnectionViewers, Channel, ElapsedTime, bLowNetBandwidth );
+			}
+
+			// Actor is relevant to this connection, add it to the list
+			FGatheredActorPriority& Entry = OutGatheredActors.AddDefaulted_GetRef();
+
+			Entry.ActorPriority = FActorPriority( PriorityConnection, Channel, ActorInfo, ConnectionViewers, bLowNetBandwidth );
+			Entry.bStartBecomingDormant = bStartBecomingDormant;
+		}
+	}
+}
+
+void UNetDriver::ServerReplicateActors_GatherActorsParallel( const int32 NumClientsToTick, const TArray<FNetworkObjectInfo*>& ConsiderList, const float DeltaSeconds )
+{
+	SCOPE_CYCLE_COUNTER( STAT_NetGatherActorsParallelTime );
+
+	if ( ConnectionGatheredActors.Num() < NumClientsToTick )
+	{
+		ConnectionGatheredActors.SetNum( NumClientsToTick );
+	}
+
+	// Viewers are computed up front on the game thread, as the view point queries are not thread safe
+	for ( int32 i=0; i < NumClientsToTick; i++ )
+	{
+		UNetConnection* Connection = ClientConnections[i];
+		FConnectionGatheredActors& Gathered = ConnectionGatheredActors[i];
+
+		Gathered.Viewers.Reset();
+		Gathered.bGathered = Connection->ViewTarget != nullptr;
+
+		if ( Gathered.bGathered )
+		{
+			new( Gathered.Viewers )FNetViewer( Connection, DeltaSeconds );
+			for ( int32 ViewerIndex = 0; ViewerIndex < Connection->Children.Num(); ViewerIndex++ )
+			{
+				if ( Connection->Children[ViewerIndex]->ViewTarget != NULL )
 				{
-					// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
-					Channel->StartBecomingDormant();
+					new( Gathered.Viewers )FNetViewer( Connection->Children[ViewerIndex], DeltaSeconds );
 				}
 			}
+		}
+	}
+
+	// NOTE: Every connection is gathered against the state at the start of replication. The serial path gathers each connection
+	//	right before it replicates, so if replicating to one connection changes state read by the gather for another (relevancy,
+	//	ownership, dormancy), the two paths differ for that frame. The engine's own replication doesn't do this, game overrides may.
+	ParallelFor( NumClientsToTick, [this, &ConsiderList]( int32 ConnectionIdx )
+	{
+		FConnectionGatheredActors& Gathered = ConnectionGatheredActors[ConnectionIdx];
+
+		if ( Gathered.bGathered )
+		{
+			ServerReplicateActors_GatherActors( ClientConnections[ConnectionIdx], Gathered.Viewers, ConsiderList, Gathered.GatheredActors );
+		}
+	} );
+}
+
+bool UNetDriver::ServerReplicateActors_ValidateGatheredActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*>& ConsiderList, const TArray<FGatheredActorPriority>& GatheredActors ) const
+{
+	TArray<FGatheredActorPriority> SerialGatheredActors;
+
+	ServerReplicateActors_GatherActors( Connection, ConnectionViewers, ConsiderList, SerialGatheredActors );
+
+	auto IsSameGather = []( const FGatheredActorPriority& A, const FGatheredActorPriority& B )
+	{
+		return A.ActorPriority.ActorInfo == B.ActorPriority.ActorInfo && A.ActorPriority.Channel == B.ActorPriority.Channel &&
+			A.ActorPriority.Priority == B.ActorPriority.Priority && A.bCloseChannel == B.bCloseChannel &&
+			A.bStartBecomingDormant == B.bStartBecomingDormant;
+	};
+
+	bool bValid = SerialGatheredActors.Num() == GatheredActors.Num();
+
+	for ( int32 GatheredIdx = 0; bValid && GatheredIdx < GatheredActors.Num(); GatheredIdx++ )
+	{
+		if ( !IsSameGather( GatheredActors[GatheredIdx], SerialGatheredActors[GatheredIdx] ) )
+		{
+			const FNetworkObjectInfo* ActorInfo = GatheredActors[GatheredIdx].ActorPriority.ActorInfo;
+
+			UE_LOG( LogNet, Warning, TEXT( "ValidateGatheredActors: Parallel and serial gather differ at entry %i (%s) for connection %s" ), GatheredIdx,
+				ActorInfo != nullptr ? *GetFullNameSafe( ActorInfo->Actor ) : TEXT( "None" ), *Connection->Describe() );
+
+			bValid = false;
+		}
+	}
+
+	if ( !bValid && SerialGatheredActors.Num() != GatheredActors.Num() )
+	{
+		UE_LOG( LogNet, Warning, TEXT( "ValidateGatheredActors: Parallel gather found %i actors, serial gather found %i, for connection %s" ),
+			GatheredActors.Num(), SerialGatheredActors.Num(), *Connection->Describe() );
+	}
+
+	return bValid;
+}
+
+int32 UNetDriver::ServerReplicateActors_PrioritizeGatheredActors( UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FGatheredActorPriority>& GatheredActors, FActorPriority*& OutPriorityList, FActorPriority**& OutPriorityActors )
+{
+	// Get list of visible/relevant actors.
+
+	NetTag++;
+
+	// Set up to skip all sent temporaries actors
+	for ( int32 j = 0; j < Connection->SentTemporaries.Num(); j++ )
+	{
+		Connection->SentTemporaries[j]->NetTag = NetTag;
+	}
+
+	int32 FinalSortedCount = 0;
+	int32 DeletedCount = 0;
+
+	const int32 MaxSortedActors = GatheredActors.Num() + DestroyedStartupOrDormantActors.Num();
+	if ( MaxSortedActors > 0 )
+	{
+		OutPriorityList = new ( FMemStack::Get(), MaxSortedActors ) FActorPriority;
+		OutPriorityActors = new ( FMemStack::Get(), MaxSortedActors ) FActorPriority*;
+
+		for ( const FGatheredActorPriority& Gathered : GatheredActors )
+		{
+			UActorChannel* Channel = Gathered.ActorPriority.Channel;
+
+			if ( Gathered.bCloseChannel )
+			{
+				Channel->Close(EChannelCloseReason::Relevancy);
+				continue;
+			}
+
+			if ( Gathered.bStartBecomingDormant )
+			{
+				// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
+				Channel->StartBecomingDormant();
+			}
+
+			AActor* Actor = Gathered.ActorPriority.ActorInfo->Actor;
 
-			// Actor is relevant to this connection, add it to the list
 			// NOTE - We use NetTag to make sure SentTemporaries didn't already mark this actor to be skipped
 			if ( Actor->NetTag != NetTag )
 			{
@@ -4558,7 +5272,7 @@ int32 UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connec
 
 				Actor->NetTag = NetTag;
 
-				OutPriorityList[FinalSortedCount] = FActorPriority( PriorityConnection, Channel, ActorInfo, ConnectionViewers, bLowNetBandwidth );
+				OutPriorityList[FinalSortedCount] = Gathered.ActorPriority;
 				OutPriorityActors[FinalSortedCount] = OutPriorityList + FinalSortedCount;
 
 				FinalSortedCount++;
@@ -4584,7 +5298,7 @@ int32 UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connec
 		Sort( OutPriorityActors, FinalSortedCount, FCompareFActorPriority() );
 	}
 
-	UE_LOG( LogNetTraffic, Log, TEXT( "ServerReplicateActors_PrioritizeActors: Potential %04i ConsiderList %03i FinalSortedCount %03i" ), MaxSortedActors, ConsiderList.Num(), FinalSortedCount );
+	UE_LOG( LogNetTraffic, Log, TEXT( "ServerReplicateActors_PrioritizeActors: Potential %04i GatheredList %03i FinalSortedCount %03i" ), MaxSortedActors, GatheredActors.Num(), FinalSortedCount );
 
 	// Setup stats
 	SET_DWORD_STAT( STAT_PrioritizedActors, FinalSortedCount );
@@ -4885,10 +5599,15 @@ DECLARE_DWORD_COUNTER_STAT(TEXT("Num Saturated Connections"), STAT_NumSaturatedC
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("SharedSerialization RPC Hit"), STAT_SharedSerializationRPCHit, STATGROUP_Net);
 DECLARE_DWORD_COUNTER_STAT(TEXT("SharedSerialization RPC Miss"), STAT_SharedSerializationRPCMiss, STATGROUP_Net);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SharedSerialization RPC Bytes Saved"), STAT_SharedSerializationRPCBytesSaved, STATGROUP_Net);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Empty Object Replicate Properties Skipped"), STAT_NumSkippedObjectEmptyUpdates, STATGROUP_Net);
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("SharedSerialization Property Hit"), STAT_SharedSerializationPropertyHit, STATGROUP_Net);
 DECLARE_DWORD_COUNTER_STAT(TEXT("SharedSerialization Property Miss"), STAT_SharedSerializationPropertyMiss, STATGROUP_Net);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SharedSerialization Property Bytes Saved"), STAT_SharedSerializationPropertyBytesSaved, STATGROUP_Net);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("SharedSerialization Property Hit Rate"), STAT_SharedSerializationPropertyHitRate, STATGROUP_Net);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("FastArray Delta Bytes Saved"), STAT_FastArrayDeltaBytesSaved, STATGROUP_Net);
 
 struct FReplicationAutoCapture
 {
@@ -4959,10 +5678,12 @@ struct FScopedNetDriverStats
 			// Whatever these values currently are were (mostly) set by RPCs (technically something else could have force ReplicateActor to be called but this is rare).
 			SET_DWORD_STAT(STAT_SharedSerializationRPCHit, GNumSharedSerializationHit);
 			SET_DWORD_STAT(STAT_SharedSerializationRPCMiss, GNumSharedSerializationMiss);
+			SET_DWORD_STAT(STAT_SharedSerializationRPCBytesSaved, (uint32)(GNumSharedSerializationBitsSaved >> 3));
 
 			const FNetworkObjectList& NetworkObjectList = NetDriver->GetNetworkObjectList();
 			CSV_CUSTOM_STAT(Replication, NumberOfActiveActors, NetworkObjectList.GetActiveObjects().Num(), ECsvCustomStatOp::Set);
 			CSV_CUSTOM_STAT(Replication, NumberOfFullyDormantActors, NetworkObjectList.GetDormantObjectsOnAllConnections().Num(), ECsvCustomStatOp::Set);
+			CSV_CUSTOM_STAT(Replication, NumberOfQuiescentActors, NetworkObjectList.GetQuiescentObjects().Num(), ECsvCustomStatOp::Set);
 
 			StartTime = FPlatformTime::Seconds();
 			StartOutBytes = GNetOutBytes;
@@ -4996,12 +5717,28 @@ struct FScopedNetDriverStats
 			CSV_CUSTOM_STAT(Replication, NumClientUpdateLevelVisibility, ((float)GNumClientUpdateLevelVisibility), ECsvCustomStatOp::Set );
 			CSV_CUSTOM_STAT(Replication, NumSkippedObjectEmptyUpdates, (float)GNumSkippedObjectEmptyUpdates, ECsvCustomStatOp::Set);
 
+			const int32 NumSharedSerializationLookups = GNumSharedSerializationHit + GNumSharedSerializationMiss;
+			const float SharedSerializationHitRate = NumSharedSerializationLookups > 0 ? ((float)GNumSharedSerializationHit / (float)NumSharedSerializationLookups) * 100.f : 0.f;
+			const uint32 SharedSerializationBytesSaved = (uint32)(GNumSharedSerializationBitsSaved >> 3);
+
 			SET_DWORD_STAT(STAT_SharedSerializationPropertyHit, GNumSharedSerializationHit);
 			SET_DWORD_STAT(STAT_SharedSerializationPropertyMiss, GNumSharedSerializationMiss);
+			SET_DWORD_STAT(STAT_SharedSerializationPropertyBytesSaved, SharedSerializationBytesSaved);
+			SET_FLOAT_STAT(STAT_SharedSerializationPropertyHitRate, SharedSerializationHitRate);
+
+			CSV_CUSTOM_STAT(Replication, SharedSerializationHitRate, SharedSerializationHitRate, ECsvCustomStatOp::Set);
+			CSV_CUSTOM_STAT(Replication, SharedSerializationKBytesSaved, ((float)SharedSerializationBytesSaved) / 1024.f, ECsvCustomStatOp::Set);
+
+			const uint32 FastArrayDeltaBytesSaved = (uint32)(GNumFastArrayDeltaBitsSaved >> 3);
+
+			SET_DWORD_STAT(STAT_FastArrayDeltaBytesSaved, FastArrayDeltaBytesSaved);
+			CSV_CUSTOM_STAT(Replication, FastArrayDeltaKBytesSaved, ((float)FastArrayDeltaBytesSaved) / 1024.f, ECsvCustomStatOp::Set);
 
 			// Note: we want to reset this at the end of the frame since the RPC stats are incremented at the top (recv)
 			GNumSharedSerializationHit = 0;
 			GNumSharedSerializationMiss = 0;
+			GNumSharedSerializationBitsSaved = 0;
+			GNumFastArrayDeltaBitsSaved = 0;
 			GNumClientUpdateLevelVisibility = 0;
 		}
 	}
@@ -5074,10 +5811,24 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 	ConsiderList.Reserve( GetNetworkObjectList().GetActiveObjects().Num() );
 
 	// Build the consider list (actors that are ready to replicate)
-	ServerReplicateActors_BuildConsiderList( ConsiderList, ServerTickTime );
+	{
+		FScopedReplicationPhaseTimer PhaseTimer( ReplicationPhaseTimings, &FNetReplicationPhaseTimings::BuildConsiderListCycles );
+
+		ServerReplicateActors_BuildConsiderList( ConsiderList, ServerTickTime );
+	}
 
 	TSet<UNetConnection*> ConnectionsToClose;
 
+	const bool bParallelPrioritize = GNetParallelPrioritizeActors != 0 && NumClientsToTick > 1 && FApp::ShouldUseThreadingForPerformance();
+
+	if ( bParallelPrioritize )
+	{
+		FScopedReplicationPhaseTimer PhaseTimer( ReplicationPhaseTimings, &FNetReplicationPhaseTimings::PrioritizeActorsCycles );
+
+		// Gather relevant actors for every ticked connection up front, on worker threads
+		ServerReplicateActors_GatherActorsParallel( NumClientsToTick, ConsiderList, DeltaSeconds );
+	}
+
 	FMemMark Mark( FMemStack::Get() );
 
 	for ( int32 i=0; i < ClientConnections.Num(); i++ )
@@ -5135,13 +5886,24 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 			// Make a list of viewers this connection should consider (this connection and children of this connection)
 			TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
 
+			// Use the gathered actors, unless the connection's view target was only set after gathering
+			const bool bUseGatheredActors = bParallelPrioritize && ConnectionGatheredActors[i].bGathered;
+
 			ConnectionViewers.Reset();
-			new( ConnectionViewers )FNetViewer( Connection, DeltaSeconds );
-			for ( int32 ViewerIndex = 0; ViewerIndex < Connection->Children.Num(); ViewerIndex++ )
+
+			if ( bUseGatheredActors )
 			{
-				if ( Connection->Children[ViewerIndex]->ViewTarget != NULL )
+				ConnectionViewers.Append( ConnectionGatheredActors[i].Viewers );
+			}
+			else
+			{
+				new( ConnectionViewers )FNetViewer( Connection, DeltaSeconds );
+				for ( int32 ViewerIndex = 0; ViewerIndex < Connection->Children.Num(); ViewerIndex++ )
 				{
-					new( ConnectionViewers )FNetViewer( Connection->Children[ViewerIndex], DeltaSeconds );
+					if ( Connection->Children[ViewerIndex]->ViewTarget != NULL )
+					{
+						new( ConnectionViewers )FNetViewer( Connection->Children[ViewerIndex], DeltaSeconds );
+					}
 				}
 			}
 
@@ -5165,11 +5927,32 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 			FActorPriority* PriorityList	= NULL;
 			FActorPriority** PriorityActors = NULL;
 
+			int32 FinalSortedCount = 0;
+			int32 LastProcessedActor = 0;
+
+			if ( bUseGatheredActors && GNetParallelPrioritizeActorsValidate != 0 )
+			{
+				if ( !ServerReplicateActors_ValidateGatheredActors( Connection, ConnectionViewers, ConsiderList, ConnectionGatheredActors[i].GatheredActors ) )
+				{
+					ParallelGatherMismatches++;
+				}
+			}
+
 			// Get a sorted list of actors for this connection
-			const int32 FinalSortedCount = ServerReplicateActors_PrioritizeActors( Connection, ConnectionViewers, ConsiderList, bCPUSaturated, PriorityList, PriorityActors );
+			{
+				FScopedReplicationPhaseTimer PhaseTimer( ReplicationPhaseTimings, &FNetReplicationPhaseTimings::PrioritizeActorsCycles );
+
+				FinalSortedCount = bUseGatheredActors ?
+					ServerReplicateActors_PrioritizeGatheredActors( Connection, ConnectionViewers, ConnectionGatheredActors[i].GatheredActors, PriorityList, PriorityActors ) :
+					ServerReplicateActors_PrioritizeActors( Connection, ConnectionViewers, ConsiderList, bCPUSaturated, PriorityList, PriorityActors );
+			}
 
 			// Process the sorted list of actors for this connection
-			const int32 LastProcessedActor = ServerReplicateActors_ProcessPrioritizedActors( Connection, ConnectionViewers, PriorityActors, FinalSortedCount, Updated );
+			{
+				FScopedReplicationPhaseTimer PhaseTimer( ReplicationPhaseTimings, &FNetReplicationPhaseTimings::ReplicatePropertiesCycles );
+
+				LastProcessedActor = ServerReplicateActors_ProcessPrioritizedActors( Connection, ConnectionViewers, PriorityActors, FinalSortedCount, Updated );
+			}
 
 			// relevant actors that could not be processed this frame are marked to be considered for next frame
 			for ( int32 k=LastProcessedActor; k<FinalSortedCount; k++ )
@@ -6205,6 +6988,12 @@ void UNetDriver::ProcessRemoteFunction(
 
 		++TotalRPCsCalled;
 
+		// Queued RPCs are sent with the next replication update, so quiescent actors need to be considered again
+		if (bIsServer)
+		{
+			WakeQuiescentActor(Actor);
+		}
+
 		// Copy Any Out Params to Local Params 
 		TArray<NetDriverInternal::FAutoDestructProperty> LocalOutParms;
 		if (Stack == nullptr)
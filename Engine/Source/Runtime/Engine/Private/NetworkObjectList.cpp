@@ -76,7 +76,7 @@ TSharedPtr<FNetworkObjectInfo>* FNetworkObjectList::FindOrAdd(AActor* const Acto
 		}
 	}
 	
-	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num()) == AllNetworkObjects.Num());
+	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
 
 	return NetworkObjectInfo;
 }
@@ -95,7 +95,8 @@ void FNetworkObjectList::Remove(AActor* const Actor)
 		// Sanity check that we're not on the other lists either
 		check(!ActiveNetworkObjects.Contains(Actor));
 		check(!ObjectsDormantOnAllConnections.Contains(Actor));
-		check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num()) == AllNetworkObjects.Num());
+		check(!QuiescentNetworkObjects.Contains(Actor));
+		check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
 		return;
 	}
 
@@ -117,12 +118,15 @@ void FNetworkObjectList::Remove(AActor* const Actor)
 		NumDormantObjectsPerConnectionRef--;
 	}
 
+	RelevancyGrid.Remove(*NetworkObjectInfo);
+
 	// Remove this object from all lists
 	AllNetworkObjects.Remove(Actor);
 	ActiveNetworkObjects.Remove(Actor);
 	ObjectsDormantOnAllConnections.Remove(Actor);
+	QuiescentNetworkObjects.Remove(Actor);
 
-	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num()) == AllNetworkObjects.Num());
+	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
 }
 
 void FNetworkObjectList::MarkDormant(AActor* const Actor, UNetConnection* const Connection, const int32 NumConnections, UNetDriver* NetDriver)
@@ -136,6 +140,11 @@ void FNetworkObjectList::MarkDormant(AActor* const Actor, UNetConnection* const
 
 	FNetworkObjectInfo* NetworkObjectInfo = NetworkObjectInfoPtr->Get();
 
+	if (NetworkObjectInfo->bQuiescent)
+	{
+		WakeQuiescentInternal(*NetworkObjectInfoPtr);
+	}
+
 	// Add the connection to the list of dormant connections (if it's not already on the list)
 	if (!NetworkObjectInfo->DormantConnections.Contains(Connection))
 	{
@@ -171,7 +180,7 @@ void FNetworkObjectList::MarkDormant(AActor* const Actor, UNetConnection* const
 		UE_LOG(LogNetDormancy, Log, TEXT("FNetworkObjectList::MarkDormant: Actor is now dormant on all connections. Actor: %s. Total: %i, Active: %i, Connection: %s"), *Actor->GetName(), AllNetworkObjects.Num(), ActiveNetworkObjects.Num(), *Connection->GetName());
 	}
 
-	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num()) == AllNetworkObjects.Num());
+	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
 }
 
 bool FNetworkObjectList::MarkActive(AActor* const Actor, UNetConnection* const Connection, UNetDriver* NetDriver)
@@ -185,6 +194,11 @@ bool FNetworkObjectList::MarkActive(AActor* const Actor, UNetConnection* const C
 
 	FNetworkObjectInfo* NetworkObjectInfo = NetworkObjectInfoPtr->Get();
 
+	if (NetworkObjectInfo->bQuiescent)
+	{
+		WakeQuiescentInternal(*NetworkObjectInfoPtr);
+	}
+
 	// Remove from the ObjectsDormantOnAllConnections if needed
 	if (ObjectsDormantOnAllConnections.Remove(Actor) > 0)
 	{
@@ -194,7 +208,7 @@ bool FNetworkObjectList::MarkActive(AActor* const Actor, UNetConnection* const C
 		UE_LOG(LogNetDormancy, Log, TEXT("FNetworkObjectList::MarkDormant: Actor is no longer dormant on all connections. Actor: %s. Total: %i, Active: %i, Connection: %s"), *Actor->GetName(), AllNetworkObjects.Num(), ActiveNetworkObjects.Num(), *Connection->GetName());
 	}
 
-	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num()) == AllNetworkObjects.Num());
+	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
 
 	// Remove connection from the dormant connection list
 	if (NetworkObjectInfo->DormantConnections.Remove(Connection) > 0)
@@ -251,12 +265,16 @@ void FNetworkObjectList::HandleConnectionAdded()
 	}
 
 	ObjectsDormantOnAllConnections.Empty();
+
+	// Quiescent objects also need to be considered, to replicate to the new connection
+	WakeAllQuiescent();
 }
 
 void FNetworkObjectList::ResetDormancyState()
 {
 	// Reset all state related to dormancy, and move all objects back on to the active list
 	ObjectsDormantOnAllConnections.Empty();
+	QuiescentNetworkObjects.Empty();
 
 	ActiveNetworkObjects = AllNetworkObjects;
 
@@ -266,11 +284,81 @@ void FNetworkObjectList::ResetDormancyState()
 
 		NetworkObjectInfo->DormantConnections.Empty();
 		NetworkObjectInfo->RecentlyDormantConnections.Empty();
+		NetworkObjectInfo->bQuiescent = false;
+		NetworkObjectInfo->QuiescentChangelistMgrs.Empty();
 	}
 
 	NumDormantObjectsPerConnection.Empty();
 }
 
+void FNetworkObjectList::MarkQuiescent(AActor* const Actor)
+{
+	const TSharedPtr<FNetworkObjectInfo>* NetworkObjectInfoPtr = ActiveNetworkObjects.Find(Actor);
+
+	if (NetworkObjectInfoPtr == nullptr)
+	{
+		return;		// Only active objects can become quiescent
+	}
+
+	(*NetworkObjectInfoPtr)->bQuiescent = true;
+	(*NetworkObjectInfoPtr)->bWokenFromQuiescence = false;
+
+	QuiescentNetworkObjects.Add(*NetworkObjectInfoPtr);
+	ActiveNetworkObjects.Remove(Actor);
+
+	UE_LOG(LogNetDormancy, Verbose, TEXT("FNetworkObjectList::MarkQuiescent: Actor is now quiescent. Actor: %s. Total: %i, Active: %i, Quiescent: %i"), *Actor->GetName(), AllNetworkObjects.Num(), ActiveNetworkObjects.Num(), QuiescentNetworkObjects.Num());
+
+	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
+}
+
+bool FNetworkObjectList::WakeQuiescent(AActor* const Actor)
+{
+	if (QuiescentNetworkObjects.Num() == 0)
+	{
+		return false;
+	}
+
+	if (const TSharedPtr<FNetworkObjectInfo>* NetworkObjectInfoPtr = QuiescentNetworkObjects.Find(Actor))
+	{
+		WakeQuiescentInternal(*NetworkObjectInfoPtr);
+		return true;
+	}
+
+	return false;
+}
+
+void FNetworkObjectList::WakeAllQuiescent()
+{
+	for (const TSharedPtr<FNetworkObjectInfo>& NetworkObjectInfo : QuiescentNetworkObjects)
+	{
+		NetworkObjectInfo->bQuiescent = false;
+		NetworkObjectInfo->bWokenFromQuiescence = true;
+		NetworkObjectInfo->QuiescentChangelistMgrs.Reset();
+
+		ActiveNetworkObjects.Add(NetworkObjectInfo);
+	}
+
+	QuiescentNetworkObjects.Empty();
+}
+
+void FNetworkObjectList::WakeQuiescentInternal(const TSharedPtr<FNetworkObjectInfo>& NetworkObjectInfo)
+{
+	// Keep a reference, as the set element may be the caller's reference
+	TSharedPtr<FNetworkObjectInfo> WokenInfo = NetworkObjectInfo;
+	AActor* const Actor = WokenInfo->Actor;
+
+	WokenInfo->bQuiescent = false;
+	WokenInfo->bWokenFromQuiescence = true;
+	WokenInfo->QuiescentChangelistMgrs.Reset();
+
+	QuiescentNetworkObjects.Remove(Actor);
+	ActiveNetworkObjects.Add(WokenInfo);
+
+	UE_LOG(LogNetDormancy, Verbose, TEXT("FNetworkObjectList::WakeQuiescent: Actor is no longer quiescent. Actor: %s. Total: %i, Active: %i, Quiescent: %i"), *GetNameSafe(Actor), AllNetworkObjects.Num(), ActiveNetworkObjects.Num(), QuiescentNetworkObjects.Num());
+
+	check((ActiveNetworkObjects.Num() + ObjectsDormantOnAllConnections.Num() + QuiescentNetworkObjects.Num()) == AllNetworkObjects.Num());
+}
+
 int32 FNetworkObjectList::GetNumDormantActorsForConnection(UNetConnection* const Connection) const
 {
 	const int32 *Count = NumDormantObjectsPerConnection.Find( Connection );
@@ -295,9 +383,11 @@ void FNetworkObjectList::ForceActorRelevantNextUpdate(AActor* const Actor, UNetD
 void FNetworkObjectList::Reset()
 {
 	// Reset all state
+	RelevancyGrid.Reset();
 	AllNetworkObjects.Empty();
 	ActiveNetworkObjects.Empty();
 	ObjectsDormantOnAllConnections.Empty();
+	QuiescentNetworkObjects.Empty();
 	NumDormantObjectsPerConnection.Empty();
 }
 
@@ -305,6 +395,7 @@ void FNetworkObjectInfo::CountBytes(FArchive& Ar) const
 {
 	DormantConnections.CountBytes(Ar);
 	RecentlyDormantConnections.CountBytes(Ar);
+	QuiescentChangelistMgrs.CountBytes(Ar);
 }
 
 void FNetworkObjectList::CountBytes(FArchive& Ar) const
@@ -312,9 +403,11 @@ void FNetworkObjectList::CountBytes(FArchive& Ar) const
 	AllNetworkObjects.CountBytes(Ar);
 	ActiveNetworkObjects.CountBytes(Ar);
 	ObjectsDormantOnAllConnections.CountBytes(Ar);
+	QuiescentNetworkObjects.CountBytes(Ar);
 	NumDormantObjectsPerConnection.CountBytes(Ar);
+	RelevancyGrid.CountBytes(Ar);
  
-	// ObjectsDormantOnAllConnections and ActiveNetworkObjects are both sub sets of AllNetworkObjects
+	// ObjectsDormantOnAllConnections, QuiescentNetworkObjects and ActiveNetworkObjects are all sub sets of AllNetworkObjects
 	// and only have pointers back to the data there.
 	// So, to avoid double (or triple) counting, only explicit count the elements from AllNetworkObjects.
 	for (const TSharedPtr<FNetworkObjectInfo>& SharedInfo : AllNetworkObjects)
@@ -989,6 +989,25 @@ void StatelessConnectHandlerComponent::Outgoing(FBitWriter& Packet, FOutPacketTr
 	Packet = MoveTemp(NewPacket);
 }
 
+int32 StatelessConnectHandlerComponent::GetOutgoingPrefixBits(bool bConnectionless) const
+{
+	// Connectionless packets are not modified, and UNetConnection packets are only prefixed with the magic header and bHandshakePacket bit
+	return bConnectionless ? 0 : MagicHeader.Num() + 1;
+}
+
+void StatelessConnectHandlerComponent::WriteOutgoingPrefix(const TSharedPtr<const FInternetAddr>& Address, FBitWriter& Prefix, FOutPacketTraits& Traits)
+{
+	// Must match Outgoing
+	uint8 bHandshakePacket = 0;
+
+	if (MagicHeader.Num() > 0)
+	{
+		Prefix.SerializeBits(MagicHeader.GetData(), MagicHeader.Num());
+	}
+
+	Prefix.WriteBit(bHandshakePacket);
+}
+
 void StatelessConnectHandlerComponent::IncomingConnectionless(FIncomingPacketRef PacketRef)
 {
 	FBitReader& Packet = PacketRef.Packet;
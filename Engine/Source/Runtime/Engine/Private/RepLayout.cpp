@@ -55,6 +55,16 @@ int32 GNetSharedSerializedData = 1;
 static FAutoConsoleVariableRef CVarNetShareSerializedData(TEXT("net.ShareSerializedData"), GNetSharedSerializedData,
 	TEXT("If true, enable shared serialization system used by replication to reduce CPU usage when multiple clients need the same data"));
 
+int32 GNetSharedSerializedDataOnMiss = 1;
+static FAutoConsoleVariableRef CVarNetShareSerializedDataOnMiss(TEXT("net.ShareSerializedDataOnMiss"), GNetSharedSerializedDataOnMiss,
+	TEXT("If true, shareable properties that weren't part of the initial shared serialization data are serialized into it the first time a connection needs them, ")
+	TEXT("so other connections sending the same property this frame can copy the serialized bits instead of serializing it again"));
+
+int32 GNetSharedSerializedFastArrayData = 1;
+static FAutoConsoleVariableRef CVarNetShareSerializedFastArrayData(TEXT("net.ShareSerializedFastArrayData"), GNetSharedSerializedFastArrayData,
+	TEXT("If true, changed items of Fast Arrays using delta struct serialization will share their serialized properties between connections each frame. ")
+	TEXT("Requires net.ShareSerializedData."));
+
 int32 GNetVerifyShareSerializedData = 0;
 static FAutoConsoleVariableRef CVarNetVerifyShareSerializedData(TEXT("net.VerifyShareSerializedData"), GNetVerifyShareSerializedData,
 	TEXT("Debug option to verify shared serialization data during replication"));
@@ -71,6 +81,11 @@ int32 GShareShadowState = 1;
 static FAutoConsoleVariableRef CVarShareShadowState(TEXT("net.ShareShadowState"), GShareShadowState,
 	TEXT("If true, work done to compare properties will be shared across connections"));
 
+int32 GCompareRepPODSpans = 1;
+static FAutoConsoleVariableRef CVarCompareRepPODSpans(TEXT("net.CompareRepPODSpans"), GCompareRepPODSpans,
+	TEXT("If true, runs of adjacent plain old data properties will be compared against the shadow state in bulk, ")
+	TEXT("and only compared individually when something in the run has changed. Doesn't apply to push model objects."));
+
 int32 GShareInitialCompareState = 0;
 static FAutoConsoleVariableRef CVarShareInitialCompareState(TEXT("net.ShareInitialCompareState"), GShareInitialCompareState,
 	TEXT("If true and net.ShareShadowState is enabled, attempt to also share initial replication compares across connections."));
@@ -92,6 +107,13 @@ constexpr bool GbPushModelValidateProperties = false;
 
 extern int32 GNumSharedSerializationHit;
 extern int32 GNumSharedSerializationMiss;
+extern int64 GNumSharedSerializationBitsSaved;
+extern int64 GNumFastArrayDeltaBitsSaved;
+
+static int32 GNetTrackFastArrayDeltaSavings = 1;
+static FAutoConsoleVariableRef CVarNetTrackFastArrayDeltaSavings(TEXT("net.TrackFastArrayDeltaSavings"), GNetTrackFastArrayDeltaSavings,
+	TEXT("When enabled, Fast Array items sent relative to a connection's acked baseline are compared against the size of their last full send, ")
+	TEXT("and the bits saved are reported to stats and NetTrace (FastArrayDeltaBitsSaved)."));
 
 extern NETCORE_API TAutoConsoleVariable<int32> CVarNetEnableDetailedScopeCounters;
 
@@ -494,9 +516,16 @@ struct FDeltaArrayHistoryState
 	/** Index in the buffer where changelist history ends (i.e., the Newest changelist). */
 	uint32 HistoryEnd = 0;
 
+	/**
+	 * Number of bits last used to send all properties of an element, by element ID.
+	 * Used to measure the bandwidth saved by sending elements relative to a connection's acked baseline (see net.TrackFastArrayDeltaSavings).
+	 */
+	TMap<int32, uint32> FullItemBitsByID;
+
 	void CountBytes(FArchive& Ar) const
 	{
 		IDToIndexMap.CountBytes(Ar);
+		FullItemBitsByID.CountBytes(Ar);
 
 		for (const FDeltaArrayHistoryItem& HistoryItem : ChangeHistory)
 		{
@@ -521,6 +550,12 @@ struct FCustomDeltaChangelistState
 	 */
 	TArray<FDeltaArrayHistoryState> ArrayStates;
 
+	/**
+	 * Shared serialization data for Fast Array item properties sent during LastReplicationFrame.
+	 * Item properties aren't tracked by the object's changelist, so this is reset every replication frame.
+	 */
+	FRepSerializationSharedInfo SharedSerialization;
+
 	void CountBytes(FArchive& Ar) const
 	{
 		GRANULAR_NETWORK_MEMORY_TRACKING_INIT(Ar, "FCustomDeltaChangelistState::CountBytes");
@@ -532,6 +567,8 @@ struct FCustomDeltaChangelistState
 				ArrayState.CountBytes(Ar);
 			}
 		);
+
+		GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("SharedSerialization", SharedSerialization.CountBytes(Ar));
 	}
 };
 
@@ -1310,6 +1347,7 @@ struct FComparePropertiesSharedParams
 	const bool bValidateProperties = false;
 	const bool bIsNetworkProfilerActive = false;
 	const bool bChangedNetOwner = false;
+	const TArray<FRepPODParentSpan>* const PODParentSpans = nullptr;
 #if (WITH_PUSH_VALIDATION_SUPPORT || USE_NETWORK_PROFILER)
 	TBitArray<> PropertiesCompared;
 	TBitArray<> PropertiesChanged;
@@ -1453,6 +1491,101 @@ namespace UE_RepLayout_Private
 #endif // WITH_PUSH_MODEL	
 }	
 
+namespace UE_RepLayout_Private
+{
+	/**
+	 * Returns whether or not two blocks of memory hold the same bytes.
+	 * Used to compare spans of plain old data properties against the shadow state, where
+	 * spans are typically a few dozen bytes and a call to memcmp would dominate the cost.
+	 */
+	static FORCEINLINE bool AreBytesIdentical(const uint8* RESTRICT A, const uint8* RESTRICT B, const int32 NumBytes)
+	{
+		int32 Offset = 0;
+
+#if defined(UE_PLATFORM_MATH_USE_AVX_2) && UE_PLATFORM_MATH_USE_AVX_2
+		for (; Offset + 32 <= NumBytes; Offset += 32)
+		{
+			const __m256i VecA = _mm256_loadu_si256((const __m256i*)(A + Offset));
+			const __m256i VecB = _mm256_loadu_si256((const __m256i*)(B + Offset));
+
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(VecA, VecB)) != -1)
+			{
+				return false;
+			}
+		}
+#endif
+
+#if defined(UE_PLATFORM_MATH_USE_SSE4_1)
+		// UnrealMathSSE is in use, so SSE2 is always available.
+		for (; Offset + 16 <= NumBytes; Offset += 16)
+		{
+			const __m128i VecA = _mm_loadu_si128((const __m128i*)(A + Offset));
+			const __m128i VecB = _mm_loadu_si128((const __m128i*)(B + Offset));
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(VecA, VecB)) != 0xFFFF)
+			{
+				return false;
+			}
+		}
+#endif
+
+		for (; Offset + 8 <= NumBytes; Offset += 8)
+		{
+			if (FPlatformMemory::ReadUnaligned<uint64>(A + Offset) != FPlatformMemory::ReadUnaligned<uint64>(B + Offset))
+			{
+				return false;
+			}
+		}
+
+		for (; Offset < NumBytes; ++Offset)
+		{
+			if (A[Offset] != B[Offset])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Compares all Parent Properties, skipping any plain old data spans whose bytes match the shadow state. */
+	static void CompareParentPropertiesWithPODSpans(
+		const FComparePropertiesSharedParams& SharedParams,
+		FComparePropertiesStackParams& StackParams)
+	{
+		const uint8* RESTRICT Data = StackParams.Data.Data;
+		const uint8* RESTRICT ShadowData = StackParams.ShadowData.Data;
+		const int32 NumParents = SharedParams.Parents.Num();
+
+		int32 ParentIndex = 0;
+
+		for (const FRepPODParentSpan& Span : *SharedParams.PODParentSpans)
+		{
+			for (; ParentIndex < Span.ParentStart; ++ParentIndex)
+			{
+				CompareParentPropertyHelper(ParentIndex, SharedParams, StackParams);
+			}
+
+			// If any byte in the span changed, fall back to comparing each property in it, so the changelist and
+			// shadow state are updated exactly as they would normally be.
+			if (!AreBytesIdentical(Data + Span.Offset, ShadowData + Span.ShadowOffset, Span.Size))
+			{
+				for (; ParentIndex < Span.ParentEnd; ++ParentIndex)
+				{
+					CompareParentPropertyHelper(ParentIndex, SharedParams, StackParams);
+				}
+			}
+
+			ParentIndex = Span.ParentEnd;
+		}
+
+		for (; ParentIndex < NumParents; ++ParentIndex)
+		{
+			CompareParentPropertyHelper(ParentIndex, SharedParams, StackParams);
+		}
+	}
+}
+
 static void CompareParentProperties(
 	const FComparePropertiesSharedParams& SharedParams,
 	FComparePropertiesStackParams& StackParams)
@@ -1526,6 +1659,14 @@ static void CompareParentProperties(
 	}
 #endif // WITH_PUSH_MODEL
 
+	// When forcibly comparing all properties every property will be marked changed anyway,
+	// and the network profiler needs to track individual comparisons.
+	if (SharedParams.PODParentSpans && SharedParams.PODParentSpans->Num() > 0 && !SharedParams.bForceFail && !SharedParams.bIsNetworkProfilerActive)
+	{
+		UE_RepLayout_Private::CompareParentPropertiesWithPODSpans(SharedParams, StackParams);
+		return;
+	}
+
 	for (int32 ParentIndex = 0; ParentIndex < SharedParams.Parents.Num(); ++ParentIndex)
 	{
 		UE_RepLayout_Private::CompareParentPropertyHelper(ParentIndex, SharedParams, StackParams);
@@ -1703,7 +1844,8 @@ ERepLayoutResult FRepLayout::CompareProperties(
 		/*PushModelProperties=*/ LocalPushModelProperties,	
 		/*bValidateProperties=*/GbPushModelValidateProperties,
 		/*bIsNetworkProfilerActive=*/UE_RepLayout_Private::IsNetworkProfilerComparisonTrackingEnabled(),
-		/*bChangedNetOwner=*/ RepState && RepState->RepFlags.bNetOwner != RepFlags.bNetOwner
+		/*bChangedNetOwner=*/ RepState && RepState->RepFlags.bNetOwner != RepFlags.bNetOwner,
+		/*PODParentSpans=*/ (GCompareRepPODSpans != 0) ? &PODParentSpans : nullptr
 	};
 
 	FComparePropertiesStackParams StackParams{
@@ -2574,6 +2716,7 @@ void FRepSerializationSharedInfo::CountBytes(FArchive& Ar) const
 	GRANULAR_NETWORK_MEMORY_TRACKING_INIT(Ar, "FRepSerializationSharedInfo::CountBytes");
 
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("SharedPropertyInfo", SharedPropertyInfo.CountBytes(Ar));
+	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("SharedPropertyInfoIndices", SharedPropertyInfoIndices.CountBytes(Ar));
 
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("SerializedProperties",
 		if (FNetBitWriter const* const LocalSerializedProperties = SerializedProperties.Get())
@@ -2609,12 +2752,11 @@ const FRepSerializedPropertyInfo* FRepSerializationSharedInfo::WriteSharedProper
 	const bool bDoChecksum)
 {
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-	check(!SharedPropertyInfo.ContainsByPredicate([PropertyKey](const FRepSerializedPropertyInfo& Info)
-	{ 
-		return (Info.PropertyKey == PropertyKey);
-	}));
+	check(!SharedPropertyInfoIndices.Contains(PropertyKey));
 #endif
 
+	SharedPropertyInfoIndices.Add(PropertyKey, SharedPropertyInfo.Num());
+
 	FRepSerializedPropertyInfo& SharedPropInfo = SharedPropertyInfo.Emplace_GetRef();
 
 	SharedPropInfo.PropertyKey = PropertyKey;
@@ -2655,11 +2797,14 @@ void FRepLayout::SendProperties_r(
 	FRepHandleIterator& HandleIterator,
 	const FConstRepObjectDataBuffer SourceData,
 	const int32 ArrayDepth,
-	const FRepSerializationSharedInfo* const RESTRICT SharedInfo,
+	FRepSerializationSharedInfo* const RESTRICT SharedInfo,
 	const ESerializePropertyType SerializePropertyType) const
 {
 	const bool bDoSharedSerialization = SharedInfo && !!GNetSharedSerializedData;
 
+	// Shared data always includes the property handle, so we can only add to it when sending handles.
+	const bool bShareOnMiss = bDoSharedSerialization && SharedInfo->IsValid() && !!GNetSharedSerializedDataOnMiss && (SerializePropertyType == ESerializePropertyType::Handle);
+
 	while (HandleIterator.NextHandle())
 	{
 		const FRepLayoutCmd& Cmd = Cmds[HandleIterator.CmdIndex];
@@ -2717,15 +2862,23 @@ void FRepLayout::SendProperties_r(
 #endif
 
 		const FRepSerializedPropertyInfo* SharedPropInfo = nullptr;
+		bool bWroteSharedProperty = false;
 
 		if (bDoSharedSerialization && EnumHasAnyFlags(Cmd.Flags, ERepLayoutCmdFlags::IsSharedSerialization))
 		{
 			FRepSharedPropertyKey PropertyKey(HandleIterator.CmdIndex, HandleIterator.ArrayIndex, ArrayDepth, (void*)Data.Data);
 
-			SharedPropInfo = SharedInfo->SharedPropertyInfo.FindByPredicate([PropertyKey](const FRepSerializedPropertyInfo& Info)
-			{ 
-				return (Info.PropertyKey == PropertyKey);
-			});
+			SharedPropInfo = SharedInfo->FindSharedProperty(PropertyKey);
+
+			// This property wasn't part of the shared data yet (e.g., it's only in this connection's changelist).
+			// Serialize it into the shared data now, so any other connection sending it this frame can reuse it.
+			if (!SharedPropInfo && bShareOnMiss)
+			{
+				UE_LOG(LogRepProperties, VeryVerbose, TEXT("SendProperties_r: Adding SharedSerialization - Handle=%d, Key=%s"), HandleIterator.Handle, *PropertyKey.ToDebugString());
+
+				SharedPropInfo = SharedInfo->WriteSharedProperty(Cmd, PropertyKey, HandleIterator.CmdIndex, HandleIterator.Handle, Data, /*bWriteHandle=*/true, bDoChecksum);
+				bWroteSharedProperty = true;
+			}
 		}
 
 		// Use shared serialization if was found
@@ -2735,7 +2888,17 @@ void FRepLayout::SendProperties_r(
 			UE_NET_TRACE_SCOPE(Shared, Writer, GetTraceCollector(Writer), ENetTraceVerbosity::Trace);
 
 			UE_LOG(LogRepProperties, VeryVerbose, TEXT("SerializeProperties_r: SharedSerialization - Handle=%d, Key=%s"), HandleIterator.Handle, *SharedPropInfo->PropertyKey.ToDebugString());
-			GNumSharedSerializationHit++;
+
+			// We had to serialize the property ourselves if we just added it to the shared data
+			if (bWroteSharedProperty)
+			{
+				GNumSharedSerializationMiss++;
+			}
+			else
+			{
+				GNumSharedSerializationHit++;
+				GNumSharedSerializationBitsSaved += SharedPropInfo->PropBitLength;
+			}
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 			if (GNetVerifyShareSerializedData != 0)
 			{
@@ -2827,7 +2990,7 @@ void FRepLayout::SendProperties(
 	UClass* ObjectClass,
 	FNetBitWriter& Writer,
 	TArray<uint16>& Changed,
-	const FRepSerializationSharedInfo& SharedInfo,
+	FRepSerializationSharedInfo& SharedInfo,
 	const ESerializePropertyType SerializePropertyType) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NetReplicateDynamicPropSendTime);
@@ -5906,6 +6069,140 @@ static void BuildShadowOffsets(
 	}
 }
 
+/** Whether or not bitwise equality of the command's memory guarantees PropertiesAreIdentical will return true. */
+static bool IsPODCmd(const FRepLayoutCmd& Cmd)
+{
+	switch (Cmd.Type)
+	{
+		case ERepLayoutCmdType::PropertyNativeBool:
+		case ERepLayoutCmdType::PropertyByte:
+		case ERepLayoutCmdType::PropertyFloat:
+		case ERepLayoutCmdType::PropertyInt:
+		case ERepLayoutCmdType::PropertyName:
+		case ERepLayoutCmdType::PropertyUInt32:
+		case ERepLayoutCmdType::PropertyUInt64:
+		case ERepLayoutCmdType::PropertyVector:
+		case ERepLayoutCmdType::PropertyVector100:
+		case ERepLayoutCmdType::PropertyVectorQ:
+		case ERepLayoutCmdType::PropertyVectorNormal:
+		case ERepLayoutCmdType::PropertyVector10:
+		case ERepLayoutCmdType::PropertyPlane:
+		case ERepLayoutCmdType::PropertyRotator:
+			return true;
+
+		case ERepLayoutCmdType::Property:
+			return Cmd.Property->IsA<FNumericProperty>() || Cmd.Property->IsA<FEnumProperty>();
+
+		default:
+			// Bitfield bools may share memory with non replicated bits, and everything else
+			// either owns memory elsewhere or needs a custom comparison.
+			return false;
+	}
+}
+
+/**
+ * Finds runs of adjacent Parent Commands that only contain plain old data, and are contiguous in both
+ * Object and Shadow memory (see FRepPODParentSpan).
+ *
+ * Note, floating point properties holding NaN will compare as identical if their bits haven't changed,
+ * instead of being treated as changed on every compare.
+ */
+static void BuildPODParentSpans(
+	const ERepLayoutFlags Flags,
+	const TArray<FRepParentCmd>& Parents,
+	const TArray<FRepLayoutCmd>& Cmds,
+	TArray<FRepPODParentSpan>& OutPODParentSpans)
+{
+	OutPODParentSpans.Reset();
+
+	const bool bIsActor = EnumHasAnyFlags(Flags, ERepLayoutFlags::IsActor);
+
+	auto IsPODParent = [&Parents, &Cmds, bIsActor](const int32 ParentIndex)
+	{
+		const FRepParentCmd& Parent = Parents[ParentIndex];
+
+		// Role and RemoteRole are compared against the per connection saved roles, not the shadow state.
+		if (bIsActor && (ParentIndex == (int32)AActor::ENetFields_Private::Role || ParentIndex == (int32)AActor::ENetFields_Private::RemoteRole))
+		{
+			return false;
+		}
+
+		if (Parent.CmdEnd <= Parent.CmdStart || EnumHasAnyFlags(Parent.Flags, ERepParentFlags::IsCustomDelta))
+		{
+			return false;
+		}
+
+		for (int32 CmdIndex = Parent.CmdStart; CmdIndex < Parent.CmdEnd; ++CmdIndex)
+		{
+			const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
+
+			if (!IsPODCmd(Cmd))
+			{
+				return false;
+			}
+
+			// Properties of flattened structs need to be contiguous too.
+			if (CmdIndex > Parent.CmdStart)
+			{
+				const FRepLayoutCmd& PrevCmd = Cmds[CmdIndex - 1];
+
+				if (Cmd.Offset != PrevCmd.Offset + PrevCmd.ElementSize || Cmd.ShadowOffset != PrevCmd.ShadowOffset + PrevCmd.ElementSize)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	FRepPODParentSpan CurrentSpan;
+	int32 NumSpanParents = 0;
+
+	auto FinishSpan = [&CurrentSpan, &NumSpanParents, &OutPODParentSpans]()
+	{
+		// A single property gains nothing from being compared as a span.
+		if (NumSpanParents > 1)
+		{
+			OutPODParentSpans.Add(CurrentSpan);
+		}
+
+		NumSpanParents = 0;
+	};
+
+	for (int32 ParentIndex = 0; ParentIndex < Parents.Num(); ++ParentIndex)
+	{
+		if (!IsPODParent(ParentIndex))
+		{
+			FinishSpan();
+			continue;
+		}
+
+		const FRepParentCmd& Parent = Parents[ParentIndex];
+		const FRepLayoutCmd& FirstCmd = Cmds[Parent.CmdStart];
+		const FRepLayoutCmd& LastCmd = Cmds[Parent.CmdEnd - 1];
+
+		const bool bExtendsSpan = NumSpanParents > 0 &&
+			(FirstCmd.Offset == CurrentSpan.Offset + CurrentSpan.Size) &&
+			(FirstCmd.ShadowOffset == CurrentSpan.ShadowOffset + CurrentSpan.Size);
+
+		if (!bExtendsSpan)
+		{
+			FinishSpan();
+
+			CurrentSpan.ParentStart = (uint16)ParentIndex;
+			CurrentSpan.Offset = FirstCmd.Offset;
+			CurrentSpan.ShadowOffset = FirstCmd.ShadowOffset;
+		}
+
+		CurrentSpan.ParentEnd = (uint16)(ParentIndex + 1);
+		CurrentSpan.Size = LastCmd.Offset + LastCmd.ElementSize - CurrentSpan.Offset;
+		++NumSpanParents;
+	}
+
+	FinishSpan();
+}
+
 TSharedPtr<FRepLayout> FRepLayout::CreateFromClass(
 	UClass* InClass,
 	const UNetConnection* ServerConnection,
@@ -6256,6 +6553,11 @@ void FRepLayout::InitFromClass(
 
 	BuildShadowOffsets<ERepBuildType::Class>(InObjectClass, Parents, Cmds, ShadowDataBufferSize);
 
+	if (!ServerConnection || EnumHasAnyFlags(CreateFlags, ECreateRepLayoutFlags::MaySendProperties))
+	{
+		BuildPODParentSpans(Flags, Parents, Cmds, PODParentSpans);
+	}
+
 	Owner = InObjectClass;
 }
 
@@ -6475,10 +6777,7 @@ void FRepLayout::SerializeProperties_r(
 		{
 			FRepSharedPropertyKey PropertyKey(CmdIndex, ArrayIndex, ArrayDepth, (void*)(Data + Cmd).Data);
 
-			SharedPropInfo = SharedInfo.SharedPropertyInfo.FindByPredicate([PropertyKey](const FRepSerializedPropertyInfo& Info) 
-			{ 
-				return (Info.PropertyKey == PropertyKey);
-			});
+			SharedPropInfo = SharedInfo.FindSharedProperty(PropertyKey);
 		}
 
 		if (Ar.IsLoading() && Map)
@@ -6491,6 +6790,7 @@ void FRepLayout::SerializeProperties_r(
 		if (SharedPropInfo)
 		{
 			GNumSharedSerializationHit++;
+			GNumSharedSerializationBitsSaved += SharedPropInfo->PropBitLength;
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 			if ((GNetVerifyShareSerializedData != 0) && Ar.IsSaving())
 			{
@@ -7258,6 +7558,10 @@ void FRepLayout::PreSendCustomDeltaProperties(
 			{
 				CustomDeltaChangelistState.LastReplicationFrame = ReplicationFrame;
 
+				// Item properties may have changed since last frame, so start with fresh shared serialization data.
+				CustomDeltaChangelistState.SharedSerialization.Reset();
+				CustomDeltaChangelistState.SharedSerialization.SetValid();
+
 				const FConstRepObjectDataBuffer ObjectData(Object);
 				const uint16 NumLifetimeCustomDeltaProperties = LocalLifetimeCustomPropertyState.GetNumCustomDeltaProperties();
 
@@ -7417,6 +7721,15 @@ ERepLayoutResult FRepLayout::DeltaSerializeFastArrayProperty(FFastArrayDeltaSeri
 		// This is a list of changelists to send, corresponding to items in ChangedElements.
 		TArray<TArray<uint16>> Changelists;
 
+		// Shared serialization data for item properties, reused by every connection sending the same items this frame.
+		FRepSerializationSharedInfo* ItemSharedInfo = nullptr;
+
+		// Per item full send sizes, used to measure the bandwidth saved by sending items relative to the acked baseline.
+		FDeltaArrayHistoryState* DeltaSavingsState = nullptr;
+
+		// Whether or not Changelists were merged from history, relative to the baseline this connection last acked.
+		bool bSendingFromBaseline = false;
+
 		const FHandleToCmdIndex& ArrayHandleToCmd = BaseHandleToCmdIndex[FastArrayItemCmd.RelativeHandle - 1];
 		const TArray<FHandleToCmdIndex>& ArrayHandleToCmdIndex = *ArrayHandleToCmd.HandleToCmdIndex;
 
@@ -7430,9 +7743,24 @@ ERepLayoutResult FRepLayout::DeltaSerializeFastArrayProperty(FFastArrayDeltaSeri
 				FRepChangelistState& RepChangelistState = *ChangelistMgr->GetRepChangelistState();
 				FCustomDeltaChangelistState& DeltaChangelistState = *RepChangelistState.CustomDeltaChangelistState;
 
+				if ((GNetSharedSerializedData != 0) && (GNetSharedSerializedFastArrayData != 0) && DeltaChangelistState.SharedSerialization.IsValid())
+				{
+					ItemSharedInfo = &DeltaChangelistState.SharedSerialization;
+				}
+
 				const int32 FastArrayNumber = CustomDeltaProperty.FastArrayNumber;
 				FDeltaArrayHistoryState& FastArrayState = DeltaChangelistState.ArrayStates[FastArrayNumber];
 
+				if (GNetTrackFastArrayDeltaSavings)
+				{
+					DeltaSavingsState = &FastArrayState;
+
+					// Items are only ever added to this map, so drop stale IDs once it grows well past the array size.
+					if (FastArrayState.FullItemBitsByID.Num() > FMath::Max(2 * ObjectArrayNum, 64))
+					{
+						FastArrayState.FullItemBitsByID.Reset();
+					}
+				}
 
 				// Params.WriteBaseState should be valid, and have the most up to date IDToChangelist map for the Fast Array.
 				// However, it's ChangelistHistory will be to the last History Number sent to the Fast TArray on the specific
@@ -7697,6 +8025,7 @@ ERepLayoutResult FRepLayout::DeltaSerializeFastArrayProperty(FFastArrayDeltaSeri
 				{
 					const FConstRepObjectDataBuffer ConstObjectData(ObjectData);
 					Changelists.SetNum(ChangedElements.Num());
+					bSendingFromBaseline = true;
 
 					// Note, we iterate from LastSentHistory + 1, because we don't want to send something if
 					// we think it's already been sent/received.
@@ -7777,6 +8106,8 @@ ERepLayoutResult FRepLayout::DeltaSerializeFastArrayProperty(FFastArrayDeltaSeri
 		// We will rely on the normal custom delta property tracking which happens elsewhere.
 		NETWORK_PROFILER_IGNORE_PROPERTY_SCOPE
 
+		uint32 DeltaBitsSaved = 0;
+
 		// Now that we have our changelists setup, we can send the data.
 		for (int32 i = 0; i < ChangedElements.Num(); ++i)
 		{
@@ -7805,6 +8136,8 @@ ERepLayoutResult FRepLayout::DeltaSerializeFastArrayProperty(FFastArrayDeltaSeri
 				const bool bAnythingToSend = Changelist.Num() > 1;
 				Writer.WriteBit(!!bAnythingToSend);
 
+				const int64 ItemStartBits = Writer.GetNumBits();
+
 				if (bAnythingToSend)
 				{
 					FChangelistIterator ChangelistIterator(Changelist, 0);
@@ -7825,15 +8158,39 @@ ERepLayoutResult FRepLayout::DeltaSerializeFastArrayProperty(FFastArrayDeltaSeri
 						HandleIterator,
 						ElementData,
 						/*ArrayDepth=*/ 1,
-						/*SharedInfo=*/ nullptr,
+						ItemSharedInfo,
 						ESerializePropertyType::Handle);
 
 					WritePropertyHandle(Writer, 0, false);
 				}
+
+				if (DeltaSavingsState)
+				{
+					const uint32 ItemBits = (uint32)(Writer.GetNumBits() - ItemStartBits);
+
+					if (!bSendingFromBaseline)
+					{
+						DeltaSavingsState->FullItemBitsByID.Add(IDIndexPair.ID, ItemBits);
+					}
+					else if (const uint32* FullItemBits = DeltaSavingsState->FullItemBitsByID.Find(IDIndexPair.ID))
+					{
+						DeltaBitsSaved += (*FullItemBits > ItemBits) ? (*FullItemBits - ItemBits) : 0;
+					}
+				}
 			}
 			
 		}
 
+		if (DeltaBitsSaved > 0)
+		{
+			GNumFastArrayDeltaBitsSaved += DeltaBitsSaved;
+
+			if (Connection->Driver)
+			{
+				UE_NET_TRACE_CONNECTION_STATSCOUNTER(Connection->Driver->GetNetTraceId(), Connection->GetConnectionId(), FastArrayDeltaBitsSaved, DeltaBitsSaved, ENetTraceVerbosity::Trace);
+			}
+		}
+
 		return !Writer.IsError() ? ERepLayoutResult::Success : ERepLayoutResult::Error;
 	}
 	else
@@ -8072,6 +8429,7 @@ void FRepLayout::CountBytes(FArchive& Ar) const
 	GRANULAR_NETWORK_MEMORY_TRACKING_INIT(Ar, "FRepLayout::CountBytes");
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("Parents", Parents.CountBytes(Ar));
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("Cmds", Cmds.CountBytes(Ar));
+	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("PODParentSpans", PODParentSpans.CountBytes(Ar));
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("BaseHandleToCmdIndex", BaseHandleToCmdIndex.CountBytes(Ar));
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("SharedInfoRPC", SharedInfoRPC.CountBytes(Ar));
 	GRANULAR_NETWORK_MEMORY_TRACKING_TRACK("SharedInfoRPCParentsChanged", SharedInfoRPCParentsChanged.CountBytes(Ar));
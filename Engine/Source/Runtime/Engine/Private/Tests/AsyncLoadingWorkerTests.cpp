@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AsyncLoadingWorkerTest
+{
+
+constexpr const uint32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter;
+
+/**
+ * Loads every engine package which isn't already loaded, several times over with garbage collection in between, while the async
+ * loading thread workers create and serialize exports concurrently with PostLoad on the async loading thread.
+ *
+ * The workers are only started along with the async loading thread, so this must be run with s.AsyncLoadingThreadWorkerCount set
+ * from startup (e.g. -dpcvars=s.AsyncLoadingThreadWorkerCount=4). The optional parameter limits the number of packages loaded.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLoadingWorkerStressTest, "System.Engine.Loading.AsyncLoadingWorkerStress", TestFlags)
+bool FAsyncLoadingWorkerStressTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* WorkerCountCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("s.AsyncLoadingThreadWorkerCount"));
+
+	if (!IsAsyncLoadingMultithreaded() || WorkerCountCVar == nullptr || WorkerCountCVar->GetInt() <= 0)
+	{
+		AddWarning(TEXT("Skipped: requires the async loading thread, with s.AsyncLoadingThreadWorkerCount set from startup"));
+		return true;
+	}
+
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+
+	if (!TestNotNull(TEXT("The asset registry must be available"), AssetRegistry))
+	{
+		return false;
+	}
+
+	int32 MaxPackages = MAX_int32;
+	LexFromString(MaxPackages, *Parameters);
+	MaxPackages = MaxPackages > 0 ? MaxPackages : MAX_int32;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry->GetAssetsByPath(TEXT("/Engine"), Assets, true);
+
+	TSet<FName> PackageNames;
+
+	for (const FAssetData& Asset : Assets)
+	{
+		if (PackageNames.Num() >= MaxPackages)
+		{
+			break;
+		}
+
+		if (FindPackage(nullptr, *Asset.PackageName.ToString()) == nullptr)
+		{
+			PackageNames.Add(Asset.PackageName);
+		}
+	}
+
+	if (PackageNames.Num() == 0)
+	{
+		AddWarning(TEXT("Skipped: no unloaded engine packages were found"));
+		return true;
+	}
+
+	const int32 NumRounds = 3;
+
+	for (int32 Round = 0; Round < NumRounds; Round++)
+	{
+		int32 NumCompleted = 0;
+		TArray<FName> FailedPackages;
+
+		for (const FName& PackageName : PackageNames)
+		{
+			LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+				[&NumCompleted, &FailedPackages](const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+				{
+					NumCompleted++;
+
+					if (Result != EAsyncLoadingResult::Succeeded || LoadedPackage == nullptr)
+					{
+						FailedPackages.Add(LoadedPackageName);
+					}
+				}));
+		}
+
+		FlushAsyncLoading();
+
+		TestEqual(FString::Printf(TEXT("Round %d: every load request must complete"), Round), NumCompleted, PackageNames.Num());
+
+		for (const FName& FailedPackage : FailedPackages)
+		{
+			AddError(FString::Printf(TEXT("Round %d: failed to load %s"), Round, *FailedPackage.ToString()));
+		}
+
+		// Unload the packages again, so that the next round loads them from scratch
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return !HasAnyErrors();
+}
+
+} // namespace AsyncLoadingWorkerTest
+
+#endif // WITH_DEV_AUTOMATION_TESTS
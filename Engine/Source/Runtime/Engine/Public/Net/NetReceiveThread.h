@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/MpscQueue.h"
+#include "Misc/Timespan.h"
+#include "Net/Common/Sockets/SocketErrors.h"
+#include "SocketTypes.h"
+#include <atomic>
+
+class FInternetAddr;
+class FRunnableThread;
+class FSocket;
+class ISocketSubsystem;
+
+/**
+ * A packet received by FNetReceiveThread, waiting to be dispatched on the game thread
+ */
+struct FNetReceivedPacket
+{
+	/** The packet data buffer - only the first NumBytes are valid */
+	TArray<uint8> Data;
+
+	/** The size of the packet data, in bytes */
+	int32 NumBytes = 0;
+
+	/** The address the packet was received from */
+	TSharedPtr<FInternetAddr> Address;
+
+	/** The time the packet was received, in FPlatformTime::Seconds */
+	double ReceiveTime = 0.0;
+
+	/**
+	 * A socket error associated with Address (e.g. SE_ECONNRESET, for an ICMP unreachable), in which case there is no packet data.
+	 * Errors from FSocket::RecvMulti are not associated with an address, and use an unspecified (any) address.
+	 */
+	ESocketErrors Error = SE_NO_ERROR;
+};
+
+/**
+ * Drains a socket on a dedicated thread, using FSocket::RecvMulti where supported, and queues received packets for the game thread.
+ *
+ * Packets are passed to the game thread through a lock-free MPSC queue (TMpscQueue), and recycled back to the receive thread
+ * through a second MPSC queue, so that no locks are taken and packet buffers are not reallocated in steady state.
+ * An optional pre-process function runs on the receive thread for every packet, allowing net drivers to perform
+ * thread-safe work (such as filtering) ahead of the game thread. PacketHandler processing remains on the game thread.
+ *
+ * If waiting on the socket fails (e.g. the socket was closed), the error is passed on to the game thread and the thread backs off
+ * for its wait time before retrying, and it exits once the socket is no longer valid.
+ *
+ * Typically owned by UNetDriver (see UNetDriver::StartReceiveThread and net.ReceiveThread).
+ */
+class ENGINE_API FNetReceiveThread : public FRunnable
+{
+public:
+	/**
+	 * Function run on the receive thread for each received packet, before it is queued for the game thread.
+	 * Returns false if the packet should be dropped.
+	 */
+	using FPreProcessFunc = TFunction<bool(FNetReceivedPacket&)>;
+
+	/**
+	 * @param InSocket				The socket to receive from - must outlive the receive thread (see StopThread)
+	 * @param InSocketSubsystem		The socket subsystem the socket belongs to
+	 * @param InMaxQueuedPackets	The maximum number of packets waiting for the game thread, before further packets are dropped
+	 * @param InPreProcess			Optional function run on the receive thread for each packet
+	 */
+	FNetReceiveThread(FSocket* InSocket, ISocketSubsystem* InSocketSubsystem, int32 InMaxQueuedPackets, FPreProcessFunc&& InPreProcess=nullptr);
+
+	virtual ~FNetReceiveThread();
+
+	/**
+	 * Starts the receive thread
+	 *
+	 * @param ThreadName	The name of the thread
+	 * @return				Whether or not the thread was started
+	 */
+	bool StartThread(const TCHAR* ThreadName);
+
+	/**
+	 * Stops the receive thread, and blocks until it has exited. Must be called before the socket is closed.
+	 */
+	void StopThread();
+
+	/**
+	 * Dequeues received packets on the game thread, in the order they were received.
+	 * The packet passed to PacketFunc is recycled after it returns, and must not be referenced afterwards.
+	 *
+	 * @param PacketFunc	Called for each dequeued packet
+	 * @param MaxPackets	The maximum number of packets to dequeue
+	 * @return				The number of packets dequeued
+	 */
+	int32 DequeuePackets(TFunctionRef<void(FNetReceivedPacket&)> PacketFunc, int32 MaxPackets=MAX_int32);
+
+	/** Returns the socket this thread receives from */
+	FSocket* GetSocket() const
+	{
+		return Socket;
+	}
+
+	/** Returns the number of packets currently waiting for the game thread */
+	int32 GetNumQueuedPackets() const
+	{
+		return NumQueuedPackets.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the number of packets dropped since the last call, due to the queue being full or pre-processing failing */
+	uint32 ConsumeNumDroppedPackets()
+	{
+		return NumDroppedPackets.exchange(0, std::memory_order_relaxed);
+	}
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	/** Receives all pending packets with FSocket::RecvMulti */
+	void ReceiveMulti();
+
+	/** Receives all pending packets with FSocket::RecvFrom, when RecvMulti is not supported */
+	void ReceiveSingle();
+
+	/** Returns a recycled packet, or a new packet if none are available */
+	TUniquePtr<FNetReceivedPacket> AllocPacket();
+
+	/** Queues the specified socket error (if any) for the game thread using the specified packet, or recycles the packet */
+	void EnqueueSocketError(TUniquePtr<FNetReceivedPacket>&& Packet, ESocketErrors Error);
+
+	/** Pre-processes and queues a packet for the game thread, or recycles it if it is dropped */
+	void EnqueuePacket(TUniquePtr<FNetReceivedPacket>&& Packet);
+
+private:
+	/** The socket being received from */
+	FSocket* Socket;
+
+	/** The socket subsystem the socket belongs to */
+	ISocketSubsystem* SocketSubsystem;
+
+	/** Optional function run on the receive thread for each packet */
+	FPreProcessFunc PreProcess;
+
+	/** RecvMulti state, if RecvMulti is supported */
+	TUniquePtr<FRecvMulti> RecvMultiState;
+
+	/** Packets waiting to be dispatched (produced by the receive thread, consumed by the game thread) */
+	TMpscQueue<TUniquePtr<FNetReceivedPacket>> ReceivedPackets;
+
+	/** Dispatched packets available for reuse (produced by the game thread, consumed by the receive thread) */
+	TMpscQueue<TUniquePtr<FNetReceivedPacket>> FreePackets;
+
+	/** The number of packets in ReceivedPackets */
+	std::atomic<int32> NumQueuedPackets;
+
+	/** The number of packets dropped since the last ConsumeNumDroppedPackets */
+	std::atomic<uint32> NumDroppedPackets;
+
+	/** Whether or not the thread has been asked to stop */
+	std::atomic<bool> bStopRequested;
+
+	/** The maximum number of packets in ReceivedPackets, before further packets are dropped */
+	const int32 MaxQueuedPackets;
+
+	/** The maximum time the thread blocks waiting for data, before checking for a stop request */
+	const FTimespan WaitTime;
+
+	/** The receive thread */
+	FRunnableThread* Thread;
+};
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+class AActor;
+struct FNetworkObjectInfo;
+
+/**
+ * Spatial hash of replicated actor locations, used to gather the considered actors which are within their net cull distance
+ * of the viewers of a connection, without walking the whole consider list (see net.RelevancyGrid).
+ *
+ * Only actors whose relevancy is decided purely by AActor's distance based relevancy are indexed (see IsActorIndexable) -
+ * all other considered actors are kept in a separate list, and are always tested with IsNetRelevantFor.
+ * The grid is owned by FNetworkObjectList, and is kept up to date while the consider list is built.
+ */
+class ENGINE_API FNetRelevancyGrid
+{
+public:
+	FNetRelevancyGrid();
+
+	/**
+	 * Whether or not the specified actor uses only the default distance based relevancy, and can be indexed by the grid.
+	 * Actor classes which override IsNetRelevantFor to extend relevancy beyond NetCullDistanceSquared, must not be used with the grid.
+	 *
+	 * @param Actor		The actor to check
+	 * @return			Whether or not the actor can be indexed
+	 */
+	static bool IsActorIndexable(const AActor* Actor);
+
+	/**
+	 * Adds the actor to the grid or updates its location, or removes it from the grid if it is no longer indexable
+	 *
+	 * @param ObjectInfo	The network object info for the actor
+	 */
+	void UpdateActor(FNetworkObjectInfo& ObjectInfo);
+
+	/**
+	 * Adds an object to the grid at the specified location, or updates its location
+	 *
+	 * @param ObjectInfo			The network object info to index
+	 * @param Location				The location of the object
+	 * @param CullDistanceSquared	The squared distance from a viewer, beyond which the object is not relevant
+	 */
+	void Update(FNetworkObjectInfo& ObjectInfo, const FVector& Location, float CullDistanceSquared);
+
+	/**
+	 * Removes an object from the grid, if it is indexed
+	 *
+	 * @param ObjectInfo	The network object info to remove
+	 */
+	void Remove(FNetworkObjectInfo& ObjectInfo);
+
+	/**
+	 * Whether or not the object is indexed by the grid
+	 *
+	 * @param ObjectInfo	The network object info to check
+	 */
+	static bool IsIndexed(const FNetworkObjectInfo& ObjectInfo);
+
+	/** Starts a new consider list, forgetting the objects added by AddConsideredActor so far */
+	void ResetConsidered();
+
+	/**
+	 * Adds an actor to the consider list: indexes it (or updates its location) if it is indexable, otherwise keeps it in the list of
+	 * unindexed considered objects.
+	 *
+	 * @param ObjectInfo	The network object info for the considered actor
+	 */
+	void AddConsideredActor(FNetworkObjectInfo& ObjectInfo);
+
+	/**
+	 * Adds an object to the consider list, at its current location in the grid if it is indexed
+	 *
+	 * @param ObjectInfo	The network object info for the considered object
+	 */
+	void AddConsidered(FNetworkObjectInfo& ObjectInfo);
+
+	/**
+	 * Gathers the considered objects a connection needs to test: every unindexed considered object, and the indexed considered objects
+	 * within their cull distance of any of the specified view locations. Only cells within the largest indexed cull distance of each
+	 * view location are visited.
+	 *
+	 * @param ViewLocations		The view locations to test
+	 * @param OutObjects		Receives the gathered objects
+	 * @param OutGathered		Receives a bit per indexed object (by grid index), set when the object was gathered
+	 */
+	void GatherConsideredObjects(TArrayView<const FVector> ViewLocations, TArray<FNetworkObjectInfo*>& OutObjects, TBitArray<>& OutGathered) const;
+
+	/**
+	 * Adds an indexed considered object to the output of GatherConsideredObjects, regardless of distance (e.g. because it has a channel).
+	 * Does nothing if the object isn't indexed, wasn't considered, or was already gathered.
+	 *
+	 * @param ObjectInfo		The network object info to add
+	 * @param InOutObjects		The gathered objects
+	 * @param InOutGathered		The gathered bits, as returned by GatherConsideredObjects
+	 */
+	void GatherConsideredObject(const FNetworkObjectInfo& ObjectInfo, TArray<FNetworkObjectInfo*>& InOutObjects, TBitArray<>& InOutGathered) const;
+
+	/** Returns the number of considered objects which are not indexed */
+	int32 NumUnindexedConsidered() const
+	{
+		return UnindexedConsidered.Num();
+	}
+
+	/** Removes all objects from the grid */
+	void Reset();
+
+	/** Returns the number of indexed objects */
+	int32 Num() const
+	{
+		return Entries.Num() - FreeEntries.Num();
+	}
+
+	void CountBytes(FArchive& Ar) const;
+
+private:
+	/** The grid cell coordinates containing the specified location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex);
+
+private:
+	/** An indexed object */
+	struct FEntry
+	{
+		FNetworkObjectInfo*	ObjectInfo = nullptr;
+		FVector				Location = FVector::ZeroVector;
+		float				CullDistanceSquared = 0.f;
+		FIntPoint			Cell = FIntPoint::ZeroValue;
+		/** The value of ConsiderFrame when the object was last added to the consider list */
+		uint32				ConsideredFrame = 0;
+	};
+
+	/** The indexed objects, addressed by FNetworkObjectInfo::RelevancyGridIndex */
+	TArray<FEntry> Entries;
+
+	/** Unused indices within Entries */
+	TArray<int32> FreeEntries;
+
+	/** The considered objects which are not indexed, since the last ResetConsidered */
+	TArray<FNetworkObjectInfo*> UnindexedConsidered;
+
+	/** Incremented by ResetConsidered, so that entries added to the consider list before are no longer considered */
+	uint32 ConsiderFrame;
+
+	/** The indices of the objects within each occupied grid cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** The size of grid cells along the X/Y axes, in world units */
+	float CellSize;
+
+	/** The largest cull distance of any object indexed since the grid was last empty (determines the query radius) */
+	float MaxCullDistanceSquared;
+};
@@ -316,6 +316,7 @@ struct FRepSerializationSharedInfo
 		if (bIsValid)
 		{
 			SharedPropertyInfo.Reset();
+			SharedPropertyInfoIndices.Reset();
 			SerializedProperties->Reset();
 
 			bIsValid = false;
@@ -363,6 +364,19 @@ struct FRepSerializationSharedInfo
 		const bool bWriteHandle,
 		const bool bDoChecksum);
 
+	/**
+	 * Finds a property previously written with WriteSharedProperty.
+	 *
+	 * @param PropertyKey		The unique key used to identify the property.
+	 *
+	 * @return The shared property info, or nullptr if the property hasn't been written.
+	 */
+	const FRepSerializedPropertyInfo* FindSharedProperty(const FRepSharedPropertyKey& PropertyKey) const
+	{
+		const int32* FoundIndex = SharedPropertyInfoIndices.Find(PropertyKey);
+		return FoundIndex ? &SharedPropertyInfo[*FoundIndex] : nullptr;
+	}
+
 	/** Metadata for properties in the shared data blob. */
 	TArray<FRepSerializedPropertyInfo> SharedPropertyInfo;
 
@@ -373,6 +387,9 @@ struct FRepSerializationSharedInfo
 
 private:
 
+	/** Maps property keys to their index in SharedPropertyInfo, so lookups stay cheap as the shared data grows. */
+	TMap<FRepSharedPropertyKey, int32> SharedPropertyInfoIndices;
+
 	/** Whether or not shared serialization data has been successfully built. */
 	bool bIsValid;
 };
@@ -927,6 +944,31 @@ public:
 	ERepLayoutCmdType Type;
 	ERepLayoutCmdFlags Flags;
 };
+
+/**
+ * A run of consecutive Parent Commands whose properties only contain plain old data, and are laid out
+ * contiguously in both Object and Shadow memory.
+ *
+ * If the bytes of the whole span match the Shadow State, none of its properties have changed,
+ * so they can all be skipped without being compared individually.
+ */
+struct FRepPODParentSpan
+{
+	/** Index of the first Parent Command in the span. */
+	uint16 ParentStart = 0;
+
+	/** Index of the Parent Command following the span. */
+	uint16 ParentEnd = 0;
+
+	/** Absolute offset of the span in Object Memory. */
+	int32 Offset = 0;
+
+	/** Absolute offset of the span in Shadow Memory. */
+	int32 ShadowOffset = 0;
+
+	/** Size of the span, in bytes. */
+	int32 Size = 0;
+};
 	
 /** Converts a relative handle to the appropriate index into the Cmds array */
 class FHandleToCmdIndex
@@ -1617,6 +1659,7 @@ private:
 	 * @param Writer			Writer used to store / write out the replicated properties.
 	 * @param Changed			Aggregate list of property handles that need to be written.
 	 * @param SharedInfo		Shared Serialization state for properties.
+	 *							Shareable properties that are missing will be added, so other connections can reuse them.
 	 */
 	void SendProperties(
 		FSendingRepState* RESTRICT RepState,
@@ -1625,7 +1668,7 @@ private:
 		UClass* ObjectClass,
 		FNetBitWriter& Writer,
 		TArray<uint16>& Changed,
-		const FRepSerializationSharedInfo& SharedInfo,
+		FRepSerializationSharedInfo& SharedInfo,
 		const ESerializePropertyType SerializePropertyType) const;
 
 	/**
@@ -1684,7 +1727,7 @@ private:
 		FRepHandleIterator& HandleIterator,
 		const FConstRepObjectDataBuffer SourceData,
 		const int32	 ArrayDepth,
-		const FRepSerializationSharedInfo* const RESTRICT SharedInfo,
+		FRepSerializationSharedInfo* const RESTRICT SharedInfo,
 		const ESerializePropertyType SerializePropertyType) const;
 
 	void BuildSharedSerialization(
@@ -1918,6 +1961,9 @@ private:
 	/** All Layout Commands. */
 	TArray<FRepLayoutCmd> Cmds;
 
+	/** Spans of plain old data Parent Commands that can be compared in bulk, sorted by ParentStart. See FRepPODParentSpan. */
+	TArray<FRepPODParentSpan> PODParentSpans;
+
 	/** Converts a relative handle to the appropriate index into the Cmds array */
 	TArray<FHandleToCmdIndex> BaseHandleToCmdIndex;
 
@@ -199,6 +199,10 @@ protected:
 		return true;
 	}
 
+	virtual int32 GetOutgoingPrefixBits(bool bConnectionless) const override;
+
+	virtual void WriteOutgoingPrefix(const TSharedPtr<const FInternetAddr>& Address, FBitWriter& Prefix, FOutPacketTraits& Traits) override;
+
 	virtual int32 GetReservedPacketBits() const override;
 
 	virtual void Tick(float DeltaTime) override;
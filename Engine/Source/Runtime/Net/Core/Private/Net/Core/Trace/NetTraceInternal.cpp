@@ -28,6 +28,7 @@ struct FNetTraceInternal
 		ENetTraceVersion_Initial = 1,
 		ENetTraceVersion_BunchChannelIndex = 2,
 		ENetTraceVersion_BunchChannelInfo = 3,
+		ENetTraceVersion_ConnectionStatsCounter = 4,
 	};
 
 	struct FThreadBuffer : public FTlsAutoCleanup
@@ -45,7 +46,7 @@ struct FNetTraceInternal
 	FORCENOINLINE static FThreadBuffer* CreateThreadBuffer();
 
 	static thread_local FThreadBuffer* ThreadBuffer;
-	static constexpr ENetTraceVersion NetTraceVersion = ENetTraceVersion::ENetTraceVersion_BunchChannelInfo;
+	static constexpr ENetTraceVersion NetTraceVersion = ENetTraceVersion::ENetTraceVersion_ConnectionStatsCounter;
 };
 
 thread_local FNetTraceInternal::FThreadBuffer* FNetTraceInternal::ThreadBuffer = nullptr;
@@ -490,6 +491,14 @@ void FNetTrace::TraceConnectionClosed(uint32 GameInstanceId, uint32 ConnectionId
 	}
 }
 
+void FNetTrace::TraceConnectionStatsCounter(uint32 GameInstanceId, uint32 ConnectionId, FNetDebugNameId CounterNameId, uint32 Value)
+{
+	if (GNetTraceRuntimeVerbosity)
+	{
+		FNetTraceInternal::Reporter::ReportConnectionStatsCounter(GameInstanceId, ConnectionId, CounterNameId, Value);
+	}
+}
+
 FNetDebugNameId FNetTrace::TraceName(const TCHAR* Name)
 {
 	if ((GNetTraceRuntimeVerbosity == 0U) | (Name == nullptr))
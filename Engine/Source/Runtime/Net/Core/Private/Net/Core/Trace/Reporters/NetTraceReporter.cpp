@@ -67,6 +67,15 @@ UE_TRACE_EVENT_BEGIN(NetTrace, ConnectionClosedEvent)
 	UE_TRACE_EVENT_FIELD(uint8, GameInstanceId)
 UE_TRACE_EVENT_END()
 
+// Value of a named per connection counter, the name is traced using a NameEvent
+UE_TRACE_EVENT_BEGIN(NetTrace, ConnectionStatsCounterEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Timestamp)
+	UE_TRACE_EVENT_FIELD(uint32, Value)
+	UE_TRACE_EVENT_FIELD(uint16, NameId)
+	UE_TRACE_EVENT_FIELD(uint16, ConnectionId)
+	UE_TRACE_EVENT_FIELD(uint8, GameInstanceId)
+UE_TRACE_EVENT_END()
+
 // Provides additional information about game instance
 UE_TRACE_EVENT_BEGIN(NetTrace, InstanceUpdatedEvent)
 	UE_TRACE_EVENT_FIELD(uint8, GameInstanceId)
@@ -287,6 +296,16 @@ void FNetTraceReporter::ReportConnectionClosed(uint32 GameInstanceId, uint32 Con
 		<< ConnectionClosedEvent.GameInstanceId(GameInstanceId);
 }
 
+void FNetTraceReporter::ReportConnectionStatsCounter(uint32 GameInstanceId, uint32 ConnectionId, FNetDebugNameId CounterNameId, uint32 Value)
+{
+	UE_TRACE_LOG(NetTrace, ConnectionStatsCounterEvent, NetChannel)
+		<< ConnectionStatsCounterEvent.Timestamp(FPlatformTime::Cycles64())
+		<< ConnectionStatsCounterEvent.Value(Value)
+		<< ConnectionStatsCounterEvent.NameId(CounterNameId)
+		<< ConnectionStatsCounterEvent.ConnectionId(ConnectionId)
+		<< ConnectionStatsCounterEvent.GameInstanceId(GameInstanceId);
+}
+
 void FNetTraceReporter::ReportObjectCreated(uint32 GameInstanceId, uint32 NetObjectId, FNetDebugNameId NameId, uint64 TypeIdentifier, uint32 OwnerId)
 {
 	UE_TRACE_LOG(NetTrace, ObjectCreatedEvent, NetChannel)
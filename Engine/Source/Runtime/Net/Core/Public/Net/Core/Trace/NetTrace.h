@@ -102,6 +102,9 @@
 /** That that a connection has been closed */
 #define UE_NET_TRACE_CONNECTION_CLOSED(...) UE_NET_TRACE_INTERNAL_CONNECTION_CLOSED(__VA_ARGS__)
 
+/** Trace the value of a named counter for the given connection, Name is a literal identifier as for UE_NET_TRACE_SCOPE */
+#define UE_NET_TRACE_CONNECTION_STATSCOUNTER(GameInstanceId, ConnectionId, Name, Value, Verbosity) UE_NET_TRACE_INTERNAL_CONNECTION_STATSCOUNTER(GameInstanceId, ConnectionId, Name, Value, Verbosity)
+
 /** Trace that we have dropped a packet */
 #define UE_NET_TRACE_PACKET_DROPPED(...)  UE_NET_TRACE_INTERNAL_PACKET_DROPPED(__VA_ARGS__)
 
@@ -147,6 +150,7 @@
 #define UE_NET_TRACE_CONNECTION_STATE_UPDATED(...)
 #define UE_NET_TRACE_CONNECTION_UPDATED(...)
 #define UE_NET_TRACE_CONNECTION_CLOSED(...)
+#define UE_NET_TRACE_CONNECTION_STATSCOUNTER(...)
 #define UE_NET_TRACE_PACKET_DROPPED(...)
 #define UE_NET_TRACE_NAMED_OBJECT_SCOPE(...)
 #define UE_NET_TRACE_NAMED_DYNAMIC_NAME_SCOPE(...)
@@ -230,6 +230,9 @@ struct FNetTrace
 	/** Trace that we have removed a connection for the given GameInstanceId */
 	NETCORE_API static void TraceConnectionClosed(uint32 GameInstanceId, uint32 ConnectionId);
 
+	/** Trace the value of a named per connection counter, such as the number of bits saved by a specific compression scheme since the last time it was reported */
+	NETCORE_API static void TraceConnectionStatsCounter(uint32 GameInstanceId, uint32 ConnectionId, FNetDebugNameId CounterNameId, uint32 Value);
+
 	/** Trace the name */
 	NETCORE_API static FNetDebugNameId TraceName(const TCHAR* Name);
 
@@ -558,6 +561,8 @@ void FNetTraceCollector::Reset()
 #define UE_NET_TRACE_INTERNAL_CONNECTION_STATE_UPDATED(...) FNetTrace::TraceConnectionStateUpdated(__VA_ARGS__)
 #define UE_NET_TRACE_INTERNAL_CONNECTION_UPDATED(...) FNetTrace::TraceConnectionUpdated(__VA_ARGS__)
 #define UE_NET_TRACE_INTERNAL_CONNECTION_CLOSED(...) FNetTrace::TraceConnectionClosed(__VA_ARGS__)
+#define UE_NET_TRACE_INTERNAL_CONNECTION_STATSCOUNTER(GameInstanceId, ConnectionId, Name, Value, Verbosity) \
+	UE_NET_TRACE_DO_IF(FNetTrace::GetNetTraceVerbosityEnabled(Verbosity) && (GNetTraceRuntimeVerbosity >= Verbosity), FNetTrace::TraceConnectionStatsCounter(GameInstanceId, ConnectionId, FNetTrace::TraceName(TEXT(#Name)), Value))
 #define UE_NET_TRACE_INTERNAL_PACKET_DROPPED(...) UE_NET_TRACE_DO_IF(GNetTraceRuntimeVerbosity, FNetTrace::TracePacketDropped(__VA_ARGS__))
 #define UE_NET_TRACE_INTERNAL_PACKET_SEND(...) UE_NET_TRACE_DO_IF(GNetTraceRuntimeVerbosity, FNetTrace::TracePacket(__VA_ARGS__, ENetTracePacketType::Outgoing))
 #define UE_NET_TRACE_INTERNAL_PACKET_RECV(...) UE_NET_TRACE_DO_IF(GNetTraceRuntimeVerbosity, FNetTrace::TracePacket(__VA_ARGS__, ENetTracePacketType::Incoming))
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSocketSendMultiTest, "System.Engine.Networking.Sockets.SendMulti", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+bool FSocketSendMultiTest::RunTest(const FString& Parameters)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	if (!TestNotNull(TEXT("Platform socket subsystem must exist"), SocketSubsystem))
+	{
+		return false;
+	}
+
+	const int32 NumPackets = 8;
+	const int32 PacketSize = 64;
+
+	FSocket* RecvSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("SendMultiTest Recv"), FNetworkProtocolTypes::IPv4);
+	FSocket* SendSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("SendMultiTest Send"), FNetworkProtocolTypes::IPv4);
+	TSharedRef<FInternetAddr> RecvAddr = SocketSubsystem->CreateInternetAddr(FNetworkProtocolTypes::IPv4);
+
+	RecvAddr->SetLoopbackAddress();
+	RecvAddr->SetPort(0);
+
+	if (TestNotNull(TEXT("Receive socket must be created"), RecvSocket) && TestNotNull(TEXT("Send socket must be created"), SendSocket) &&
+		TestTrue(TEXT("Receive socket must bind to loopback"), RecvSocket->Bind(*RecvAddr)))
+	{
+		RecvSocket->GetAddress(*RecvAddr);
+		RecvAddr->SetLoopbackAddress();
+
+		TUniquePtr<FSendMulti> SendData = SocketSubsystem->CreateSendMulti(NumPackets, PacketSize, ESendMultiFlags::None);
+
+		for (int32 PacketIdx=0; PacketIdx<NumPackets; PacketIdx++)
+		{
+			uint8 Packet[PacketSize];
+
+			FMemory::Memset(Packet, (uint8)PacketIdx, PacketSize);
+			TestTrue(TEXT("Packet must be queued"), SendData->AddPacket(Packet, PacketIdx + 1, RecvAddr));
+		}
+
+		TestTrue(TEXT("Batch must be full"), SendData->IsFull());
+
+		int32 NumSent = 0;
+
+		TestTrue(TEXT("SendMulti must succeed on a bound loopback destination"), SendSocket->SendMulti(*SendData, NumSent));
+		TestEqual(TEXT("SendMulti must send every packet"), NumSent, NumPackets);
+		TestEqual(TEXT("A successful SendMulti must not report an error"), SendData->GetLastSendError(), SE_NO_ERROR);
+
+		TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr(FNetworkProtocolTypes::IPv4);
+		int32 NumReceived = 0;
+
+		while (NumReceived < NumPackets && RecvSocket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(5.0)))
+		{
+			uint8 Packet[PacketSize];
+			int32 BytesRead = 0;
+
+			if (!RecvSocket->RecvFrom(Packet, PacketSize, BytesRead, *FromAddr))
+			{
+				break;
+			}
+
+			// Loopback UDP preserves ordering, so the size and contents identify the packet
+			TestEqual(TEXT("Packets must be received in order"), BytesRead, NumReceived + 1);
+			TestEqual(TEXT("Packet contents must be preserved"), (int32)Packet[0], NumReceived);
+			TestEqual(TEXT("Packet contents must be preserved"), (int32)Packet[BytesRead - 1], NumReceived);
+
+			NumReceived++;
+		}
+
+		TestEqual(TEXT("Every packet must be received"), NumReceived, NumPackets);
+
+		// Sending on a closed socket must fail, and capture the error from the send itself
+		SendData->Reset();
+		SendData->AddPacket((const uint8*)"Closed", 6, RecvAddr);
+		SendSocket->Close();
+
+		NumSent = 0;
+
+		TestFalse(TEXT("SendMulti must fail on a closed socket"), SendSocket->SendMulti(*SendData, NumSent));
+		TestEqual(TEXT("SendMulti on a closed socket must not send anything"), NumSent, 0);
+		TestNotEqual(TEXT("A failed SendMulti must report an error"), SendData->GetLastSendError(), SE_NO_ERROR);
+	}
+
+	if (SendSocket != nullptr)
+	{
+		SocketSubsystem->DestroySocket(SendSocket);
+	}
+
+	if (RecvSocket != nullptr)
+	{
+		SocketSubsystem->DestroySocket(RecvSocket);
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -39,6 +39,14 @@ FAutoConsoleVariableRef CVarNetPacketHandlerCRCDump(
 	TEXT("Enables or disables dumping of packet CRC's for every HandlerComponent, Incoming and Outgoing, for debugging."));
 #endif
 
+int32 GPacketHandlerInPlaceOutgoing = 1;
+
+FAutoConsoleVariableRef CVarNetPacketHandlerInPlaceOutgoing(
+	TEXT("net.PacketHandlerInPlaceOutgoing"),
+	GPacketHandlerInPlaceOutgoing,
+	TEXT("Whether or not outgoing HandlerComponent prefixes are written in place into reserved packet headroom, where every active component supports it, ")
+	TEXT("avoiding per-component packet allocations/copies."));
+
 
 /**
  * PacketHandler
@@ -51,6 +59,7 @@ PacketHandler::PacketHandler(FDDoSDetection* InDDoS/*=nullptr*/)
 	, LowLevelSendDel()
 	, HandshakeCompleteDel()
 	, OutgoingPacket()
+	, OutgoingPrefix()
 	, IncomingPacket()
 	, HandlerComponents()
 	, MaxPacketBits(0)
@@ -69,6 +78,7 @@ PacketHandler::PacketHandler(FDDoSDetection* InDDoS/*=nullptr*/)
 {
 	OutgoingPacket.SetAllowResize(true);
 	OutgoingPacket.AllowAppend(true);
+	OutgoingPrefix.SetAllowResize(true);
 }
 
 void PacketHandler::Tick(float DeltaTime)
@@ -434,6 +444,7 @@ void PacketHandler::CountBytes(FArchive& Ar) const
 {
 	Ar.CountBytes(sizeof(*this), sizeof(*this));
 	OutgoingPacket.CountMemory(Ar);
+	OutgoingPrefix.CountMemory(Ar);
 	IncomingPacket.CountMemory(Ar);
 
 	HandlerComponents.CountBytes(Ar);
@@ -692,51 +703,137 @@ const ProcessedPacket PacketHandler::Outgoing_Internal(uint8* Packet, int32 Coun
 
 		if (State == Handler::State::Initialized)
 		{
-			OutgoingPacket.SerializeBits(Packet, CountBits);
+			bool bInPlace = !!GPacketHandlerInPlaceOutgoing;
+			int32 TotalPrefixBits = 0;
+
+#if !UE_BUILD_SHIPPING
+			// CRC dumping inspects the packet after every component, so requires the per-component path
+			bInPlace = bInPlace && !GPacketHandlerCRCDump;
+#endif
 
-			FPacketAudit::AddStage(TEXT("PrePacketHandler"), OutgoingPacket, true);
+			bInPlace = bInPlace && GetOutgoingPrefixBits(bConnectionless, TotalPrefixBits);
 
-			for (int32 i=0; i<HandlerComponents.Num() && !OutgoingPacket.IsError(); ++i)
+			if (bInPlace)
 			{
-				HandlerComponent& CurComponent = *HandlerComponents[i];
+#if !UE_BUILD_SHIPPING
+				if (GPacketAuditor != nullptr)
+				{
+					// The audited stage is the unprefixed payload from bit 0, so it's recorded before the headroom is reserved
+					OutgoingPacket.SerializeBits(Packet, CountBits);
+
+					FPacketAudit::AddStage(TEXT("PrePacketHandler"), OutgoingPacket, true);
+
+					OutgoingPacket.Reset();
+				}
+#endif
+
+				// Reserve zeroed headroom for the component prefixes ahead of the payload, so that the payload is only copied once,
+				// and the (persistent) OutgoingPacket buffer is reused for every packet, without reallocating
+				uint64 ZeroBits = 0;
 
-				if (CurComponent.IsActive())
+				for (int32 HeadroomBits=TotalPrefixBits; HeadroomBits > 0; HeadroomBits -= 64)
 				{
-					if (OutgoingPacket.GetNumBits() <= CurComponent.MaxOutgoingBits)
+					OutgoingPacket.SerializeBits(&ZeroBits, FMath::Min(HeadroomBits, 64));
+				}
+
+				OutgoingPacket.SerializeBits(Packet, CountBits);
+
+				// Each component prefixes the output of the previous component, so prefixes are written from the payload backwards
+				int32 PrefixEndBit = TotalPrefixBits;
+
+				for (int32 i=0; i<HandlerComponents.Num() && !OutgoingPacket.IsError(); ++i)
+				{
+					HandlerComponent& CurComponent = *HandlerComponents[i];
+
+					if (CurComponent.IsActive())
 					{
-						if (bConnectionless)
+						const int32 CurPacketBits = CountBits + (TotalPrefixBits - PrefixEndBit);
+
+						if (CurPacketBits <= (int32)CurComponent.MaxOutgoingBits)
 						{
-							CurComponent.OutgoingConnectionless(Address, OutgoingPacket, Traits);
+							const int32 PrefixBits = CurComponent.GetOutgoingPrefixBits(bConnectionless);
+
+							if (PrefixBits > 0)
+							{
+								OutgoingPrefix.Reset();
+
+								CurComponent.WriteOutgoingPrefix(Address, OutgoingPrefix, Traits);
+
+								if (!OutgoingPrefix.IsError() && OutgoingPrefix.GetNumBits() == PrefixBits)
+								{
+									PrefixEndBit -= PrefixBits;
+
+									appBitsCpy(OutgoingPacket.GetData(), PrefixEndBit, OutgoingPrefix.GetData(), 0, PrefixBits);
+								}
+								else
+								{
+									OutgoingPacket.SetError();
+
+									UE_LOG(PacketHandlerLog, Error, TEXT("HandlerComponent '%s' wrote an outgoing prefix of %lld bits, expected %i bits"),
+											*CurComponent.GetName().ToString(), OutgoingPrefix.GetNumBits(), PrefixBits);
+								}
+							}
 						}
 						else
 						{
-							CurComponent.Outgoing(OutgoingPacket, Traits);
+							OutgoingPacket.SetError();
+
+							UE_LOG(PacketHandlerLog, Error, TEXT("Packet exceeded HandlerComponents 'MaxOutgoingBits' value: %i vs %i"),
+									CurPacketBits, CurComponent.MaxOutgoingBits);
 						}
 					}
-					else
-					{
-						OutgoingPacket.SetError();
+				}
 
-						UE_LOG(PacketHandlerLog, Error, TEXT("Packet exceeded HandlerComponents 'MaxOutgoingBits' value: %i vs %i"),
-								OutgoingPacket.GetNumBits(), CurComponent.MaxOutgoingBits);
+				check(OutgoingPacket.IsError() || PrefixEndBit == 0);
+			}
+			else
+			{
+				OutgoingPacket.SerializeBits(Packet, CountBits);
 
-						break;
-					}
-				}
+				FPacketAudit::AddStage(TEXT("PrePacketHandler"), OutgoingPacket, true);
 
-#if !UE_BUILD_SHIPPING
-				if (UNLIKELY(!!GPacketHandlerCRCDump))
+				for (int32 i=0; i<HandlerComponents.Num() && !OutgoingPacket.IsError(); ++i)
 				{
-					if (OutgoingPacket.IsError())
+					HandlerComponent& CurComponent = *HandlerComponents[i];
+
+					if (CurComponent.IsActive())
 					{
-						HandlerCRCs.Add({0, true});
+						if (OutgoingPacket.GetNumBits() <= CurComponent.MaxOutgoingBits)
+						{
+							if (bConnectionless)
+							{
+								CurComponent.OutgoingConnectionless(Address, OutgoingPacket, Traits);
+							}
+							else
+							{
+								CurComponent.Outgoing(OutgoingPacket, Traits);
+							}
+						}
+						else
+						{
+							OutgoingPacket.SetError();
+
+							UE_LOG(PacketHandlerLog, Error, TEXT("Packet exceeded HandlerComponents 'MaxOutgoingBits' value: %i vs %i"),
+									OutgoingPacket.GetNumBits(), CurComponent.MaxOutgoingBits);
+
+							break;
+						}
 					}
-					else
+
+#if !UE_BUILD_SHIPPING
+					if (UNLIKELY(!!GPacketHandlerCRCDump))
 					{
-						HandlerCRCs.Add({FCrc::MemCrc32(OutgoingPacket.GetData(), OutgoingPacket.GetNumBytes()), false});
+						if (OutgoingPacket.IsError())
+						{
+							HandlerCRCs.Add({0, true});
+						}
+						else
+						{
+							HandlerCRCs.Add({FCrc::MemCrc32(OutgoingPacket.GetData(), OutgoingPacket.GetNumBytes()), false});
+						}
 					}
-				}
 #endif
+				}
 			}
 
 			// Add a termination bit, the same as the UNetConnection code does, if appropriate
@@ -1052,6 +1149,28 @@ void PacketHandler::HandlerComponentInitialized(HandlerComponent* InComponent)
 	}
 }
 
+bool PacketHandler::GetOutgoingPrefixBits(bool bConnectionless, int32& OutTotalPrefixBits) const
+{
+	OutTotalPrefixBits = 0;
+
+	for (const TSharedPtr<HandlerComponent>& Component : HandlerComponents)
+	{
+		if (Component.IsValid() && Component->IsActive())
+		{
+			const int32 PrefixBits = Component->GetOutgoingPrefixBits(bConnectionless);
+
+			if (PrefixBits == INDEX_NONE)
+			{
+				return false;
+			}
+
+			OutTotalPrefixBits += PrefixBits;
+		}
+	}
+
+	return true;
+}
+
 bool PacketHandler::DoesAnyProfileHaveComponent(const FString& InComponentName)
 {
 	TArray<FString> ProfileSectionNames;
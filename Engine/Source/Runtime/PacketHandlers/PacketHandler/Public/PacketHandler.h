@@ -628,6 +628,16 @@ private:
 	 */
 	void RealignPacket(FBitReader& Packet);
 
+	/**
+	 * Returns the total number of bits prepended to outgoing packets by the active HandlerComponents,
+	 * if they all support prefixing in place (see HandlerComponent::GetOutgoingPrefixBits)
+	 *
+	 * @param bConnectionless		Whether or not this is for a connectionless packet
+	 * @param OutTotalPrefixBits	Outputs the total number of prefix bits
+	 * @return						Whether or not every active component supports prefixing in place
+	 */
+	bool GetOutgoingPrefixBits(bool bConnectionless, int32& OutTotalPrefixBits) const;
+
 
 public:
 	/** Mode of the handler, Client or Server */
@@ -655,6 +665,9 @@ private:
 	/** Used for packing outgoing packets */
 	FBitWriter OutgoingPacket;
 
+	/** Used for writing HandlerComponent prefixes, when outgoing packets are prefixed in place (see HandlerComponent::GetOutgoingPrefixBits) */
+	FBitWriter OutgoingPrefix;
+
 	/** Used for unpacking incoming packets */
 	FBitReader IncomingPacket;
 
@@ -826,6 +839,33 @@ public:
 		return false;
 	}
 
+	/**
+	 * Returns the exact number of bits this component prepends to outgoing packets, if its Outgoing/OutgoingConnectionless implementation
+	 * only ever prepends a fixed-size prefix (leaving the rest of the packet untouched) - or INDEX_NONE if the packet is otherwise transformed.
+	 *
+	 * Where every active component supports this, PacketHandler writes the prefixes in place into headroom reserved ahead of the payload,
+	 * instead of calling Outgoing/OutgoingConnectionless (which typically allocates and copies a new packet, for each component).
+	 *
+	 * @param bConnectionless	Whether or not this is for a connectionless packet (see OutgoingConnectionless)
+	 * @return					The number of prefix bits, or INDEX_NONE if prefixing in place is not supported
+	 */
+	virtual int32 GetOutgoingPrefixBits(bool bConnectionless) const
+	{
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Writes the outgoing packet prefix, for components which support prefixing in place (see GetOutgoingPrefixBits).
+	 * Must write exactly the number of bits returned by GetOutgoingPrefixBits, and have the same effect as Outgoing/OutgoingConnectionless.
+	 *
+	 * @param Address	The address the packet is being sent to, for connectionless packets (otherwise nullptr)
+	 * @param Prefix	The writer to serialize the prefix into
+	 * @param Traits	Traits for the packet, passed down through the packet pipeline
+	 */
+	virtual void WriteOutgoingPrefix(const TSharedPtr<const FInternetAddr>& Address, FBitWriter& Prefix, FOutPacketTraits& Traits)
+	{
+	}
+
 
 	/**
 	 * Initialization functionality should be placed here
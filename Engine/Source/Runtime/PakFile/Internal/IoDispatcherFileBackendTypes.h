@@ -58,6 +58,8 @@ struct PAKFILE_API FFileIoStoreContainerFile
 	TArray<FSHAHash> BlockSignatureHashes;
 	TArray<FFileIoStoreContainerFilePartition> Partitions;
 	uint32 ContainerInstanceId = 0;
+	/** Identifies the contents of the container across runs, unlike ContainerInstanceId, see FFileIoStorePersistentBlockCache */
+	uint64 ContentHash = 0;
 
 	void GetPartitionFileHandleAndOffset(uint64 TocOffset, uint64& OutFileHandle, uint64& OutOffset) const
 	{
@@ -123,6 +125,10 @@ struct PAKFILE_API FFileIoStoreCompressedBlock
 	uint8* CompressedDataBuffer = nullptr;
 	FAES::FAESKey EncryptionKey;
 	const FSHAHash* SignatureHash = nullptr;
+	/** The ContentHash of the container if the decompressed block can be stored in the persistent block cache, else 0 */
+	uint64 PersistentCacheContainerHash = 0;
+	/** The decompressed block if it was read from the persistent block cache, in which case there are no raw blocks */
+	uint8* PersistentCacheData = nullptr;
 	bool bFailed = false;
 	bool bCancelled = false;
 };
@@ -549,10 +555,14 @@ public:
 	FFileIoStoreBuffer* AllocBuffer();
 	void FreeBuffer(FFileIoStoreBuffer* Buffer);
 	uint64 GetBufferSize() const { return BufferSize; }
+	// The contiguous range all buffers are allocated from, e.g. for registering with the OS ahead of time
+	uint8* GetBufferMemory() const { return BufferMemory; }
+	uint64 GetBufferMemorySize() const { return BufferMemorySize; }
 
 private:
 	FFileIoStoreStats& Stats;
 	uint64 BufferSize = 0;
+	uint64 BufferMemorySize = 0;
 	uint8* BufferMemory = nullptr;
 	FCriticalSection BuffersCritical;
 	FFileIoStoreBuffer* FirstFreeBuffer = nullptr;
@@ -5,6 +5,7 @@
 #include "Misc/CoreMisc.h"
 #include "Misc/CommandLine.h"
 #include "Async/AsyncWork.h"
+#include "Async/ParallelFor.h"
 #include "Serialization/MemoryReader.h"
 #include "HAL/IConsoleManager.h"
 #include "HAL/LowLevelMemTracker.h"
@@ -1266,6 +1267,42 @@ class FPakPrecacher
 
 	IPlatformFile* LowerLevel;
 	FCriticalSection CachedFilesScopeLock;
+#if !UE_BUILD_SHIPPING
+	/** Counters for the contention on CachedFilesScopeLock, see pak.PrecacherStressTest */
+	FThreadSafeCounter64 LockAcquisitions;
+	FThreadSafeCounter64 LockContentions;
+	FThreadSafeCounter64 LockWaitCycles;
+#endif
+
+	/** Locks CachedFilesScopeLock, recording how long the thread waited for it outside of shipping builds */
+	class FCachedFilesScopeLock
+	{
+	public:
+		explicit FCachedFilesScopeLock(FPakPrecacher& InPrecacher)
+			: Precacher(InPrecacher)
+		{
+#if !UE_BUILD_SHIPPING
+			Precacher.LockAcquisitions.Increment();
+			if (!Precacher.CachedFilesScopeLock.TryLock())
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Precacher.CachedFilesScopeLock.Lock();
+				Precacher.LockContentions.Increment();
+				Precacher.LockWaitCycles.Add(int64(FPlatformTime::Cycles64() - StartCycles));
+			}
+#else
+			Precacher.CachedFilesScopeLock.Lock();
+#endif
+		}
+
+		~FCachedFilesScopeLock()
+		{
+			Precacher.CachedFilesScopeLock.Unlock();
+		}
+
+	private:
+		FPakPrecacher& Precacher;
+	};
 	FJoinedOffsetAndPakIndex LastReadRequest;
 	uint64 NextUniqueID;
 	int64 BlockMemory;
@@ -1425,8 +1462,27 @@ class FPakPrecacher
 
 	FRequestToLower RequestsToLower[PAK_CACHE_MAX_REQUESTS];
 	TArray<IAsyncReadRequest*> RequestsToDelete;
+	FThreadSafeCounter NumRequestsToDelete;
 	int32 NotifyRecursion;
 
+	/**
+	 * Completed requests whose owners haven't been notified yet. Owners are notified by DeliverNotifications once the thread that
+	 * completed them has released CachedFilesScopeLock, so the copy of the data and the callbacks of the requests don't block other threads.
+	 */
+	struct FPendingNotification
+	{
+		IPakRequestor* Owner;
+		uint64 UniqueID;
+	};
+	TArray<FPendingNotification> PendingNotifications;
+	/** Owners being notified outside of the lock, which can't be cancelled by other threads until their notification returns */
+	struct FNotifyingOwner
+	{
+		IPakRequestor* Owner;
+		uint32 ThreadId;
+	};
+	TArray<FNotifyingOwner> NotifyingOwners;
+
 	uint32 Loads;
 	uint32 Frees;
 	uint64 LoadSize;
@@ -1435,6 +1491,15 @@ class FPakPrecacher
 	bool bEnableSignatureChecks;
 public:
 	int64 GetBlockMemory() { return BlockMemory; }
+
+#if !UE_BUILD_SHIPPING
+	void GetLockStats(int64& OutAcquisitions, int64& OutContentions, double& OutWaitSeconds) const
+	{
+		OutAcquisitions = LockAcquisitions.GetValue();
+		OutContentions = LockContentions.GetValue();
+		OutWaitSeconds = FPlatformTime::ToSeconds64(uint64(LockWaitCycles.GetValue()));
+	}
+#endif
 	int64 GetBlockMemoryHighWater() { return BlockMemoryHighWater; }
 
 	static void Init(IPlatformFile* InLowerLevel, bool bInEnableSignatureChecks) 
@@ -1589,7 +1654,7 @@ public:
 #if !UE_BUILD_SHIPPING
 	void SimulatePakFileCorruption()
 	{
-		FScopeLock Lock(&CachedFilesScopeLock);
+		FCachedFilesScopeLock Lock(*this);
 
 		for (FPakData& PakData : CachedPakData)
 		{
@@ -2182,7 +2247,7 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 		if (Request.Status == EInRequestStatus::Complete && Request.UniqueID == Request.Owner->UniqueID && RequestIndex == Request.Owner->InRequestIndex &&  Request.OffsetAndPakIndex == Request.Owner->OffsetAndPakIndex)
 		{
 			UE_LOG(LogPakFile, VeryVerbose, TEXT("FPakReadRequest[%016llX, %016llX) Notify complete"), Request.OffsetAndPakIndex, Request.OffsetAndPakIndex + Request.Size);
-			Request.Owner->RequestIsComplete();
+			PendingNotifications.Add({ Request.Owner, Request.UniqueID });
 			return;
 		}
 		else
@@ -2520,13 +2585,14 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 	}
 	void ClearOldBlockTasks()
 	{
-		if (!NotifyRecursion)
+		if (!NotifyRecursion && NumRequestsToDelete.GetValue() > 0)
 		{
 			TArray<IAsyncReadRequest*> Swapped;
 			{
-				FScopeLock Lock(&CachedFilesScopeLock);
+				FCachedFilesScopeLock Lock(*this);
 				Swapped = (MoveTemp(RequestsToDelete));
 				check(RequestsToDelete.IsEmpty());
+				NumRequestsToDelete.Reset();
 			}
 
 			for (IAsyncReadRequest* Elem : Swapped)
@@ -2747,7 +2813,7 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 				FPakInRequest& CompReq = InRequestAllocator.Get(Comp);
 				CompReq.Status = EInRequestStatus::Complete;
 				AddToIntervalTree(&Pak.InRequests[CompReq.GetPriority()][(int32)EInRequestStatus::Complete], InRequestAllocator, Comp, Pak.StartShift, Pak.MaxShift);
-				NotifyComplete(Comp); // potentially scary recursion here
+				NotifyComplete(Comp);
 			}
 		}
 
@@ -2763,7 +2829,14 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 		return false;
 	}
 
-	bool GetCompletedRequestData(FPakInRequest& DoneRequest, uint8* Result)
+	struct FBlockCopy
+	{
+		const uint8* Src;
+		int64 DstOffset;
+		int64 Size;
+	};
+
+	bool GetCompletedRequestData(FPakInRequest& DoneRequest, TArray<FBlockCopy, TInlineAllocator<4>>& OutCopies)
 	{
 		// CachedFilesScopeLock is locked
 		check(DoneRequest.Status == EInRequestStatus::Complete);
@@ -2786,7 +2859,7 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 			Pak.MaxNode,
 			Pak.StartShift,
 			Pak.MaxShift,
-			[this, Offset, Size, &BytesCopied, Result, &Pak](TIntervalTreeIndex BlockIndex) -> bool
+			[this, Offset, Size, &BytesCopied, &OutCopies, &Pak](TIntervalTreeIndex BlockIndex) -> bool
 		{
 			FCacheBlock &Block = CacheBlockAllocator.Get(BlockIndex);
 			int64 BlockOffset = GetRequestOffset(Block.OffsetAndPakIndex);
@@ -2796,7 +2869,7 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 			int64 OverlapEnd = FMath::Min(Offset + Size, BlockOffset + Block.Size);
 			check(OverlapEnd > OverlapStart);
 			BytesCopied += OverlapEnd - OverlapStart;
-			FMemory::Memcpy(Result + OverlapStart - Offset, Block.Memory + OverlapStart - BlockOffset, OverlapEnd - OverlapStart);
+			OutCopies.Add({ Block.Memory + OverlapStart - BlockOffset, OverlapStart - Offset, OverlapEnd - OverlapStart });
 			check(Block.InRequestRefCount);
 			if (!--Block.InRequestRefCount)
 			{
@@ -2822,7 +2895,7 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 			Pak.MaxNode,
 			Pak.StartShift,
 			Pak.MaxShift,
-			[this, Offset, Size, &BytesCopied, Result, &Pak](TIntervalTreeIndex BlockIndex) -> bool
+			[this, Offset, Size, &BytesCopied, &OutCopies, &Pak](TIntervalTreeIndex BlockIndex) -> bool
 		{
 			FCacheBlock &Block = CacheBlockAllocator.Get(BlockIndex);
 			int64 BlockOffset = GetRequestOffset(Block.OffsetAndPakIndex);
@@ -2832,7 +2905,8 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 			int64 OverlapEnd = FMath::Min(Offset + Size, BlockOffset + Block.Size);
 			check(OverlapEnd > OverlapStart);
 			BytesCopied += OverlapEnd - OverlapStart;
-			FMemory::Memcpy(Result + OverlapStart - Offset, Block.Memory + OverlapStart - BlockOffset, OverlapEnd - OverlapStart);
+			// Copied by GetCompletedRequest outside of the lock, the block can't be freed while the request references it
+			OutCopies.Add({ Block.Memory + OverlapStart - BlockOffset, OverlapStart - Offset, OverlapEnd - OverlapStart });
 			return true;
 		}
 		);
@@ -2843,6 +2917,52 @@ private: // below here we assume CachedFilesScopeLock until we get to the next s
 		return true;
 	}
 
+	/** Notifies the owners of the completed requests, must be called without holding CachedFilesScopeLock */
+	void DeliverNotifications()
+	{
+		const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+		TArray<FPendingNotification> Notifications;
+		for (;;)
+		{
+			{
+				// Notifications of requests completed while delivering this batch are delivered by the next iteration
+				FCachedFilesScopeLock Lock(*this);
+				Swap(Notifications, PendingNotifications);
+			}
+			if (Notifications.IsEmpty())
+			{
+				return;
+			}
+
+			for (const FPendingNotification& Notification : Notifications)
+			{
+				IPakRequestor* Owner = Notification.Owner;
+				{
+					FCachedFilesScopeLock Lock(*this);
+					// The owner may have cancelled the request, and been destroyed, since the request completed
+					if (!OutstandingRequests.Contains(Notification.UniqueID))
+					{
+						continue;
+					}
+					NotifyingOwners.Add({ Owner, ThreadId });
+				}
+
+				Owner->RequestIsComplete();
+
+				FCachedFilesScopeLock Lock(*this);
+				NotifyingOwners.RemoveAllSwap([Owner](const FNotifyingOwner& NotifyingOwner) { return NotifyingOwner.Owner == Owner; }, false);
+			}
+			Notifications.Reset();
+		}
+	}
+
+	bool IsBeingNotifiedByAnotherThread(IPakRequestor* Owner) const
+	{
+		// CachedFilesScopeLock is locked
+		const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+		return NotifyingOwners.ContainsByPredicate([Owner, ThreadId](const FNotifyingOwner& NotifyingOwner) { return NotifyingOwner.Owner == Owner && NotifyingOwner.ThreadId != ThreadId; });
+	}
+
 	///// Below here are the thread entrypoints
 
 public:
@@ -2852,18 +2972,26 @@ public:
 		LLM_SCOPE(ELLMTag::FileSystem);
 		ClearOldBlockTasks();
 
-		FScopeLock Lock(&CachedFilesScopeLock);
-		RequestsToLower[Index].RequestHandle = Request;
-		NotifyRecursion++;
-		if (!RequestsToLower[Index].Memory) // might have already been filled in by the signature check
 		{
-			RequestsToLower[Index].Memory = Request->GetReadResults();
+			FCachedFilesScopeLock Lock(*this);
+			RequestsToLower[Index].RequestHandle = Request;
+			NotifyRecursion++;
+			if (!RequestsToLower[Index].Memory) // might have already been filled in by the signature check
+			{
+				RequestsToLower[Index].Memory = Request->GetReadResults();
+			}
+			CompleteRequest(bWasCanceled, RequestsToLower[Index].Memory, RequestsToLower[Index].BlockIndex);
+			RequestsToLower[Index].RequestHandle = nullptr;
+			RequestsToDelete.Add(Request);
+			NumRequestsToDelete.Increment();
+			RequestsToLower[Index].BlockIndex = IntervalTreeInvalidIndex;
+			StartNextRequest();
 		}
-		CompleteRequest(bWasCanceled, RequestsToLower[Index].Memory, RequestsToLower[Index].BlockIndex);
-		RequestsToLower[Index].RequestHandle = nullptr;
-		RequestsToDelete.Add(Request);
-		RequestsToLower[Index].BlockIndex = IntervalTreeInvalidIndex;
-		StartNextRequest();
+
+		// Request is still in its callback, so it must not be deleted by the owners being notified
+		DeliverNotifications();
+
+		FCachedFilesScopeLock Lock(*this);
 		NotifyRecursion--;
 	}
 
@@ -2871,7 +2999,18 @@ public:
 	{
 		CSV_SCOPED_TIMING_STAT(FileIOVerbose, PakPrecacherQueueRequest);
 		check(Owner && File != NAME_None && Size > 0 && Offset >= 0 && Offset < PakFileSize && (PriorityAndFlags&AIOP_PRIORITY_MASK) >= AIOP_MIN && (PriorityAndFlags&AIOP_PRIORITY_MASK) <= AIOP_MAX);
-		FScopeLock Lock(&CachedFilesScopeLock);
+		if (!QueueRequestInternal(Owner, InActualPakFile, File, PakFileSize, Offset, Size, PriorityAndFlags))
+		{
+			return false;
+		}
+		DeliverNotifications();
+		return true;
+	}
+
+private:
+	bool QueueRequestInternal(IPakRequestor* Owner, FPakFile* InActualPakFile, FName File, int64 PakFileSize, int64 Offset, int64 Size, EAsyncIOPriorityAndFlags PriorityAndFlags)
+	{
+		FCachedFilesScopeLock Lock(*this);
 		uint16* PakIndexPtr = RegisterPakFile(InActualPakFile, File, PakFileSize);
 		if (PakIndexPtr == nullptr)
 		{
@@ -2918,6 +3057,7 @@ public:
 		return true;
 	}
 
+public:
 	void SetAsyncMinimumPriority(EAsyncIOPriorityAndFlags NewPriority)
 	{
 		bool bStartNewRequests = false;
@@ -2935,7 +3075,7 @@ public:
 
 		if (bStartNewRequests)
 		{
-			FScopeLock Lock(&CachedFilesScopeLock);
+			FCachedFilesScopeLock Lock(*this);
 			StartNextRequest();
 		}
 	}
@@ -2945,16 +3085,26 @@ public:
 		check(Owner);
 		ClearOldBlockTasks();
 
-		FScopeLock Lock(&CachedFilesScopeLock);
-		TIntervalTreeIndex RequestIndex = OutstandingRequests.FindRef(Owner->UniqueID);
-		static_assert(IntervalTreeInvalidIndex == 0, "FindRef will return 0 for something not found");
-		if (RequestIndex)
+		TArray<FBlockCopy, TInlineAllocator<4>> Copies;
 		{
+			FCachedFilesScopeLock Lock(*this);
+			TIntervalTreeIndex RequestIndex = OutstandingRequests.FindRef(Owner->UniqueID);
+			static_assert(IntervalTreeInvalidIndex == 0, "FindRef will return 0 for something not found");
+			if (!RequestIndex)
+			{
+				return false; // canceled
+			}
 			FPakInRequest& Request = InRequestAllocator.Get(RequestIndex);
 			check(Owner == Request.Owner && Request.Status == EInRequestStatus::Complete && Request.UniqueID == Request.Owner->UniqueID && RequestIndex == Request.Owner->InRequestIndex &&  Request.OffsetAndPakIndex == Request.Owner->OffsetAndPakIndex);
-			return GetCompletedRequestData(Request, UserSuppliedMemory);
+			GetCompletedRequestData(Request, Copies);
+		}
+
+		// The blocks stay referenced by the request until its owner removes it, which can't happen concurrently with this
+		for (const FBlockCopy& Copy : Copies)
+		{
+			FMemory::Memcpy(UserSuppliedMemory + Copy.DstOffset, Copy.Src, Copy.Size);
 		}
-		return false; // canceled
+		return true;
 	}
 
 	void CancelRequest(IPakRequestor* Owner)
@@ -2962,7 +3112,26 @@ public:
 		check(Owner);
 		ClearOldBlockTasks();
 
-		FScopeLock Lock(&CachedFilesScopeLock);
+		for (;;)
+		{
+			{
+				FCachedFilesScopeLock Lock(*this);
+				if (!IsBeingNotifiedByAnotherThread(Owner))
+				{
+					CancelRequestInternal(Owner);
+					break;
+				}
+			}
+			// Wait for the notification to return, the owner can go away once it is cancelled
+			FPlatformProcess::YieldThread();
+		}
+		DeliverNotifications();
+	}
+
+private:
+	void CancelRequestInternal(IPakRequestor* Owner)
+	{
+		// CachedFilesScopeLock is locked
 		TIntervalTreeIndex RequestIndex = OutstandingRequests.FindRef(Owner->UniqueID);
 		static_assert(IntervalTreeInvalidIndex == 0, "FindRef will return 0 for something not found");
 		if (RequestIndex)
@@ -2974,15 +3143,17 @@ public:
 		StartNextRequest();
 	}
 
+public:
+
 	bool IsProbablyIdle() // nothing to prevent new requests from being made before I return
 	{
-		FScopeLock Lock(&CachedFilesScopeLock);
+		FCachedFilesScopeLock Lock(*this);
 		return !HasRequestsAtStatus(EInRequestStatus::Waiting) && !HasRequestsAtStatus(EInRequestStatus::InFlight);
 	}
 
 	void Unmount(FName PakFile, FPakFile* UnmountedPak)
 	{
-		FScopeLock Lock(&CachedFilesScopeLock);
+		FCachedFilesScopeLock Lock(*this);
 
 		for (TMap<FPakFile*, uint16>::TIterator It(CachedPaks); It; ++It)
 		{
@@ -3155,7 +3326,7 @@ public:
 			QUICK_SCOPE_CYCLE_COUNTER(STAT_WaitDumpBlocks);
 			FPlatformProcess::SleepNoStats(0.001f);
 		}
-		FScopeLock Lock(&CachedFilesScopeLock);
+		FCachedFilesScopeLock Lock(*this);
 		bool bDone = !HasRequestsAtStatus(EInRequestStatus::Waiting) && !HasRequestsAtStatus(EInRequestStatus::InFlight) && !HasRequestsAtStatus(EInRequestStatus::Complete);
 
 		if (!bDone)
@@ -3208,6 +3379,116 @@ static FAutoConsoleCommand DumpBlocksCmd(
 	FConsoleCommandWithArgsDelegate::CreateStatic(&DumpBlocks)
 );
 
+#if !UE_BUILD_SHIPPING
+static void PrecacherStressTest(const TArray<FString>& Args)
+{
+	if (Args.Num() == 0)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("pak.PrecacherStressTest requires a filename argument: \"pak.PrecacherStressTest <filename> <numreads> <readsize> <numthreads>\""));
+		return;
+	}
+
+	if (!PakPrecacherSingleton)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("pak.PrecacherStressTest: The pak precacher is not running."));
+		return;
+	}
+
+	const FString& TestFile = Args[0];
+	int32 NumReads = 10000;
+	int64 ReadSize = 4096;
+	int32 NumThreads = 8;
+	if (Args.Num() > 1)
+	{
+		LexFromString(NumReads, *Args[1]);
+	}
+	if (Args.Num() > 2)
+	{
+		LexFromString(ReadSize, *Args[2]);
+	}
+	if (Args.Num() > 3)
+	{
+		LexFromString(NumThreads, *Args[3]);
+	}
+	if (NumReads <= 0 || ReadSize <= 0 || NumThreads <= 0)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("pak.PrecacherStressTest numreads, readsize and numthreads must be > 0"));
+		return;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IAsyncReadFileHandle> FileHandle(PlatformFile.OpenAsyncRead(*TestFile));
+	if (!FileHandle)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("pak.PrecacherStressTest: Failed to open %s."), *TestFile);
+		return;
+	}
+	int64 FileSize = -1;
+	{
+		TUniquePtr<IAsyncReadRequest> SizeRequest(FileHandle->SizeRequest());
+		if (SizeRequest)
+		{
+			SizeRequest->WaitCompletion();
+			FileSize = SizeRequest->GetSizeResults();
+		}
+	}
+	if (FileSize < ReadSize)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("pak.PrecacherStressTest: %s is smaller than the read size (%" INT64_FMT " < %" INT64_FMT ")."), *TestFile, FileSize, ReadSize);
+		return;
+	}
+
+	int64 StartAcquisitions, StartContentions;
+	double StartWaitSeconds;
+	FPakPrecacher::Get().GetLockStats(StartAcquisitions, StartContentions, StartWaitSeconds);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Each thread keeps a window of small reads at random offsets in flight, so that request registration and completion run concurrently
+	ParallelFor(NumThreads, [&FileHandle, NumReads, NumThreads, ReadSize, FileSize](int32 ThreadIndex)
+	{
+		constexpr int32 MaxReadsInFlightPerThread = 64;
+		FRandomStream RandomStream(ThreadIndex + 1);
+		const int32 ThreadReads = NumReads / NumThreads + (ThreadIndex < NumReads % NumThreads ? 1 : 0);
+		TArray<TUniquePtr<IAsyncReadRequest>> ReadsInFlight;
+		for (int32 ReadIndex = 0; ReadIndex < ThreadReads; ++ReadIndex)
+		{
+			if (ReadsInFlight.Num() == MaxReadsInFlightPerThread)
+			{
+				ReadsInFlight[0]->WaitCompletion();
+				ReadsInFlight.RemoveAt(0, 1, false);
+			}
+			const int64 Offset = int64(RandomStream.GetFraction() * double(FileSize - ReadSize));
+			if (IAsyncReadRequest* ReadRequest = FileHandle->ReadRequest(Offset, ReadSize, AIOP_Normal))
+			{
+				ReadsInFlight.Emplace(ReadRequest);
+			}
+		}
+		for (TUniquePtr<IAsyncReadRequest>& ReadRequest : ReadsInFlight)
+		{
+			ReadRequest->WaitCompletion();
+		}
+	}, EParallelForFlags::Unbalanced);
+
+	const double TimeSpent = FPlatformTime::Seconds() - StartTime;
+	int64 Acquisitions, Contentions;
+	double WaitSeconds;
+	FPakPrecacher::Get().GetLockStats(Acquisitions, Contentions, WaitSeconds);
+	Acquisitions -= StartAcquisitions;
+	Contentions -= StartContentions;
+	WaitSeconds -= StartWaitSeconds;
+
+	UE_LOG(LogPakFile, Display, TEXT("pak.PrecacherStressTest: %d reads of %" INT64_FMT " bytes on %d threads in %.3fs (%.0f reads/s)"), NumReads, ReadSize, NumThreads, TimeSpent, double(NumReads) / TimeSpent);
+	UE_LOG(LogPakFile, Display, TEXT("pak.PrecacherStressTest: precacher lock acquired %" INT64_FMT " times, %" INT64_FMT " contended (%.1f%%), %.2fms total wait, %.2fus per acquisition"),
+		Acquisitions, Contentions, Acquisitions ? 100.0 * double(Contentions) / double(Acquisitions) : 0.0, WaitSeconds * 1000.0, Acquisitions ? WaitSeconds * 1000000.0 / double(Acquisitions) : 0.0);
+}
+
+static FAutoConsoleCommand PrecacherStressTestCmd(
+	TEXT("pak.PrecacherStressTest"),
+	TEXT("Issues many small concurrent async reads to a file in a pak and reports the contention on the pak precacher lock. params: <filename> <numreads> <readsize> <numthreads>"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&PrecacherStressTest)
+);
+#endif
+
 static FCriticalSection FPakReadRequestEvent;
 
 class FPakAsyncReadFileHandle;
@@ -3747,6 +4028,7 @@ void FPakPrecacher::DoSignatureCheck(bool bWasCanceled, IAsyncReadRequest* Reque
 	int64 RequestOffset = 0;
 	uint16 PakIndex;
 	FSHAHash MasterSignatureHash;
+	TSharedPtr<const FPakSignatureFile, ESPMode::ThreadSafe> Signatures;
 	static const int64 MaxHashesToCache = 16;
 
 #if PAKHASH_USE_CRC
@@ -3757,7 +4039,7 @@ void FPakPrecacher::DoSignatureCheck(bool bWasCanceled, IAsyncReadRequest* Reque
 
 	{
 		// Try and keep lock for as short a time as possible. Find our request and copy out the data we need
-		FScopeLock Lock(&CachedFilesScopeLock);
+		FCachedFilesScopeLock Lock(*this);
 		FRequestToLower& RequestToLower = RequestsToLower[Index];
 		RequestToLower.RequestHandle = Request;
 		RequestToLower.Memory = Request->GetReadResults();
@@ -3775,6 +4057,8 @@ void FPakPrecacher::DoSignatureCheck(bool bWasCanceled, IAsyncReadRequest* Reque
 
 		FPakData& PakData = CachedPakData[PakIndex];
 		MasterSignatureHash = PakData.Signatures->DecryptedHash;
+		// The signature file is immutable and kept alive by the reference, so the rest of the hashes are read without the lock
+		Signatures = PakData.Signatures;
 
 		for (int32 CacheIndex = 0; CacheIndex < FMath::Min(NumSignaturesToCheck, MaxHashesToCache); ++CacheIndex)
 		{
@@ -3794,11 +4078,9 @@ void FPakPrecacher::DoSignatureCheck(bool bWasCanceled, IAsyncReadRequest* Reque
 
 		if ((SignedChunkIndex > 0) && ((SignedChunkIndex % MaxHashesToCache) == 0))
 		{
-			FScopeLock Lock(&CachedFilesScopeLock);
-			FPakData& PakData = CachedPakData[PakIndex];
 			for (int32 CacheIndex = 0; (CacheIndex < MaxHashesToCache) && ((SignedChunkIndex + CacheIndex) < NumSignaturesToCheck); ++CacheIndex)
 			{
-				HashCache[CacheIndex] = PakData.Signatures->ChunkHashes[SignatureIndex + CacheIndex];
+				HashCache[CacheIndex] = Signatures->ChunkHashes[SignatureIndex + CacheIndex];
 			}
 		}
 
@@ -3810,7 +4092,7 @@ void FPakPrecacher::DoSignatureCheck(bool bWasCanceled, IAsyncReadRequest* Reque
 
 			if (!bChunkHashesMatch)
 			{
-				FScopeLock Lock(&CachedFilesScopeLock);
+				FCachedFilesScopeLock Lock(*this);
 				FPakData* PakData = &CachedPakData[PakIndex];
 
 				UE_LOG(LogPakFile, Warning, TEXT("Pak chunk signing mismatch on chunk [%i/%i]! Expected %s, Received %s"), SignatureIndex, PakData->Signatures->ChunkHashes.Num() - 1, *ChunkHashToString(PakData->Signatures->ChunkHashes[SignatureIndex]), *ChunkHashToString(ThisHash));
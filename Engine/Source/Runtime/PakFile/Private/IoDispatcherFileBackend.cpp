@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "IoDispatcherFileBackend.h"
+#include "Hash/CityHash.h"
 #include "Misc/CommandLine.h"
 #include "Misc/Parse.h"
 #include "Misc/ScopeRWLock.h"
@@ -62,6 +63,13 @@ static FAutoConsoleVariableRef CVar_IoDispatcherCacheSizeMB(
 	TEXT("IoDispatcher cache memory size (in megabytes).")
 );
 
+int32 GIoDispatcherPersistentCacheSizeMB = 0;
+static FAutoConsoleVariableRef CVar_IoDispatcherPersistentCacheSizeMB(
+	TEXT("s.IoDispatcherPersistentCacheSizeMB"),
+	GIoDispatcherPersistentCacheSizeMB,
+	TEXT("IoDispatcher on disk cache of decompressed blocks, kept across runs (in megabytes). The file can be set with -IoDispatcherPersistentCache=<path>, 0 disables the cache.")
+);
+
 int32 GIoDispatcherSortRequestsByOffset = 1;
 static FAutoConsoleVariableRef CVar_IoDispatcherSortRequestsByOffset(
 	TEXT("s.IoDispatcherSortRequestsByOffset"),
@@ -129,6 +137,7 @@ void FFileIoStoreBufferAllocator::Initialize(uint64 InMemorySize, uint64 InBuffe
 	uint64 BufferCount = InMemorySize / InBufferSize;
 	uint64 MemorySize = BufferCount * InBufferSize;
 	BufferMemory = reinterpret_cast<uint8*>(FMemory::Malloc(MemorySize, InBufferAlignment));
+	BufferMemorySize = MemorySize;
 	BufferSize = InBufferSize;
 	for (uint64 BufferIndex = 0; BufferIndex < BufferCount; ++BufferIndex)
 	{
@@ -716,6 +725,15 @@ FIoStatus FFileIoStoreReader::Initialize(const TCHAR* InTocFilePath, int32 InOrd
 	ContainerFile.BlockSignatureHashes	= MoveTemp(TocResource.ChunkBlockSignatures);
 	ContainerFile.ContainerInstanceId	= ++GlobalContainerInstanceId;
 
+	// Blocks are only shared with earlier runs through the persistent block cache while the container is unchanged
+	ContainerFile.ContentHash = CityHash64(reinterpret_cast<const char*>(ContainerFile.CompressionBlocks.GetData()), ContainerFile.CompressionBlocks.Num() * sizeof(FIoStoreTocCompressedBlockEntry));
+	ContainerFile.ContentHash = CityHash128to64({ ContainerFile.ContentHash, TocResource.Header.ContainerId.Value() });
+	for (const FFileIoStoreContainerFilePartition& Partition : ContainerFile.Partitions)
+	{
+		ContainerFile.ContentHash = CityHash128to64({ ContainerFile.ContentHash, Partition.FileSize });
+		ContainerFile.ContentHash = CityHash128to64({ ContainerFile.ContentHash, uint64(Ipf.GetTimeStamp(*Partition.FilePath).GetTicks()) });
+	}
+
 	Stats.OnTocMounted(GetTocAllocatedSize());
 
 	UE_LOG(LogIoDispatcher, Display, TEXT("Toc signature hash: %s"), *TocResource.SignatureHash.ToString());
@@ -1210,6 +1228,16 @@ void FFileIoStore::Initialize(TSharedRef<const FIoDispatcherBackendContext> InCo
 	uint64 CacheMemorySize = uint64(GIoDispatcherCacheSizeMB) << 20ull;
 	BlockCache.Initialize(CacheMemorySize, BufferSize);
 
+	if (GIoDispatcherPersistentCacheSizeMB > 0)
+	{
+		FString PersistentCacheFilename;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("IoDispatcherPersistentCache="), PersistentCacheFilename))
+		{
+			PersistentCacheFilename = FPaths::ProjectSavedDir() / TEXT("IoStore") / TEXT("PersistentBlockCache.bin");
+		}
+		PersistentBlockCache.Initialize(*PersistentCacheFilename, uint64(GIoDispatcherPersistentCacheSizeMB) << 20ull);
+	}
+
 	PlatformImpl->Initialize({
 		&BackendContext->WakeUpDispatcherThreadDelegate,
 		&RequestAllocator,
@@ -1429,6 +1457,13 @@ void FFileIoStore::ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bo
 	
 	check(!CompressedBlock->bFailed);
 
+	if (CompressedBlock->PersistentCacheData)
+	{
+		check(!bIsAsync);
+		ScatterUncompressedBlock(CompressedBlock, CompressedBlock->PersistentCacheData);
+		return;
+	}
+
 	FFileIoStoreCompressionContext* CompressionContext = CompressedBlock->CompressionContext;
 	check(CompressionContext);
 	uint8* CompressedBuffer;
@@ -1501,17 +1536,13 @@ void FFileIoStore::ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bo
 				UE_LOG(LogIoDispatcher, Warning, TEXT("Failed decompressing block"));
 				CompressedBlock->bFailed = true;
 			}
-		}
-
-		for (FFileIoStoreBlockScatter& Scatter : CompressedBlock->ScatterList)
-		{
-			if (Scatter.Size)
+			else if (CompressedBlock->PersistentCacheContainerHash)
 			{
-				check(Scatter.DstOffset + Scatter.Size <= Scatter.Request->GetBuffer().DataSize());
-				check(Scatter.SrcOffset + Scatter.Size <= CompressedBlock->UncompressedSize);
-				FMemory::Memcpy(Scatter.Request->GetBuffer().Data() + Scatter.DstOffset, UncompressedBuffer + Scatter.SrcOffset, Scatter.Size);
+				PersistentBlockCache.Store(CompressedBlock->PersistentCacheContainerHash, CompressedBlock->Key.BlockIndex, UncompressedBuffer, CompressedBlock->UncompressedSize);
 			}
 		}
+
+		ScatterUncompressedBlock(CompressedBlock, UncompressedBuffer);
 	}
 
 	if (bIsAsync)
@@ -1524,6 +1555,19 @@ void FFileIoStore::ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bo
 	}
 }
 
+void FFileIoStore::ScatterUncompressedBlock(FFileIoStoreCompressedBlock* CompressedBlock, const uint8* UncompressedBuffer)
+{
+	for (FFileIoStoreBlockScatter& Scatter : CompressedBlock->ScatterList)
+	{
+		if (Scatter.Size && !Scatter.Request->bCancelled)
+		{
+			check(Scatter.DstOffset + Scatter.Size <= Scatter.Request->GetBuffer().DataSize());
+			check(Scatter.SrcOffset + Scatter.Size <= CompressedBlock->UncompressedSize);
+			FMemory::Memcpy(Scatter.Request->GetBuffer().Data() + Scatter.DstOffset, UncompressedBuffer + Scatter.SrcOffset, Scatter.Size);
+		}
+	}
+}
+
 void FFileIoStore::CompleteDispatcherRequest(FFileIoStoreResolvedRequest* ResolvedRequest)
 {
 	check(ResolvedRequest);
@@ -1551,7 +1595,13 @@ void FFileIoStore::FinalizeCompressedBlock(FFileIoStoreCompressedBlock* Compress
 {
 	Stats.OnDecompressComplete(CompressedBlock); 
 
-	if (CompressedBlock->RawBlocks.Num() > 1)
+	if (CompressedBlock->PersistentCacheData)
+	{
+		check(CompressedBlock->RawBlocks.IsEmpty());
+		FMemory::Free(CompressedBlock->PersistentCacheData);
+		CompressedBlock->PersistentCacheData = nullptr;
+	}
+	else if (CompressedBlock->RawBlocks.Num() > 1)
 	{
 		check(CompressedBlock->CompressedDataBuffer || CompressedBlock->bCancelled || CompressedBlock->bFailed);
 		if (CompressedBlock->CompressedDataBuffer)
@@ -1573,11 +1623,13 @@ void FFileIoStore::FinalizeCompressedBlock(FFileIoStoreCompressedBlock* Compress
 			}
 		}
 	}
-	check(CompressedBlock->CompressionContext || CompressedBlock->bCancelled || CompressedBlock->bFailed);
+	check(CompressedBlock->CompressionContext || CompressedBlock->RawBlocks.IsEmpty() || CompressedBlock->bCancelled || CompressedBlock->bFailed);
 	if (CompressedBlock->CompressionContext)
 	{
 		FreeCompressionContext(CompressedBlock->CompressionContext);
 	}
+	// Blocks read from the persistent cache aren't referenced by any raw blocks, so nothing else will free them
+	const bool bFreeCompressedBlock = CompressedBlock->RawBlocks.IsEmpty();
 	for (int32 ScatterIndex = 0, ScatterCount = CompressedBlock->ScatterList.Num(); ScatterIndex < ScatterCount; ++ScatterIndex)
 	{
 		FFileIoStoreBlockScatter& Scatter = CompressedBlock->ScatterList[ScatterIndex];
@@ -1594,6 +1646,10 @@ void FFileIoStore::FinalizeCompressedBlock(FFileIoStoreCompressedBlock* Compress
 			RequestTracker.ReleaseIoRequestReferences(*Scatter.Request);
 		}
 	}
+	if (bFreeCompressedBlock)
+	{
+		RequestAllocator.Free(CompressedBlock);
+	}
 }
 
 FIoRequestImpl* FFileIoStore::GetCompletedRequests()
@@ -1728,15 +1784,18 @@ FIoRequestImpl* FFileIoStore::GetCompletedRequests()
 			continue;
 		}
 		
-		BlockToDecompress->CompressionContext = AllocCompressionContext();
-		if (!BlockToDecompress->CompressionContext)
+		if (!BlockToDecompress->PersistentCacheData)
 		{
-			break;
+			BlockToDecompress->CompressionContext = AllocCompressionContext();
+			if (!BlockToDecompress->CompressionContext)
+			{
+				break;
+			}
 		}
 
 		for (const FFileIoStoreBlockScatter& Scatter : BlockToDecompress->ScatterList)
 		{
-			if (Scatter.Size)
+			if (Scatter.Size && !Scatter.Request->bCancelled)
 			{
 				FIoRequestImpl* DispatcherRequest = Scatter.Request->DispatcherRequest;
 				check(DispatcherRequest);
@@ -1747,8 +1806,9 @@ FIoRequestImpl* FFileIoStore::GetCompletedRequests()
 			}
 		}
 
-		// Scatter block asynchronous when the block is compressed, encrypted or signed
-		const bool bScatterAsync = bIsMultithreaded && (!BlockToDecompress->CompressionMethod.IsNone() || BlockToDecompress->EncryptionKey.IsValid() || BlockToDecompress->SignatureHash);
+		// Scatter block asynchronous when the block is compressed, encrypted or signed, unless it was already decompressed by an earlier run
+		const bool bScatterAsync = bIsMultithreaded && !BlockToDecompress->PersistentCacheData &&
+			(!BlockToDecompress->CompressionMethod.IsNone() || BlockToDecompress->EncryptionKey.IsValid() || BlockToDecompress->SignatureHash);
 		if (bScatterAsync)
 		{
 			TGraphTask<FDecompressAsyncTask>::CreateTask().ConstructAndDispatchWhenReady(*this, BlockToDecompress);
@@ -1872,6 +1932,20 @@ void FFileIoStore::ReadBlocks(FFileIoStoreResolvedRequest& ResolvedRequest)
 			CompressedBlock->SignatureHash = EnumHasAnyFlags(ContainerFile.ContainerFlags, EIoContainerFlags::Signed) ? &ContainerFile.BlockSignatureHashes[CompressedBlockIndex] : nullptr;
 			CompressedBlock->RawSize = Align(CompressionBlockEntry.GetCompressedSize(), FAES::AESBlockSize); // The raw blocks size is always aligned to AES blocks size;
 
+			// Only plain compressed blocks go through the persistent cache, the contents of encrypted or signed containers are never written to disk decrypted or unverified
+			if (PersistentBlockCache.IsEnabled() &&
+				!CompressedBlock->CompressionMethod.IsNone() &&
+				!CompressedBlock->EncryptionKey.IsValid() &&
+				!CompressedBlock->SignatureHash &&
+				CompressedBlock->UncompressedSize <= PersistentBlockCache.GetSlotSize())
+			{
+				CompressedBlock->PersistentCacheContainerHash = ContainerFile.ContentHash;
+				CompressedBlock->PersistentCacheData = PersistentBlockCache.Read(ContainerFile.ContentHash, CompressedBlockIndex, CompressedBlock->UncompressedSize);
+			}
+		}
+		if (bCompressedBlockWasAdded && !CompressedBlock->PersistentCacheData)
+		{
+			const FIoStoreTocCompressedBlockEntry& CompressionBlockEntry = ContainerFile.CompressionBlocks[CompressedBlockIndex];
 			int32 PartitionIndex = int32(CompressionBlockEntry.GetOffset() / ContainerFile.PartitionSize);
 			const FFileIoStoreContainerFilePartition& Partition = ContainerFile.Partitions[PartitionIndex];
 			uint64 PartitionRawOffset = CompressionBlockEntry.GetOffset() % ContainerFile.PartitionSize;
@@ -1925,6 +1999,23 @@ void FFileIoStore::ReadBlocks(FFileIoStoreResolvedRequest& ResolvedRequest)
 		RequestStartOffsetInBlock = 0;
 
 		RequestTracker.AddReadRequestsToResolvedRequest(CompressedBlock, ResolvedRequest);
+
+		if (CompressedBlock->PersistentCacheData)
+		{
+			// Nothing to read, the block only needs to be scattered. It can't be shared with other requests as it's no longer tracked.
+			Stats.OnDecompressQueued(CompressedBlock);
+			RequestTracker.RemoveCompressedBlock(CompressedBlock);
+			if (!ReadyForDecompressionTail)
+			{
+				ReadyForDecompressionHead = ReadyForDecompressionTail = CompressedBlock;
+			}
+			else
+			{
+				ReadyForDecompressionTail->Next = CompressedBlock;
+				ReadyForDecompressionTail = CompressedBlock;
+			}
+			CompressedBlock->Next = nullptr;
+		}
 	}
 
 	if (!NewBlocks.IsEmpty())
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "IoDispatcherFileBackendTypes.h"
+#include "IoDispatcherPersistentBlockCache.h"
 #include "IO/IoDispatcher.h"
 #include "IO/IoStore.h"
 #include "Containers/Array.h"
@@ -161,6 +162,7 @@ private:
 	FFileIoStoreCompressionContext* AllocCompressionContext();
 	void FreeCompressionContext(FFileIoStoreCompressionContext* CompressionContext);
 	void ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bool bIsAsync);
+	void ScatterUncompressedBlock(FFileIoStoreCompressedBlock* CompressedBlock, const uint8* UncompressedBuffer);
 	void CompleteDispatcherRequest(FFileIoStoreResolvedRequest* ResolvedRequest);
 	void FinalizeCompressedBlock(FFileIoStoreCompressedBlock* CompressedBlock);
 
@@ -168,6 +170,7 @@ private:
 	TSharedPtr<const FIoDispatcherBackendContext> BackendContext;
 	FFileIoStoreStats Stats;
 	FFileIoStoreBlockCache BlockCache;
+	FFileIoStorePersistentBlockCache PersistentBlockCache;
 	FFileIoStoreBufferAllocator BufferAllocator;
 	FFileIoStoreRequestAllocator RequestAllocator;
 	FFileIoStoreRequestQueue RequestQueue;
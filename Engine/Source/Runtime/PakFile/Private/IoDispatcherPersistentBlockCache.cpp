@@ -0,0 +1,398 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IoDispatcherPersistentBlockCache.h"
+#include "Algo/Sort.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformFileManager.h"
+#include "IO/IoDispatcher.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace PersistentBlockCache
+{
+	static constexpr uint32 Magic = 0x49534243; // 'ISBC'
+	static constexpr uint32 Version = 1;
+	/** The default IoStore compression block size, larger blocks are not cached */
+	static constexpr uint32 SlotSize = 64 << 10;
+	/** The slot data is aligned so that it can be mapped on any platform */
+	static constexpr uint64 SlotDataAlignment = 64 << 10;
+	/** Blocks stored while this much data is already waiting to be written are dropped */
+	static constexpr uint64 MaxPendingWritesSize = 4 << 20;
+
+	struct FFileHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint32 SlotSize = 0;
+		uint32 SlotCount = 0;
+	};
+}
+
+FFileIoStorePersistentBlockCache::~FFileIoStorePersistentBlockCache()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FlushTask.Wait();
+
+	// Keep the LRU order for the next run, the slot table on disk is only written when blocks are stored
+	if (!bWriteFailed)
+	{
+		WriteFile(GetSlotTableOffset(), reinterpret_cast<const uint8*>(Slots.GetData()), uint64(SlotCount) * sizeof(FSlot));
+	}
+	UE_LOG(LogIoDispatcher, Display, TEXT("Persistent block cache '%s': %llu hits, %llu misses, %llu blocks stored, %llu dropped"),
+		*Filename, HitCount, MissCount, StoreCount, DroppedStoreCount);
+
+	MappedRegion.Reset();
+	MappedFileHandle.Reset();
+	FileHandle.Reset();
+}
+
+bool FFileIoStorePersistentBlockCache::Initialize(const TCHAR* InFilename, uint64 CacheSize)
+{
+	using namespace PersistentBlockCache;
+
+	check(!IsEnabled());
+	Filename = InFilename;
+	SlotSize = PersistentBlockCache::SlotSize;
+	SlotCount = int32(FMath::Min<uint64>(CacheSize / SlotSize, MAX_int32));
+	if (!SlotCount)
+	{
+		return false;
+	}
+
+	IPlatformFile& Ipf = FPlatformFileManager::Get().GetPlatformFile();
+	Ipf.CreateDirectoryTree(*FPaths::GetPath(Filename));
+	// Opened for appending so that an existing cache isn't truncated, all writes seek first
+	FileHandle.Reset(Ipf.OpenWrite(*Filename, true, true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to open persistent block cache '%s', it may be in use by another process"), *Filename);
+		return false;
+	}
+
+	const uint64 FileSize = GetSlotDataOffset(SlotCount);
+	const uint64 SlotTableSize = uint64(SlotCount) * sizeof(FSlot);
+	Slots.SetNum(SlotCount);
+
+	FFileHeader Header;
+	bool bIsValid =
+		FileHandle->Size() == int64(FileSize) &&
+		ReadFile(0, reinterpret_cast<uint8*>(&Header), sizeof(Header)) &&
+		Header.Magic == Magic &&
+		Header.Version == Version &&
+		Header.SlotSize == SlotSize &&
+		Header.SlotCount == uint32(SlotCount) &&
+		ReadFile(GetSlotTableOffset(), reinterpret_cast<uint8*>(Slots.GetData()), SlotTableSize);
+	if (!bIsValid)
+	{
+		// New cache, or one written by a different version or with a different size, start over
+		for (FSlot& Slot : Slots)
+		{
+			Slot = FSlot();
+		}
+		Header.Magic = Magic;
+		Header.Version = Version;
+		Header.SlotSize = SlotSize;
+		Header.SlotCount = uint32(SlotCount);
+		bIsValid =
+			FileHandle->Truncate(0) &&
+			FileHandle->Truncate(int64(FileSize)) &&
+			WriteFile(0, reinterpret_cast<const uint8*>(&Header), sizeof(Header)) &&
+			WriteFile(GetSlotTableOffset(), reinterpret_cast<const uint8*>(Slots.GetData()), SlotTableSize);
+		if (!bIsValid)
+		{
+			UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to create persistent block cache '%s' (%llu bytes)"), *Filename, FileSize);
+			FileHandle.Reset();
+			return false;
+		}
+	}
+
+	TArray<int32> SlotOrder;
+	SlotOrder.Reserve(SlotCount);
+	for (int32 SlotIndex = 0; SlotIndex < SlotCount; ++SlotIndex)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		if (Slot.Size > SlotSize || (Slot.Size && SlotsByBlock.Contains(FBlockKey(Slot.ContainerHash, Slot.BlockIndex))))
+		{
+			Slot = FSlot();
+		}
+		if (Slot.Size)
+		{
+			SlotsByBlock.Add(FBlockKey(Slot.ContainerHash, Slot.BlockIndex), SlotIndex);
+			NextLastUsed = FMath::Max(NextLastUsed, Slot.LastUsed + 1);
+		}
+		else
+		{
+			Slot.LastUsed = 0;
+		}
+		SlotOrder.Add(SlotIndex);
+	}
+	Algo::Sort(SlotOrder, [this](int32 A, int32 B)
+	{
+		return Slots[A].LastUsed > Slots[B].LastUsed;
+	});
+	LruPrev.SetNumUninitialized(SlotCount);
+	LruNext.SetNumUninitialized(SlotCount);
+	for (int32 SlotIndex : SlotOrder)
+	{
+		LinkLeastRecentlyUsed(SlotIndex);
+	}
+
+	if (FPlatformProperties::SupportsMemoryMappedFiles())
+	{
+		// Not possible on all platforms while the file is open for writing, in which case blocks are read through the file handle
+		MappedFileHandle.Reset(Ipf.OpenMapped(*Filename));
+		if (MappedFileHandle)
+		{
+			MappedRegion.Reset(MappedFileHandle->MapRegion(GetSlotDataOffset(0), uint64(SlotCount) * SlotSize));
+		}
+	}
+
+	UE_LOG(LogIoDispatcher, Display, TEXT("Using persistent block cache '%s' (%llu MB, %d blocks cached, %s)"),
+		*Filename, FileSize >> 20, SlotsByBlock.Num(), MappedRegion ? TEXT("mapped") : TEXT("not mapped"));
+	return true;
+}
+
+uint8* FFileIoStorePersistentBlockCache::Read(uint64 ContainerHash, uint32 BlockIndex, uint32 Size)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const int32* FindSlotIndex = SlotsByBlock.Find(FBlockKey(ContainerHash, BlockIndex));
+	if (!FindSlotIndex || Slots[*FindSlotIndex].Size != Size)
+	{
+		++MissCount;
+		return nullptr;
+	}
+	const int32 SlotIndex = *FindSlotIndex;
+
+	uint8* Data = reinterpret_cast<uint8*>(FMemory::Malloc(Size));
+	bool bIsValid;
+	if (MappedRegion)
+	{
+		FMemory::Memcpy(Data, MappedRegion->GetMappedPtr() + uint64(SlotIndex) * SlotSize, Size);
+		bIsValid = true;
+	}
+	else
+	{
+		bIsValid = ReadFile(GetSlotDataOffset(SlotIndex), Data, Size);
+	}
+	if (!bIsValid || CityHash64(reinterpret_cast<const char*>(Data), Size) != Slots[SlotIndex].DataHash)
+	{
+		UE_LOG(LogIoDispatcher, Verbose, TEXT("Discarding corrupt block %u in persistent block cache slot %d"), BlockIndex, SlotIndex);
+		FMemory::Free(Data);
+		FreeSlot(SlotIndex);
+		++MissCount;
+		return nullptr;
+	}
+
+	Slots[SlotIndex].LastUsed = NextLastUsed++;
+	Unlink(SlotIndex);
+	LinkMostRecentlyUsed(SlotIndex);
+	++HitCount;
+	return Data;
+}
+
+void FFileIoStorePersistentBlockCache::Store(uint64 ContainerHash, uint32 BlockIndex, const uint8* Data, uint32 Size)
+{
+	if (!Size || Size > SlotSize)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&PendingWritesCriticalSection);
+
+	if (PendingWritesSize + Size > PersistentBlockCache::MaxPendingWritesSize)
+	{
+		// The disk can't keep up, this is only a cache so the block is dropped rather than holding up decompression
+		++DroppedStoreCount;
+		return;
+	}
+
+	FPendingWrite& PendingWrite = PendingWrites.AddDefaulted_GetRef();
+	PendingWrite.ContainerHash = ContainerHash;
+	PendingWrite.DataHash = CityHash64(reinterpret_cast<const char*>(Data), Size);
+	PendingWrite.BlockIndex = BlockIndex;
+	PendingWrite.Data.Append(Data, Size);
+	PendingWritesSize += Size;
+
+	if (!bFlushScheduled)
+	{
+		bFlushScheduled = true;
+		FlushTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this] { FlushPendingWrites(); }, UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+}
+
+void FFileIoStorePersistentBlockCache::FlushPendingWrites()
+{
+	TArray<FPendingWrite> LocalPendingWrites;
+	for (;;)
+	{
+		{
+			FScopeLock Lock(&PendingWritesCriticalSection);
+			if (PendingWrites.IsEmpty())
+			{
+				bFlushScheduled = false;
+				return;
+			}
+			LocalPendingWrites = MoveTemp(PendingWrites);
+			PendingWrites.Reset();
+			PendingWritesSize = 0;
+		}
+
+		for (const FPendingWrite& PendingWrite : LocalPendingWrites)
+		{
+			WritePendingWrite(PendingWrite);
+		}
+		LocalPendingWrites.Reset();
+	}
+}
+
+void FFileIoStorePersistentBlockCache::WritePendingWrite(const FPendingWrite& PendingWrite)
+{
+	const FBlockKey Key(PendingWrite.ContainerHash, PendingWrite.BlockIndex);
+	int32 SlotIndex;
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		if (bWriteFailed || SlotsByBlock.Contains(Key))
+		{
+			return;
+		}
+
+		// The slot is taken out of the LRU order and the block map while it's written, so that it's neither read nor reused
+		SlotIndex = LruTail;
+		check(SlotIndex != INDEX_NONE);
+		FSlot& Slot = Slots[SlotIndex];
+		if (Slot.Size)
+		{
+			SlotsByBlock.Remove(FBlockKey(Slot.ContainerHash, Slot.BlockIndex));
+		}
+		Unlink(SlotIndex);
+		Slot = FSlot();
+	}
+
+	// The slot stays free on disk until the block is completely written
+	FSlot NewSlot;
+	bool bWritten = WriteSlot(SlotIndex, NewSlot) && WriteFile(GetSlotDataOffset(SlotIndex), PendingWrite.Data.GetData(), PendingWrite.Data.Num());
+	if (bWritten)
+	{
+		NewSlot.ContainerHash = PendingWrite.ContainerHash;
+		NewSlot.DataHash = PendingWrite.DataHash;
+		NewSlot.BlockIndex = PendingWrite.BlockIndex;
+		NewSlot.Size = uint32(PendingWrite.Data.Num());
+		{
+			FScopeLock Lock(&CriticalSection);
+			NewSlot.LastUsed = NextLastUsed++;
+		}
+		bWritten = WriteSlot(SlotIndex, NewSlot);
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	if (!bWritten)
+	{
+		// Most likely out of disk space, keep using what is already cached
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed writing to persistent block cache '%s', no more blocks will be stored"), *Filename);
+		bWriteFailed = true;
+		LinkLeastRecentlyUsed(SlotIndex);
+		return;
+	}
+
+	Slots[SlotIndex] = NewSlot;
+	SlotsByBlock.Add(Key, SlotIndex);
+	LinkMostRecentlyUsed(SlotIndex);
+	++StoreCount;
+}
+
+uint64 FFileIoStorePersistentBlockCache::GetSlotTableOffset() const
+{
+	return sizeof(PersistentBlockCache::FFileHeader);
+}
+
+uint64 FFileIoStorePersistentBlockCache::GetSlotDataOffset(int32 SlotIndex) const
+{
+	const uint64 SlotDataBegin = Align(GetSlotTableOffset() + uint64(SlotCount) * sizeof(FSlot), PersistentBlockCache::SlotDataAlignment);
+	return SlotDataBegin + uint64(SlotIndex) * SlotSize;
+}
+
+bool FFileIoStorePersistentBlockCache::WriteSlot(int32 SlotIndex, const FSlot& Slot)
+{
+	return WriteFile(GetSlotTableOffset() + uint64(SlotIndex) * sizeof(FSlot), reinterpret_cast<const uint8*>(&Slot), sizeof(FSlot));
+}
+
+bool FFileIoStorePersistentBlockCache::ReadFile(uint64 Offset, uint8* Dst, uint64 Size)
+{
+	FScopeLock Lock(&FileCriticalSection);
+	return FileHandle->Seek(int64(Offset)) && FileHandle->Read(Dst, int64(Size));
+}
+
+bool FFileIoStorePersistentBlockCache::WriteFile(uint64 Offset, const uint8* Src, uint64 Size)
+{
+	FScopeLock Lock(&FileCriticalSection);
+	return FileHandle->Seek(int64(Offset)) && FileHandle->Write(Src, int64(Size));
+}
+
+void FFileIoStorePersistentBlockCache::FreeSlot(int32 SlotIndex)
+{
+	FSlot& Slot = Slots[SlotIndex];
+	SlotsByBlock.Remove(FBlockKey(Slot.ContainerHash, Slot.BlockIndex));
+	Slot = FSlot();
+	Unlink(SlotIndex);
+	LinkLeastRecentlyUsed(SlotIndex);
+}
+
+void FFileIoStorePersistentBlockCache::LinkMostRecentlyUsed(int32 SlotIndex)
+{
+	LruPrev[SlotIndex] = INDEX_NONE;
+	LruNext[SlotIndex] = LruHead;
+	if (LruHead != INDEX_NONE)
+	{
+		LruPrev[LruHead] = SlotIndex;
+	}
+	else
+	{
+		LruTail = SlotIndex;
+	}
+	LruHead = SlotIndex;
+}
+
+void FFileIoStorePersistentBlockCache::LinkLeastRecentlyUsed(int32 SlotIndex)
+{
+	LruNext[SlotIndex] = INDEX_NONE;
+	LruPrev[SlotIndex] = LruTail;
+	if (LruTail != INDEX_NONE)
+	{
+		LruNext[LruTail] = SlotIndex;
+	}
+	else
+	{
+		LruHead = SlotIndex;
+	}
+	LruTail = SlotIndex;
+}
+
+void FFileIoStorePersistentBlockCache::Unlink(int32 SlotIndex)
+{
+	const int32 Prev = LruPrev[SlotIndex];
+	const int32 Next = LruNext[SlotIndex];
+	if (Prev != INDEX_NONE)
+	{
+		LruNext[Prev] = Next;
+	}
+	else
+	{
+		LruHead = Next;
+	}
+	if (Next != INDEX_NONE)
+	{
+		LruPrev[Next] = Prev;
+	}
+	else
+	{
+		LruTail = Prev;
+	}
+}
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Task.h"
+#include "Templates/Tuple.h"
+#include "Templates/UniquePtr.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Second tier cache of decompressed IoStore blocks, kept on disk across runs (see s.IoDispatcherPersistentCacheSizeMB).
+ *
+ * The file is split into a fixed number of slots, each holding one decompressed compression block. A slot table at the start of the file
+ * records which block of which container each slot holds and when it was last used, so the least recently used blocks are replaced first,
+ * also across runs. Blocks are keyed by their compression block index and the ContentHash of their container, so blocks of a container that
+ * was rebuilt are never used.
+ *
+ * Blocks are read through a memory mapping of the file where the platform allows mapping a file that is open for writing, else through the
+ * file handle. Each slot records a hash of its data, which is checked before the block is used, so a slot left half written (e.g. by a crash)
+ * is only a miss. Only one process can use the file at a time, others run without the cache.
+ *
+ * Stored blocks are copied to a queue and written to the file by a background task, so decompression never waits on a cache write.
+ */
+class FFileIoStorePersistentBlockCache
+{
+public:
+	FFileIoStorePersistentBlockCache() = default;
+	~FFileIoStorePersistentBlockCache();
+
+	/** Opens or creates the cache file, returns false and leaves the cache disabled if it can't be used */
+	bool Initialize(const TCHAR* InFilename, uint64 CacheSize);
+
+	bool IsEnabled() const
+	{
+		return FileHandle.IsValid();
+	}
+
+	/** The size of the largest block that can be cached */
+	uint32 GetSlotSize() const
+	{
+		return SlotSize;
+	}
+
+	/** Returns a copy of the block allocated with FMemory::Malloc and owned by the caller, or null if the block isn't cached */
+	uint8* Read(uint64 ContainerHash, uint32 BlockIndex, uint32 Size);
+
+	/**
+	 * Queues a block to be added to the cache, replacing the least recently used one when the cache is full. Can be called from any thread.
+	 * The block is written in the background, and dropped if too many blocks are already waiting to be written.
+	 */
+	void Store(uint64 ContainerHash, uint32 BlockIndex, const uint8* Data, uint32 Size);
+
+private:
+	/** The slot table entries as stored in the file */
+	struct FSlot
+	{
+		uint64 ContainerHash = 0;
+		uint64 DataHash = 0;
+		uint64 LastUsed = 0;
+		uint32 BlockIndex = 0;
+		/** Size of the block in the slot, 0 if the slot is free */
+		uint32 Size = 0;
+	};
+	static_assert(sizeof(FSlot) == 32, "FSlot is stored in the cache file");
+
+	using FBlockKey = TTuple<uint64, uint32>;
+
+	/** A block waiting to be written by FlushPendingWrites */
+	struct FPendingWrite
+	{
+		uint64 ContainerHash;
+		uint64 DataHash;
+		uint32 BlockIndex;
+		TArray<uint8> Data;
+	};
+
+	void FlushPendingWrites();
+	void WritePendingWrite(const FPendingWrite& PendingWrite);
+	uint64 GetSlotTableOffset() const;
+	uint64 GetSlotDataOffset(int32 SlotIndex) const;
+	bool WriteSlot(int32 SlotIndex, const FSlot& Slot);
+	bool ReadFile(uint64 Offset, uint8* Dst, uint64 Size);
+	bool WriteFile(uint64 Offset, const uint8* Src, uint64 Size);
+	void FreeSlot(int32 SlotIndex);
+	void LinkMostRecentlyUsed(int32 SlotIndex);
+	void LinkLeastRecentlyUsed(int32 SlotIndex);
+	void Unlink(int32 SlotIndex);
+
+	FString Filename;
+	TUniquePtr<IFileHandle> FileHandle;
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	uint32 SlotSize = 0;
+	int32 SlotCount = 0;
+
+	/** Guards the file handle, which is shared by reads (when not mapped) and writes */
+	FCriticalSection FileCriticalSection;
+
+	/** Guards the blocks waiting to be written, and whether a task is writing them */
+	FCriticalSection PendingWritesCriticalSection;
+	TArray<FPendingWrite> PendingWrites;
+	uint64 PendingWritesSize = 0;
+	bool bFlushScheduled = false;
+	UE::Tasks::FTask FlushTask;
+
+	/** Guards the slot table and the LRU order, never held while writing */
+	FCriticalSection CriticalSection;
+	TArray<FSlot> Slots;
+	TMap<FBlockKey, int32> SlotsByBlock;
+	/** The slots ordered from most to least recently used, free slots come last */
+	TArray<int32> LruPrev;
+	TArray<int32> LruNext;
+	int32 LruHead = INDEX_NONE;
+	int32 LruTail = INDEX_NONE;
+	uint64 NextLastUsed = 1;
+	/** Set after a failed write, e.g. when the disk is full, after which blocks are only read */
+	bool bWriteFailed = false;
+
+	uint64 HitCount = 0;
+	uint64 MissCount = 0;
+	uint64 StoreCount = 0;
+	uint64 DroppedStoreCount = 0;
+};
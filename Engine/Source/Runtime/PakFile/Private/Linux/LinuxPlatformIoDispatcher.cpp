@@ -0,0 +1,532 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Linux/LinuxPlatformIoDispatcher.h"
+#include "IoDispatcherFileBackend.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/ScopeLock.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int32 GIoDispatcherIoUringQueueDepth = 64;
+static FAutoConsoleVariableRef CVar_IoDispatcherIoUringQueueDepth(
+	TEXT("s.IoDispatcherIoUringQueueDepth"),
+	GIoDispatcherIoUringQueueDepth,
+	TEXT("The maximum number of reads queued with the kernel at once by the io_uring IoDispatcher backend (Linux only).")
+);
+
+int32 GIoDispatcherIoUringRegisterBuffers = 1;
+static FAutoConsoleVariableRef CVar_IoDispatcherIoUringRegisterBuffers(
+	TEXT("s.IoDispatcherIoUringRegisterBuffers"),
+	GIoDispatcherIoUringRegisterBuffers,
+	TEXT("Whether the io_uring IoDispatcher backend registers the IoDispatcher read buffers with the kernel, to avoid mapping them for every read (Linux only).")
+);
+
+// The io_uring kernel ABI (see linux/io_uring.h), which is stable but not available in every sysroot we compile against
+#ifndef __NR_io_uring_setup
+	#define __NR_io_uring_setup		425
+#endif
+#ifndef __NR_io_uring_enter
+	#define __NR_io_uring_enter		426
+#endif
+#ifndef __NR_io_uring_register
+	#define __NR_io_uring_register	427
+#endif
+
+struct FIoUringSqe
+{
+	uint8 Opcode;
+	uint8 Flags;
+	uint16 IoPriority;
+	int32 Fd;
+	uint64 Offset;
+	uint64 Address;
+	uint32 Length;
+	uint32 OpFlags;
+	uint64 UserData;
+	uint16 BufferIndex;
+	uint16 Personality;
+	int32 SpliceFdIn;
+	uint64 Pad[2];
+};
+static_assert(sizeof(FIoUringSqe) == 64, "FIoUringSqe must match struct io_uring_sqe");
+
+struct FIoUringCqe
+{
+	uint64 UserData;
+	int32 Result;
+	uint32 Flags;
+};
+static_assert(sizeof(FIoUringCqe) == 16, "FIoUringCqe must match struct io_uring_cqe");
+
+namespace LinuxIoUring
+{
+	struct FSqRingOffsets
+	{
+		uint32 Head;
+		uint32 Tail;
+		uint32 RingMask;
+		uint32 RingEntries;
+		uint32 Flags;
+		uint32 Dropped;
+		uint32 Array;
+		uint32 Reserved1;
+		uint64 Reserved2;
+	};
+
+	struct FCqRingOffsets
+	{
+		uint32 Head;
+		uint32 Tail;
+		uint32 RingMask;
+		uint32 RingEntries;
+		uint32 Overflow;
+		uint32 Cqes;
+		uint32 Flags;
+		uint32 Reserved1;
+		uint64 Reserved2;
+	};
+
+	struct FParams
+	{
+		uint32 SqEntries;
+		uint32 CqEntries;
+		uint32 Flags;
+		uint32 SqThreadCpu;
+		uint32 SqThreadIdle;
+		uint32 Features;
+		uint32 WqFd;
+		uint32 Reserved[3];
+		FSqRingOffsets SqOffsets;
+		FCqRingOffsets CqOffsets;
+	};
+	static_assert(sizeof(FParams) == 120, "FParams must match struct io_uring_params");
+
+	static constexpr uint8 OpReadV = 1;
+	static constexpr uint8 OpReadFixed = 4;
+
+	static constexpr uint32 FeatureSingleMmap = 1u << 0;
+
+	static constexpr uint32 RegisterBuffers = 0;
+	static constexpr uint32 RegisterEventFd = 4;
+
+	static constexpr uint64 OffsetSqRing = 0;
+	static constexpr uint64 OffsetCqRing = 0x8000000ull;
+	static constexpr uint64 OffsetSqes = 0x10000000ull;
+
+	static constexpr int32 MaxRetryCount = 10;
+
+	static int32 Setup(uint32 Entries, FParams& Params)
+	{
+		return int32(syscall(__NR_io_uring_setup, Entries, &Params));
+	}
+
+	static int32 Enter(int32 RingFd, uint32 ToSubmit, uint32 MinComplete, uint32 Flags)
+	{
+		return int32(syscall(__NR_io_uring_enter, RingFd, ToSubmit, MinComplete, Flags, nullptr, 0));
+	}
+
+	static int32 Register(int32 RingFd, uint32 Opcode, const void* Args, uint32 NumArgs)
+	{
+		return int32(syscall(__NR_io_uring_register, RingFd, Opcode, Args, NumArgs));
+	}
+
+	static void* MapRing(int32 RingFd, uint64 Size, uint64 Offset)
+	{
+		void* Memory = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, Offset);
+		return Memory != MAP_FAILED ? Memory : nullptr;
+	}
+}
+
+FLinuxFileIoStoreImpl::FLinuxFileIoStoreImpl()
+{
+}
+
+FLinuxFileIoStoreImpl::~FLinuxFileIoStoreImpl()
+{
+	DestroyRing();
+}
+
+bool FLinuxFileIoStoreImpl::InitializeRing(uint32 QueueDepth)
+{
+	using namespace LinuxIoUring;
+
+	check(RingFd < 0);
+
+	FParams Params;
+	FMemory::Memzero(Params);
+	RingFd = Setup(QueueDepth, Params);
+	if (RingFd < 0)
+	{
+		const int32 ErrNo = errno;
+		UE_LOG(LogIoDispatcher, Display, TEXT("io_uring is not available (errno=%d (%s)), using the generic IoDispatcher backend"), ErrNo, UTF8_TO_TCHAR(strerror(ErrNo)));
+		RingFd = -1;
+		return false;
+	}
+
+	SqRingMemorySize = Params.SqOffsets.Array + Params.SqEntries * sizeof(uint32);
+	CqRingMemorySize = Params.CqOffsets.Cqes + Params.CqEntries * sizeof(FIoUringCqe);
+	if (Params.Features & FeatureSingleMmap)
+	{
+		SqRingMemorySize = CqRingMemorySize = FMath::Max(SqRingMemorySize, CqRingMemorySize);
+	}
+
+	SqRingMemory = MapRing(RingFd, SqRingMemorySize, OffsetSqRing);
+	if (SqRingMemory)
+	{
+		CqRingMemory = (Params.Features & FeatureSingleMmap) ? SqRingMemory : MapRing(RingFd, CqRingMemorySize, OffsetCqRing);
+	}
+	if (CqRingMemory)
+	{
+		SqeMemorySize = Params.SqEntries * sizeof(FIoUringSqe);
+		SqeMemory = MapRing(RingFd, SqeMemorySize, OffsetSqes);
+	}
+	if (!SqeMemory)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed mapping io_uring queues (errno=%d), using the generic IoDispatcher backend"), errno);
+		DestroyRing();
+		return false;
+	}
+
+	EventFd = eventfd(0, EFD_CLOEXEC);
+	if (EventFd < 0 || Register(RingFd, RegisterEventFd, &EventFd, 1) < 0)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed registering io_uring completion eventfd (errno=%d), using the generic IoDispatcher backend"), errno);
+		DestroyRing();
+		return false;
+	}
+
+	uint8* SqRing = reinterpret_cast<uint8*>(SqRingMemory);
+	SqHead = reinterpret_cast<uint32*>(SqRing + Params.SqOffsets.Head);
+	SqTail = reinterpret_cast<uint32*>(SqRing + Params.SqOffsets.Tail);
+	SqRingMask = *reinterpret_cast<uint32*>(SqRing + Params.SqOffsets.RingMask);
+	SqRingEntries = *reinterpret_cast<uint32*>(SqRing + Params.SqOffsets.RingEntries);
+	SqArray = reinterpret_cast<uint32*>(SqRing + Params.SqOffsets.Array);
+	Sqes = reinterpret_cast<FIoUringSqe*>(SqeMemory);
+
+	uint8* CqRing = reinterpret_cast<uint8*>(CqRingMemory);
+	CqHead = reinterpret_cast<uint32*>(CqRing + Params.CqOffsets.Head);
+	CqTail = reinterpret_cast<uint32*>(CqRing + Params.CqOffsets.Tail);
+	CqRingMask = *reinterpret_cast<uint32*>(CqRing + Params.CqOffsets.RingMask);
+	Cqes = reinterpret_cast<FIoUringCqe*>(CqRing + Params.CqOffsets.Cqes);
+
+	// Every in-flight read owns at most one submission, so the submission queue can never overflow
+	const uint32 InFlightReadCount = FMath::Min(QueueDepth, SqRingEntries);
+	InFlightReads.SetNum(InFlightReadCount);
+	FreeInFlightReads.Reserve(InFlightReadCount);
+	for (uint32 SlotIndex = InFlightReadCount; SlotIndex > 0; --SlotIndex)
+	{
+		FreeInFlightReads.Add(SlotIndex - 1);
+	}
+
+	UE_LOG(LogIoDispatcher, Display, TEXT("Using io_uring IoDispatcher backend (queue depth: %u)"), InFlightReadCount);
+	return true;
+}
+
+void FLinuxFileIoStoreImpl::DestroyRing()
+{
+	if (SqeMemory)
+	{
+		munmap(SqeMemory, SqeMemorySize);
+		SqeMemory = nullptr;
+	}
+	if (CqRingMemory && CqRingMemory != SqRingMemory)
+	{
+		munmap(CqRingMemory, CqRingMemorySize);
+	}
+	CqRingMemory = nullptr;
+	if (SqRingMemory)
+	{
+		munmap(SqRingMemory, SqRingMemorySize);
+		SqRingMemory = nullptr;
+	}
+	if (EventFd >= 0)
+	{
+		close(EventFd);
+		EventFd = -1;
+	}
+	if (RingFd >= 0)
+	{
+		// Closing the ring waits for any reads still owned by the kernel, and unregisters the buffers
+		close(RingFd);
+		RingFd = -1;
+	}
+}
+
+void FLinuxFileIoStoreImpl::Initialize(const FInitializePlatformFileIoStoreParams& Params)
+{
+	WakeUpDispatcherThreadDelegate = Params.WakeUpDispatcherThreadDelegate;
+	BufferAllocator = Params.BufferAllocator;
+	BlockCache = Params.BlockCache;
+	Stats = Params.Stats;
+
+	if (GIoDispatcherIoUringRegisterBuffers && BufferAllocator->GetBufferMemorySize())
+	{
+		struct iovec BufferMemory;
+		BufferMemory.iov_base = BufferAllocator->GetBufferMemory();
+		BufferMemory.iov_len = BufferAllocator->GetBufferMemorySize();
+
+		// The buffer memory is locked while registered, so this can fail if it exceeds RLIMIT_MEMLOCK
+		if (LinuxIoUring::Register(RingFd, LinuxIoUring::RegisterBuffers, &BufferMemory, 1) == 0)
+		{
+			bRegisteredBuffers = true;
+		}
+		else
+		{
+			UE_LOG(LogIoDispatcher, Display, TEXT("Failed registering IoDispatcher buffers with io_uring (errno=%d), using unregistered reads"), errno);
+		}
+	}
+}
+
+bool FLinuxFileIoStoreImpl::OpenContainer(const TCHAR* ContainerFilePath, uint64& ContainerFileHandle, uint64& ContainerFileSize)
+{
+	IPlatformFile& Ipf = IPlatformFile::GetPlatformPhysical();
+	const FString Filename = Ipf.ConvertToAbsolutePathForExternalAppForRead(ContainerFilePath);
+	int32 Fd = open(TCHAR_TO_UTF8(*Filename), O_RDONLY | O_CLOEXEC);
+	if (Fd < 0)
+	{
+		return false;
+	}
+	struct stat FileInfo;
+	if (fstat(Fd, &FileInfo) != 0)
+	{
+		close(Fd);
+		return false;
+	}
+	ContainerFileHandle = uint64(Fd);
+	ContainerFileSize = uint64(FileInfo.st_size);
+	return true;
+}
+
+void FLinuxFileIoStoreImpl::CloseContainer(uint64 ContainerFileHandle)
+{
+	check(ContainerFileHandle != uint64(-1));
+	close(int32(ContainerFileHandle));
+}
+
+bool FLinuxFileIoStoreImpl::StartRequests(FFileIoStoreRequestQueue& RequestQueue)
+{
+	uint32 CompletedCount = ReapCompletions();
+	bool bStartedAny = false;
+
+	while (FreeInFlightReads.Num())
+	{
+		FFileIoStoreReadRequest* NextRequest = RequestQueue.Pop();
+		if (!NextRequest)
+		{
+			break;
+		}
+
+		if (NextRequest->bCancelled)
+		{
+			CompleteRequest(NextRequest);
+			++CompletedCount;
+			continue;
+		}
+
+		check(!NextRequest->ImmediateScatter.Request);
+		NextRequest->Buffer = BufferAllocator->AllocBuffer();
+		if (!NextRequest->Buffer)
+		{
+			RequestQueue.Push(*NextRequest);
+			break;
+		}
+
+		if (BlockCache->Read(NextRequest))
+		{
+			CompleteRequest(NextRequest);
+			++CompletedCount;
+			continue;
+		}
+
+		const uint32 SlotIndex = FreeInFlightReads.Pop(false);
+		FInFlightRead& InFlightRead = InFlightReads[SlotIndex];
+		InFlightRead.Request = NextRequest;
+		InFlightRead.BytesRead = 0;
+		InFlightRead.RetryCount = 0;
+
+		Stats->OnFilesystemReadStarted(NextRequest);
+		verify(QueueRead(SlotIndex));
+		bStartedAny = true;
+	}
+
+	SubmitQueuedReads();
+
+	if (CompletedCount)
+	{
+		WakeUpDispatcherThreadDelegate->Execute();
+	}
+	return bStartedAny || CompletedCount > 0;
+}
+
+void FLinuxFileIoStoreImpl::GetCompletedRequests(FFileIoStoreReadRequestList& OutRequests)
+{
+	FScopeLock _(&CompletedRequestsCritical);
+	OutRequests.AppendSteal(CompletedRequests);
+}
+
+void FLinuxFileIoStoreImpl::ServiceNotify()
+{
+	const uint64 Value = 1;
+	ssize_t Result = write(EventFd, &Value, sizeof(Value));
+	(void)Result;
+}
+
+void FLinuxFileIoStoreImpl::ServiceWait()
+{
+	// Woken by either ServiceNotify or the kernel posting a completion, as the eventfd is registered with the ring
+	uint64 Value = 0;
+	while (read(EventFd, &Value, sizeof(Value)) < 0 && errno == EINTR)
+	{
+	}
+}
+
+uint32 FLinuxFileIoStoreImpl::ReapCompletions()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(IoUringReapCompletions);
+
+	uint32 CompletedCount = 0;
+	uint32 Head = *CqHead;
+	const uint32 Tail = __atomic_load_n(CqTail, __ATOMIC_ACQUIRE);
+	while (Head != Tail)
+	{
+		const FIoUringCqe& Cqe = Cqes[Head & CqRingMask];
+		const uint32 SlotIndex = uint32(Cqe.UserData);
+		const int32 Result = Cqe.Result;
+		++Head;
+
+		FInFlightRead& InFlightRead = InFlightReads[SlotIndex];
+		FFileIoStoreReadRequest* Request = InFlightRead.Request;
+		check(Request);
+
+		bool bRetry = false;
+		if (Result == -EINTR || Result == -EAGAIN)
+		{
+			bRetry = true;
+		}
+		else if (Result <= 0)
+		{
+			UE_LOG(LogIoDispatcher, Warning, TEXT("Failed reading %llu bytes at offset %llu (Result: %d, Retries: %d)"), Request->Size, Request->Offset, Result, InFlightRead.RetryCount);
+			bRetry = Result < 0;
+		}
+		else
+		{
+			// Short reads are legal, in which case the rest of the block is read by a new submission
+			InFlightRead.BytesRead += uint64(Result);
+			if (InFlightRead.BytesRead < Request->Size)
+			{
+				bRetry = true;
+				--InFlightRead.RetryCount;
+			}
+			else
+			{
+				Request->bFailed = false;
+				Stats->OnFilesystemReadCompleted(Request);
+				BlockCache->Store(Request);
+				InFlightRead.Request = nullptr;
+				FreeInFlightReads.Add(SlotIndex);
+				CompleteRequest(Request);
+				++CompletedCount;
+				continue;
+			}
+		}
+
+		if (bRetry && ++InFlightRead.RetryCount <= LinuxIoUring::MaxRetryCount && QueueRead(SlotIndex))
+		{
+			continue;
+		}
+
+		Request->bFailed = true;
+		InFlightRead.Request = nullptr;
+		FreeInFlightReads.Add(SlotIndex);
+		CompleteRequest(Request);
+		++CompletedCount;
+	}
+	__atomic_store_n(CqHead, Head, __ATOMIC_RELEASE);
+
+	return CompletedCount;
+}
+
+bool FLinuxFileIoStoreImpl::QueueRead(uint32 SlotIndex)
+{
+	const uint32 Tail = *SqTail;
+	if (Tail - __atomic_load_n(SqHead, __ATOMIC_ACQUIRE) >= SqRingEntries)
+	{
+		return false;
+	}
+
+	FInFlightRead& InFlightRead = InFlightReads[SlotIndex];
+	FFileIoStoreReadRequest* Request = InFlightRead.Request;
+	uint8* Dest = Request->Buffer->Memory + InFlightRead.BytesRead;
+	const uint64 RemainingSize = Request->Size - InFlightRead.BytesRead;
+
+	const uint32 Index = Tail & SqRingMask;
+	FIoUringSqe& Sqe = Sqes[Index];
+	FMemory::Memzero(Sqe);
+	Sqe.Fd = int32(Request->FileHandle);
+	Sqe.Offset = Request->Offset + InFlightRead.BytesRead;
+	Sqe.UserData = SlotIndex;
+	if (bRegisteredBuffers)
+	{
+		// Buffer index 0 covers all of BufferAllocator's memory
+		Sqe.Opcode = LinuxIoUring::OpReadFixed;
+		Sqe.Address = reinterpret_cast<UPTRINT>(Dest);
+		Sqe.Length = uint32(RemainingSize);
+		Sqe.BufferIndex = 0;
+	}
+	else
+	{
+		InFlightRead.Iov.iov_base = Dest;
+		InFlightRead.Iov.iov_len = RemainingSize;
+		Sqe.Opcode = LinuxIoUring::OpReadV;
+		Sqe.Address = reinterpret_cast<UPTRINT>(&InFlightRead.Iov);
+		Sqe.Length = 1;
+	}
+	SqArray[Index] = Index;
+
+	__atomic_store_n(SqTail, Tail + 1, __ATOMIC_RELEASE);
+	++PendingSubmitCount;
+	return true;
+}
+
+void FLinuxFileIoStoreImpl::SubmitQueuedReads()
+{
+	while (PendingSubmitCount)
+	{
+		const int32 SubmittedCount = LinuxIoUring::Enter(RingFd, PendingSubmitCount, 0, 0);
+		if (SubmittedCount < 0)
+		{
+			// Anything not consumed by the kernel stays in the submission queue, and is submitted on the next call
+			const int32 ErrNo = errno;
+			UE_CLOG(ErrNo != EINTR && ErrNo != EAGAIN && ErrNo != EBUSY, LogIoDispatcher, Warning, TEXT("Failed submitting io_uring reads (errno=%d)"), ErrNo);
+			if (ErrNo != EINTR)
+			{
+				break;
+			}
+			continue;
+		}
+		PendingSubmitCount -= FMath::Min(uint32(SubmittedCount), PendingSubmitCount);
+	}
+}
+
+void FLinuxFileIoStoreImpl::CompleteRequest(FFileIoStoreReadRequest* Request)
+{
+	FScopeLock _(&CompletedRequestsCritical);
+	CompletedRequests.Add(Request);
+}
+
+TUniquePtr<IPlatformFileIoStore> CreatePlatformFileIoStore()
+{
+	TUniquePtr<FLinuxFileIoStoreImpl> PlatformImpl = MakeUnique<FLinuxFileIoStoreImpl>();
+	if (!PlatformImpl->InitializeRing(uint32(FMath::Clamp(GIoDispatcherIoUringQueueDepth, 1, 4096))))
+	{
+		return nullptr;
+	}
+	return PlatformImpl;
+}
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "HAL/CriticalSection.h"
+#include "IO/IoDispatcher.h"
+#include "IoDispatcherFileBackendTypes.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#include <sys/uio.h>
+
+struct FIoUringSqe;
+struct FIoUringCqe;
+
+/**
+ * IoStore file backend for Linux using io_uring.
+ * Many read requests are queued with the kernel at once (up to s.IoDispatcherIoUringQueueDepth), reading directly into the
+ * buffers of FFileIoStoreBufferAllocator, which are registered with the ring up front where possible (see s.IoDispatcherIoUringRegisterBuffers).
+ * Completions are signaled through an eventfd, which is shared with ServiceNotify so that the IoService thread can block on both.
+ *
+ * Created by CreatePlatformFileIoStore, which returns null when io_uring isn't available (e.g. older kernels, or disabled by seccomp),
+ * in which case the IoStore falls back to FGenericFileIoStoreImpl.
+ */
+class FLinuxFileIoStoreImpl : public IPlatformFileIoStore
+{
+public:
+	FLinuxFileIoStoreImpl();
+	~FLinuxFileIoStoreImpl();
+
+	/** Creates the ring and completion eventfd, returns false if io_uring is not supported */
+	bool InitializeRing(uint32 QueueDepth);
+
+	void Initialize(const FInitializePlatformFileIoStoreParams& Params) override;
+	bool OpenContainer(const TCHAR* ContainerFilePath, uint64& ContainerFileHandle, uint64& ContainerFileSize) override;
+	void CloseContainer(uint64 ContainerFileHandle) override;
+	bool CreateCustomRequests(FFileIoStoreResolvedRequest& ResolvedRequest, FFileIoStoreReadRequestList& OutRequests) override
+	{
+		return false;
+	}
+	bool StartRequests(FFileIoStoreRequestQueue& RequestQueue) override;
+	void GetCompletedRequests(FFileIoStoreReadRequestList& OutRequests) override;
+
+	virtual void ServiceNotify() override;
+	virtual void ServiceWait() override;
+
+private:
+	struct FInFlightRead
+	{
+		FFileIoStoreReadRequest* Request = nullptr;
+		uint64 BytesRead = 0;
+		int32 RetryCount = 0;
+		struct iovec Iov;
+	};
+
+	/** Moves finished reads from the completion queue to CompletedRequests, returns the number of reads that finished */
+	uint32 ReapCompletions();
+	/** Queues a read of the remaining bytes of an in-flight read, returns false if the submission queue is full */
+	bool QueueRead(uint32 SlotIndex);
+	/** Submits all queued reads to the kernel */
+	void SubmitQueuedReads();
+	void CompleteRequest(FFileIoStoreReadRequest* Request);
+	void DestroyRing();
+
+	const FWakeUpIoDispatcherThreadDelegate* WakeUpDispatcherThreadDelegate = nullptr;
+	FFileIoStoreBufferAllocator* BufferAllocator = nullptr;
+	FFileIoStoreBlockCache* BlockCache = nullptr;
+	FFileIoStoreStats* Stats = nullptr;
+
+	int32 RingFd = -1;
+	int32 EventFd = -1;
+
+	void* SqRingMemory = nullptr;
+	uint64 SqRingMemorySize = 0;
+	void* CqRingMemory = nullptr;
+	uint64 CqRingMemorySize = 0;
+	void* SqeMemory = nullptr;
+	uint64 SqeMemorySize = 0;
+
+	uint32* SqHead = nullptr;
+	uint32* SqTail = nullptr;
+	uint32 SqRingMask = 0;
+	uint32 SqRingEntries = 0;
+	uint32* SqArray = nullptr;
+	FIoUringSqe* Sqes = nullptr;
+	uint32* CqHead = nullptr;
+	uint32* CqTail = nullptr;
+	uint32 CqRingMask = 0;
+	FIoUringCqe* Cqes = nullptr;
+
+	/** The number of queued submissions not yet passed to the kernel */
+	uint32 PendingSubmitCount = 0;
+
+	/** Reads owned by the kernel, indexed by the user data of their submissions */
+	TArray<FInFlightRead> InFlightReads;
+	TArray<uint32> FreeInFlightReads;
+
+	/** Whether BufferAllocator's memory is registered with the ring, in which case fixed buffer reads are used */
+	bool bRegisteredBuffers = false;
+
+	FCriticalSection CompletedRequestsCritical;
+	FFileIoStoreReadRequestList CompletedRequests;
+};
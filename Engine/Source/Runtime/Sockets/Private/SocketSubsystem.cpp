@@ -652,6 +652,17 @@ bool ISocketSubsystem::IsSocketRecvMultiSupported() const
 	return false;
 }
 
+TUniquePtr<FSendMulti> ISocketSubsystem::CreateSendMulti(int32 MaxNumPackets, int32 MaxPacketSize,
+															ESendMultiFlags Flags/*=ESendMultiFlags::None*/)
+{
+	return MakeUnique<FSendMulti>(this, MaxNumPackets, MaxPacketSize, Flags);
+}
+
+bool ISocketSubsystem::IsSocketSendMultiSupported() const
+{
+	return false;
+}
+
 double ISocketSubsystem::TranslatePacketTimestamp(const FPacketTimestamp& Timestamp,
 													ETimestampTranslation Translation/*=ETimestampTranslation::LocalTimestamp*/)
 {
@@ -25,6 +25,69 @@ void FRecvMulti::CountBytes(FArchive& Ar) const
 	Ar.CountBytes(MaxNumPackets * sizeof(FRecvData), MaxNumPackets * sizeof(FRecvData));
 }
 
+
+/**
+ * FSendMulti
+ */
+
+FSendMulti::FSendMulti(ISocketSubsystem* InSocketSubsystem, int32 InMaxNumPackets, int32 InMaxPacketSize, ESendMultiFlags InFlags)
+	: Packets(MakeUnique<FSendData[]>(InMaxNumPackets))
+	, DataBuffer(MakeUnique<uint8[]>(InMaxNumPackets * InMaxPacketSize))
+	, NumPackets(0)
+	, SocketSubsystem(InSocketSubsystem)
+	, LastSendError(SE_NO_ERROR)
+	, MaxNumPackets(InMaxNumPackets)
+	, MaxPacketSize(InMaxPacketSize)
+	, Flags(InFlags)
+{
+	for (int32 i=0; i<MaxNumPackets; i++)
+	{
+		Packets[i].Data = &DataBuffer[MaxPacketSize*i];
+	}
+}
+
+bool FSendMulti::AddPacket(const uint8* Data, int32 Count, const TSharedRef<const FInternetAddr>& Destination)
+{
+	bool bSuccess = false;
+
+	if (NumPackets < MaxNumPackets && Count > 0 && Count <= MaxPacketSize)
+	{
+		FSendData& CurPacket = Packets[NumPackets];
+
+		FMemory::Memcpy(const_cast<uint8*>(CurPacket.Data), Data, Count);
+
+		CurPacket.Count = Count;
+		CurPacket.Destination = Destination;
+
+		NumPackets++;
+		bSuccess = true;
+	}
+
+	return bSuccess;
+}
+
+void FSendMulti::Reset()
+{
+	for (int32 i=0; i<NumPackets; i++)
+	{
+		Packets[i].Destination.Reset();
+		Packets[i].Count = 0;
+	}
+
+	NumPackets = 0;
+}
+
+void FSendMulti::CountBytes(FArchive& Ar) const
+{
+	Ar.CountBytes(sizeof(*this), sizeof(*this));
+
+	// Packets
+	Ar.CountBytes(MaxNumPackets * sizeof(FSendData), MaxNumPackets * sizeof(FSendData));
+
+	// DataBuffer
+	Ar.CountBytes(MaxNumPackets * MaxPacketSize, MaxNumPackets * MaxPacketSize);
+}
+
 //
 // FSocket stats implementation
 //
@@ -45,6 +108,30 @@ bool FSocket::Send(const uint8* Data, int32 Count, int32& BytesSent)
 }
 
 
+bool FSocket::SendMulti(FSendMulti& MultiData, int32& OutPacketsSent)
+{
+	OutPacketsSent = 0;
+	MultiData.LastSendError = SE_NO_ERROR;
+
+	// Generic fallback, for platforms without native batched sends
+	for (int32 PacketIdx=0; PacketIdx<MultiData.GetNumPackets(); PacketIdx++)
+	{
+		TArrayView<const uint8> PacketData = MultiData.GetPacketData(PacketIdx);
+		int32 BytesSent = 0;
+
+		if (!SendTo(PacketData.GetData(), PacketData.Num(), BytesSent, MultiData.GetPacketDestination(PacketIdx)))
+		{
+			MultiData.LastSendError = MultiData.SocketSubsystem != nullptr ? MultiData.SocketSubsystem->GetLastErrorCode() : SE_EINVAL;
+			return false;
+		}
+
+		OutPacketsSent++;
+	}
+
+	return true;
+}
+
+
 bool FSocket::RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInternetAddr& Source, ESocketReceiveFlags::Type Flags)
 {
 	if( BytesRead > 0 )
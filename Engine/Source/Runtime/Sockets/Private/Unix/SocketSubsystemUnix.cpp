@@ -174,6 +174,24 @@ bool FSocketSubsystemUnix::IsSocketRecvMultiSupported() const
 	return false;
 }
 
+TUniquePtr<FSendMulti> FSocketSubsystemUnix::CreateSendMulti(int32 MaxNumPackets, int32 MaxPacketSize, ESendMultiFlags Flags)
+{
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG
+	return MakeUnique<FUnixSendMulti>(this, MaxNumPackets, MaxPacketSize, Flags);
+#endif
+
+	return FSocketSubsystemBSD::CreateSendMulti(MaxNumPackets, MaxPacketSize, Flags);
+}
+
+bool FSocketSubsystemUnix::IsSocketSendMultiSupported() const
+{
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG
+	return true;
+#endif
+
+	return false;
+}
+
 double FSocketSubsystemUnix::TranslatePacketTimestamp(const FPacketTimestamp& Timestamp, ETimestampTranslation Translation)
 {
 	double ReturnVal = 0.0;
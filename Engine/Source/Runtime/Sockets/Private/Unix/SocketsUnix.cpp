@@ -4,6 +4,20 @@
 #include "SocketsUnix.h"
 #include "BSDSockets/IPAddressBSD.h"
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG
+#include <errno.h>
+#include <netinet/udp.h>
+
+// UDP segmentation offload may not be defined by older system headers (added in Linux 4.18)
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#endif
+
 
 // @todo: Add timestamp support for normal Recv/RecvFrom (not essential, there is no API for this yet)
 
@@ -115,6 +129,156 @@ void FUnixRecvMulti::CountBytes(FArchive& Ar) const
 #endif
 
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG
+constexpr const int32 SegmentControlMsgSize		= CMSG_SPACE(sizeof(uint16));
+
+/** The maximum number of segments the kernel accepts for a single UDP_SEGMENT send (UDP_MAX_SEGMENTS) */
+constexpr const int32 MaxSegmentsPerSend		= 64;
+
+/** The maximum total payload for a single UDP_SEGMENT send */
+constexpr const int32 MaxSegmentedSendBytes		= 65507;
+
+
+/**
+ * FUnixSendMulti
+ */
+
+FUnixSendMulti::FUnixSendMulti(ISocketSubsystem* SocketSubsystem, int32 InMaxNumPackets, int32 InMaxPacketSize,
+								ESendMultiFlags InFlags)
+	: FSendMulti(SocketSubsystem, InMaxNumPackets, InMaxPacketSize, InFlags)
+	, Headers(MakeUnique<mmsghdr[]>(MaxNumPackets))
+	, HeaderPacketCounts(MakeUnique<int32[]>(MaxNumPackets))
+	, bSegmentationOffloadFailed(false)
+	, BufferMaps(MakeUnique<iovec[]>(MaxNumPackets))
+{
+	const bool bSegmentationOffload = EnumHasAnyFlags(InFlags, ESendMultiFlags::SegmentationOffload);
+
+	RawSegmentData = (bSegmentationOffload ? MakeUnique<uint8[]>(SegmentControlMsgSize * MaxNumPackets) : nullptr);
+
+	for (int32 i=0; i<MaxNumPackets; i++)
+	{
+		BufferMaps[i].iov_base = (void*)Packets[i].Data;
+		BufferMaps[i].iov_len = 0;
+	}
+}
+
+int32 FUnixSendMulti::BuildHeaders(int32 StartPacketIdx, const FName& SocketProtocol)
+{
+	const bool bSegment = UseSegmentationOffload() && RawSegmentData.IsValid();
+	int32 NumHeaders = 0;
+	int32 PacketIdx = StartPacketIdx;
+
+	while (PacketIdx < NumPackets)
+	{
+		const FSendData& FirstPacket = Packets[PacketIdx];
+
+		if (FirstPacket.Destination->GetProtocolType() != SocketProtocol)
+		{
+			UE_LOG(LogSockets, Warning, TEXT("Destination protocol of '%s' does not match protocol: '%s' for address: '%s'"),
+				*FirstPacket.Destination->GetProtocolType().ToString(), *SocketProtocol.ToString(), *FirstPacket.Destination->ToString(true));
+
+			break;
+		}
+
+		int32 GroupCount = 1;
+		BufferMaps[PacketIdx].iov_len = FirstPacket.Count;
+
+		// Coalesce following packets to the same destination, into one segmented send. Every segment except the last must match
+		// the size of the first packet, as the kernel splits the payload at that size.
+		if (bSegment)
+		{
+			const int32 SegmentSize = FirstPacket.Count;
+			int32 TotalBytes = SegmentSize;
+
+			while (PacketIdx + GroupCount < NumPackets && GroupCount < MaxSegmentsPerSend)
+			{
+				const FSendData& PrevPacket = Packets[PacketIdx + GroupCount - 1];
+				const FSendData& NextPacket = Packets[PacketIdx + GroupCount];
+
+				if (PrevPacket.Count != SegmentSize || NextPacket.Count > SegmentSize ||
+					(TotalBytes + NextPacket.Count) > MaxSegmentedSendBytes || !(*NextPacket.Destination == *FirstPacket.Destination))
+				{
+					break;
+				}
+
+				BufferMaps[PacketIdx + GroupCount].iov_len = NextPacket.Count;
+				TotalBytes += NextPacket.Count;
+				GroupCount++;
+			}
+		}
+
+		mmsghdr& CurHeader = Headers[NumHeaders];
+		msghdr& CurInnerHeader = CurHeader.msg_hdr;
+		FInternetAddrBSD& CurBSDAddr = const_cast<FInternetAddrBSD&>(static_cast<const FInternetAddrBSD&>(*FirstPacket.Destination));
+
+		CurInnerHeader.msg_name = CurBSDAddr.GetRawAddr();
+		CurInnerHeader.msg_namelen = CurBSDAddr.GetStorageSize();
+		CurInnerHeader.msg_iov = &BufferMaps[PacketIdx];
+		CurInnerHeader.msg_iovlen = GroupCount;
+		CurInnerHeader.msg_control = nullptr;
+		CurInnerHeader.msg_controllen = 0;
+		CurInnerHeader.msg_flags = 0;
+		CurHeader.msg_len = 0;
+
+		if (GroupCount > 1)
+		{
+			uint8* CurSegmentData = &RawSegmentData[NumHeaders * SegmentControlMsgSize];
+
+			FMemory::Memzero(CurSegmentData, SegmentControlMsgSize);
+
+			CurInnerHeader.msg_control = CurSegmentData;
+			CurInnerHeader.msg_controllen = SegmentControlMsgSize;
+
+			cmsghdr* SegmentMsg = CMSG_FIRSTHDR(&CurInnerHeader);
+
+			SegmentMsg->cmsg_level = SOL_UDP;
+			SegmentMsg->cmsg_type = UDP_SEGMENT;
+			SegmentMsg->cmsg_len = CMSG_LEN(sizeof(uint16));
+
+			const uint16 SegmentSize = (uint16)FirstPacket.Count;
+
+			FMemory::Memcpy(CMSG_DATA(SegmentMsg), &SegmentSize, sizeof(SegmentSize));
+		}
+
+		HeaderPacketCounts[NumHeaders] = GroupCount;
+		PacketIdx += GroupCount;
+		NumHeaders++;
+	}
+
+	return NumHeaders;
+}
+
+void FUnixSendMulti::CountBytes(FArchive& Ar) const
+{
+	FSendMulti::CountBytes(Ar);
+
+	int32 CurSize = sizeof(*this) - sizeof(FSendMulti);
+
+	Ar.CountBytes(CurSize, CurSize);
+
+	// Headers
+	CurSize = sizeof(mmsghdr) * MaxNumPackets;
+
+	Ar.CountBytes(CurSize, CurSize);
+
+	// HeaderPacketCounts
+	CurSize = sizeof(int32) * MaxNumPackets;
+
+	Ar.CountBytes(CurSize, CurSize);
+
+	// RawSegmentData
+	CurSize = (RawSegmentData.IsValid() ? (SegmentControlMsgSize * MaxNumPackets) : 0);
+
+	Ar.CountBytes(CurSize, CurSize);
+
+	// BufferMaps
+	CurSize = sizeof(iovec) * MaxNumPackets;
+
+	Ar.CountBytes(CurSize, CurSize);
+}
+#endif
+
+
 /**
  * FSocketUnix
  */
@@ -142,6 +306,62 @@ bool FSocketUnix::RecvMulti(FRecvMulti& MultiData, ESocketReceiveFlags::Type Fla
 	return bSuccess;
 }
 
+// NOTE: Does not support TCP at the moment.
+bool FSocketUnix::SendMulti(FSendMulti& MultiData, int32& OutPacketsSent)
+{
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG
+	FUnixSendMulti& UnixMultiData = (FUnixSendMulti&)MultiData;
+	const int32 NumPackets = UnixMultiData.NumPackets;
+
+	OutPacketsSent = 0;
+	UnixMultiData.LastSendError = SE_NO_ERROR;
+
+	while (OutPacketsSent < NumPackets)
+	{
+		const bool bSegmented = UnixMultiData.UseSegmentationOffload();
+		const int32 NumHeaders = UnixMultiData.BuildHeaders(OutPacketsSent, GetProtocol());
+
+		if (NumHeaders == 0)
+		{
+			UnixMultiData.LastSendError = SE_EINVAL;
+			return false;
+		}
+
+		const int NumHeadersSent = sendmmsg(Socket, UnixMultiData.Headers.Get(), NumHeaders, 0);
+
+		if (NumHeadersSent <= 0)
+		{
+			const int SendError = errno;
+
+			// Kernels/NICs without UDP_SEGMENT support reject the control message - fall back to unsegmented sends
+			if (bSegmented && (SendError == EINVAL || SendError == ENOPROTOOPT || SendError == EOPNOTSUPP || SendError == EIO))
+			{
+				UE_LOG(LogSockets, Log, TEXT("Socket '%s' UDP segmentation offload unsupported (errno %i), disabling."), *SocketDescription,
+						SendError);
+
+				UnixMultiData.bSegmentationOffloadFailed = true;
+
+				continue;
+			}
+
+			UnixMultiData.LastSendError = SocketSubsystem->TranslateErrorCode(SendError);
+			return false;
+		}
+
+		for (int32 HeaderIdx=0; HeaderIdx<NumHeadersSent; HeaderIdx++)
+		{
+			OutPacketsSent += UnixMultiData.HeaderPacketCounts[HeaderIdx];
+		}
+
+		LastActivityTime = FPlatformTime::Seconds();
+	}
+
+	return true;
+#else
+	return FSocketBSD::SendMulti(MultiData, OutPacketsSent);
+#endif
+}
+
 bool FSocketUnix::SetRetrieveTimestamp(bool bRetrieveTimestamp)
 {
 	bool bSuccess = false;
@@ -39,8 +39,58 @@ public:
 #endif
 
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_SENDMMSG
 /**
- * Unix specific socket implementation - primarily, adds support for recvmmsg
+ * Implements platform specific data/buffers for SendMulti in Linux
+ */
+struct FUnixSendMulti : public FSendMulti
+{
+	friend class FSocketUnix;
+
+protected:
+	/** Stores mmsghdr struct values for use with sendmmsg, rebuilt from the queued packets for each send */
+	TUniquePtr<mmsghdr[]>	Headers;
+
+	/** The number of queued packets covered by each entry in Headers (more than one, when segmentation offload coalesces packets) */
+	TUniquePtr<int32[]>		HeaderPacketCounts;
+
+	/** Buffer for storing UDP_SEGMENT control messages, when segmentation offload is enabled */
+	TUniquePtr<uint8[]>		RawSegmentData;
+
+	/** Whether or not segmentation offload was rejected by the kernel, and should no longer be attempted */
+	bool					bSegmentationOffloadFailed;
+
+private:
+	/** Maps each packet in DataBuffer, within Headers */
+	TUniquePtr<iovec[]>		BufferMaps;
+
+
+public:
+	FUnixSendMulti(ISocketSubsystem* SocketSubsystem, int32 InMaxNumPackets, int32 InMaxPacketSize, ESendMultiFlags InFlags);
+
+	virtual void CountBytes(FArchive& Ar) const override;
+
+protected:
+	/**
+	 * Fills in Headers for the queued packets, starting at the specified packet
+	 *
+	 * @param StartPacketIdx	The first packet which has not been sent yet
+	 * @param SocketProtocol	The protocol of the socket the packets will be sent on
+	 * @return					The number of Headers which were filled in
+	 */
+	int32 BuildHeaders(int32 StartPacketIdx, const FName& SocketProtocol);
+
+	/** Whether or not segmentation offload should be used for the next send */
+	bool UseSegmentationOffload() const
+	{
+		return EnumHasAnyFlags(Flags, ESendMultiFlags::SegmentationOffload) && !bSegmentationOffloadFailed;
+	}
+};
+#endif
+
+
+/**
+ * Unix specific socket implementation - primarily, adds support for recvmmsg/sendmmsg
  */
 class FSocketUnix : public FSocketBSD
 {
@@ -55,5 +105,6 @@ public:
 	}
 
 	virtual bool RecvMulti(FRecvMulti& MultiData, ESocketReceiveFlags::Type Flags) override;
+	virtual bool SendMulti(FSendMulti& MultiData, int32& OutPacketsSent) override;
 	virtual bool SetRetrieveTimestamp(bool bRetrieveTimestamp) override;
 };
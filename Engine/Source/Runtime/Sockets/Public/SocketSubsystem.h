@@ -333,6 +333,18 @@ public:
 	virtual TUniquePtr<FRecvMulti> CreateRecvMulti(int32 MaxNumPackets, int32 MaxPacketSize,
 													ERecvMultiFlags Flags=ERecvMultiFlags::None);
 
+	/**
+	 * Create a platform specific FSendMulti representation.
+	 * If the platform does not support batched sends, a generic instance is returned which FSocket::SendMulti sends per-packet.
+	 *
+	 * @param MaxNumPackets			The maximum number of packets which can be queued per batch
+	 * @param MaxPacketSize			The maximum supported packet size
+	 * @param Flags					Flags for specifying how FSendMulti should send packets (for e.g. segmentation offload)
+	 * @return						Returns the platform specific FSendMulti instance
+	 */
+	virtual TUniquePtr<FSendMulti> CreateSendMulti(int32 MaxNumPackets, int32 MaxPacketSize,
+													ESendMultiFlags Flags=ESendMultiFlags::None);
+
 	/**
 	 * @return Whether the machine has a properly configured network device or not
 	 */
@@ -458,6 +470,11 @@ public:
 	 */
 	virtual bool IsSocketRecvMultiSupported() const;
 
+	/**
+	 * Returns true if FSocket::SendMulti is natively batched by this socket subsystem (rather than falling back to SendTo per packet)
+	 */
+	virtual bool IsSocketSendMultiSupported() const;
+
 
 	/**
 	 * Returns true if FSocket::Wait is supported by this socket subsystem.
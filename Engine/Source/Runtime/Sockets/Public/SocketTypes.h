@@ -264,3 +264,166 @@ public:
 	 */
 	virtual void CountBytes(FArchive& Ar) const;
 };
+
+/**
+ * Flags for specifying how an FSendMulti instance should be initialized
+ */
+enum class ESendMultiFlags : uint32
+{
+	None					= 0x00000000,
+	SegmentationOffload		= 0x00000001	// Whether or not to coalesce same-destination packets using UDP segmentation offload (where supported)
+};
+
+ENUM_CLASS_FLAGS(ESendMultiFlags);
+
+
+/**
+ * Stores the persistent state and packet buffers/data, for sending packets with FSocket::SendMulti.
+ * Packets are copied into an internal buffer when added, so the source buffers may be reused immediately.
+ * To optimize performance, use only once instance of this struct, for the lifetime of the socket.
+ */
+struct SOCKETS_API FSendMulti : public FNoncopyable, public FVirtualDestructor
+{
+	friend class FSocket;
+	friend class FSocketUnix;
+
+protected:
+	/**
+	 * Send data for each individual packet
+	 */
+	struct FSendData
+	{
+		/** The destination address for the packet */
+		TSharedPtr<const FInternetAddr>	Destination;
+
+		/** Pointer to the packet data, within DataBuffer */
+		const uint8*					Data;
+
+		/** The size of the packet data, in bytes */
+		int32							Count;
+
+
+		FSendData()
+			: Destination()
+			, Data(nullptr)
+			, Count(0)
+		{
+		}
+	};
+
+
+protected:
+	/** The current list of packets queued for sending */
+	TUniquePtr<FSendData[]>			Packets;
+
+	/** The raw data buffer where all queued packet data is stored */
+	TUniquePtr<uint8[]>				DataBuffer;
+
+	/** The number of packets queued for sending */
+	int32							NumPackets;
+
+	/** The socket subsystem which created this FSendMulti instance, used to retrieve send errors */
+	ISocketSubsystem*				SocketSubsystem;
+
+	/** The error which stopped the last FSocket::SendMulti call, or SE_NO_ERROR if it sent every packet */
+	ESocketErrors					LastSendError;
+
+public:
+	/** The maximum number of packets this FSendMulti instance can queue */
+	const int32						MaxNumPackets;
+
+	/** The maximum packet size this FSendMulti instance can support */
+	const int32						MaxPacketSize;
+
+	/** The flags this FSendMulti instance was initialized with */
+	const ESendMultiFlags			Flags;
+
+
+public:
+	/**
+	 * Initialize an FSendMulti instance, supporting the specified maximum packet count/sizes.
+	 * Use ISocketSubsystem::CreateSendMulti to create the platform specific representation.
+	 *
+	 * @param SocketSubsystem		The socket subsystem initializing this FSendMulti instance
+	 * @param InMaxNumPackets		The maximum number of packet sends supported per batch
+	 * @param InMaxPacketSize		The maximum supported packet size
+	 * @param InFlags				Flags for specifying how the batch should be sent
+	 */
+	FSendMulti(ISocketSubsystem* SocketSubsystem, int32 InMaxNumPackets, int32 InMaxPacketSize,
+				ESendMultiFlags InFlags=ESendMultiFlags::None);
+
+	/**
+	 * Copies a packet into the batch
+	 *
+	 * @param Data			The packet data
+	 * @param Count			The size of the packet data, in bytes
+	 * @param Destination	The address the packet should be sent to
+	 * @return				Whether or not the packet was queued (fails if the batch is full, or the packet is too large)
+	 */
+	bool AddPacket(const uint8* Data, int32 Count, const TSharedRef<const FInternetAddr>& Destination);
+
+	/**
+	 * Removes all packets from the batch
+	 */
+	void Reset();
+
+	/**
+	 * Retrieves the current number of queued packets
+	 */
+	int32 GetNumPackets() const
+	{
+		return NumPackets;
+	}
+
+	/**
+	 * Retrieves the error which stopped the last FSocket::SendMulti call. Captured when the send fails, unlike
+	 * ISocketSubsystem::GetLastErrorCode, which later socket calls on the same thread overwrite.
+	 */
+	ESocketErrors GetLastSendError() const
+	{
+		return LastSendError;
+	}
+
+	/**
+	 * Whether or not the batch can accept any more packets
+	 */
+	bool IsFull() const
+	{
+		return NumPackets >= MaxNumPackets;
+	}
+
+	/**
+	 * Retrieves the data for the specified queued packet
+	 *
+	 * @param PacketIdx		The index of the packet to be retrieved
+	 */
+	TArrayView<const uint8> GetPacketData(int32 PacketIdx) const
+	{
+		check(PacketIdx >= 0);
+		check(PacketIdx < NumPackets);
+
+		const FSendData& CurData = Packets.Get()[PacketIdx];
+
+		return TArrayView<const uint8>(CurData.Data, CurData.Count);
+	}
+
+	/**
+	 * Retrieves the destination address for the specified queued packet
+	 *
+	 * @param PacketIdx		The index of the packet to be retrieved
+	 */
+	const FInternetAddr& GetPacketDestination(int32 PacketIdx) const
+	{
+		check(PacketIdx >= 0);
+		check(PacketIdx < NumPackets);
+
+		return *Packets.Get()[PacketIdx].Destination;
+	}
+
+	/**
+	 * Calculates the total memory consumption of this FSendMulti instance, including platform-specific data
+	 *
+	 * @param Ar	The archive being used to count the memory consumption
+	 */
+	virtual void CountBytes(FArchive& Ar) const;
+};
@@ -185,6 +185,18 @@ public:
 	 */
 	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent);
 
+	/**
+	 * Sends every packet queued in an FSendMulti batch, using as few system calls as the platform allows.
+	 * Use ISocketSubsystem::IsSocketSendMultiSupported to check if the current socket platform natively batches sends,
+	 * otherwise this falls back to one SendTo call per packet.
+	 * NOTE: The batch is not reset by this call - the caller is responsible for calling FSendMulti::Reset afterwards.
+	 *
+	 * @param MultiData			The FSendMulti instance holding the queued packets and platform specific send buffers.
+	 * @param OutPacketsSent	Will indicate how many packets (in queue order) were sent.
+	 * @return					Whether or not all of the queued packets were sent
+	 */
+	virtual bool SendMulti(FSendMulti& MultiData, int32& OutPacketsSent);
+
 	/**
 	 * Reads a chunk of data from the socket and gathers the source address.
 	 *